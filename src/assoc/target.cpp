@@ -3,8 +3,11 @@
 #include "logger.h"
 #include "stringconv.h"
 
+#include "projection/transformation.h"
+
 #include <cassert>
 #include <sstream>
+#include <algorithm>
 
 //#include <ogr_spatialref.h>
 
@@ -13,6 +16,15 @@ using namespace Utils;
 
 namespace Association
 {
+    template <typename T>
+    static void insertSortedUnique (std::vector<T>& values, const T& value)
+    {
+        auto it = lower_bound(values.begin(), values.end(), value);
+
+        if (it == values.end() || *it != value)
+            values.insert(it, value);
+    }
+
     bool Target::in_appimage_ {getenv("APPDIR") != nullptr};
 //    double Target::max_time_diff_ {15.0};
 //    double Target::max_altitude_diff_ {300.0};
@@ -32,6 +44,40 @@ namespace Association
     }
 
     void Target::addAssociated (TargetReport* tr)
+    {
+        addAssociatedInfo(tr);
+        addFlatData(assoc_trs_.size()-1);
+    }
+
+    void Target::addAssociated (vector<TargetReport*> trs)
+    {
+        if (!trs.size())
+            return;
+
+        unsigned int first_index = assoc_trs_.size();
+        bool in_order = true;
+        float prev_tod = tods_.size() ? tods_.back() : trs.front()->tod_;
+
+        for (auto& tr_it : trs)
+        {
+            if (tr_it->tod_ < prev_tod)
+                in_order = false;
+
+            prev_tod = tr_it->tod_;
+
+            addAssociatedInfo(tr_it);
+        }
+
+        if (in_order) // can be appended
+        {
+            for (unsigned int index = first_index; index < assoc_trs_.size(); ++index)
+                addFlatData(index);
+        }
+        else // merge by complete rebuild, avoids repeated insertion in the middle
+            rebuildFlatData();
+    }
+
+    void Target::addAssociatedInfo (TargetReport* tr)
     {
         assert (tr);
 
@@ -40,46 +86,103 @@ namespace Association
         {
             tod_min_ = tr->tod_;
             tod_max_ = tr->tod_;
+
+            latitude_min_ = tr->latitude_;
+            latitude_max_ = tr->latitude_;
+            longitude_min_ = tr->longitude_;
+            longitude_max_ = tr->longitude_;
         }
         else
         {
             tod_min_ = min(tod_min_, tr->tod_);
             tod_max_ = max(tod_max_, tr->tod_);
+
+            latitude_min_ = min(latitude_min_, tr->latitude_);
+            latitude_max_ = max(latitude_max_, tr->latitude_);
+            longitude_min_ = min(longitude_min_, tr->longitude_);
+            longitude_max_ = max(longitude_max_, tr->longitude_);
         }
         has_tod_ = true;
 
-        if (!ds_ids_.count(tr->ds_id_))
-            ds_ids_.insert(tr->ds_id_);
+        insertSortedUnique(ds_ids_, tr->ds_id_);
 
-        if (tr->has_tn_ && !track_nums_.count({tr->ds_id_, tr->tn_}))
-            track_nums_.insert({tr->ds_id_, tr->tn_});
+        if (tr->has_tn_)
+            insertSortedUnique(track_nums_, {tr->ds_id_, tr->tn_});
 
-        if (tr->has_ma_ && !mas_.count(tr->ma_))
-            mas_.insert(tr->ma_);
+        if (tr->has_ma_)
+            insertSortedUnique(mas_, tr->ma_);
 
-        timed_indexes_[tr->tod_] = assoc_trs_.size();
         assoc_trs_.push_back(tr);
 
         if (tr->has_ta_)
         {
-            if (tas_.size() && !tas_.count(tr->ta_))
+            if (tas_.size() && !hasTA(tr->ta_))
             {
                 logwrn << "Target: addAssociated: ta mismatch, target " << asStr()
                        << " tr " << tr->asStr();
             }
 
-            if (!tas_.count(tr->ta_))
-                tas_.insert(tr->ta_);
+            insertSortedUnique(tas_, tr->ta_);
         }
 
         if (!tmp_)
             tr->addAssociated(this);
     }
 
-    void Target::addAssociated (vector<TargetReport*> trs)
+    void Target::addFlatData (unsigned int tr_index)
     {
-        for (auto& tr_it : trs)
-            addAssociated(tr_it);
+        assert (tr_index < assoc_trs_.size());
+        TargetReport* tr = assoc_trs_.at(tr_index);
+
+        unsigned char flags = (tr->has_ma_ ? HAS_MA : 0) | (tr->has_mc_ ? HAS_MC : 0);
+
+        // mostly added in time order
+        auto it = tods_.size() && tr->tod_ > tods_.back() ? tods_.end()
+                                                           : lower_bound(tods_.begin(), tods_.end(), tr->tod_);
+        unsigned int index = it - tods_.begin();
+
+        if (it != tods_.end() && *it == tr->tod_) // same time, replace
+        {
+            latitudes_[index] = tr->latitude_;
+            longitudes_[index] = tr->longitude_;
+            mcs_[index] = tr->mc_;
+            mode_as_[index] = tr->ma_;
+            flags_[index] = flags;
+            tr_indexes_[index] = tr_index;
+
+            return;
+        }
+
+        tods_.insert(it, tr->tod_);
+        latitudes_.insert(latitudes_.begin()+index, tr->latitude_);
+        longitudes_.insert(longitudes_.begin()+index, tr->longitude_);
+        mcs_.insert(mcs_.begin()+index, tr->mc_);
+        mode_as_.insert(mode_as_.begin()+index, tr->ma_);
+        flags_.insert(flags_.begin()+index, flags);
+        tr_indexes_.insert(tr_indexes_.begin()+index, tr_index);
+    }
+
+    void Target::rebuildFlatData ()
+    {
+        vector<unsigned int> order (assoc_trs_.size());
+
+        for (unsigned int cnt=0; cnt < order.size(); ++cnt)
+            order[cnt] = cnt;
+
+        // stable, so last associated of same time is last
+        stable_sort(order.begin(), order.end(), [this](unsigned int a, unsigned int b) {
+            return assoc_trs_[a]->tod_ < assoc_trs_[b]->tod_; });
+
+        tods_.clear();
+        latitudes_.clear();
+        longitudes_.clear();
+        mcs_.clear();
+        mode_as_.clear();
+        flags_.clear();
+        tr_indexes_.clear();
+
+        for (unsigned int tr_index : order)
+            addFlatData(tr_index); // appends or replaces last
     }
 
     unsigned int Target::numAssociated() const
@@ -100,31 +203,33 @@ namespace Association
 
     bool Target::hasTA (unsigned int ta) const
     {
-        return tas_.count(ta);
+        return binary_search(tas_.begin(), tas_.end(), ta);
     }
 
-    bool Target::hasAllOfTAs (std::set<unsigned int> tas) const
+    bool Target::hasAllOfTAs (const std::vector<unsigned int>& tas) const
     {
         assert (hasTA() && tas.size());
 
-        for (auto other_ta : tas)
-        {
-            if (!tas_.count(other_ta))
-                return false;
-        }
-
-        return true;
+        return includes(tas_.begin(), tas_.end(), tas.begin(), tas.end());
     }
 
-    bool Target::hasAnyOfTAs (std::set<unsigned int> tas) const
+    bool Target::hasAnyOfTAs (const std::vector<unsigned int>& tas) const
     {
         assert (hasTA() && tas.size());
 
-        for (auto other_ta : tas)
+        auto it = tas_.begin();
+        auto other_it = tas.begin();
+
+        while (it != tas_.end() && other_it != tas.end())
         {
-            if (tas_.count(other_ta))
+            if (*it < *other_it)
+                ++it;
+            else if (*other_it < *it)
+                ++other_it;
+            else
                 return true;
         }
+
         return false;
     }
 
@@ -135,7 +240,7 @@ namespace Association
 
     bool Target::hasMA (unsigned int ma)  const
     {
-        return mas_.count(ma);
+        return binary_search(mas_.begin(), mas_.end(), ma);
     }
 
     std::string Target::asStr() const
@@ -199,102 +304,66 @@ namespace Association
         if (!isTimeInside(tod))
             return false;
 
-        if (timed_indexes_.count(tod))
-            return true; // contains exact value
-
-        //    Return iterator to lower bound
-        //    Returns an iterator pointing to the first element in the container whose key is not considered to go
-        //    before k (i.e., either it is equivalent or goes after).
-
-        auto lb_it = timed_indexes_.lower_bound(tod);
-
-        if (lb_it == timed_indexes_.end())
-            return false;
-
-        assert (lb_it->first >= tod);
-
-        if (lb_it->first - tod > d_max)
-            return false; // too much time difference
-
-        // save value
-        float upper = lb_it->first;
-
-        // TODO lb_it--; ?
-        while (lb_it != timed_indexes_.end() && tod < lb_it->first)
-        {
-            if (lb_it == timed_indexes_.begin()) // exit condition on first value
-            {
-                if (tod < lb_it->first) // set as not found
-                    lb_it = timed_indexes_.end();
-
-                break;
-            }
+        int lower, upper;
 
-            lb_it--;
-        }
+        tie(lower, upper) = indexesFor(tod, d_max);
 
-        if (lb_it == timed_indexes_.end())
+        if (lower == -1)
             return false;
 
-        assert (tod >= lb_it->first);
-
-        if (tod - lb_it->first > d_max)
-            return false; // too much time difference
-
-        float lower = lb_it->first;
+        if (upper == -1)
+            return true; // contains exact value
 
-        logdbg << "Target " << utn_ << ": hasDataForTime: found " << String::timeStringFromDouble(lower)
+        logdbg << "Target " << utn_ << ": hasDataForTime: found " << String::timeStringFromDouble(tods_[lower])
                << " <= " << String::timeStringFromDouble(tod)
-               << " <= " << String::timeStringFromDouble(upper);
+               << " <= " << String::timeStringFromDouble(tods_[upper]);
 
         return true;
     }
 
     std::pair<float, float> Target::timesFor (float tod, float d_max) const // lower/upper times, -1 if not existing
     {
-        if (timed_indexes_.count(tod))
-            return {tod, -1}; // contains exact value
+        int lower, upper;
 
-        //    Return iterator to lower bound
-        //    Returns an iterator pointing to the first element in the container whose key is not considered to go
-        //    before k (i.e., either it is equivalent or goes after).
+        tie(lower, upper) = indexesFor(tod, d_max);
 
-        auto lb_it = timed_indexes_.lower_bound(tod);
+        return {lower == -1 ? -1 : tods_[lower], upper == -1 ? -1 : tods_[upper]};
+    }
 
-        if (lb_it == timed_indexes_.end())
-            return {-1, -1};
+    std::pair<int, int> Target::indexesFor (float tod, float d_max) const
+    {
+        // first time not before tod
+        auto lb_it = lower_bound(tods_.begin(), tods_.end(), tod);
 
-        assert (lb_it->first >= tod);
+        return indexesFor(tod, d_max, lb_it - tods_.begin());
+    }
 
-        if (lb_it->first - tod > d_max)
-            return {-1, -1}; // too much time difference
+    std::pair<int, int> Target::indexesFor (float tod, float d_max, unsigned int lb_index) const
+    {
+        assert (lb_index <= tods_.size());
+
+        if (lb_index == tods_.size())
+            return {-1, -1};
 
-        // save value
-        float upper = lb_it->first;
+        int upper = lb_index;
 
-        // TODO lb_it--; ?
-        while (lb_it != timed_indexes_.end() && tod < lb_it->first)
-        {
-            if (lb_it == timed_indexes_.begin()) // exit condition on first value
-            {
-                if (tod < lb_it->first) // set as not found
-                    lb_it = timed_indexes_.end();
+        assert (tods_[upper] >= tod);
 
-                break;
-            }
+        if (tods_[upper] == tod)
+            return {upper, -1}; // contains exact value
 
-            lb_it--;
-        }
+        if (tods_[upper] - tod > d_max)
+            return {-1, -1}; // too much time difference
 
-        if (lb_it == timed_indexes_.end())
+        if (upper == 0)
             return {-1, upper};
 
-        assert (tod >= lb_it->first);
+        int lower = upper - 1;
 
-        if (tod - lb_it->first > d_max)
-            return {-1, upper}; // too much time difference
+        assert (tod >= tods_[lower]);
 
-        float lower = lb_it->first;
+        if (tod - tods_[lower] > d_max)
+            return {-1, upper}; // too much time difference
 
         return {lower, upper};
     }
@@ -359,8 +428,9 @@ namespace Association
         logdbg << "Target: interpolatedPosForTime: geo2cart";
         //bool ret = ogr_geo2cart->Transform(1, &x_pos, &y_pos); // wgs84 to cartesian offsets
 
-        tie(ok, x_pos, y_pos) = trafo_.distanceCart(
-                    pos1.latitude_, pos1.longitude_, pos2.latitude_, pos2.longitude_);
+        FixedTransformation trafo (pos1.latitude_, pos1.longitude_);
+
+        tie(ok, x_pos, y_pos) = trafo.distanceCart(pos2.latitude_, pos2.longitude_);
 
         if (!ok)
         {
@@ -386,7 +456,7 @@ namespace Association
 
         logdbg << "Target: interpolatedPosForTime: interpolated offsets x " << x_pos << " y " << y_pos;
 
-        tie (ok, x_pos, y_pos) = trafo_.wgsAddCartOffset(pos1.latitude_, pos1.longitude_, x_pos, y_pos);
+        tie (ok, x_pos, y_pos) = trafo.wgsAddCartOffset(x_pos, y_pos);
 
         //ret = ogr_cart2geo->Transform(1, &x_pos, &y_pos);
 
@@ -428,39 +498,33 @@ namespace Association
 
     std::pair<EvaluationTargetPosition, bool> Target::interpolatedPosForTimeFast (float tod, float d_max) const
     {
-        float lower, upper;
+        int lower, upper;
 
-        tie(lower, upper) = timesFor(tod, d_max);
+        tie(lower, upper) = indexesFor(tod, d_max);
 
         if (lower != -1 && upper == -1) // exact time
-            return {posForExactTime(lower), true};
+            return {posForIndex(lower), true};
 
         if (lower == -1)
             return {{}, false};
 
-        EvaluationTargetPosition pos1 = posForExactTime(lower);
-        EvaluationTargetPosition pos2 = posForExactTime(upper);
-        float d_t = upper - lower;
+        EvaluationTargetPosition pos1 = posForIndex(lower);
+        EvaluationTargetPosition pos2 = posForIndex(upper);
+        float d_t = tods_[upper] - tods_[lower];
 
         logdbg << "Target: interpolatedPosForTimeFast: d_t " << d_t;
 
-        assert (d_t >= 0);
+        assert (d_t > 0); // flat data has unique times
 
         if (pos1.latitude_ == pos2.latitude_
                 && pos1.longitude_ == pos2.longitude_) // same pos
             return {pos1, true};
 
-        if (lower == upper) // same time
-        {
-            logwrn << "Target: interpolatedPosForTimeFast: ref has same time twice";
-            return {{}, false};
-        }
-
         double v_lat = (pos2.latitude_ - pos1.latitude_)/d_t;
         double v_long = (pos2.longitude_ - pos1.longitude_)/d_t;
         logdbg << "Target: interpolatedPosForTimeFast: v_x " << v_lat << " v_y " << v_long;
 
-        float d_t2 = tod - lower;
+        float d_t2 = tod - tods_[lower];
         logdbg << "Target: interpolatedPosForTimeFast: d_t2 " << d_t2;
 
         assert (d_t2 >= 0);
@@ -501,28 +565,47 @@ namespace Association
 
     bool Target::hasDataForExactTime (float tod) const
     {
-        return timed_indexes_.count(tod);
+        return binary_search(tods_.begin(), tods_.end(), tod);
+    }
+
+    int Target::exactIndexFor (float tod) const
+    {
+        auto it = lower_bound(tods_.begin(), tods_.end(), tod);
+
+        if (it == tods_.end() || *it != tod)
+            return -1;
+
+        return it - tods_.begin();
     }
 
     TargetReport& Target::dataForExactTime (float tod) const
     {
-        assert (hasDataForExactTime(tod));;
-        assert (assoc_trs_.size() > timed_indexes_.at(tod));
-        return *assoc_trs_.at(timed_indexes_.at(tod));
+        int index = exactIndexFor(tod);
+
+        assert (index != -1);
+        assert (assoc_trs_.size() > tr_indexes_[index]);
+        return *assoc_trs_[tr_indexes_[index]];
     }
 
     EvaluationTargetPosition Target::posForExactTime (float tod) const
     {
-        assert (hasDataForExactTime(tod));
+        int index = exactIndexFor(tod);
+
+        assert (index != -1);
+
+        return posForIndex(index);
+    }
 
-        TargetReport& tr = dataForExactTime(tod);
+    EvaluationTargetPosition Target::posForIndex (unsigned int index) const
+    {
+        assert (index < tods_.size());
 
         EvaluationTargetPosition pos;
 
-        pos.latitude_ = tr.latitude_;
-        pos.longitude_ = tr.longitude_;
-        pos.has_altitude_ = tr.has_mc_;
-        pos.altitude_ = tr.mc_;
+        pos.latitude_ = latitudes_[index];
+        pos.longitude_ = longitudes_[index];
+        pos.has_altitude_ = flags_[index] & HAS_MC;
+        pos.altitude_ = mcs_[index];
 
         return pos;
     }
@@ -569,96 +652,140 @@ namespace Association
         return overlap_duration / targets_min_duration;
     }
 
-    std::tuple<vector<float>, vector<float>, vector<float>> Target::compareModeACodes (
-            const Target& other, float max_time_diff) const
+    CompareCounts Target::compareModeACCodeCounts (const Target& other, float max_time_diff, float max_alt_diff,
+                                                   unsigned int min_same, bool early_exit) const
     {
-        vector<float> unknown;
-        vector<float> same;
-        vector<float> different;
+        CompareCounts counts;
+
+        unsigned int num_updates = tods_.size();
+        unsigned int other_size = other.tods_.size();
+        unsigned int lb_index = 0; // first time in other not before tod
+        unsigned int step;
+        unsigned int remaining;
 
         float tod;
+        int lower, upper;
         CompareResult cmp_res;
 
-        for (auto tr_it : assoc_trs_)
+        for (unsigned int index=0; index < num_updates; ++index)
         {
-            tod = tr_it->tod_;
+            tod = tods_[index];
+
+            // gallop forward in other, times are ascending in both
+            if (lb_index < other_size && other.tods_[lb_index] < tod)
+            {
+                step = 1;
 
-            assert (hasDataForExactTime(tod));
+                while (lb_index + step < other_size && other.tods_[lb_index + step] < tod)
+                    step *= 2;
 
-            cmp_res = other.compareModeACode(tr_it->has_ma_, tr_it->ma_, tod, max_time_diff);
+                lb_index = lower_bound(other.tods_.begin() + lb_index + step/2,
+                                       other.tods_.begin() + min(lb_index + step, other_size), tod)
+                        - other.tods_.begin();
+            }
+
+            if (other.isTimeInside(tod))
+                tie(lower, upper) = other.indexesFor(tod, max_time_diff, lb_index);
+            else
+                lower = upper = -1;
+
+            cmp_res = other.compareModeACodeAt(flags_[index] & HAS_MA, mode_as_[index], lower, upper);
 
             if (cmp_res == CompareResult::UNKNOWN)
-                unknown.push_back(tod);
-            else if (cmp_res == CompareResult::SAME)
-                same.push_back(tod);
+                ++counts.ma_unknown_;
             else if (cmp_res == CompareResult::DIFFERENT)
-                different.push_back(tod);
-        }
+                ++counts.ma_different_;
+            else
+            {
+                ++counts.ma_same_;
+
+                cmp_res = other.compareModeCCodeAt(flags_[index] & HAS_MC, mcs_[index], lower, upper,
+                                                   max_alt_diff, false);
+
+                if (cmp_res == CompareResult::UNKNOWN)
+                    ++counts.mc_unknown_;
+                else if (cmp_res == CompareResult::SAME)
+                    ++counts.mc_same_;
+                else
+                    ++counts.mc_different_;
+            }
+
+            if (early_exit)
+            {
+                remaining = num_updates - index - 1;
 
-        assert (assoc_trs_.size() == unknown.size()+same.size()+different.size());
+                if (counts.ma_same_ + remaining <= counts.ma_different_
+                        || counts.ma_same_ + remaining < min_same
+                        || counts.mc_same_ + remaining <= counts.mc_different_
+                        || counts.mc_same_ + remaining < min_same)
+                {
+                    counts.stopped_ = index + 1 < num_updates;
+                    break;
+                }
+            }
+        }
 
-        return std::tuple<vector<float>, vector<float>, vector<float>>(unknown, same, different);
+        return counts;
     }
 
     CompareResult Target::compareModeACode (bool has_ma, unsigned int ma, float tod, float max_time_diff) const
     {
-        if (!hasDataForTime(tod, max_time_diff))
+        if (!isTimeInside(tod))
             return CompareResult::UNKNOWN;
 
-        float lower, upper;
+        int lower, upper;
+
+        tie(lower, upper) = indexesFor(tod, max_time_diff);
 
-        tie(lower, upper) = timesFor(tod, max_time_diff);
+        return compareModeACodeAt(has_ma, ma, lower, upper);
+    }
 
-        if (lower == -1 && upper == -1)
+    CompareResult Target::compareModeACodeAt (bool has_ma, unsigned int ma, int lower, int upper) const
+    {
+        if (lower == -1) // none or only upper, no data for time
             return CompareResult::UNKNOWN;
 
-        if ((lower == -1 && upper != -1)
-                || (lower != -1 && upper == -1)) // only 1
-        {
-            TargetReport& ref1 = (lower != -1) ? dataForExactTime(lower)
-                                               : dataForExactTime(upper);
+        bool ref1_has_ma = flags_[lower] & HAS_MA;
+        unsigned int ref1_ma = mode_as_[lower];
 
+        if (upper == -1) // only 1
+        {
             if (!has_ma)
             {
-                if (!ref1.has_ma_ ) // both have no mode a
+                if (!ref1_has_ma) // both have no mode a
                     return CompareResult::SAME;
                 else
                     return CompareResult::DIFFERENT;
             }
 
             // mode a exists
-            if (!ref1.has_ma_)
+            if (!ref1_has_ma)
                 return CompareResult::DIFFERENT;  // mode a here, but none in other
 
-            if ((ref1.has_ma_ && ref1.ma_ == ma)) // is same
+            if (ref1_ma == ma) // is same
                 return CompareResult::SAME;
             else
                 return CompareResult::DIFFERENT;
         }
 
         // both set
-        assert (lower != -1);
-        assert (hasDataForExactTime(lower));
-        TargetReport& ref1 = dataForExactTime(lower);
-
-        assert (upper != -1);
-        assert (hasDataForExactTime(upper));
-        TargetReport& ref2 = dataForExactTime(upper);
+        bool ref2_has_ma = flags_[upper] & HAS_MA;
+        unsigned int ref2_ma = mode_as_[upper];
 
         if (!has_ma)
         {
-            if (!ref1.has_ma_ || !ref2.has_ma_) // both have no mode a
+            if (!ref1_has_ma || !ref2_has_ma) // both have no mode a
                 return CompareResult::SAME;
             else
                 return CompareResult::DIFFERENT; // no mode a here, but in other
         }
 
         // mode a exists
-        if (!ref1.has_ma_ && !ref2.has_ma_)
+        if (!ref1_has_ma && !ref2_has_ma)
             return CompareResult::DIFFERENT; // mode a here, but none in other
 
-        if ((ref1.has_ma_ && ref1.ma_ == ma)
-                || (ref2.has_ma_ && ref2.ma_ == ma)) // one of them is same
+        if ((ref1_has_ma && ref1_ma == ma)
+                || (ref2_has_ma && ref2_ma == ma)) // one of them is same
         {
             return CompareResult::SAME;
         }
@@ -666,70 +793,40 @@ namespace Association
             return CompareResult::DIFFERENT;
     }
 
-    std::tuple<vector<float>, vector<float>, vector<float>> Target::compareModeCCodes (
-            const Target& other, const std::vector<float>& timestamps,
-            float max_time_diff, float max_alt_diff, bool debug) const
-    {
-        vector<float> unknown;
-        vector<float> same;
-        vector<float> different;
-
-        CompareResult cmp_res;
-
-        TargetReport* tr;
-
-        for (auto tod : timestamps)
-        {
-            assert (hasDataForExactTime(tod));
-            tr = &dataForExactTime (tod);
-
-            cmp_res = other.compareModeCCode(tr->has_mc_, tr->mc_, tod, max_time_diff, max_alt_diff, debug);
-
-            if (debug)
-               loginf << "tod " << String::timeStringFromDouble(tod) << " result " << (unsigned int) cmp_res;
-
-            if (cmp_res == CompareResult::UNKNOWN)
-                unknown.push_back(tod);
-            else if (cmp_res == CompareResult::SAME)
-                same.push_back(tod);
-            else if (cmp_res == CompareResult::DIFFERENT)
-                different.push_back(tod);
-        }
-
-        assert (timestamps.size() == unknown.size()+same.size()+different.size());
-
-        return std::tuple<vector<float>, vector<float>, vector<float>>(unknown, same, different);
-    }
-
     CompareResult Target::compareModeCCode (bool has_mc, float mc, float tod,
                                             float max_time_diff, float max_alt_diff, bool debug) const
     {
-        if (!hasDataForTime(tod, max_time_diff))
+        if (!isTimeInside(tod))
             return CompareResult::UNKNOWN;
 
-        float lower, upper;
+        int lower, upper;
+
+        tie(lower, upper) = indexesFor(tod, max_time_diff);
 
-        tie(lower, upper) = timesFor(tod, max_time_diff);
+        return compareModeCCodeAt(has_mc, mc, lower, upper, max_alt_diff, debug);
+    }
 
-        if (lower == -1 && upper == -1)
+    CompareResult Target::compareModeCCodeAt (bool has_mc, float mc, int lower, int upper,
+                                              float max_alt_diff, bool debug) const
+    {
+        if (lower == -1) // none or only upper, no data for time
         {
             if (debug)
                 loginf << "Target: compareModeCCode: unknown, no times found";
             return CompareResult::UNKNOWN;
         }
 
-        if ((lower == -1 && upper != -1)
-                || (lower != -1 && upper == -1)) // only 1
+        bool ref1_has_mc = flags_[lower] & HAS_MC;
+        float ref1_mc = mcs_[lower];
+
+        if (upper == -1) // only 1
         {
             if (debug)
                 loginf << "Target: compareModeCCode: only 1";
 
-            TargetReport& ref1 = (lower != -1) ? dataForExactTime(lower)
-                                               : dataForExactTime(upper);
-
             if (!has_mc)
             {
-                if (!ref1.has_mc_ ) // both have no mode c
+                if (!ref1_has_mc ) // both have no mode c
                 {
                     if (debug)
                         loginf << "Target: compareModeCCode: same, both have no mode c";
@@ -744,14 +841,14 @@ namespace Association
             }
 
             // mode c exists
-            if (!ref1.has_mc_)
+            if (!ref1_has_mc)
             {
                 if (debug)
                     loginf << "Target: compareModeCCode: different, mode c but not in ref1";
                 return CompareResult::DIFFERENT;  // mode c here, but none in other
             }
 
-            if ((ref1.has_mc_ && fabs(ref1.mc_ - mc) < max_alt_diff)) // is same
+            if ((ref1_has_mc && fabs(ref1_mc - mc) < max_alt_diff)) // is same
             {
                 if (debug)
                     loginf << "Target: compareModeCCode: same, diff check passed";
@@ -770,17 +867,12 @@ namespace Association
         if (debug)
             loginf << "Target: compareModeCCode: both";
 
-        assert (lower != -1);
-        assert (hasDataForExactTime(lower));
-        TargetReport& ref1 = dataForExactTime(lower);
-
-        assert (upper != -1);
-        assert (hasDataForExactTime(upper));
-        TargetReport& ref2 = dataForExactTime(upper);
+        bool ref2_has_mc = flags_[upper] & HAS_MC;
+        float ref2_mc = mcs_[upper];
 
         if (!has_mc)
         {
-            if (!ref1.has_mc_ || !ref2.has_mc_) // both have no mode c
+            if (!ref1_has_mc || !ref2_has_mc) // both have no mode c
             {
                 if (debug)
                     loginf << "Target: compareModeCCode: same, both have no mode c";
@@ -795,15 +887,15 @@ namespace Association
         }
 
         // mode a exists
-        if (!ref1.has_mc_ && !ref2.has_mc_)
+        if (!ref1_has_mc && !ref2_has_mc)
         {
             if (debug)
                 loginf << "Target: compareModeCCode: different, mode c here, but none in refs";
             return CompareResult::DIFFERENT; // mode c here, but none in other
         }
 
-        if ((ref1.has_mc_ && fabs(ref1.mc_ - mc) < max_alt_diff)
-                || (ref2.has_mc_ && fabs(ref2.mc_ - mc) < max_alt_diff)) // one of them is same
+        if ((ref1_has_mc && fabs(ref1_mc - mc) < max_alt_diff)
+                || (ref2_has_mc && fabs(ref2_mc - mc) < max_alt_diff)) // one of them is same
         {
             if (debug)
                 loginf << "Target: compareModeCCode: same, diff check passed";
@@ -815,12 +907,12 @@ namespace Association
             {
                 loginf << "Target: compareModeCCode: different, diff check failed";
 //                loginf << "\t mc " << mc;
-//                loginf << "\t ref1.has_mc_ " << ref1.has_mc_;
-//                loginf << "\t ref1.mc_ " << ref1.mc_;
-//                loginf << "\t fabs(ref1.mc_ - mc) " << fabs(ref1.mc_ - mc);
-//                loginf << "\t ref2.has_mc_ " << ref2.has_mc_;
-//                loginf << "\t ref2.mc_ " << ref2.mc_;
-//                loginf << "\t fabs(ref2.mc_ - mc) " << fabs(ref2.mc_ - mc);
+//                loginf << "\t ref1_has_mc " << ref1_has_mc;
+//                loginf << "\t ref1_mc " << ref1_mc;
+//                loginf << "\t fabs(ref1_mc - mc) " << fabs(ref1_mc - mc);
+//                loginf << "\t ref2_has_mc " << ref2_has_mc;
+//                loginf << "\t ref2_mc " << ref2_mc;
+//                loginf << "\t fabs(ref2_mc - mc) " << fabs(ref2_mc - mc);
 //                loginf << "\t max_alt_diff " << max_alt_diff;
             }
             return CompareResult::DIFFERENT;
@@ -834,7 +926,6 @@ namespace Association
         float tod;
         double latitude {0};
         double longitude {0};
-        TargetReport* tr;
 
         float tod_prev;
         double latitude_prev {0};
@@ -856,19 +947,15 @@ namespace Association
         unsigned int num_spd {0};
 
         bool first = true;
-        for (auto& time_it : timed_indexes_)
+        for (unsigned int index=0; index < tods_.size(); ++index)
         {
             tod_prev = tod;
             latitude_prev = latitude;
             longitude_prev = longitude;
 
-            tod = time_it.first;
-
-            assert (time_it.second < assoc_trs_.size());
-            tr = assoc_trs_.at(time_it.second);
-
-            latitude = tr->latitude_;
-            longitude = tr->longitude_;
+            tod = tods_[index];
+            latitude = latitudes_[index];
+            longitude = longitudes_[index];
 
             if (first)
             {
@@ -949,14 +1036,25 @@ namespace Association
         mas_.clear();
         has_tod_ = false;
         has_speed_ = false;
-        timed_indexes_.clear();
         ds_ids_.clear();
         track_nums_.clear();
 
+        tods_.clear();
+        latitudes_.clear();
+        longitudes_.clear();
+        mcs_.clear();
+        mode_as_.clear();
+        flags_.clear();
+        tr_indexes_.clear();
+
+        vector<TargetReport*> mode_s_trs;
+
         for (auto tr_it : tmp_trs)
         {
             if (tr_it->has_ta_)
-                addAssociated(tr_it);
+                mode_s_trs.push_back(tr_it);
         }
+
+        addAssociated(mode_s_trs);
     }
 }
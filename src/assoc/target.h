@@ -2,12 +2,9 @@
 #define ASSOCIATIONTARGET_H
 
 #include "evaluationtargetposition.h"
-#include "projection/transformation.h"
 
 #include <vector>
 #include <string>
-#include <map>
-#include <set>
 
 namespace Association
 {
@@ -22,6 +19,20 @@ namespace Association
         DIFFERENT
     };
 
+    struct CompareCounts // comparison results of updates of a target against another target
+    {
+        unsigned int ma_unknown_ {0};
+        unsigned int ma_same_ {0};
+        unsigned int ma_different_ {0};
+
+        // only for updates with same mode a
+        unsigned int mc_unknown_ {0};
+        unsigned int mc_same_ {0};
+        unsigned int mc_different_ {0};
+
+        bool stopped_ {false}; // early exit, counts incomplete
+    };
+
     class Target
     {
     public:
@@ -34,24 +45,42 @@ namespace Association
         bool tmp_ {false};
 
         //bool has_ta_ {false};
-        std::set<unsigned int> tas_;
-        std::set<unsigned int> mas_;
+        std::vector<unsigned int> tas_; // sorted, unique
+        std::vector<unsigned int> mas_; // sorted, unique
 
         bool has_tod_ {false};
         float tod_min_ {0};
         float tod_max_ {0};
 
+        // bounding box of associated positions, set if has_tod_
+        double latitude_min_ {0};
+        double latitude_max_ {0};
+        double longitude_min_ {0};
+        double longitude_max_ {0};
+
         bool has_speed_ {false};
         double speed_min_ {0};
         double speed_avg_ {0};
         double speed_max_ {0};
 
-        vector<TargetReport*> assoc_trs_;
-        std::map<float, unsigned int> timed_indexes_;
-        std::set <unsigned int> ds_ids_;
-        std::set <std::pair<unsigned int, unsigned int>> track_nums_; // ds_it, tn
-
-        mutable Transformation trafo_;
+        vector<TargetReport*> assoc_trs_; // in order of association
+        std::vector<unsigned int> ds_ids_; // sorted, unique
+        std::vector<std::pair<unsigned int, unsigned int>> track_nums_; // ds_it, tn, sorted, unique
+
+        // flat data of associated target reports sorted by time, one entry per time (last associated is used)
+        enum DataFlags : unsigned char
+        {
+            HAS_MA = 1,
+            HAS_MC = 2
+        };
+
+        std::vector<float> tods_;
+        std::vector<double> latitudes_;
+        std::vector<double> longitudes_;
+        std::vector<float> mcs_;
+        std::vector<unsigned int> mode_as_;
+        std::vector<unsigned char> flags_;
+        std::vector<unsigned int> tr_indexes_; // index into assoc_trs_
 
         void addAssociated (TargetReport* tr);
         void addAssociated (vector<TargetReport*> trs);
@@ -60,8 +89,8 @@ namespace Association
 
         bool hasTA () const;
         bool hasTA (unsigned int ta)  const;
-        bool hasAllOfTAs (std::set<unsigned int> tas) const;
-        bool hasAnyOfTAs (std::set<unsigned int> tas) const;
+        bool hasAllOfTAs (const std::vector<unsigned int>& tas) const; // tas sorted
+        bool hasAnyOfTAs (const std::vector<unsigned int>& tas) const; // tas sorted
 
         bool hasMA () const;
         bool hasMA (unsigned int ma)  const;
@@ -83,20 +112,33 @@ namespace Association
         bool timeOverlaps (const Target& other) const;
         float probTimeOverlaps (const Target& other) const; // ratio of overlap, measured by shortest target
 
-        std::tuple<std::vector<float>, std::vector<float>, std::vector<float>> compareModeACodes (
-                const Target& other, float max_time_diff) const;
-        // unknown, same, different
-        CompareResult compareModeACode (bool has_ma, unsigned int ma, float tod, float max_time_diff) const;
+        // single walk over updates of both targets, mode a checked for all updates, mode c only if mode a same.
+        // with early exit, stops as soon as same > different && same >= min_same fails for mode a or c
+        CompareCounts compareModeACCodeCounts (const Target& other, float max_time_diff, float max_alt_diff,
+                                               unsigned int min_same, bool early_exit) const;
 
-        std::tuple<std::vector<float>, std::vector<float>, std::vector<float>> compareModeCCodes (
-                const Target& other, const std::vector<float>& timestamps,
-                float max_time_diff, float max_alt_diff, bool debug) const;
+        CompareResult compareModeACode (bool has_ma, unsigned int ma, float tod, float max_time_diff) const;
         CompareResult compareModeCCode (bool has_mc, float mc, float tod,
                                         float max_time_diff, float max_alt_diff, bool debug) const;
-        // unknown, same, different timestamps from this
+
+        EvaluationTargetPosition posForIndex (unsigned int index) const; // index in flat data
 
         void calculateSpeeds();
         void removeNonModeSTRs();
+
+    protected:
+        void addAssociatedInfo (TargetReport* tr); // everything except flat data
+        void addFlatData (unsigned int tr_index);
+        void rebuildFlatData ();
+
+        int exactIndexFor (float tod) const; // -1 if not existing
+        std::pair<int, int> indexesFor (float tod, float d_max) const; // as timesFor, but flat data indexes
+        // as above, with given index of first time not before tod
+        std::pair<int, int> indexesFor (float tod, float d_max, unsigned int lb_index) const;
+
+        CompareResult compareModeACodeAt (bool has_ma, unsigned int ma, int lower, int upper) const;
+        CompareResult compareModeCCodeAt (bool has_mc, float mc, int lower, int upper,
+                                          float max_alt_diff, bool debug) const;
     };
 
 }
@@ -0,0 +1,125 @@
+#include "assoc/targetpositionindex.h"
+#include "assoc/target.h"
+#include "logger.h"
+
+#include <cassert>
+#include <cmath>
+#include <algorithm>
+
+using namespace std;
+
+namespace Association
+{
+    const std::vector<unsigned int> TargetPositionIndex::empty_;
+
+    // shortest length of a degree of latitude, conservative for conversion of distances
+    static const double min_meters_per_deg = 110500.0;
+
+    TargetPositionIndex::TargetPositionIndex(const std::vector<Target*>& targets, float max_time_diff,
+                                             double max_distance)
+        : max_time_diff_(max_time_diff), max_distance_(max_distance)
+    {
+        assert (max_time_diff_ >= 0);
+        assert (max_distance_ >= 0);
+
+        time_bin_size_ = max(2.0 * max_time_diff_, 1.0);
+        cell_size_ = max(2.0 * max_distance_ / min_meters_per_deg, 0.01);
+
+        for (unsigned int target_cnt=0; target_cnt < targets.size(); ++target_cnt)
+        {
+            const Target& target = *targets.at(target_cnt);
+
+            const vector<float>& tods = target.tods_;
+            const vector<double>& lats = target.latitudes_;
+            const vector<double>& longs = target.longitudes_;
+
+            if (!tods.size())
+                continue;
+
+            if (tods.size() == 1)
+            {
+                add(target_cnt, tods[0], tods[0], lats[0], longs[0], lats[0], longs[0]);
+                continue;
+            }
+
+            for (unsigned int cnt=1; cnt < tods.size(); ++cnt)
+            {
+                // interpolation only possible if both reports are within max time difference
+                if (tods[cnt] - tods[cnt-1] <= 2 * max_time_diff_)
+                    add(target_cnt, tods[cnt-1], tods[cnt], lats[cnt-1], longs[cnt-1], lats[cnt], longs[cnt]);
+                else // exact time matches still possible
+                {
+                    add(target_cnt, tods[cnt-1], tods[cnt-1], lats[cnt-1], longs[cnt-1], lats[cnt-1], longs[cnt-1]);
+                    add(target_cnt, tods[cnt], tods[cnt], lats[cnt], longs[cnt], lats[cnt], longs[cnt]);
+                }
+            }
+        }
+
+        logdbg << "TargetPositionIndex: constructor: " << targets.size() << " targets in " << cells_.size()
+               << " cells";
+    }
+
+    const std::vector<unsigned int>& TargetPositionIndex::candidates (
+            float tod, double latitude, double longitude) const
+    {
+        auto it = cells_.find(key(timeBin(tod), cell(latitude), cell(longitude)));
+
+        if (it == cells_.end())
+            return empty_;
+
+        return it->second;
+    }
+
+    int TargetPositionIndex::timeBin (double tod) const
+    {
+        return (int) floor(tod / time_bin_size_);
+    }
+
+    int TargetPositionIndex::cell (double deg) const
+    {
+        return (int) floor(deg / cell_size_);
+    }
+
+    uint64_t TargetPositionIndex::key (int time_bin, int lat_cell, int lon_cell) const
+    {
+        // 24 bits each for time bin and latitude, 16 bits for longitude, all offset to be positive
+        return ((uint64_t) (time_bin + (1 << 23)) << 40)
+                | ((uint64_t) ((lat_cell + (1 << 23)) & 0xFFFFFF) << 16)
+                | (uint64_t) ((lon_cell + (1 << 15)) & 0xFFFF);
+    }
+
+    void TargetPositionIndex::add (unsigned int target_index, float tod1, float tod2, double lat1, double lon1,
+                                   double lat2, double lon2)
+    {
+        double lat_margin = max_distance_ / min_meters_per_deg;
+
+        double lat_min = min(lat1, lat2) - lat_margin;
+        double lat_max = max(lat1, lat2) + lat_margin;
+
+        // longitude degrees shrink towards the poles, use largest latitude for margin
+        double cos_lat = cos(min(max(fabs(lat_min), fabs(lat_max)), 89.0) * M_PI / 180.0);
+        double lon_margin = lat_margin / cos_lat;
+
+        double lon_min = min(lon1, lon2) - lon_margin;
+        double lon_max = max(lon1, lon2) + lon_margin;
+
+        int time_bin_max = timeBin(tod2);
+        int lat_cell_max = cell(lat_max);
+        int lon_cell_max = cell(lon_max);
+
+        for (int time_bin = timeBin(tod1); time_bin <= time_bin_max; ++time_bin)
+        {
+            for (int lat_cell = cell(lat_min); lat_cell <= lat_cell_max; ++lat_cell)
+            {
+                for (int lon_cell = cell(lon_min); lon_cell <= lon_cell_max; ++lon_cell)
+                {
+                    std::vector<unsigned int>& indexes = cells_[key(time_bin, lat_cell, lon_cell)];
+
+                    // targets are added in order, so duplicates can only be the last entry
+                    if (!indexes.size() || indexes.back() != target_index)
+                        indexes.push_back(target_index);
+                }
+            }
+        }
+    }
+}
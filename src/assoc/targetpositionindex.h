@@ -0,0 +1,49 @@
+#ifndef ASSOCIATIONTARGETPOSITIONINDEX_H
+#define ASSOCIATIONTARGETPOSITIONINDEX_H
+
+#include <vector>
+#include <unordered_map>
+#include <cstdint>
+
+namespace Association
+{
+    class Target;
+
+    /// @brief Candidate lookup of targets by time and position
+    ///
+    /// Every segment between two consecutive associated target reports of a target is entered into all
+    /// time bins it spans and all lat/lon grid cells covered by its bounding box, enlarged by the maximum
+    /// acceptable distance. A target which can provide an interpolated position within the maximum
+    /// time difference and the maximum distance of a report is therefore always found in the single
+    /// bin/cell of the report. Targets must not be changed while the index is in use.
+    class TargetPositionIndex
+    {
+    public:
+        /// @brief Builds the index, candidates are returned as indexes into targets
+        TargetPositionIndex(const std::vector<Target*>& targets, float max_time_diff, double max_distance);
+
+        /// @brief Returns sorted, unique target indexes possibly within reach of the given time and position
+        const std::vector<unsigned int>& candidates (float tod, double latitude, double longitude) const;
+
+    protected:
+        float max_time_diff_ {0};
+        double max_distance_ {0};
+
+        double time_bin_size_ {0}; // s
+        double cell_size_ {0}; // deg
+
+        std::unordered_map<uint64_t, std::vector<unsigned int>> cells_; // key -> target indexes
+
+        static const std::vector<unsigned int> empty_;
+
+        int timeBin (double tod) const;
+        int cell (double deg) const;
+        uint64_t key (int time_bin, int lat_cell, int lon_cell) const;
+
+        void add (unsigned int target_index, float tod1, float tod2, double lat1, double lon1,
+                  double lat2, double lon2);
+    };
+
+}
+
+#endif // ASSOCIATIONTARGETPOSITIONINDEX_H
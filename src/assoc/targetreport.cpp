@@ -34,15 +34,12 @@ std::string TargetReport::asStr()
 {
     stringstream ss;
 
-    ss << "dbo " << dbo_name_ << " ds_id " << ds_id_ << " rec_num " << rec_num_
+    ss << "dbo " << (dbo_name_ ? *dbo_name_ : "") << " ds_id " << ds_id_ << " rec_num " << rec_num_
        << " tod " << String::timeStringFromDouble(tod_);
 
     if (has_ta_)
         ss << " ta " << String::hexStringFromInt(ta_, 6, '0');
 
-    if (has_ti_)
-        ss << " ti '" << ti_ << "'";
-
     if (has_tn_)
         ss << " tn " << tn_;
 
@@ -15,7 +15,7 @@ namespace Association
     public:
         TargetReport();
 
-        string dbo_name_;
+        const string* dbo_name_{nullptr}; // shared, not copied per target report
         unsigned int ds_id_{0};
         unsigned int rec_num_{0};
         float tod_{0};
@@ -24,9 +24,6 @@ namespace Association
         bool has_ta_{false};
         unsigned int ta_{0};
 
-        bool has_ti_{false};
-        string ti_;
-
         // track num
         bool has_tn_{false};
         unsigned int tn_{0};
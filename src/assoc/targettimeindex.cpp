@@ -0,0 +1,104 @@
+#include "assoc/targettimeindex.h"
+#include "assoc/target.h"
+#include "logger.h"
+
+#include <cassert>
+#include <cmath>
+#include <algorithm>
+
+using namespace std;
+
+namespace Association
+{
+    // shortest length of a degree of latitude, conservative for conversion of distances
+    static const double min_meters_per_deg = 110500.0;
+
+    TargetTimeIndex::TargetTimeIndex(float bucket_size)
+        : bucket_size_(bucket_size)
+    {
+        assert (bucket_size_ > 0);
+    }
+
+    void TargetTimeIndex::update (const Target& target)
+    {
+        if (!target.has_tod_)
+            return;
+
+        int first = bucket(target.tod_min_);
+        int last = bucket(target.tod_max_);
+
+        auto range_it = bucket_ranges_.find(&target);
+
+        if (range_it == bucket_ranges_.end())
+        {
+            for (int cnt = first; cnt <= last; ++cnt)
+                buckets_[cnt].push_back(&target);
+
+            bucket_ranges_[&target] = {first, last};
+            return;
+        }
+
+        // time span can only grow
+        int& old_first = range_it->second.first;
+        int& old_last = range_it->second.second;
+
+        assert (first <= old_first && last >= old_last);
+
+        for (int cnt = first; cnt < old_first; ++cnt)
+            buckets_[cnt].push_back(&target);
+
+        for (int cnt = old_last+1; cnt <= last; ++cnt)
+            buckets_[cnt].push_back(&target);
+
+        old_first = first;
+        old_last = last;
+    }
+
+    std::vector<const Target*> TargetTimeIndex::candidates (const Target& target, double max_distance) const
+    {
+        std::vector<const Target*> candidates;
+
+        if (!target.has_tod_)
+            return candidates;
+
+        double lat_margin = max_distance / min_meters_per_deg;
+
+        double lat_min = target.latitude_min_ - lat_margin;
+        double lat_max = target.latitude_max_ + lat_margin;
+
+        // longitude degrees shrink towards the poles, use largest latitude for margin
+        double cos_lat = cos(min(max(fabs(lat_min), fabs(lat_max)), 89.0) * M_PI / 180.0);
+        double lon_margin = lat_margin / cos_lat;
+
+        double lon_min = target.longitude_min_ - lon_margin;
+        double lon_max = target.longitude_max_ + lon_margin;
+
+        auto end_it = buckets_.upper_bound(bucket(target.tod_max_));
+
+        for (auto it = buckets_.lower_bound(bucket(target.tod_min_)); it != end_it; ++it)
+        {
+            for (const Target* other : it->second)
+            {
+                if (other == &target)
+                    continue;
+
+                if (other->latitude_max_ < lat_min || other->latitude_min_ > lat_max
+                        || other->longitude_max_ < lon_min || other->longitude_min_ > lon_max)
+                    continue;
+
+                candidates.push_back(other);
+            }
+        }
+
+        sort(candidates.begin(), candidates.end(), [](const Target* a, const Target* b) {
+            return a->utn_ < b->utn_; });
+        candidates.erase(unique(candidates.begin(), candidates.end()), candidates.end());
+
+        return candidates;
+    }
+
+    int TargetTimeIndex::bucket (float tod) const
+    {
+        return (int) floor(tod / bucket_size_);
+    }
+}
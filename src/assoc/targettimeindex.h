@@ -0,0 +1,39 @@
+#ifndef ASSOCIATIONTARGETTIMEINDEX_H
+#define ASSOCIATIONTARGETTIMEINDEX_H
+
+#include <vector>
+#include <map>
+
+namespace Association
+{
+    class Target;
+
+    /// @brief Candidate lookup of targets by time span and bounding box
+    ///
+    /// Targets are entered into all time buckets covered by their time span. Targets may grow after being
+    /// added, in which case update() enters them into the additional buckets. Targets must not be moved or
+    /// deleted while the index is in use.
+    class TargetTimeIndex
+    {
+    public:
+        TargetTimeIndex(float bucket_size);
+
+        /// @brief Adds target or updates buckets for grown time span
+        void update (const Target& target);
+
+        /// @brief Returns targets with time span overlapping the given target's one, and bounding box closer
+        /// than max_distance (in meters, approximated conservatively). Sorted by utn, without given target.
+        std::vector<const Target*> candidates (const Target& target, double max_distance) const;
+
+    protected:
+        float bucket_size_ {0}; // s
+
+        std::map<int, std::vector<const Target*>> buckets_; // time bucket -> targets
+        std::map<const Target*, std::pair<int, int>> bucket_ranges_; // target -> first, last bucket entered
+
+        int bucket (float tod) const;
+    };
+
+}
+
+#endif // ASSOCIATIONTARGETTIMEINDEX_H
@@ -31,6 +31,7 @@
 using namespace nlohmann;
 
 unsigned int Buffer::ids_ = 0;
+std::atomic<unsigned long> Buffer::access_ticks_{0};
 
 /**
  * Creates an empty buffer withput an DBO type
@@ -711,3 +712,96 @@ nlohmann::json Buffer::asJSON()
 
     return j;
 }
+
+size_t Buffer::memorySize()
+{
+    size_t size = 0;
+
+    for (auto& it : columnMemorySizes())
+        size += std::get<0>(it.second);
+
+    return size;
+}
+
+size_t Buffer::spilledSize()
+{
+    size_t size = 0;  // without columnMemorySizes, which iterates all strings
+
+    addColumnSpilledSizes<bool>(size);
+    addColumnSpilledSizes<char>(size);
+    addColumnSpilledSizes<unsigned char>(size);
+    addColumnSpilledSizes<int>(size);
+    addColumnSpilledSizes<unsigned int>(size);
+    addColumnSpilledSizes<long int>(size);
+    addColumnSpilledSizes<unsigned long int>(size);
+    addColumnSpilledSizes<float>(size);
+    addColumnSpilledSizes<double>(size);
+    addColumnSpilledSizes<std::string>(size);
+
+    return size;
+}
+
+std::map<std::string, std::tuple<size_t, size_t, unsigned long>> Buffer::columnMemorySizes()
+{
+    std::map<std::string, std::tuple<size_t, size_t, unsigned long>> sizes;
+
+    addColumnMemorySizes<bool>(sizes);
+    addColumnMemorySizes<char>(sizes);
+    addColumnMemorySizes<unsigned char>(sizes);
+    addColumnMemorySizes<int>(sizes);
+    addColumnMemorySizes<unsigned int>(sizes);
+    addColumnMemorySizes<long int>(sizes);
+    addColumnMemorySizes<unsigned long int>(sizes);
+    addColumnMemorySizes<float>(sizes);
+    addColumnMemorySizes<double>(sizes);
+    addColumnMemorySizes<std::string>(sizes);
+
+    return sizes;
+}
+
+void Buffer::spill(const std::string& id, const std::string& directory)
+{
+    logdbg << "Buffer: spill: dbo " << dbo_name_ << " id " << id;
+
+    assert(!pinned());
+    assert(properties_.hasProperty(id));
+
+    switch (properties_.get(id).dataType())
+    {
+        case PropertyDataType::BOOL:
+            getArrayListMap<bool>().at(id)->spill(directory);
+            break;
+        case PropertyDataType::CHAR:
+            getArrayListMap<char>().at(id)->spill(directory);
+            break;
+        case PropertyDataType::UCHAR:
+            getArrayListMap<unsigned char>().at(id)->spill(directory);
+            break;
+        case PropertyDataType::INT:
+            getArrayListMap<int>().at(id)->spill(directory);
+            break;
+        case PropertyDataType::UINT:
+            getArrayListMap<unsigned int>().at(id)->spill(directory);
+            break;
+        case PropertyDataType::LONGINT:
+            getArrayListMap<long int>().at(id)->spill(directory);
+            break;
+        case PropertyDataType::ULONGINT:
+            getArrayListMap<unsigned long int>().at(id)->spill(directory);
+            break;
+        case PropertyDataType::FLOAT:
+            getArrayListMap<float>().at(id)->spill(directory);
+            break;
+        case PropertyDataType::DOUBLE:
+            getArrayListMap<double>().at(id)->spill(directory);
+            break;
+        case PropertyDataType::STRING:
+            getArrayListMap<std::string>().at(id)->spill(directory);
+            break;
+        default:
+            logerr << "Buffer: spill: unknown property type "
+                   << Property::asString(properties_.get(id).dataType());
+            throw std::runtime_error("Buffer: spill: unknown property type " +
+                                     Property::asString(properties_.get(id).dataType()));
+    }
+}
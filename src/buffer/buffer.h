@@ -21,6 +21,7 @@
 #include "propertylist.h"
 #include "logger.h"
 
+#include <atomic>
 #include <memory>
 #include <tuple>
 #include <unordered_map>
@@ -129,6 +130,20 @@ class Buffer
 
     nlohmann::json asJSON();
 
+    /// @brief Returns number of bytes held in memory by all columns
+    size_t memorySize();
+    /// @brief Returns number of bytes swapped out to spill files by all columns
+    size_t spilledSize();
+    /// @brief Returns (memory size, spilled size, last access tick) per property name
+    std::map<std::string, std::tuple<size_t, size_t, unsigned long>> columnMemorySizes();
+    /// @brief Swaps out column to a temporary file in directory, paged back in on next access
+    void spill(const std::string& id, const std::string& directory);
+
+    /// @brief Marks buffer as used by a job or background computation, pinned buffers are not spilled
+    void pin() { ++pin_count_; }
+    void unpin() { assert(pin_count_); --pin_count_; }
+    bool pinned() const { return pin_count_ > 0; }
+
   protected:
     /// Unique buffer id, copied when getting shallow copies
     unsigned int id_;
@@ -142,8 +157,12 @@ class Buffer
 
     /// Flag indicating if buffer is the last of a DB operation
     bool last_one_;
+    /// Number of users holding references to columns outside of the main thread
+    std::atomic<unsigned int> pin_count_{0};
 
     static unsigned int ids_;
+    /// Counter for column accesses, used to find least recently used columns
+    static std::atomic<unsigned long> access_ticks_;
 
   private:
     template <typename T>
@@ -152,6 +171,11 @@ class Buffer
     void renameArrayListMapEntry(const std::string& id, const std::string& id_new);
     template <typename T>
     void seizeArrayListMap(Buffer& org_buffer);
+    template <typename T>
+    void addColumnMemorySizes(
+        std::map<std::string, std::tuple<size_t, size_t, unsigned long>>& sizes);
+    template <typename T>
+    void addColumnSpilledSizes(size_t& size);
 };
 
 #include "nullablevector.h"
@@ -172,9 +196,14 @@ NullableVector<T>& Buffer::get(const std::string& id)
     assert ((std::get<Index<std::map<std::string, std::shared_ptr<NullableVector<T>>>,
              ArrayListMapTupel>::value>(array_list_tuple_)).count(id));
 
-    return *(std::get<Index<std::map<std::string, std::shared_ptr<NullableVector<T>>>,
-                            ArrayListMapTupel>::value>(array_list_tuple_))
-                .at(id);
+    NullableVector<T>& array_list =
+        *(std::get<Index<std::map<std::string, std::shared_ptr<NullableVector<T>>>,
+                         ArrayListMapTupel>::value>(array_list_tuple_))
+             .at(id);
+
+    array_list.last_access_.store(++access_ticks_, std::memory_order_relaxed);
+
+    return array_list;
 }
 
 template <typename T>
@@ -218,4 +247,20 @@ void Buffer::seizeArrayListMap(Buffer& org_buffer)
     org_buffer.getArrayListMap<T>().clear();
 }
 
+template <typename T>
+void Buffer::addColumnMemorySizes(
+    std::map<std::string, std::tuple<size_t, size_t, unsigned long>>& sizes)
+{
+    for (auto& it : getArrayListMap<T>())
+        sizes[it.first] = std::make_tuple(it.second->memorySize(), it.second->spilledSize(),
+                                          it.second->lastAccess());
+}
+
+template <typename T>
+void Buffer::addColumnSpilledSizes(size_t& size)
+{
+    for (auto& it : getArrayListMap<T>())
+        size += it.second->spilledSize();
+}
+
 #endif /* BUFFER_H_ */
@@ -99,3 +99,93 @@ void NullableVector<std::string>::append(unsigned int index, std::string value)
 
     // logdbg << "ArrayListTemplate: append: size " << size_ << " max_size " << max_size_;
 }
+
+template <>
+size_t NullableVector<bool>::memorySize()
+{
+    if (spilled_)
+        return 0;
+
+    return data_.capacity() / 8 + null_flags_.capacity() / 8;
+}
+
+template <>
+size_t NullableVector<bool>::dataSpillSize()
+{
+    return data_.size();
+}
+
+template <>
+void NullableVector<bool>::writeSpillData(char* ptr)
+{
+    for (size_t cnt = 0; cnt < data_.size(); ++cnt)
+        ptr[cnt] = data_[cnt];
+}
+
+template <>
+void NullableVector<bool>::readSpillData(const char* ptr)
+{
+    data_.resize(spilled_data_size_);
+
+    for (size_t cnt = 0; cnt < spilled_data_size_; ++cnt)
+        data_[cnt] = ptr[cnt];
+}
+
+template <>
+size_t NullableVector<std::string>::memorySize()
+{
+    if (spilled_)
+        return 0;
+
+    size_t size = data_.capacity() * sizeof(std::string) + null_flags_.capacity() / 8;
+
+    for (auto& value : data_)
+        if (value.capacity() >= sizeof(std::string))  // not in small string buffer
+            size += value.capacity() + 1;
+
+    return size;
+}
+
+template <>
+size_t NullableVector<std::string>::dataSpillSize()
+{
+    size_t size = 0;
+
+    for (auto& value : data_)  // length prefix and content
+        size += sizeof(size_t) + value.size();
+
+    return size;
+}
+
+template <>
+void NullableVector<std::string>::writeSpillData(char* ptr)
+{
+    size_t length;
+
+    for (auto& value : data_)
+    {
+        length = value.size();
+        memcpy(ptr, &length, sizeof(size_t));
+        ptr += sizeof(size_t);
+
+        memcpy(ptr, value.data(), length);
+        ptr += length;
+    }
+}
+
+template <>
+void NullableVector<std::string>::readSpillData(const char* ptr)
+{
+    data_.resize(spilled_data_size_);
+
+    size_t length;
+
+    for (auto& value : data_)
+    {
+        memcpy(&length, ptr, sizeof(size_t));
+        ptr += sizeof(size_t);
+
+        value.assign(ptr, length);
+        ptr += length;
+    }
+}
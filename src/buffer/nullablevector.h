@@ -22,16 +22,20 @@
 
 #include <QDateTime>
 #include <array>
+#include <atomic>
 #include <bitset>
+#include <cstring>
 #include <iomanip>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <set>
 #include <sstream>
 #include <vector>
 
 #include "buffer.h"
 #include "property.h"
+#include "spillfile.h"
 #include "stringconv.h"
 
 //#include "boost/lexical_cast.hpp"
@@ -106,6 +110,20 @@ class NullableVector
         return property_.name() + "(" + property_.dataTypeString() + ")";
     }
 
+    /// @brief Returns number of bytes held in memory
+    size_t memorySize();
+    /// @brief Returns number of bytes swapped out to the spill file
+    size_t spilledSize() const { return spill_file_ ? spill_file_->size() : 0; }
+    /// @brief Returns if contents are swapped out
+    bool spilled() const { return spilled_; }
+    /// @brief Swaps contents out to a temporary file in directory. Not thread-safe w.r.t. access,
+    /// only to be called for buffers which are not pinned.
+    void spill(const std::string& directory);
+    /// @brief Reads swapped out contents back into memory
+    void restore();
+    /// @brief Returns access tick of last Buffer::get, used to find cold columns
+    unsigned long lastAccess() const { return last_access_; }
+
   private:
     Property property_;
     Buffer& buffer_;
@@ -114,6 +132,24 @@ class NullableVector
     // Null flags container
     std::vector<bool> null_flags_;
 
+    /// Flag indicating if data_ and null_flags_ are stored in spill_file_
+    std::atomic<bool> spilled_{false};
+    std::mutex spill_mutex_;
+    std::unique_ptr<SpillFile> spill_file_;
+    size_t spilled_data_size_{0};
+    size_t spilled_null_size_{0};
+    std::atomic<unsigned long> last_access_{0};
+
+    /// @brief Pages spilled data back in, to be called before any access to data_ or null_flags_
+    void restoreIfSpilled()
+    {
+        if (spilled_)
+            restore();
+    }
+    size_t dataSpillSize();
+    void writeSpillData(char* ptr);
+    void readSpillData(const char* ptr);
+
     /// @brief Sets specific element to not Null value
     void unsetNull(unsigned int index);
 
@@ -137,6 +173,9 @@ template <class T>
 void NullableVector<T>::clear()
 {
     logdbg << "NullableVector " << property_.name() << ": clear";
+
+    restoreIfSpilled();
+
     std::fill(data_.begin(), data_.end(), T());
     std::fill(null_flags_.begin(), null_flags_.end(), true);
 }
@@ -145,6 +184,9 @@ template <class T>
 const T NullableVector<T>::get(unsigned int index)
 {
     logdbg << "NullableVector " << property_.name() << ": get: index " << index;
+
+    restoreIfSpilled();
+
     if (BUFFER_PEDANTIC_CHECKING)
     {
         assert(data_.size() <= buffer_.data_size_);
@@ -181,6 +223,8 @@ void NullableVector<T>::set(unsigned int index, T value)
     logdbg << "NullableVector " << property_.name() << ": set: index " << index << " value '"
            << value << "'";
 
+    restoreIfSpilled();
+
     if (BUFFER_PEDANTIC_CHECKING)
     {
         assert(data_.size() <= buffer_.data_size_);
@@ -261,6 +305,8 @@ void NullableVector<T>::setFromFormat(unsigned int index, const std::string& for
 template <class T>
 void NullableVector<T>::setAll(T value)
 {
+    restoreIfSpilled();
+
     unsigned int data_size = data_.size();
 
     for (unsigned int cnt=0; cnt < data_size; ++cnt)
@@ -276,6 +322,8 @@ void NullableVector<T>::append(unsigned int index, T value)
     logdbg << "NullableVector " << property_.name() << ": append: index " << index << " value '"
            << value << "'";
 
+    restoreIfSpilled();
+
     if (BUFFER_PEDANTIC_CHECKING)
     {
         assert(data_.size() <= buffer_.data_size_);
@@ -340,6 +388,8 @@ void NullableVector<T>::setNull(unsigned int index)
 {
     logdbg << "NullableVector " << property_.name() << ": setNull: index " << index;
 
+    restoreIfSpilled();
+
     if (BUFFER_PEDANTIC_CHECKING)
     {
         assert(data_.size() <= buffer_.data_size_);
@@ -358,6 +408,8 @@ void NullableVector<T>::setNull(unsigned int index)
 template <class T>
 void NullableVector<T>::setAllNull()
 {
+    restoreIfSpilled();
+
     unsigned int data_size = data_.size();
 
     for (unsigned int cnt=0; cnt < data_size; ++cnt)
@@ -371,6 +423,8 @@ bool NullableVector<T>::isNull(unsigned int index)
 {
     logdbg << "NullableVector " << property_.name() << ": isNull: index " << index;
 
+    restoreIfSpilled();
+
     if (BUFFER_PEDANTIC_CHECKING)
     {
         assert(data_.size() <= buffer_.data_size_);
@@ -395,6 +449,8 @@ void NullableVector<T>::resizeDataTo(unsigned int size)
 {
     logdbg << "NullableVector " << property_.name() << ": resizeDataTo: size " << size;
 
+    restoreIfSpilled();
+
     if (BUFFER_PEDANTIC_CHECKING)
     {
         assert(data_.size() <= buffer_.data_size_);
@@ -412,6 +468,8 @@ void NullableVector<T>::resizeNullTo(unsigned int size)
 {
     logdbg << "NullableVector " << property_.name() << ": resizeNullTo: size " << size;
 
+    restoreIfSpilled();
+
     if (BUFFER_PEDANTIC_CHECKING)
         assert(null_flags_.size() <= buffer_.data_size_);
 
@@ -433,6 +491,9 @@ void NullableVector<T>::addData(NullableVector<T>& other)
 {
     logdbg << "NullableVector " << property_.name() << ": addData";
 
+    restoreIfSpilled();
+    other.restoreIfSpilled();
+
     if (BUFFER_PEDANTIC_CHECKING)
     {
         assert(data_.size() <= buffer_.data_size_);
@@ -499,6 +560,9 @@ void NullableVector<T>::copyData(NullableVector<T>& other)
 {
     logdbg << "NullableVector " << property_.name() << ": copyData";
 
+    restoreIfSpilled();
+    other.restoreIfSpilled();
+
     data_ = other.data_;
     null_flags_ = other.null_flags_;
 
@@ -518,6 +582,8 @@ NullableVector<T>& NullableVector<T>::operator*=(double factor)
 {
     logdbg << "NullableVector " << property_.name() << ": operator*=";
 
+    restoreIfSpilled();
+
     unsigned int data_size = data_.size();
 
     tbb::parallel_for(uint(0), data_size, [&](unsigned int cnt) {
@@ -538,6 +604,8 @@ std::set<T> NullableVector<T>::distinctValues(unsigned int index)
 {
     logdbg << "NullableVector " << property_.name() << ": distinctValues";
 
+    restoreIfSpilled();
+
     std::set<T> values;
 
     T value;
@@ -558,6 +626,8 @@ std::set<T> NullableVector<T>::distinctValues(unsigned int index)
 template <class T>
 std::tuple<bool,T,T> NullableVector<T>::minMaxValues(unsigned int index)
 {
+    restoreIfSpilled();
+
     bool set = false;
     T min, max;
 
@@ -588,6 +658,8 @@ std::map<T, std::vector<unsigned int>> NullableVector<T>::distinctValuesWithInde
 {
     logdbg << "NullableVector " << property_.name() << ": distinctValuesWithIndexes";
 
+    restoreIfSpilled();
+
     std::map<T, std::vector<unsigned int>> values;
 
     assert(from_index <= to_index);
@@ -626,6 +698,8 @@ std::map<T, std::vector<unsigned int>> NullableVector<T>::distinctValuesWithInde
 {
     logdbg << "NullableVector " << property_.name() << ": distinctValuesWithIndexes";
 
+    restoreIfSpilled();
+
     std::map<T, std::vector<unsigned int>> values;
 
     if (BUFFER_PEDANTIC_CHECKING)
@@ -656,6 +730,8 @@ std::vector<unsigned int> NullableVector<T>::nullValueIndexes(unsigned int from_
 {
     logdbg << "NullableVector " << property_.name() << ": nullValueIndexes";
 
+    restoreIfSpilled();
+
     std::vector<unsigned int> indexes;
 
     assert(from_index <= to_index);
@@ -694,6 +770,8 @@ std::vector<unsigned int> NullableVector<T>::nullValueIndexes(
 {
     logdbg << "NullableVector " << property_.name() << ": nullValueIndexes";
 
+    restoreIfSpilled();
+
     std::vector<unsigned int> ret_indexes;
 
     for (auto index : indexes)
@@ -717,6 +795,8 @@ void NullableVector<T>::convertToStandardFormat(const std::string& from_format)
 {
     logdbg << "NullableVector " << property_.name() << ": convertToStandardFormat";
 
+    restoreIfSpilled();
+
     static_assert(std::is_integral<T>::value, "only defined for integer types");
 
     // std::string value_str;
@@ -761,6 +841,8 @@ void NullableVector<T>::convertToStandardFormat(const std::string& from_format)
 template <class T>
 unsigned int NullableVector<T>::size()
 {
+    restoreIfSpilled();
+
     return data_.size();
 }
 
@@ -769,6 +851,8 @@ void NullableVector<T>::cutToSize(unsigned int size)
 {
     logdbg << "NullableVector " << property_.name() << ": cutToSize: size " << size;
 
+    restoreIfSpilled();
+
     if (BUFFER_PEDANTIC_CHECKING)
     {
         assert(data_.size() <= buffer_.data_size_);
@@ -789,6 +873,8 @@ void NullableVector<T>::checkNotNull()
 {
     logdbg << "NullableVector " << property_.name() << ": checkNotNull";
 
+    restoreIfSpilled();
+
     for (unsigned int cnt = 0; cnt < null_flags_.size(); cnt++)
     {
         if (null_flags_.at(cnt))
@@ -799,6 +885,86 @@ void NullableVector<T>::checkNotNull()
     }
 }
 
+template <class T>
+size_t NullableVector<T>::memorySize()
+{
+    if (spilled_)
+        return 0;
+
+    return data_.capacity() * sizeof(T) + null_flags_.capacity() / 8;
+}
+
+template <class T>
+void NullableVector<T>::spill(const std::string& directory)
+{
+    logdbg << "NullableVector " << property_.name() << ": spill: size " << data_.size();
+
+    std::lock_guard<std::mutex> lock(spill_mutex_);
+
+    if (spilled_ || (!data_.size() && !null_flags_.size()))
+        return;
+
+    size_t data_bytes = dataSpillSize();
+    size_t null_bytes = (null_flags_.size() + 7) / 8;
+
+    spill_file_.reset(new SpillFile(directory, data_bytes + null_bytes));  // throws on failure
+
+    char* ptr = spill_file_->data();
+
+    writeSpillData(ptr);
+
+    unsigned char* null_ptr = reinterpret_cast<unsigned char*>(ptr + data_bytes);
+    memset(null_ptr, 0, null_bytes);
+
+    for (size_t cnt = 0; cnt < null_flags_.size(); ++cnt)
+        if (null_flags_[cnt])
+            null_ptr[cnt / 8] |= 1 << (cnt % 8);
+
+    spill_file_->unmap();
+
+    spilled_data_size_ = data_.size();
+    spilled_null_size_ = null_flags_.size();
+
+    std::vector<T>().swap(data_);  // release memory
+    std::vector<bool>().swap(null_flags_);
+
+    spilled_ = true;
+}
+
+template <class T>
+void NullableVector<T>::restore()
+{
+    std::lock_guard<std::mutex> lock(spill_mutex_);
+
+    if (!spilled_)  // restored by other thread
+        return;
+
+    logdbg << "NullableVector " << property_.name() << ": restore: size " << spilled_data_size_;
+
+    assert(spill_file_);
+
+    const char* ptr = spill_file_->data();
+
+    readSpillData(ptr);
+    assert(data_.size() == spilled_data_size_);
+
+    const unsigned char* null_ptr =
+        reinterpret_cast<const unsigned char*>(ptr + spill_file_->size()) -
+        (spilled_null_size_ + 7) / 8;
+
+    null_flags_.resize(spilled_null_size_);
+
+    for (size_t cnt = 0; cnt < spilled_null_size_; ++cnt)
+        null_flags_[cnt] = null_ptr[cnt / 8] & (1 << (cnt % 8));
+
+    spill_file_ = nullptr;
+
+    spilled_data_size_ = 0;
+    spilled_null_size_ = 0;
+
+    spilled_ = false;
+}
+
 // private stuff
 
 /// @brief Sets specific element to not Null value
@@ -807,6 +973,8 @@ void NullableVector<T>::unsetNull(unsigned int index)
 {
     logdbg << "NullableVector " << property_.name() << ": unsetNull";
 
+    restoreIfSpilled();
+
     if (BUFFER_PEDANTIC_CHECKING)
     {
         assert(data_.size() <= buffer_.data_size_);
@@ -819,6 +987,28 @@ void NullableVector<T>::unsetNull(unsigned int index)
         null_flags_.at(index) = false;
 }
 
+template <class T>
+size_t NullableVector<T>::dataSpillSize()
+{
+    return data_.size() * sizeof(T);
+}
+
+template <class T>
+void NullableVector<T>::writeSpillData(char* ptr)
+{
+    if (data_.size())
+        memcpy(ptr, data_.data(), data_.size() * sizeof(T));
+}
+
+template <class T>
+void NullableVector<T>::readSpillData(const char* ptr)
+{
+    data_.resize(spilled_data_size_);
+
+    if (spilled_data_size_)
+        memcpy(data_.data(), ptr, spilled_data_size_ * sizeof(T));
+}
+
 template <>
 NullableVector<bool>& NullableVector<bool>::operator*=(double factor);
 
@@ -828,4 +1018,22 @@ void NullableVector<bool>::append(unsigned int index, bool value);
 template <>
 void NullableVector<std::string>::append(unsigned int index, std::string value);
 
+template <>
+size_t NullableVector<bool>::memorySize();
+template <>
+size_t NullableVector<bool>::dataSpillSize();
+template <>
+void NullableVector<bool>::writeSpillData(char* ptr);
+template <>
+void NullableVector<bool>::readSpillData(const char* ptr);
+
+template <>
+size_t NullableVector<std::string>::memorySize();
+template <>
+size_t NullableVector<std::string>::dataSpillSize();
+template <>
+void NullableVector<std::string>::writeSpillData(char* ptr);
+template <>
+void NullableVector<std::string>::readSpillData(const char* ptr);
+
 #endif /* ARRAYLIST_H_ */
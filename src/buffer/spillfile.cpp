@@ -0,0 +1,102 @@
+/*
+ * This file is part of OpenATS COMPASS.
+ *
+ * COMPASS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * COMPASS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with COMPASS. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "spillfile.h"
+#include "logger.h"
+
+#include <cassert>
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+SpillFile::SpillFile(const std::string& directory, size_t size) : size_(size)
+{
+    assert(size_);
+
+    std::string path_template = directory;
+
+    if (!path_template.size() || path_template.back() != '/')
+        path_template += "/";
+
+    path_template += "compass_spill_XXXXXX";
+
+    std::vector<char> path(path_template.begin(), path_template.end());
+    path.push_back('\0');
+
+    fd_ = mkstemp(path.data());
+
+    if (fd_ == -1)
+    {
+        logerr << "SpillFile: constructor: creating file in '" << directory
+               << "' failed: " << strerror(errno);
+        throw std::runtime_error("SpillFile: constructor: unable to create file in " + directory);
+    }
+
+    unlink(path.data());  // removed by os when closed
+
+    if (ftruncate(fd_, size_) == -1)
+    {
+        logerr << "SpillFile: constructor: resizing file to " << size_
+               << " failed: " << strerror(errno);
+        close(fd_);
+        fd_ = -1;
+        throw std::runtime_error("SpillFile: constructor: unable to resize file");
+    }
+
+    logdbg << "SpillFile: constructor: created file with size " << size_;
+}
+
+SpillFile::~SpillFile()
+{
+    unmap();
+
+    if (fd_ != -1)
+        close(fd_);
+}
+
+char* SpillFile::data()
+{
+    if (mapping_)
+        return mapping_;
+
+    void* mapping = mmap(nullptr, size_, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+
+    if (mapping == MAP_FAILED)
+    {
+        logerr << "SpillFile: data: mapping " << size_ << " bytes failed: " << strerror(errno);
+        throw std::runtime_error("SpillFile: data: unable to map file");
+    }
+
+    mapping_ = static_cast<char*>(mapping);
+
+    return mapping_;
+}
+
+void SpillFile::unmap()
+{
+    if (!mapping_)
+        return;
+
+    munmap(mapping_, size_);
+    mapping_ = nullptr;
+}
@@ -0,0 +1,54 @@
+/*
+ * This file is part of OpenATS COMPASS.
+ *
+ * COMPASS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * COMPASS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with COMPASS. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SPILLFILE_H
+#define SPILLFILE_H
+
+#include <string>
+
+/**
+ * @brief Temporary memory-mapped file used to swap out NullableVector contents
+ *
+ * The file is created in the given directory and unlinked immediately, so it is removed by the
+ * operating system when the object is deleted or the process terminates. The content is accessed
+ * through a shared memory mapping, which is only held between data() and unmap() calls.
+ */
+class SpillFile
+{
+  public:
+    /// @brief Constructor, creates file of given size. Throws std::runtime_error on failure.
+    SpillFile(const std::string& directory, size_t size);
+    /// @brief Destructor, unmaps and closes the file
+    virtual ~SpillFile();
+
+    SpillFile(const SpillFile&) = delete;
+    SpillFile& operator=(const SpillFile&) = delete;
+
+    /// @brief Returns pointer to mapped file content, maps if required
+    char* data();
+    /// @brief Releases the mapping, content stays in file
+    void unmap();
+
+    size_t size() const { return size_; }
+
+  protected:
+    int fd_{-1};
+    size_t size_{0};
+    char* mapping_{nullptr};
+};
+
+#endif  // SPILLFILE_H
@@ -22,10 +22,12 @@
 #include "configurationmanager.h"
 #include "files.h"
 #include "global.h"
+#include "jobmanager.h"
 #include "logger.h"
 #include "mainwindow.h"
 #include "stringconv.h"
 #include "taskmanager.h"
+#include "tracer.h"
 
 #include <QApplication>
 #include <QMessageBox>
@@ -38,8 +40,6 @@
 #include <locale.h>
 #include <thread>
 
-#include <tbb/tbb.h>
-
 #if USE_EXPERIMENTAL_SOURCE == true
 #include <osgDB/Registry>
 
@@ -59,8 +59,6 @@ Client::Client(int& argc, char** argv) : QApplication(argc, argv)
 
     APP_FILENAME = argv[0];
 
-    tbb::task_scheduler_init guard(std::thread::hardware_concurrency());
-
     //    QApplication::setAttribute(Qt::AA_ShareOpenGLContexts);
 
 //    QSurfaceFormat format;
@@ -103,6 +101,14 @@ Client::Client(int& argc, char** argv) : QApplication(argc, argv)
     std::string export_eval_report_filename;
     bool quit {false};
 
+    unsigned int max_threads {0};
+    unsigned int import_threads {0};
+    unsigned int association_threads {0};
+    unsigned int evaluation_threads {0};
+    bool pin_threads {false};
+
+    std::string trace_filename;
+
     po::options_description desc("Allowed options");
     desc.add_options()("help", "produce help message")
             ("reset,r", po::bool_switch(&config_and_data_copy_wanted_) ,"reset user configuration and data")
@@ -138,7 +144,19 @@ Client::Client(int& argc, char** argv) : QApplication(argc, argv)
             ("evaluate", po::bool_switch(&evaluate), "run evaluation")
             ("export_eval_report", po::value<std::string>(&export_eval_report_filename),
              "export evaluation report after start with given filename, e.g. '/data/eval_db2/report.tex")
-            ("quit", po::bool_switch(&quit), "quit after finishing all previous steps");
+            ("quit", po::bool_switch(&quit), "quit after finishing all previous steps")
+            ("max_threads", po::value<unsigned int>(&max_threads),
+             "maximum number of worker threads for all subsystems, e.g. '8'")
+            ("import_threads", po::value<unsigned int>(&import_threads),
+             "number of worker threads for import, e.g. '4'")
+            ("association_threads", po::value<unsigned int>(&association_threads),
+             "number of worker threads for association, e.g. '4'")
+            ("evaluation_threads", po::value<unsigned int>(&evaluation_threads),
+             "number of worker threads for evaluation, e.g. '4'")
+            ("pin_threads", po::bool_switch(&pin_threads), "pin worker threads to cores")
+            ("trace", po::value<std::string>(&trace_filename),
+             "records performance trace, written as Chrome trace-event JSON on exit with given "
+             "filename, e.g. '/data/trace.json'");
 
     try
     {
@@ -164,12 +182,19 @@ Client::Client(int& argc, char** argv) : QApplication(argc, argv)
     if (quit_requested_)
         return;
 
+    if (trace_filename.size())
+        Tracer::instance().start(trace_filename);
+
     if (import_json_filename.size() && !import_json_schema.size())
     {
         loginf << "COMPASSClient: schema name must be set for JSON import";
         return;
     }
 
+    // only for this run, configured values are kept
+    JobManager::instance().overrideThreads(max_threads, import_threads, association_threads,
+                                           evaluation_threads, pin_threads);
+
     loginf << "COMPASSClient: started with " << std::thread::hardware_concurrency() << " threads";
 
     TaskManager& task_man = COMPASS::instance().taskManager();
@@ -249,6 +274,15 @@ Client::Client(int& argc, char** argv) : QApplication(argc, argv)
 Client::~Client()
 {
     loginf << "Client: destructor";
+
+    try
+    {
+        Tracer::instance().write();
+    }
+    catch (exception& e)
+    {
+        logerr << "Client: destructor: writing trace failed: " << e.what();
+    }
 }
 
 MainWindow& Client::mainWindow()
@@ -25,6 +25,7 @@
 #include "stringconv.h"
 #include "compass.h"
 #include "dbobjectmanager.h"
+#include "jobmanager.h"
 
 #include <QApplication>
 #include <QThread>
@@ -41,7 +42,7 @@ using namespace Utils;
 EvaluationData::EvaluationData(EvaluationManager& eval_man)
     : eval_man_(eval_man)
 {
-
+    connect(&eval_man_, &EvaluationManager::sectorsChangedSignal, this, &EvaluationData::sectorsChangedSlot);
 }
 
 void EvaluationData::addReferenceData (DBObject& object, std::shared_ptr<Buffer> buffer)
@@ -58,6 +59,7 @@ void EvaluationData::addReferenceData (DBObject& object, std::shared_ptr<Buffer>
 
     assert (!ref_buffer_);
     ref_buffer_ = buffer;
+    ref_buffer_->pin(); // read by evaluation tasks, not to be spilled
 
     // preset variable names
     DBObjectManager& object_manager = COMPASS::instance().objectManager();
@@ -199,6 +201,7 @@ void EvaluationData::addTestData (DBObject& object, std::shared_ptr<Buffer> buff
 
     assert (!tst_buffer_);
     tst_buffer_ = buffer;
+    tst_buffer_->pin(); // read by evaluation tasks, not to be spilled
 
     DBObjectManager& object_manager = COMPASS::instance().objectManager();
 
@@ -364,7 +367,7 @@ void EvaluationData::finalize ()
 
     EvaluateTargetsFinalizeTask* t = new (tbb::task::allocate_root()) EvaluateTargetsFinalizeTask(
                 target_data_, done_flags, done);
-    tbb::task::enqueue(*t);
+    tbb::task::enqueue(*t, JobManager::instance().arena(TaskArenaType::EVALUATION));
 
     postprocess_dialog_.setValue(0);
 
@@ -433,6 +436,10 @@ void EvaluationData::finalize ()
     //        target_data_.modify(target_it, [&](EvaluationTargetData& t) { t.finalize(); });
 
     finalized_ = true;
+    sector_inside_flags_valid_ = eval_man_.sectorsLoaded(); // computed in target finalize
+
+    if (sector_inside_flags_valid_)
+        logSectorInsideFlags();
 
     endResetModel();
 
@@ -444,6 +451,74 @@ void EvaluationData::finalize ()
     QApplication::restoreOverrideCursor();
 }
 
+void EvaluationData::sectorsChangedSlot()
+{
+    if (!sector_inside_flags_valid_)
+        return;
+
+    loginf << "EvaluationData: sectorsChangedSlot: clearing sector containment caches";
+
+    for (auto& target_it : target_data_)
+        target_it.clearSectorInsideFlags();
+
+    sector_inside_flags_valid_ = false;
+}
+
+void EvaluationData::updateSectorInsideFlags ()
+{
+    if (!finalized_ || sector_inside_flags_valid_)
+        return;
+
+    loginf << "EvaluationData: updateSectorInsideFlags";
+
+    TraceSpan span("evaluation", "updateSectorInsideFlags");
+
+    std::vector<std::shared_ptr<SectorLayer>>& sector_layers = eval_man_.sectorsLayers();
+    unsigned int num_targets = target_data_.size();
+
+    JobManager::instance().arena(TaskArenaType::EVALUATION).execute([&] {
+        tbb::parallel_for(uint(0), num_targets, [&](unsigned int cnt)
+        {
+            target_data_[cnt].computeSectorInsideFlags(sector_layers);
+        });
+    });
+
+    sector_inside_flags_valid_ = true;
+
+    logSectorInsideFlags();
+}
+
+void EvaluationData::logSectorInsideFlags ()
+{
+    for (auto& sec_it : eval_man_.sectorsLayers())
+    {
+        unsigned int num_outside = numOutsideTargets(*sec_it);
+        unsigned int num_constant = 0;
+
+        for (auto& target_it : target_data_)
+        {
+            const SectorInsideFlags* inside_flags = target_it.sectorInsideFlags(*sec_it);
+
+            if (inside_flags && !inside_flags->outside_)
+                num_constant += inside_flags->constant_;
+        }
+
+        loginf << "EvaluationData: logSectorInsideFlags: layer '" << sec_it->name() << "' targets "
+               << target_data_.size() << " skipped as outside " << num_outside
+               << " without polygon checks " << num_constant;
+    }
+}
+
+unsigned int EvaluationData::numOutsideTargets (const SectorLayer& sector_layer)
+{
+    unsigned int num_outside = 0;
+
+    for (auto& target_it : target_data_)
+        num_outside += target_it.isOutside(sector_layer);
+
+    return num_outside;
+}
+
 bool EvaluationData::hasTargetData (unsigned int utn)
 {
     return target_data_.get<target_tag>().find(utn) != target_data_.get<target_tag>().end();
@@ -460,11 +535,17 @@ void EvaluationData::clear()
 {
     beginResetModel();
 
+    if (ref_buffer_)
+        ref_buffer_->unpin();
+    if (tst_buffer_)
+        tst_buffer_->unpin();
+
     ref_buffer_ = nullptr;
     tst_buffer_ = nullptr;
 
     target_data_.clear();
     finalized_ = false;
+    sector_inside_flags_valid_ = false;
 
     unassociated_ref_cnt_ = 0;
     associated_ref_cnt_ = 0;
@@ -650,8 +731,8 @@ bool EvaluationData::setData(const QModelIndex &index, const QVariant& value, in
         bool checked = (Qt::CheckState)value.toInt() == Qt::Checked;
         loginf << "EvaluationData: setData: utn " << it->utn_ <<" check state " << checked;
 
-        eval_man_.useUTN(it->utn_, checked, false);
         target_data_.modify(it, [value,checked](EvaluationTargetData& p) { p.use(checked); });
+        eval_man_.useUTN(it->utn_, checked, false); // results are updated from target use
 
         emit dataChanged(index, EvaluationData::index(index.row(), columnCount()-1));
         return true;
@@ -21,6 +21,7 @@
 #include "evaluationtargetdata.h"
 #include "evaluationdatawidget.h"
 #include "evaluationdatafilterdialog.h"
+#include "tracer.h"
 
 #include <QAbstractItemModel>
 
@@ -65,6 +66,8 @@ public:
     /*override*/ tbb::task* execute() {
         // Do the job
 
+        TraceSpan span("evaluation", "finalizeTargets");
+
         unsigned int num_targets = target_data_.size();
 
         tbb::parallel_for(uint(0), num_targets, [&](unsigned int cnt)
@@ -95,6 +98,9 @@ class EvaluationData : public QAbstractItemModel
 {
     Q_OBJECT
 
+public slots:
+    void sectorsChangedSlot();
+
 public:
     EvaluationData(EvaluationManager& eval_man);
 
@@ -102,6 +108,11 @@ public:
     void addTestData (DBObject& object, std::shared_ptr<Buffer> buffer);
     void finalize ();
 
+    // re-computes sector containment caches of all targets if sectors changed since finalize
+    void updateSectorInsideFlags ();
+    // number of targets outside of the layer by the sector containment caches, without polygon tests
+    unsigned int numOutsideTargets (const SectorLayer& sector_layer);
+
     bool hasTargetData (unsigned int utn);
     const EvaluationTargetData& targetData(unsigned int utn);
     unsigned int size() { return target_data_.size(); }
@@ -195,6 +206,7 @@ protected:
 
     TargetCache target_data_;
     bool finalized_ {false};
+    bool sector_inside_flags_valid_ {false};
 
     std::unique_ptr<EvaluationDataWidget> widget_;
     std::unique_ptr<EvaluationDataFilterDialog> dialog_;
@@ -204,6 +216,8 @@ protected:
 
     unsigned int unassociated_tst_cnt_ {0};
     unsigned int associated_tst_cnt_ {0};
+
+    void logSectorInsideFlags (); // number of targets pre-filtered by bounding box, per sector layer
 };
 
 #endif // EVALUATIONDATA_H
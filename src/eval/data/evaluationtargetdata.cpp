@@ -24,6 +24,7 @@
 #include "compass.h"
 #include "dbobjectmanager.h"
 #include "evaluationmanager.h"
+#include "sectorlayer.h"
 //#include "projection/transformation.h"
 
 //#include <ogr_spatialref.h>
@@ -31,6 +32,7 @@
 #include <cassert>
 #include <algorithm>
 #include <cmath>
+#include <numeric>
 
 using namespace std;
 using namespace Utils;
@@ -39,6 +41,133 @@ using namespace Utils;
 
 //const unsigned int debug_utn = 3275;
 
+namespace
+{
+// estimate baro alt at index from mode c of updates within 120s
+std::pair<bool, float> estimateAltitude (const TargetUpdates& updates, unsigned int index)
+{
+    assert (index < updates.size());
+
+    float tod = updates.tods_[index];
+
+    bool found_prev {false};
+    bool found_after {false};
+
+    // search for prev index
+    float tod_prev;
+    unsigned int prev_index = index;
+
+    while (tod - updates.tods_[prev_index] < 120.0)
+    {
+        if (updates.has_mode_c_[prev_index])
+        {
+            found_prev = true;
+            tod_prev = updates.tods_[prev_index];
+
+            break;
+        }
+
+        if (prev_index == 0) // undefined decrement
+            break;
+
+        --prev_index;
+    }
+
+    // search after index
+    float tod_after;
+    unsigned int after_index = index;
+
+    while (after_index < updates.size() && updates.tods_[after_index] - tod < 120.0)
+    {
+        if (updates.has_mode_c_[after_index])
+        {
+            found_after = true;
+            tod_after = updates.tods_[after_index];
+
+            break;
+        }
+        ++after_index;
+    }
+
+    if (found_prev && found_after)
+    {
+        float alt_prev = updates.mode_c_codes_[prev_index];
+        float alt_after = updates.mode_c_codes_[after_index];
+
+        if (tod_after <= tod_prev || tod_prev >= tod)
+        {
+            logerr << "EvaluationTargetData: estimateAltitude: tod_prev " << tod_prev << " tod "
+                   << tod << " tod_after " << tod_after;
+            return {false, 0}; // should never happen
+        }
+
+        float d_alt_ft = alt_after - alt_prev;
+        float d_t = tod_after - tod_prev;
+
+        float alt_spd_ft_s = d_alt_ft/d_t;
+
+        float d_t2 = tod - tod_prev;
+
+        float alt_calc = alt_prev + alt_spd_ft_s*d_t2;
+
+        return {true, alt_calc};
+    }
+    else if (found_prev && tod - tod_prev < 120.0)
+        return {true, updates.mode_c_codes_[prev_index]};
+    else if (found_after && tod_after - tod < 120.0)
+        return {true, updates.mode_c_codes_[after_index]};
+    else
+        return {false, 0}; // none found
+}
+}
+
+int TargetUpdates::index (float tod) const
+{
+    auto it = lower_bound(tods_.begin(), tods_.end(), tod);
+
+    if (it == tods_.end() || *it != tod)
+        return -1;
+
+    return it - tods_.begin();
+}
+
+unsigned int TargetUpdates::firstIndex (unsigned int index) const
+{
+    assert (index < tods_.size());
+
+    while (index && tods_[index-1] == tods_[index])
+        --index;
+
+    return index;
+}
+
+void TargetUpdates::sort()
+{
+    if (is_sorted(tods_.begin(), tods_.end()))
+        return;
+
+    vector<unsigned int> order (tods_.size());
+    iota(order.begin(), order.end(), 0);
+
+    stable_sort(order.begin(), order.end(),
+                [this](unsigned int a, unsigned int b) { return tods_[a] < tods_[b]; });
+
+    vector<float> tods;
+    vector<unsigned int> indexes;
+
+    tods.reserve(order.size());
+    indexes.reserve(order.size());
+
+    for (auto order_it : order)
+    {
+        tods.push_back(tods_[order_it]);
+        indexes.push_back(indexes_[order_it]);
+    }
+
+    tods_.swap(tods);
+    indexes_.swap(indexes);
+}
+
 EvaluationTargetData::EvaluationTargetData()
 {
 
@@ -60,12 +189,14 @@ EvaluationTargetData::~EvaluationTargetData()
 
 void EvaluationTargetData::addRefIndex (float tod, unsigned int index)
 {
-    ref_data_.insert({tod, index});
+    ref_data_.tods_.push_back(tod);
+    ref_data_.indexes_.push_back(index);
 }
 
 void EvaluationTargetData::addTstIndex (float tod, unsigned int index)
 {
-    tst_data_.insert({tod, index});
+    tst_data_.tods_.push_back(tod);
+    tst_data_.indexes_.push_back(index);
 }
 
 bool EvaluationTargetData::hasData() const
@@ -89,11 +220,11 @@ void EvaluationTargetData::finalize () const
     //           << " ref " << hasRefData() << " up " << ref_rec_nums_.size()
     //           << " tst " << hasTstData() << " up " << tst_rec_nums_.size();
 
-    for (auto& ref_it : ref_data_)
-        ref_indexes_.push_back(ref_it.second);
+    ref_data_.sort();
+    tst_data_.sort();
 
-    for (auto& tst_it : tst_data_)
-        tst_indexes_.push_back(tst_it.second);
+    prefetchColumns(true);
+    prefetchColumns(false);
 
     updateCallsigns();
     updateTargetAddresses();
@@ -153,6 +284,9 @@ void EvaluationTargetData::finalize () const
     }
 
     calculateTestDataMappings();
+
+    if (eval_man_->sectorsLoaded())
+        computeSectorInsideFlags(eval_man_->sectorsLayers());
 }
 
 unsigned int EvaluationTargetData::numUpdates () const
@@ -172,11 +306,11 @@ unsigned int EvaluationTargetData::numTstUpdates () const
 float EvaluationTargetData::timeBegin() const
 {
     if (ref_data_.size() && tst_data_.size())
-        return min(ref_data_.begin()->first, tst_data_.begin()->first);
+        return min(ref_data_.tods_.front(), tst_data_.tods_.front());
     else if (ref_data_.size())
-        return ref_data_.begin()->first;
+        return ref_data_.tods_.front();
     else if (tst_data_.size())
-        return tst_data_.begin()->first;
+        return tst_data_.tods_.front();
     else
         throw std::runtime_error("EvaluationTargetData: timeBegin: no data");
 }
@@ -192,11 +326,11 @@ std::string EvaluationTargetData::timeBeginStr() const
 float EvaluationTargetData::timeEnd() const
 {
     if (ref_data_.size() && tst_data_.size())
-        return max(ref_data_.rbegin()->first, tst_data_.rbegin()->first);
+        return max(ref_data_.tods_.back(), tst_data_.tods_.back());
     else if (ref_data_.size())
-        return ref_data_.rbegin()->first;
+        return ref_data_.tods_.back();
     else if (tst_data_.size())
-        return tst_data_.rbegin()->first;
+        return tst_data_.tods_.back();
     else
         throw std::runtime_error("EvaluationTargetData: timeEnd: no data");
 }
@@ -287,21 +421,172 @@ void EvaluationTargetData::use(bool use)
     use_ = use;
 }
 
-const std::multimap<float, unsigned int>& EvaluationTargetData::refData() const
+const TargetUpdates& EvaluationTargetData::refData() const
 {
     return ref_data_;
 }
 
 
-const std::multimap<float, unsigned int>& EvaluationTargetData::tstData() const
+const TargetUpdates& EvaluationTargetData::tstData() const
 {
     return tst_data_;
 }
 
+void EvaluationTargetData::prefetchColumns(bool ref) const
+{
+    TargetUpdates& updates = ref ? ref_data_ : tst_data_;
+
+    unsigned int size = updates.size();
+
+    if (!size)
+        return;
+
+    Buffer& buffer = ref ? *eval_data_->ref_buffer_ : *eval_data_->tst_buffer_;
+
+    NullableVector<double>& latitude_vec = buffer.get<double>(
+                ref ? eval_data_->ref_latitude_name_ : eval_data_->tst_latitude_name_);
+    NullableVector<double>& longitude_vec = buffer.get<double>(
+                ref ? eval_data_->ref_longitude_name_ : eval_data_->tst_longitude_name_);
+    NullableVector<string>& callsign_vec = buffer.get<string>(
+                ref ? eval_data_->ref_callsign_name_ : eval_data_->tst_callsign_name_);
+
+    NullableVector<int>& modea_vec = buffer.get<int>(ref ? eval_data_->ref_modea_name_ : eval_data_->tst_modea_name_);
+    const string& modea_g_name = ref ? eval_data_->ref_modea_g_name_ : eval_data_->tst_modea_g_name_;
+    NullableVector<string>* modea_g_vec = modea_g_name.size() ? &buffer.get<string>(modea_g_name) : nullptr;
+    const string& modea_v_name = ref ? eval_data_->ref_modea_v_name_ : eval_data_->tst_modea_v_name_;
+    NullableVector<string>* modea_v_vec = modea_v_name.size() ? &buffer.get<string>(modea_v_name) : nullptr;
+
+    NullableVector<int>& modec_vec = buffer.get<int>(ref ? eval_data_->ref_modec_name_ : eval_data_->tst_modec_name_);
+    const string& modec_g_name = ref ? eval_data_->ref_modec_g_name_ : eval_data_->tst_modec_g_name_;
+    NullableVector<string>* modec_g_vec = modec_g_name.size() ? &buffer.get<string>(modec_g_name) : nullptr;
+    const string& modec_v_name = ref ? eval_data_->ref_modec_v_name_ : eval_data_->tst_modec_v_name_;
+    NullableVector<string>* modec_v_vec = modec_v_name.size() ? &buffer.get<string>(modec_v_name) : nullptr;
+
+    NullableVector<int>* altitude_secondary_vec =
+            ref && eval_data_->has_ref_altitude_secondary_ ?
+                &buffer.get<int>(eval_data_->ref_altitude_secondary_name_) : nullptr;
+
+    const string& ta_name = ref ? eval_data_->ref_target_address_name_ : eval_data_->tst_target_address_name_;
+    NullableVector<int>* ta_vec = ta_name.size() ? &buffer.get<int>(ta_name) : nullptr;
+
+    const string& ground_bit_name = ref ? eval_data_->ref_ground_bit_name_ : eval_data_->tst_ground_bit_name_;
+    NullableVector<string>* ground_bit_vec =
+            ground_bit_name.size() ? &buffer.get<string>(ground_bit_name) : nullptr;
+
+    updates.latitudes_.resize(size);
+    updates.longitudes_.resize(size);
+    updates.has_altitudes_.assign(size, false);
+    updates.altitudes_calculated_.assign(size, false);
+    updates.altitudes_.assign(size, 0);
+    updates.has_mode_c_.assign(size, false);
+    updates.mode_c_valid_.assign(size, false);
+    updates.mode_c_codes_.assign(size, 0);
+    updates.has_mode_a_.assign(size, false);
+    updates.mode_a_valid_.assign(size, false);
+    updates.mode_a_codes_.assign(size, 0);
+    updates.has_target_addresses_.assign(size, false);
+    updates.target_addresses_.assign(size, 0);
+    updates.has_ground_bits_.assign(size, false);
+    updates.ground_bits_.assign(size, false);
+    updates.callsign_codes_.assign(size, -1);
+    updates.callsigns_.clear();
+
+    map<string, int> callsign_codes;
+    unsigned int index;
+
+    for (unsigned int cnt=0; cnt < size; ++cnt)
+    {
+        index = updates.indexes_[cnt];
+
+        assert (!latitude_vec.isNull(index));
+        assert (!longitude_vec.isNull(index));
+
+        updates.latitudes_[cnt] = latitude_vec.get(index);
+        updates.longitudes_[cnt] = longitude_vec.get(index);
+
+        if (!modec_vec.isNull(index))
+        {
+            updates.has_mode_c_[cnt] = true;
+            updates.mode_c_codes_[cnt] = modec_vec.get(index);
+            updates.mode_c_valid_[cnt] =
+                    !(modec_v_vec && !modec_v_vec->isNull(index) && modec_v_vec->get(index) == "N")
+                    && !(modec_g_vec && !modec_g_vec->isNull(index) && modec_g_vec->get(index) == "Y");
+        }
+
+        if (!modea_vec.isNull(index))
+        {
+            updates.has_mode_a_[cnt] = true;
+            updates.mode_a_codes_[cnt] = modea_vec.get(index);
+            updates.mode_a_valid_[cnt] =
+                    !(modea_v_vec && !modea_v_vec->isNull(index) && modea_v_vec->get(index) == "N")
+                    && !(modea_g_vec && !modea_g_vec->isNull(index) && modea_g_vec->get(index) == "Y");
+        }
+
+        if (ta_vec && !ta_vec->isNull(index))
+        {
+            updates.has_target_addresses_[cnt] = true;
+            updates.target_addresses_[cnt] = ta_vec->get(index);
+        }
+
+        if (ground_bit_vec && !ground_bit_vec->isNull(index))
+        {
+            updates.has_ground_bits_[cnt] = true;
+            updates.ground_bits_[cnt] = ground_bit_vec->get(index) == "Y";
+        }
+
+        if (!callsign_vec.isNull(index))
+        {
+            auto code_it = callsign_codes.insert({callsign_vec.get(index), (int) updates.callsigns_.size()});
+
+            if (code_it.second) // new
+                updates.callsigns_.push_back(code_it.first->first);
+
+            updates.callsign_codes_[cnt] = code_it.first->second;
+        }
+    }
+
+    // position altitudes, needs mode c of all updates
+    bool found;
+    float alt_calc;
+
+    for (unsigned int cnt=0; cnt < size; ++cnt)
+    {
+        index = updates.indexes_[cnt];
+
+        if (updates.has_mode_c_[cnt])
+        {
+            updates.has_altitudes_[cnt] = true;
+            updates.altitudes_[cnt] = updates.mode_c_codes_[cnt];
+        }
+        else if (altitude_secondary_vec && !altitude_secondary_vec->isNull(index))
+        {
+            updates.has_altitudes_[cnt] = true;
+            updates.altitudes_calculated_[cnt] = true;
+            updates.altitudes_[cnt] = altitude_secondary_vec->get(index);
+        }
+        else // calculate
+        {
+            tie(found, alt_calc) = estimateAltitude(updates, cnt);
+
+            if (found)
+            {
+                updates.has_altitudes_[cnt] = true;
+                updates.altitudes_calculated_[cnt] = true;
+                updates.altitudes_[cnt] = alt_calc;
+            }
+        }
+    }
+}
+
 bool EvaluationTargetData::hasRefDataForTime (float tod, float d_max) const
 {
-    assert (test_data_mappings_.count(tod));
-    TstDataMapping& mapping = test_data_mappings_.at(tod);
+    return hasRefData(tstIndexForTime(tod), d_max);
+}
+
+bool EvaluationTargetData::hasRefData (unsigned int tst_index, float d_max) const
+{
+    const TstDataMapping& mapping = test_data_mappings_.at(tst_index);
+    float tod = mapping.tod_;
 
     if (!mapping.has_ref1_ && !mapping.has_ref2_) // no ref data
         return false;
@@ -325,8 +610,13 @@ bool EvaluationTargetData::hasRefDataForTime (float tod, float d_max) const
 
 std::pair<float, float> EvaluationTargetData::refTimesFor (float tod, float d_max)  const
 {
-    assert (test_data_mappings_.count(tod));
-    TstDataMapping& mapping = test_data_mappings_.at(tod);
+    return refTimes(tstIndexForTime(tod), d_max);
+}
+
+std::pair<float, float> EvaluationTargetData::refTimes (unsigned int tst_index, float d_max)  const
+{
+    const TstDataMapping& mapping = test_data_mappings_.at(tst_index);
+    float tod = mapping.tod_;
 
     if (!mapping.has_ref1_ && !mapping.has_ref2_) // no ref data
         return {-1, -1};
@@ -351,8 +641,14 @@ std::pair<float, float> EvaluationTargetData::refTimesFor (float tod, float d_ma
 std::pair<EvaluationTargetPosition, bool>  EvaluationTargetData::interpolatedRefPosForTime (
         float tod, float d_max) const
 {
-    assert (test_data_mappings_.count(tod));
-    TstDataMapping& mapping = test_data_mappings_.at(tod);
+    return interpolatedRefPos(tstIndexForTime(tod), d_max);
+}
+
+std::pair<EvaluationTargetPosition, bool>  EvaluationTargetData::interpolatedRefPos (
+        unsigned int tst_index, float d_max) const
+{
+    const TstDataMapping& mapping = test_data_mappings_.at(tst_index);
+    float tod = mapping.tod_;
 
     if (!mapping.has_ref1_ && !mapping.has_ref2_) // no ref data
         return {{}, false};
@@ -401,8 +697,14 @@ std::pair<EvaluationTargetPosition, bool>  EvaluationTargetData::interpolatedRef
 std::pair<EvaluationTargetVelocity, bool>  EvaluationTargetData::interpolatedRefPosBasedSpdForTime (
         float tod, float d_max) const
 {
-    assert (test_data_mappings_.count(tod));
-    TstDataMapping& mapping = test_data_mappings_.at(tod);
+    return interpolatedRefPosBasedSpd(tstIndexForTime(tod), d_max);
+}
+
+std::pair<EvaluationTargetVelocity, bool>  EvaluationTargetData::interpolatedRefPosBasedSpd (
+        unsigned int tst_index, float d_max) const
+{
+    const TstDataMapping& mapping = test_data_mappings_.at(tst_index);
+    float tod = mapping.tod_;
 
     if (!mapping.has_ref1_ && !mapping.has_ref2_) // no ref data
         return {{}, false};
@@ -450,367 +752,117 @@ std::pair<EvaluationTargetVelocity, bool>  EvaluationTargetData::interpolatedRef
 
 bool EvaluationTargetData::hasRefPosForTime (float tod) const
 {
-    return ref_data_.count(tod);
+    return ref_data_.index(tod) != -1;
 }
 
 EvaluationTargetPosition EvaluationTargetData::refPosForTime (float tod) const
 {
-    assert (hasRefPosForTime(tod));
-
-    auto it_pair = ref_data_.equal_range(tod);
-
-    assert (it_pair.first != ref_data_.end());
-
-    unsigned int index = it_pair.first->second;
-
-    EvaluationTargetPosition pos;
-
-    NullableVector<double>& latitude_vec = eval_data_->ref_buffer_->get<double>(eval_data_->ref_latitude_name_);
-    NullableVector<double>& longitude_vec = eval_data_->ref_buffer_->get<double>(eval_data_->ref_longitude_name_);
-    NullableVector<int>& altitude_vec = eval_data_->ref_buffer_->get<int>(eval_data_->ref_modec_name_);
-
-    assert (!latitude_vec.isNull(index));
-    assert (!longitude_vec.isNull(index));
-
-    pos.latitude_ = latitude_vec.get(index);
-    pos.longitude_ = longitude_vec.get(index);
-
-    if (!altitude_vec.isNull(index))
-    {
-        pos.has_altitude_ = true;
-        pos.altitude_calculated_ = false;
-        pos.altitude_ = altitude_vec.get(index);
-    }
-    else if (eval_data_->has_ref_altitude_secondary_
-             && !eval_data_->ref_buffer_->get<int>(eval_data_->ref_altitude_secondary_name_).isNull(index))
-    {
-        pos.has_altitude_ = true;
-        pos.altitude_calculated_ = true;
-        pos.altitude_ = eval_data_->ref_buffer_->get<int>(eval_data_->ref_altitude_secondary_name_).get(index);
-    }
-    else // calculate
-    {
-        bool found;
-        float alt_calc;
-
-        tie(found,alt_calc) = estimateRefAltitude(tod, index);
-
-        if (found)
-        {
-            pos.has_altitude_ = true;
-            pos.altitude_calculated_ = true;
-            pos.altitude_ = alt_calc;
-        }
-    }
-
-    //    if (utn_ == debug_utn)
-    //        loginf << "EvaluationTargetData: refPosForTime: tod " << String::timeStringFromDouble(tod)
-    //               << " has_alt " << pos.has_altitude_ << " alt_calc " << pos.altitude_calculated_
-    //               << " alt " << pos.altitude_;
+    int index = ref_data_.index(tod);
+    assert (index != -1);
 
-    return pos;
+    return refPos(index);
 }
 
-std::pair<bool, float> EvaluationTargetData::estimateRefAltitude (float tod, unsigned int index) const
+EvaluationTargetPosition EvaluationTargetData::refPos (unsigned int ref_index) const
 {
-    NullableVector<int>& altitude_vec = eval_data_->ref_buffer_->get<int>(eval_data_->ref_modec_name_);
-    NullableVector<float>& tods = eval_data_->ref_buffer_->get<float>("tod");
-
-    bool found_prev {false};
-    bool found_after {false};
-
-    // search for prev index
-    float tod_prev;
-    auto prev_it = find(ref_indexes_.begin(), ref_indexes_.end(), index);
-    assert (prev_it != ref_indexes_.end());
-
-    auto after_it = prev_it;
-
-    while (prev_it != ref_indexes_.end() && tod - tods.get(*prev_it) < 120.0)
-    {
-        if (!altitude_vec.isNull(*prev_it))
-        {
-            found_prev = true;
-            tod_prev = tods.get(*prev_it);
-
-            //            if (utn_ == debug_utn)
-            //                loginf << "EvaluationTargetData: refPosForTime: found prev at tod "
-            //                       << String::timeStringFromDouble(tod_prev);
-
-            break;
-        }
+    unsigned int index = ref_data_.firstIndex(ref_index);
 
-        if (prev_it == ref_indexes_.begin()) // undefined decrement
-            break;
-
-        --prev_it;
-    }
-
-    //    if (utn_ == debug_utn)
-    //    {
-    //        if (prev_it != ref_indexes_.end())
-    //            loginf << "EvaluationTargetData: refPosForTime: checking prev found end";
-    //        else if (prev_it != ref_indexes_.begin())
-    //            loginf << "EvaluationTargetData: refPosForTime: checking prev found begin";
-    //        else
-    //            loginf << "EvaluationTargetData: refPosForTime: finished prev tod "
-    //                   << String::timeStringFromDouble(tods.get(*prev_it)) << " found " << found_prev;
-    //    }
-
-    // search after index
-    float tod_after;
-
-    while (after_it != ref_indexes_.end() && tods.get(*after_it) - tod < 120.0)
-    {
-        //        if (utn_ == debug_utn)
-        //            loginf << "EvaluationTargetData: refPosForTime: checking after tod "
-        //                   << String::timeStringFromDouble(tods.get(*after_it));
-
-        if (!altitude_vec.isNull(*after_it))
-        {
-            found_after = true;
-            tod_after = tods.get(*after_it);
-
-            //            if (utn_ == debug_utn)
-            //                loginf << "EvaluationTargetData: refPosForTime: found after at tod "
-            //                       << String::timeStringFromDouble(tod_after);
-
-            break;
-        }
-        ++after_it;
-    }
-
-    //    if (utn_ == debug_utn)
-    //    {
-    //        if (after_it != ref_indexes_.end())
-    //            loginf << "EvaluationTargetData: refPosForTime: checking after found end";
-    //        else
-    //            loginf << "EvaluationTargetData: refPosForTime: finished after tod "
-    //                   << String::timeStringFromDouble(tods.get(*after_it)) << " found " << found_after;
-    //    }
-
-    if (found_prev && found_after)
-    {
-        float alt_prev = altitude_vec.get(*prev_it);
-        float alt_after = altitude_vec.get(*after_it);
-
-        if (tod_after <= tod_prev || tod_prev >= tod)
-        {
-            logerr << "EvaluationTargetData::estimateRefAltitude tod_prev " << tod_prev << " tod "
-                   << tod << " tod_after " << tod_after;
-            return {false, 0}; // should never happen
-        }
-
-        float d_alt_ft = alt_after - alt_prev;
-        float d_t = tod_after - tod_prev;
-
-        float alt_spd_ft_s = d_alt_ft/d_t;
-
-        float d_t2 = tod - tod_prev;
-
-        float alt_calc = alt_prev + alt_spd_ft_s*d_t2;
-
-        //loginf << "UGA " << alt_calc;
-
-        //        if (utn_ == debug_utn)
-        //            loginf << "EvaluationTargetData: refPosForTime: returning alt " << alt_calc;
-
-        return {true, alt_calc};
-    }
-    else if (found_prev && tod - tod_prev < 120.0)
-        return {true, altitude_vec.get(*prev_it)};
-    else if (found_after && tod_after - tod < 120.0)
-        return {true, altitude_vec.get(*after_it)};
-    else
-    {
-        //        if (utn_ == debug_utn)
-        //            loginf << "EvaluationTargetData: refPosForTime: tod " << String::timeStringFromDouble(tod)
-        //                   << " none found";
+    return {ref_data_.latitudes_[index], ref_data_.longitudes_[index], ref_data_.has_altitudes_[index],
+            ref_data_.altitudes_calculated_[index], ref_data_.altitudes_[index]};
+}
 
-        return {false, 0}; // none found
-    }
+std::pair<bool, float> EvaluationTargetData::estimateRefAltitude (unsigned int index) const
+{
+    return estimateAltitude(ref_data_, index);
 }
 
 bool EvaluationTargetData::hasRefCallsignForTime (float tod) const
 {
-    if (!ref_data_.count(tod))
-        return false;
-
-    auto it_pair = ref_data_.equal_range(tod);
-
-    assert (it_pair.first != ref_data_.end());
+    int index = ref_data_.index(tod);
 
-    unsigned int index = it_pair.first->second;
-
-    NullableVector<string>& callsign_vec = eval_data_->ref_buffer_->get<string>(eval_data_->ref_callsign_name_);
-
-    return !callsign_vec.isNull(index);
+    return index != -1 && ref_data_.callsign_codes_[index] != -1;
 }
 
 std::string EvaluationTargetData::refCallsignForTime (float tod) const
 {
     assert (hasRefCallsignForTime(tod));
 
-    auto it_pair = ref_data_.equal_range(tod);
-
-    assert (it_pair.first != ref_data_.end());
-
-    unsigned int index = it_pair.first->second;
-
-    NullableVector<string>& callsign_vec = eval_data_->ref_buffer_->get<string>(eval_data_->ref_callsign_name_);
-    assert (!callsign_vec.isNull(index));
-
-    return callsign_vec.get(index);
+    return ref_data_.callsigns_.at(ref_data_.callsign_codes_[ref_data_.index(tod)]);
 }
 
 bool EvaluationTargetData::hasRefModeAForTime (float tod) const
 {
-    if (!ref_data_.count(tod))
-        return false;
-
-    auto it_pair = ref_data_.equal_range(tod);
-
-    assert (it_pair.first != ref_data_.end());
-
-    unsigned int index = it_pair.first->second;
-
-    if (eval_data_->ref_buffer_->get<int>(eval_data_->ref_modea_name_).isNull(index))
-        return false;
-
-    if (eval_data_->ref_modea_v_name_.size()
-            && !eval_data_->ref_buffer_->get<string>(eval_data_->ref_modea_v_name_).isNull(index)
-            && eval_data_->ref_buffer_->get<string>(eval_data_->ref_modea_v_name_).get(index) == "N")
-        return false;
+    int index = ref_data_.index(tod);
 
-    if (eval_data_->ref_modea_g_name_.size()
-            && !eval_data_->ref_buffer_->get<string>(eval_data_->ref_modea_g_name_).isNull(index)
-            && eval_data_->ref_buffer_->get<string>(eval_data_->ref_modea_g_name_).get(index) == "Y")
-        return false;
-
-    return true;
+    return index != -1 && ref_data_.mode_a_valid_[index];
 }
 
 unsigned int EvaluationTargetData::refModeAForTime (float tod) const
 {
     assert (hasRefModeAForTime(tod));
 
-    auto it_pair = ref_data_.equal_range(tod);
-
-    assert (it_pair.first != ref_data_.end());
-
-    unsigned int index = it_pair.first->second;
-
-    NullableVector<int>& modea_vec = eval_data_->ref_buffer_->get<int>(eval_data_->ref_modea_name_);
-    assert (!modea_vec.isNull(index));
-
-    return modea_vec.get(index);
+    return ref_data_.mode_a_codes_[ref_data_.index(tod)];
 }
 
 bool EvaluationTargetData::hasRefModeCForTime (float tod) const
 {
-    if (!ref_data_.count(tod))
-        return false;
-
-    auto it_pair = ref_data_.equal_range(tod);
-
-    assert (it_pair.first != ref_data_.end());
-
-    unsigned int index = it_pair.first->second;
-
-    if (eval_data_->ref_buffer_->get<int>(eval_data_->ref_modec_name_).isNull(index))
-        return false;
+    int index = ref_data_.index(tod);
 
-    if (eval_data_->ref_modec_v_name_.size()
-            && !eval_data_->ref_buffer_->get<string>(eval_data_->ref_modec_v_name_).isNull(index)
-            && eval_data_->ref_buffer_->get<string>(eval_data_->ref_modec_v_name_).get(index) == "N")
-        return false;
-
-    if (eval_data_->ref_modec_g_name_.size()
-            && !eval_data_->ref_buffer_->get<string>(eval_data_->ref_modec_g_name_).isNull(index)
-            && eval_data_->ref_buffer_->get<string>(eval_data_->ref_modec_g_name_).get(index) == "Y")
-        return false;
-
-    return true;
+    return index != -1 && ref_data_.mode_c_valid_[index];
 }
 
 int EvaluationTargetData::refModeCForTime (float tod) const
 {
     assert (hasRefModeCForTime(tod));
 
-    auto it_pair = ref_data_.equal_range(tod);
-
-    assert (it_pair.first != ref_data_.end());
-
-    unsigned int index = it_pair.first->second;
-
-    NullableVector<int>& modec_vec = eval_data_->ref_buffer_->get<int>(eval_data_->ref_modec_name_);
-    assert (!modec_vec.isNull(index));
-
-    return modec_vec.get(index);
+    return ref_data_.mode_c_codes_[ref_data_.index(tod)];
 }
 
 bool EvaluationTargetData::hasRefTAForTime (float tod) const
 {
-    if (!ref_data_.count(tod))
-        return false;
-
-    auto it_pair = ref_data_.equal_range(tod);
-
-    assert (it_pair.first != ref_data_.end());
-
-    unsigned int index = it_pair.first->second;
+    int index = ref_data_.index(tod);
 
-    if (eval_data_->ref_target_address_name_.size()
-            && !eval_data_->ref_buffer_->get<int>(eval_data_->ref_target_address_name_).isNull(index))
-        return true;
-
-    return false;
+    return index != -1 && ref_data_.has_target_addresses_[index];
 }
 
 unsigned int EvaluationTargetData::refTAForTime (float tod) const
 {
     assert (hasRefTAForTime(tod));
 
-    auto it_pair = ref_data_.equal_range(tod);
-
-    assert (it_pair.first != ref_data_.end());
-
-    unsigned int index = it_pair.first->second;
-
-    assert (!eval_data_->ref_buffer_->get<int>(eval_data_->ref_target_address_name_).isNull(index));
-
-    return eval_data_->ref_buffer_->get<int>(eval_data_->ref_target_address_name_).get(index);
+    return ref_data_.target_addresses_[ref_data_.index(tod)];
 }
 
 std::pair<bool,bool> EvaluationTargetData::refGroundBitForTime (float tod) const // has gbs, gbs true
 {
-    if (!ref_data_.count(tod))
-        return {false, false};
+    int index = ref_data_.index(tod);
 
-    auto it_pair = ref_data_.equal_range(tod);
+    if (index == -1)
+        return {false, false};
 
-    assert (it_pair.first != ref_data_.end());
+    return refGroundBit(index);
+}
 
-    unsigned int index = it_pair.first->second;
+std::pair<bool,bool> EvaluationTargetData::refGroundBit (unsigned int ref_index) const // has gbs, gbs true
+{
+    unsigned int index = ref_data_.firstIndex(ref_index);
 
-    if (eval_data_->ref_ground_bit_name_.size()
-            && !eval_data_->ref_buffer_->get<string>(eval_data_->ref_ground_bit_name_).isNull(index))
-    {
-        return {true, eval_data_->ref_buffer_->get<string>(eval_data_->ref_ground_bit_name_).get(index) == "Y"};
-    }
-    else
-        return {false, false};
+    return {ref_data_.has_ground_bits_[index], ref_data_.ground_bits_[index]};
 }
 
 std::pair<bool,bool> EvaluationTargetData::interpolatedRefGroundBitForTime (float tod, float d_max) const
 // has gbs, gbs true
 {
-    assert (test_data_mappings_.count(tod));
+    return interpolatedRefGroundBit(tstIndexForTime(tod), d_max);
+}
 
+std::pair<bool,bool> EvaluationTargetData::interpolatedRefGroundBit (unsigned int tst_index, float d_max) const
+// has gbs, gbs true
+{
     bool has_gbs = false;
     bool gbs = false;
 
-    TstDataMapping& mapping = test_data_mappings_.at(tod);
+    const TstDataMapping& mapping = test_data_mappings_.at(tst_index);
+    float tod = mapping.tod_;
 
     if (!mapping.has_ref1_ && !mapping.has_ref2_) // no ref data
         return {has_gbs, gbs};
@@ -826,10 +878,10 @@ std::pair<bool,bool> EvaluationTargetData::interpolatedRefGroundBitForTime (floa
         if (mapping.tod_ref2_ - tod > d_max) // upper to far
             return {has_gbs, gbs};
 
-        tie (has_gbs, gbs) = refGroundBitForTime(mapping.tod_ref1_);
+        tie (has_gbs, gbs) = refGroundBit(mapping.ref1_index_);
 
         if (!gbs)
-            tie (has_gbs, gbs) = refGroundBitForTime(mapping.tod_ref2_);
+            tie (has_gbs, gbs) = refGroundBit(mapping.ref2_index_);
     }
 
     return {has_gbs, gbs};
@@ -837,302 +889,133 @@ std::pair<bool,bool> EvaluationTargetData::interpolatedRefGroundBitForTime (floa
 
 bool EvaluationTargetData::hasTstPosForTime (float tod) const
 {
-    return tst_data_.count(tod);
+    return tst_data_.index(tod) != -1;
 }
 
 EvaluationTargetPosition EvaluationTargetData::tstPosForTime (float tod) const
 {
-    assert (hasTstPosForTime(tod));
-
-    auto it_pair = tst_data_.equal_range(tod);
-
-    assert (it_pair.first != tst_data_.end());
-
-    unsigned int index = it_pair.first->second;
-
-    EvaluationTargetPosition pos;
-
-    NullableVector<double>& latitude_vec = eval_data_->tst_buffer_->get<double>(eval_data_->tst_latitude_name_);
-    NullableVector<double>& longitude_vec = eval_data_->tst_buffer_->get<double>(eval_data_->tst_longitude_name_);
-    NullableVector<int>& altitude_vec = eval_data_->tst_buffer_->get<int>(eval_data_->tst_modec_name_);
-
-    assert (!latitude_vec.isNull(index));
-    assert (!longitude_vec.isNull(index));
-
-    pos.latitude_ = latitude_vec.get(index);
-    pos.longitude_ = longitude_vec.get(index);
-
-    if (!altitude_vec.isNull(index))
-    {
-        pos.has_altitude_ = true;
-        pos.altitude_ = altitude_vec.get(index);
-        pos.altitude_calculated_ = false;
-    }
-    else // calculate
-    {
-        bool found;
-        float alt_calc;
-
-        tie(found,alt_calc) = estimateTstAltitude(tod, index);
-
-        if (found)
-        {
-            pos.has_altitude_ = true;
-            pos.altitude_calculated_ = true;
-            pos.altitude_ = alt_calc;
-        }
-    }
-
-    return pos;
+    return tstPos(tstIndexForTime(tod));
 }
 
-std::pair<bool, float> EvaluationTargetData::estimateTstAltitude (float tod, unsigned int index) const
+EvaluationTargetPosition EvaluationTargetData::tstPos (unsigned int tst_index) const
 {
-    NullableVector<int>& altitude_vec = eval_data_->tst_buffer_->get<int>(eval_data_->tst_modec_name_);
-    NullableVector<float>& tods = eval_data_->tst_buffer_->get<float>("tod");
+    unsigned int index = tst_data_.firstIndex(tst_index);
 
-    bool found_prev {false};
-    bool found_after {false};
-
-    // search for prev index
-    float tod_prev;
-    auto prev_it = find(tst_indexes_.begin(), tst_indexes_.end(), index);
-    assert (prev_it != tst_indexes_.end());
-
-    auto after_it = prev_it;
-
-    while (prev_it != tst_indexes_.end() && tod - tods.get(*prev_it) < 120.0)
-    {
-        if (!altitude_vec.isNull(*prev_it))
-        {
-            found_prev = true;
-            tod_prev = tods.get(*prev_it);
-
-            break;
-        }
-
-        if (prev_it == tst_indexes_.begin()) // undefined decrement
-            break;
-
-        --prev_it;
-    }
-
-    // search after index
-    float tod_after;
-
-    while (after_it != tst_indexes_.end() && tods.get(*after_it) - tod < 120.0)
-    {
-        if (!altitude_vec.isNull(*after_it))
-        {
-            found_after = true;
-            tod_after = tods.get(*after_it);
-
-            break;
-        }
-        ++after_it;
-    }
-
-    if (found_prev && found_after)
-    {
-        float alt_prev = altitude_vec.get(*prev_it);
-        float alt_after = altitude_vec.get(*after_it);
-
-        if (tod_after <= tod_prev || tod_prev >= tod)
-        {
-            logerr << "EvaluationTargetData::estimateRefAltitude tod_prev " << tod_prev << " tod "
-                   << tod << " tod_after " << tod_after;
-            return {false, 0}; // should never happen
-        }
-
-        float d_alt_ft = alt_after - alt_prev;
-        float d_t = tod_after - tod_prev;
-
-        float alt_spd_ft_s = d_alt_ft/d_t;
-
-        float d_t2 = tod - tod_prev;
-
-        float alt_calc = alt_prev + alt_spd_ft_s*d_t2;
-
-        return {true, alt_calc};
-    }
-    else if (found_prev && tod - tod_prev < 120.0)
-        return {true, altitude_vec.get(*prev_it)};
-    else if (found_after && tod_after - tod < 120.0)
-        return {true, altitude_vec.get(*after_it)};
-    else
-    {
-        return {false, 0}; // none found
-    }
+    return {tst_data_.latitudes_[index], tst_data_.longitudes_[index], tst_data_.has_altitudes_[index],
+            tst_data_.altitudes_calculated_[index], tst_data_.altitudes_[index]};
 }
 
-bool EvaluationTargetData::hasTstCallsignForTime (float tod) const
+std::pair<bool, float> EvaluationTargetData::estimateTstAltitude (unsigned int index) const
 {
-    if (!tst_data_.count(tod))
-        return false;
-
-    auto it_pair = tst_data_.equal_range(tod);
-
-    assert (it_pair.first != tst_data_.end());
-
-    unsigned int index = it_pair.first->second;
-
-    NullableVector<string>& callsign_vec = eval_data_->tst_buffer_->get<string>(eval_data_->tst_callsign_name_);
-    return !callsign_vec.isNull(index);
+    return estimateAltitude(tst_data_, index);
 }
 
-std::string EvaluationTargetData::tstCallsignForTime (float tod) const
+bool EvaluationTargetData::hasTstCallsignForTime (float tod) const
 {
-    assert (hasTstCallsignForTime(tod));
-
-    auto it_pair = tst_data_.equal_range(tod);
+    int index = tst_data_.index(tod);
 
-    assert (it_pair.first != tst_data_.end());
-
-    unsigned int index = it_pair.first->second;
-
-    NullableVector<string>& callsign_vec = eval_data_->tst_buffer_->get<string>(eval_data_->tst_callsign_name_);
-    assert (!callsign_vec.isNull(index));
-
-    return callsign_vec.get(index);
+    return index != -1 && hasTstCallsign(index);
 }
 
-bool EvaluationTargetData::hasTstModeAForTime (float tod) const
-{
-    if (!tst_data_.count(tod))
-        return false;
-
-    auto it_pair = tst_data_.equal_range(tod);
-
-    assert (it_pair.first != tst_data_.end());
-
-    unsigned int index = it_pair.first->second;
-
-    if (eval_data_->tst_buffer_->get<int>(eval_data_->tst_modea_name_).isNull(index))
-        return false;
-
-    if (eval_data_->tst_modea_v_name_.size()
-            && !eval_data_->tst_buffer_->get<string>(eval_data_->tst_modea_v_name_).isNull(index)
-            && eval_data_->tst_buffer_->get<string>(eval_data_->tst_modea_v_name_).get(index) == "N")
-        return false;
-
-    if (eval_data_->tst_modea_g_name_.size()
-            && !eval_data_->tst_buffer_->get<string>(eval_data_->tst_modea_g_name_).isNull(index)
-            && eval_data_->tst_buffer_->get<string>(eval_data_->tst_modea_g_name_).get(index) == "Y")
-        return false;
-
-    return true;
+std::string EvaluationTargetData::tstCallsignForTime (float tod) const
+{
+    return tstCallsign(tstIndexForTime(tod));
 }
 
-unsigned int EvaluationTargetData::tstModeAForTime (float tod) const
+bool EvaluationTargetData::hasTstCallsign (unsigned int tst_index) const
 {
-    assert (hasTstModeAForTime(tod));
-
-    auto it_pair = tst_data_.equal_range(tod);
+    return tst_data_.callsign_codes_[tst_data_.firstIndex(tst_index)] != -1;
+}
 
-    assert (it_pair.first != tst_data_.end());
+std::string EvaluationTargetData::tstCallsign (unsigned int tst_index) const
+{
+    assert (hasTstCallsign(tst_index));
 
-    unsigned int index = it_pair.first->second;
+    return tst_data_.callsigns_.at(tst_data_.callsign_codes_[tst_data_.firstIndex(tst_index)]);
+}
 
-    NullableVector<int>& modea_vec = eval_data_->tst_buffer_->get<int>(eval_data_->tst_modea_name_);
-    assert (!modea_vec.isNull(index));
+bool EvaluationTargetData::hasTstModeAForTime (float tod) const
+{
+    int index = tst_data_.index(tod);
 
-    return modea_vec.get(index);
+    return index != -1 && hasTstModeA(index);
 }
 
-bool EvaluationTargetData::hasTstModeCForTime (float tod) const
+bool EvaluationTargetData::hasTstModeA (unsigned int tst_index) const
 {
-    if (!tst_data_.count(tod))
-        return false;
-
-    auto it_pair = tst_data_.equal_range(tod);
+    return tst_data_.mode_a_valid_[tst_data_.firstIndex(tst_index)];
+}
 
-    assert (it_pair.first != tst_data_.end());
+unsigned int EvaluationTargetData::tstModeAForTime (float tod) const
+{
+    return tstModeA(tstIndexForTime(tod));
+}
 
-    unsigned int index = it_pair.first->second;
+unsigned int EvaluationTargetData::tstModeA (unsigned int tst_index) const
+{
+    assert (hasTstModeA(tst_index));
 
-    if (eval_data_->tst_buffer_->get<int>(eval_data_->tst_modec_name_).isNull(index))
-        return false;
+    return tst_data_.mode_a_codes_[tst_data_.firstIndex(tst_index)];
+}
 
-    if (eval_data_->tst_modec_v_name_.size()
-            && !eval_data_->tst_buffer_->get<string>(eval_data_->tst_modec_v_name_).isNull(index)
-            && eval_data_->tst_buffer_->get<string>(eval_data_->tst_modec_v_name_).get(index) == "N")
-        return false;
+bool EvaluationTargetData::hasTstModeCForTime (float tod) const
+{
+    int index = tst_data_.index(tod);
 
-    if (eval_data_->tst_modec_g_name_.size()
-            && !eval_data_->tst_buffer_->get<string>(eval_data_->tst_modec_g_name_).isNull(index)
-            && eval_data_->tst_buffer_->get<string>(eval_data_->tst_modec_g_name_).get(index) == "Y")
-        return false;
+    return index != -1 && hasTstModeC(index);
+}
 
-    return true;
+bool EvaluationTargetData::hasTstModeC (unsigned int tst_index) const
+{
+    return tst_data_.mode_c_valid_[tst_data_.firstIndex(tst_index)];
 }
 
 bool EvaluationTargetData::hasTstGroundBitForTime (float tod) const // only if set
 {
-    if (!tst_data_.count(tod))
-        return false;
-
-    auto it_pair = tst_data_.equal_range(tod);
-
-    assert (it_pair.first != tst_data_.end());
-
-    unsigned int index = it_pair.first->second;
+    int index = tst_data_.index(tod);
 
-    if (eval_data_->tst_ground_bit_name_.size()
-            && !eval_data_->tst_buffer_->get<string>(eval_data_->tst_ground_bit_name_).isNull(index))
-        return true;
-
-    return false;
+    return index != -1 && hasTstGroundBit(index);
 }
 
 bool EvaluationTargetData::tstGroundBitForTime (float tod) const // true is on ground
 {
-    assert (hasTstGroundBitForTime(tod));
-
-    auto it_pair = tst_data_.equal_range(tod);
-
-    assert (it_pair.first != tst_data_.end());
+    return tstGroundBit(tstIndexForTime(tod));
+}
 
-    unsigned int index = it_pair.first->second;
+bool EvaluationTargetData::hasTstGroundBit (unsigned int tst_index) const // only if set
+{
+    return tst_data_.has_ground_bits_[tst_data_.firstIndex(tst_index)];
+}
 
-    if (eval_data_->tst_ground_bit_name_.size()
-            && !eval_data_->tst_buffer_->get<string>(eval_data_->tst_ground_bit_name_).isNull(index)
-            && eval_data_->tst_buffer_->get<string>(eval_data_->tst_ground_bit_name_).get(index) == "Y")
-        return true;
+bool EvaluationTargetData::tstGroundBit (unsigned int tst_index) const // true is on ground
+{
+    assert (hasTstGroundBit(tst_index));
 
-    return false;
+    return tst_data_.ground_bits_[tst_data_.firstIndex(tst_index)];
 }
 
 bool EvaluationTargetData::hasTstTAForTime (float tod) const
 {
-    if (!tst_data_.count(tod))
-        return false;
+    int index = tst_data_.index(tod);
 
-    auto it_pair = tst_data_.equal_range(tod);
-
-    assert (it_pair.first != tst_data_.end());
-
-    unsigned int index = it_pair.first->second;
-
-    if (eval_data_->tst_target_address_name_.size()
-            && !eval_data_->tst_buffer_->get<int>(eval_data_->tst_target_address_name_).isNull(index))
-        return true;
-
-    return false;
+    return index != -1 && hasTstTA(index);
 }
 
 unsigned int EvaluationTargetData::tstTAForTime (float tod) const
 {
-    assert (hasTstTAForTime(tod));
-
-    auto it_pair = tst_data_.equal_range(tod);
-
-    assert (it_pair.first != tst_data_.end());
+    return tstTA(tstIndexForTime(tod));
+}
 
-    unsigned int index = it_pair.first->second;
+bool EvaluationTargetData::hasTstTA (unsigned int tst_index) const
+{
+    return tst_data_.has_target_addresses_[tst_data_.firstIndex(tst_index)];
+}
 
-    assert (!eval_data_->tst_buffer_->get<int>(eval_data_->tst_target_address_name_).isNull(index));
+unsigned int EvaluationTargetData::tstTA (unsigned int tst_index) const
+{
+    assert (hasTstTA(tst_index));
 
-    return eval_data_->tst_buffer_->get<int>(eval_data_->tst_target_address_name_).get(index);
+    return tst_data_.target_addresses_[tst_data_.firstIndex(tst_index)];
 }
 
  // has gbs, gbs true
@@ -1154,43 +1037,46 @@ pair<bool,bool> EvaluationTargetData::tstGroundBitForTimeInterpolated (float tod
 }
 
 bool EvaluationTargetData::hasTstTrackNumForTime (float tod) const
+{
+    return hasTstTrackNum(tstIndexForTime(tod));
+}
+
+bool EvaluationTargetData::hasTstTrackNum (unsigned int tst_index) const
 {
     if (!eval_data_->tst_track_num_name_.size())
         return false;
 
-    auto it_pair = tst_data_.equal_range(tod);
-
-    assert (it_pair.first != tst_data_.end());
-
-    unsigned int index = it_pair.first->second;
+    unsigned int index = tst_data_.indexes_[tst_data_.firstIndex(tst_index)];
 
     return !eval_data_->tst_buffer_->get<int>(eval_data_->tst_track_num_name_).isNull(index);
 }
 
 unsigned int EvaluationTargetData::tstTrackNumForTime (float tod) const
 {
-    assert (hasTstTrackNumForTime(tod));
-
-    auto it_pair = tst_data_.equal_range(tod);
+    return tstTrackNum(tstIndexForTime(tod));
+}
 
-    assert (it_pair.first != tst_data_.end());
+unsigned int EvaluationTargetData::tstTrackNum (unsigned int tst_index) const
+{
+    assert (hasTstTrackNum(tst_index));
 
-    unsigned int index = it_pair.first->second;
+    unsigned int index = tst_data_.indexes_[tst_data_.firstIndex(tst_index)];
 
     return eval_data_->tst_buffer_->get<int>(eval_data_->tst_track_num_name_).get(index);
 }
 
 bool EvaluationTargetData::hasTstMeasuredSpeedForTime (float tod) const
+{
+    return hasTstMeasuredSpeed(tstIndexForTime(tod));
+}
+
+bool EvaluationTargetData::hasTstMeasuredSpeed (unsigned int tst_index) const
 {
     if (!eval_data_->tst_spd_ground_speed_kts_name_.size()
             && (!eval_data_->tst_spd_x_ms_name_.size() || !eval_data_->tst_spd_y_ms_name_.size()))
         return false;
 
-    auto it_pair = tst_data_.equal_range(tod);
-
-    assert (it_pair.first != tst_data_.end());
-
-    unsigned int index = it_pair.first->second;
+    unsigned int index = tst_data_.indexes_[tst_data_.firstIndex(tst_index)];
 
     if (eval_data_->tst_spd_ground_speed_kts_name_.size())
         return !eval_data_->tst_buffer_->get<double>(eval_data_->tst_spd_ground_speed_kts_name_).isNull(index);
@@ -1201,13 +1087,14 @@ bool EvaluationTargetData::hasTstMeasuredSpeedForTime (float tod) const
 
 float EvaluationTargetData::tstMeasuredSpeedForTime (float tod) const // m/s
 {
-    assert (hasTstMeasuredSpeedForTime(tod));
-
-    auto it_pair = tst_data_.equal_range(tod);
+    return tstMeasuredSpeed(tstIndexForTime(tod));
+}
 
-    assert (it_pair.first != tst_data_.end());
+float EvaluationTargetData::tstMeasuredSpeed (unsigned int tst_index) const // m/s
+{
+    assert (hasTstMeasuredSpeed(tst_index));
 
-    unsigned int index = it_pair.first->second;
+    unsigned int index = tst_data_.indexes_[tst_data_.firstIndex(tst_index)];
 
     if (eval_data_->tst_spd_ground_speed_kts_name_.size())
     {
@@ -1228,11 +1115,10 @@ bool EvaluationTargetData::hasTstMeasuredTrackAngleForTime (float tod) const
             && (!eval_data_->tst_spd_x_ms_name_.size() || !eval_data_->tst_spd_y_ms_name_.size()))
         return false;
 
-    auto it_pair = tst_data_.equal_range(tod);
+    int update_index = tst_data_.index(tod);
+    assert (update_index != -1);
 
-    assert (it_pair.first != tst_data_.end());
-
-    unsigned int index = it_pair.first->second;
+    unsigned int index = tst_data_.indexes_[update_index];
 
     if (eval_data_->tst_spd_track_angle_deg_name_.size())
         return !eval_data_->tst_buffer_->get<double>(eval_data_->tst_spd_track_angle_deg_name_).isNull(index);
@@ -1245,11 +1131,10 @@ float EvaluationTargetData::tstMeasuredTrackAngleForTime (float tod) const // de
 {
     assert (hasTstMeasuredTrackAngleForTime(tod));
 
-    auto it_pair = tst_data_.equal_range(tod);
-
-    assert (it_pair.first != tst_data_.end());
+    int update_index = tst_data_.index(tod);
+    assert (update_index != -1);
 
-    unsigned int index = it_pair.first->second;
+    unsigned int index = tst_data_.indexes_[update_index];
 
     if (eval_data_->tst_spd_track_angle_deg_name_.size())
     {
@@ -1266,18 +1151,14 @@ float EvaluationTargetData::tstMeasuredTrackAngleForTime (float tod) const // de
 
 int EvaluationTargetData::tstModeCForTime (float tod) const
 {
-    assert (hasTstModeCForTime(tod));
-
-    auto it_pair = tst_data_.equal_range(tod);
-
-    assert (it_pair.first != tst_data_.end());
-
-    int index = it_pair.first->second;
+    return tstModeC(tstIndexForTime(tod));
+}
 
-    NullableVector<int>& modec_vec = eval_data_->tst_buffer_->get<int>(eval_data_->tst_modec_name_);
-    assert (!modec_vec.isNull(index));
+int EvaluationTargetData::tstModeC (unsigned int tst_index) const
+{
+    assert (hasTstModeC(tst_index));
 
-    return modec_vec.get(index);
+    return tst_data_.mode_c_codes_[tst_data_.firstIndex(tst_index)];
 }
 
 double EvaluationTargetData::latitudeMin() const
@@ -1362,6 +1243,236 @@ std::string EvaluationTargetData::nacpStr() const
         return "";
 }
 
+void EvaluationTargetData::computeSectorInsideFlags (
+        const std::vector<std::shared_ptr<SectorLayer>>& sector_layers) const
+{
+    sector_inside_flags_.clear();
+
+    // bounding box of all positions checked below, polygons are only checked for sectors it crosses
+    bool has_box = false;
+    double lat_min {0}, lat_max {0}, lon_min {0}, lon_max {0};
+
+    // altitude range, only usable if all positions have an altitude
+    bool all_altitudes = true;
+    double alt_min {0}, alt_max {0};
+
+    auto add_to_box = [&](double latitude, double longitude, bool has_altitude, double altitude)
+    {
+        if (!has_box)
+        {
+            lat_min = lat_max = latitude;
+            lon_min = lon_max = longitude;
+            alt_min = alt_max = altitude;
+            has_box = true;
+        }
+        else
+        {
+            lat_min = min(lat_min, latitude);
+            lat_max = max(lat_max, latitude);
+            lon_min = min(lon_min, longitude);
+            lon_max = max(lon_max, longitude);
+            alt_min = min(alt_min, altitude);
+            alt_max = max(alt_max, altitude);
+        }
+
+        all_altitudes = all_altitudes && has_altitude;
+    };
+
+    for (unsigned int ref_cnt=0; ref_cnt < ref_data_.size(); ++ref_cnt)
+        add_to_box(ref_data_.latitudes_[ref_cnt], ref_data_.longitudes_[ref_cnt],
+                   ref_data_.has_altitudes_[ref_cnt], ref_data_.altitudes_[ref_cnt]);
+
+    for (unsigned int tst_cnt=0; tst_cnt < tst_data_.size(); ++tst_cnt)
+    {
+        add_to_box(tst_data_.latitudes_[tst_cnt], tst_data_.longitudes_[tst_cnt],
+                   tst_data_.has_altitudes_[tst_cnt], tst_data_.altitudes_[tst_cnt]);
+
+        if (test_data_mappings_[tst_cnt].has_ref_pos_)
+        {
+            const EvaluationTargetPosition& pos_ref = test_data_mappings_[tst_cnt].pos_ref_;
+            add_to_box(pos_ref.latitude_, pos_ref.longitude_, pos_ref.has_altitude_, pos_ref.altitude_);
+        }
+    }
+
+    std::vector<SectorPolygon::BoxContainment> box_containment;
+
+    // positions to check are the ones of the first update of each time, as returned by the accessors
+    std::vector<double> latitudes, longitudes;
+    std::vector<int> position_indexes; // per update, index into positions, -1 if no position
+    std::vector<bool> polygon_flags; // per position and sector
+
+    auto add_position = [&](bool same_tod, bool has_pos, double latitude, double longitude)
+    {
+        if (same_tod) // same position as previous update
+            position_indexes.push_back(position_indexes.back());
+        else if (has_pos)
+        {
+            position_indexes.push_back(latitudes.size());
+            latitudes.push_back(latitude);
+            longitudes.push_back(longitude);
+        }
+        else
+            position_indexes.push_back(-1);
+    };
+
+    // checks added positions in one batch, appends flags per update
+    auto add_flags = [&](const SectorLayer& layer, std::vector<bool>& flags)
+    {
+        unsigned int num_sectors = layer.size();
+
+        polygon_flags.clear();
+        layer.polygonInsideFlags(latitudes, longitudes, box_containment, polygon_flags);
+
+        flags.reserve(position_indexes.size() * num_sectors);
+
+        for (int index : position_indexes)
+        {
+            if (index < 0)
+                flags.insert(flags.end(), num_sectors, false);
+            else
+                flags.insert(flags.end(), polygon_flags.begin() + index * num_sectors,
+                             polygon_flags.begin() + (index + 1) * num_sectors);
+        }
+
+        latitudes.clear();
+        longitudes.clear();
+        position_indexes.clear();
+    };
+
+    bool same_tod;
+
+    for (auto& sec_it : sector_layers)
+    {
+        const SectorLayer& layer = *sec_it;
+        SectorInsideFlags& inside_flags = sector_inside_flags_[&layer];
+
+        inside_flags.num_sectors_ = layer.size();
+
+        // sectors outside in altitude give the same isInside result as outside polygons
+        if (has_box && all_altitudes)
+            box_containment = layer.boxContainment(lat_min, lat_max, lon_min, lon_max, alt_min, alt_max);
+        else if (has_box)
+            box_containment = layer.boxContainment(lat_min, lat_max, lon_min, lon_max);
+        else
+            box_containment.assign(layer.size(), SectorPolygon::BoxContainment::Outside);
+
+        inside_flags.outside_ = all_of(box_containment.begin(), box_containment.end(),
+                                       [](SectorPolygon::BoxContainment containment) {
+            return containment == SectorPolygon::BoxContainment::Outside; });
+
+        if (inside_flags.outside_)
+            continue;
+
+        inside_flags.constant_ = none_of(box_containment.begin(), box_containment.end(),
+                                         [](SectorPolygon::BoxContainment containment) {
+            return containment == SectorPolygon::BoxContainment::Mixed; });
+
+        if (inside_flags.constant_)
+        {
+            for (auto containment : box_containment)
+                inside_flags.ref_.push_back(containment == SectorPolygon::BoxContainment::Inside);
+
+            inside_flags.ref_interpolated_ = inside_flags.ref_;
+            inside_flags.tst_ = inside_flags.ref_;
+            continue;
+        }
+
+        for (unsigned int ref_cnt=0; ref_cnt < ref_data_.size(); ++ref_cnt)
+        {
+            same_tod = ref_cnt && ref_data_.tods_[ref_cnt] == ref_data_.tods_[ref_cnt-1];
+
+            add_position(same_tod, true, ref_data_.latitudes_[ref_cnt], ref_data_.longitudes_[ref_cnt]);
+        }
+
+        add_flags(layer, inside_flags.ref_);
+
+        for (unsigned int tst_cnt=0; tst_cnt < tst_data_.size(); ++tst_cnt)
+        {
+            same_tod = tst_cnt && tst_data_.tods_[tst_cnt] == tst_data_.tods_[tst_cnt-1];
+
+            const TstDataMapping& mapping = test_data_mappings_[tst_cnt];
+
+            add_position(same_tod, mapping.has_ref_pos_, mapping.pos_ref_.latitude_, mapping.pos_ref_.longitude_);
+        }
+
+        add_flags(layer, inside_flags.ref_interpolated_);
+
+        for (unsigned int tst_cnt=0; tst_cnt < tst_data_.size(); ++tst_cnt)
+        {
+            same_tod = tst_cnt && tst_data_.tods_[tst_cnt] == tst_data_.tods_[tst_cnt-1];
+
+            add_position(same_tod, true, tst_data_.latitudes_[tst_cnt], tst_data_.longitudes_[tst_cnt]);
+        }
+
+        add_flags(layer, inside_flags.tst_);
+    }
+}
+
+void EvaluationTargetData::clearSectorInsideFlags () const
+{
+    sector_inside_flags_.clear();
+}
+
+const SectorInsideFlags* EvaluationTargetData::sectorInsideFlags (const SectorLayer& sector_layer) const
+{
+    auto it = sector_inside_flags_.find(&sector_layer);
+
+    if (it == sector_inside_flags_.end())
+        return nullptr;
+
+    return &it->second;
+}
+
+bool EvaluationTargetData::isOutside (const SectorLayer& sector_layer) const
+{
+    const SectorInsideFlags* inside_flags = sectorInsideFlags(sector_layer);
+
+    return inside_flags && inside_flags->outside_;
+}
+
+bool EvaluationTargetData::isRefPosInside (
+        const SectorLayer& sector_layer, unsigned int ref_index,
+        const EvaluationTargetPosition& pos, bool has_ground_bit, bool ground_bit_set) const
+{
+    assert (ref_index < ref_data_.size());
+
+    return isPosInside(sector_layer, &SectorInsideFlags::ref_, ref_index, pos, has_ground_bit, ground_bit_set);
+}
+
+bool EvaluationTargetData::isInterpolatedRefPosInside (
+        const SectorLayer& sector_layer, unsigned int tst_index,
+        const EvaluationTargetPosition& pos, bool has_ground_bit, bool ground_bit_set) const
+{
+    assert (tst_index < tst_data_.size());
+
+    return isPosInside(sector_layer, &SectorInsideFlags::ref_interpolated_, tst_index, pos,
+                       has_ground_bit, ground_bit_set);
+}
+
+bool EvaluationTargetData::isTstPosInside (
+        const SectorLayer& sector_layer, unsigned int tst_index,
+        const EvaluationTargetPosition& pos, bool has_ground_bit, bool ground_bit_set) const
+{
+    assert (tst_index < tst_data_.size());
+
+    return isPosInside(sector_layer, &SectorInsideFlags::tst_, tst_index, pos, has_ground_bit, ground_bit_set);
+}
+
+bool EvaluationTargetData::isPosInside (
+        const SectorLayer& sector_layer, std::vector<bool> SectorInsideFlags::* flags, unsigned int index,
+        const EvaluationTargetPosition& pos, bool has_ground_bit, bool ground_bit_set) const
+{
+    auto it = sector_inside_flags_.find(&sector_layer);
+
+    if (it == sector_inside_flags_.end())
+        return sector_layer.isInside(pos, has_ground_bit, ground_bit_set);
+
+    if (it->second.outside_) // no polygon tests
+        return false;
+
+    return sector_layer.isInside(pos, has_ground_bit, ground_bit_set, it->second.*flags, it->second.offset(index));
+}
+
 bool EvaluationTargetData::hasNucpNic() const
 {
     return has_nucp_nic_;
@@ -1442,7 +1553,7 @@ void EvaluationTargetData::updateCallsigns() const
     if (ref_data_.size())
     {
         NullableVector<string>& value_vec = eval_data_->ref_buffer_->get<string>(eval_data_->ref_callsign_name_);
-        map<string, vector<unsigned int>> distinct_values = value_vec.distinctValuesWithIndexes(ref_indexes_);
+        map<string, vector<unsigned int>> distinct_values = value_vec.distinctValuesWithIndexes(ref_data_.indexes_);
 
         for (auto& val_it : distinct_values)
         {
@@ -1454,7 +1565,7 @@ void EvaluationTargetData::updateCallsigns() const
     if (tst_data_.size())
     {
         NullableVector<string>& value_vec = eval_data_->tst_buffer_->get<string>(eval_data_->tst_callsign_name_);
-        map<string, vector<unsigned int>> distinct_values = value_vec.distinctValuesWithIndexes(tst_indexes_);
+        map<string, vector<unsigned int>> distinct_values = value_vec.distinctValuesWithIndexes(tst_data_.indexes_);
 
         for (auto& val_it : distinct_values)
         {
@@ -1471,7 +1582,7 @@ void EvaluationTargetData::updateTargetAddresses() const
     if (ref_data_.size())
     {
         NullableVector<int>& value_vec = eval_data_->ref_buffer_->get<int>(eval_data_->ref_target_address_name_);
-        map<int, vector<unsigned int>> distinct_values = value_vec.distinctValuesWithIndexes(ref_indexes_);
+        map<int, vector<unsigned int>> distinct_values = value_vec.distinctValuesWithIndexes(ref_data_.indexes_);
 
         for (auto& val_it : distinct_values)
         {
@@ -1483,7 +1594,7 @@ void EvaluationTargetData::updateTargetAddresses() const
     if (tst_data_.size())
     {
         NullableVector<int>& value_vec = eval_data_->tst_buffer_->get<int>(eval_data_->tst_target_address_name_);
-        map<int, vector<unsigned int>> distinct_values = value_vec.distinctValuesWithIndexes(tst_indexes_);
+        map<int, vector<unsigned int>> distinct_values = value_vec.distinctValuesWithIndexes(tst_data_.indexes_);
 
         for (auto& val_it : distinct_values)
         {
@@ -1502,7 +1613,7 @@ void EvaluationTargetData::updateModeACodes() const
     if (ref_data_.size())
     {
         NullableVector<int>& mode_a_codes = eval_data_->ref_buffer_->get<int>(eval_data_->ref_modea_name_);
-        map<int, vector<unsigned int>> distinct_codes = mode_a_codes.distinctValuesWithIndexes(ref_indexes_);
+        map<int, vector<unsigned int>> distinct_codes = mode_a_codes.distinctValuesWithIndexes(ref_data_.indexes_);
         //unsigned int null_cnt = mode_a_codes.nullValueIndexes(ref_rec_nums_).size();
 
         for (auto& ma_it : distinct_codes)
@@ -1519,7 +1630,7 @@ void EvaluationTargetData::updateModeACodes() const
     if (tst_data_.size())
     {
         NullableVector<int>& mode_a_codes = eval_data_->tst_buffer_->get<int>(eval_data_->tst_modea_name_);
-        map<int, vector<unsigned int>> distinct_codes = mode_a_codes.distinctValuesWithIndexes(tst_indexes_);
+        map<int, vector<unsigned int>> distinct_codes = mode_a_codes.distinctValuesWithIndexes(tst_data_.indexes_);
 
         for (auto& ma_it : distinct_codes)
         {
@@ -1548,7 +1659,7 @@ void EvaluationTargetData::updateModeCMinMax() const
         assert (eval_data_->ref_buffer_->has<int>(eval_data_->ref_modec_name_));
         NullableVector<int>& modec_codes_ft = eval_data_->ref_buffer_->get<int>(eval_data_->ref_modec_name_);
 
-        for (auto ind_it : ref_indexes_)
+        for (auto ind_it : ref_data_.indexes_)
         {
             if (!modec_codes_ft.isNull(ind_it))
             {
@@ -1574,7 +1685,7 @@ void EvaluationTargetData::updateModeCMinMax() const
         assert (eval_data_->tst_buffer_->has<int>(eval_data_->tst_modec_name_));
         NullableVector<int>& modec_codes_ft = eval_data_->tst_buffer_->get<int>(eval_data_->tst_modec_name_);
 
-        for (auto ind_it : tst_indexes_)
+        for (auto ind_it : tst_data_.indexes_)
         {
             if (!modec_codes_ft.isNull(ind_it))
             {
@@ -1608,7 +1719,7 @@ void EvaluationTargetData::updatePositionMinMax() const
         NullableVector<double>& lats = eval_data_->ref_buffer_->get<double>(eval_data_->ref_latitude_name_);
         NullableVector<double>& longs = eval_data_->ref_buffer_->get<double>(eval_data_->ref_longitude_name_);
 
-        for (auto ind_it : ref_indexes_)
+        for (auto ind_it : ref_data_.indexes_)
         {
             assert (!lats.isNull(ind_it));
             assert (!longs.isNull(ind_it));
@@ -1639,7 +1750,7 @@ void EvaluationTargetData::updatePositionMinMax() const
         NullableVector<double>& lats = eval_data_->tst_buffer_->get<double>(eval_data_->tst_latitude_name_);
         NullableVector<double>& longs = eval_data_->tst_buffer_->get<double>(eval_data_->tst_longitude_name_);
 
-        for (auto ind_it : tst_indexes_)
+        for (auto ind_it : tst_data_.indexes_)
         {
             assert (!lats.isNull(ind_it));
             assert (!longs.isNull(ind_it));
@@ -1684,7 +1795,7 @@ void EvaluationTargetData::updatePositionMinMax() const
 //        NullableVector<char>& nucp_nics = ref_buffer_->get<char>(nucp_nic_name);
 //        NullableVector<char>& sils = ref_buffer_->get<char>(sil_name);
 
-//        for (auto ind_it : ref_indexes_)
+//        for (auto ind_it : ref_data_.indexes_)
 //        {
 //            if (!mops.isNull(ind_it) && mops_versions_.count(mops.get(ind_it)))
 //            {
@@ -1724,7 +1835,7 @@ void EvaluationTargetData::updatePositionMinMax() const
 //        NullableVector<char>& nucp_nics = tst_buffer_->get<char>(nucp_nic_name);
 //        NullableVector<char>& sils = tst_buffer_->get<char>(sil_name);
 
-//        for (auto ind_it : tst_indexes_)
+//        for (auto ind_it : tst_data_.indexes_)
 //        {
 //            if (!mops.isNull(ind_it) && mops_versions_.count(mops.get(ind_it)))
 //            {
@@ -1755,101 +1866,104 @@ void EvaluationTargetData::updatePositionMinMax() const
 
 void EvaluationTargetData::calculateTestDataMappings() const
 {
-    loginf << "EvaluationTargetData: calculateTestDataMappings: utn " << utn_;
+    logdbg << "EvaluationTargetData: calculateTestDataMappings: utn " << utn_;
 
     assert (!test_data_mappings_.size());
 
-    for (auto& tst_it : tst_data_)
-    {
-        test_data_mappings_[tst_it.first] = calculateTestDataMapping(tst_it.first);
-    }
-
-    unsigned int cnt=0;
-
-    for (auto& tst_map_it : test_data_mappings_)
-    {
-        if (tst_map_it.second.has_ref_pos_)
-            ++cnt;
-    }
-
-    loginf << "EvaluationTargetData: calculateTestDataMappings: utn " << utn_ << " done, num map "
-           << test_data_mappings_.size() << " ref pos " << cnt;
-}
+    unsigned int tst_size = tst_data_.size();
+    unsigned int ref_size = ref_data_.size();
 
-TstDataMapping EvaluationTargetData::calculateTestDataMapping(float tod) const
-{
-    TstDataMapping ret;
-
-    ret.tod_ = tod;
+    test_data_mappings_.resize(tst_size);
 
-    //    Return iterator to lower bound
-    //    Returns an iterator pointing to the first element in the container whose key is not considered to go
-    //    before k (i.e., either it is equivalent or goes after).
+    // both sorted by time, so walked once in parallel
+    unsigned int ref_cnt = 0; // first ref update with tod >= tst tod
+    unsigned int ref1_index = 0; // first ref update with tod of ref update before ref_cnt
 
-    auto lb_it = ref_data_.lower_bound(tod);
+    // tst updates with same ref updates, interpolated together
+    unsigned int tst_begin = 0;
+    unsigned int interval_ref_cnt = 0;
+    unsigned int interval_ref1_index = 0;
 
-    auto ub_it = ref_data_.upper_bound(tod);
+    float tod;
 
-    if (lb_it != ref_data_.end()) // upper tod found
+    for (unsigned int tst_cnt=0; tst_cnt < tst_size; ++tst_cnt)
     {
-        assert (lb_it->first >= tod);
+        tod = tst_data_.tods_[tst_cnt];
 
-        // save upper value
-        ret.has_ref2_ = true;
-        ret.tod_ref2_ = lb_it->first;
-
-        // search lower values by decrementing iterator
-        while (lb_it != ref_data_.end() && (tod < lb_it->first || lb_it->first == ret.tod_ref2_))
+        while (ref_cnt < ref_size && ref_data_.tods_[ref_cnt] < tod)
         {
-            if (lb_it == ref_data_.begin()) // exit condition on first value
-            {
-                if (tod < lb_it->first) // set as not found
-                    lb_it = ref_data_.end();
+            if (!ref_cnt || ref_data_.tods_[ref_cnt] != ref_data_.tods_[ref_cnt-1])
+                ref1_index = ref_cnt;
 
-                break;
-            }
-
-            lb_it--;
+            ++ref_cnt;
         }
 
-        if (lb_it != ref_data_.end() && lb_it->first != ret.tod_ref2_) // lower tod found
+        if (ref_cnt != interval_ref_cnt)
         {
-            assert (tod >= lb_it->first);
+            if (interval_ref_cnt && interval_ref_cnt < ref_size) // previous interval had upper and lower ref
+                addRefPositionsToMappings(tst_begin, tst_cnt, interval_ref1_index, interval_ref_cnt);
 
-            // add lower value
-            ret.has_ref1_ = true;
-            ret.tod_ref1_ = lb_it->first;
+            tst_begin = tst_cnt;
+            interval_ref_cnt = ref_cnt;
+            interval_ref1_index = ref1_index;
         }
-        else // not found, clear previous
+
+        TstDataMapping& mapping = test_data_mappings_[tst_cnt];
+
+        mapping.tod_ = tod;
+
+        if (ref_cnt && ref_cnt < ref_size) // upper and lower tod found
         {
-            ret.has_ref2_ = false;
-            ret.tod_ref2_ = 0.0;
+            assert (ref_data_.tods_[ref_cnt] >= tod);
+            assert (ref_data_.tods_[ref_cnt-1] < tod);
+
+            mapping.has_ref1_ = true;
+            mapping.tod_ref1_ = ref_data_.tods_[ref_cnt-1];
+            mapping.ref1_index_ = ref1_index;
+
+            mapping.has_ref2_ = true;
+            mapping.tod_ref2_ = ref_data_.tods_[ref_cnt];
+            mapping.ref2_index_ = ref_cnt;
         }
     }
 
-    addRefPositiosToMapping(ret);
+    if (interval_ref_cnt && interval_ref_cnt < ref_size)
+        addRefPositionsToMappings(tst_begin, tst_size, interval_ref1_index, interval_ref_cnt);
 
-    return ret;
+    logdbg << "EvaluationTargetData: calculateTestDataMappings: utn " << utn_ << " done, num map "
+           << test_data_mappings_.size() << " ref pos "
+           << count_if(test_data_mappings_.begin(), test_data_mappings_.end(),
+                       [](const TstDataMapping& mapping) { return mapping.has_ref_pos_; });
 }
 
-void EvaluationTargetData::addRefPositiosToMapping (TstDataMapping& mapping) const
+void EvaluationTargetData::addRefPositionsToMappings (unsigned int tst_begin, unsigned int tst_end,
+                                                      unsigned int ref1_index, unsigned int ref2_index) const
 {
-    if (mapping.has_ref1_  && hasRefPosForTime(mapping.tod_ref1_)
-            && mapping.has_ref2_ && hasRefPosForTime(mapping.tod_ref2_)) // two positions which can be interpolated
-    {
-        float lower = mapping.tod_ref1_;
-        float upper = mapping.tod_ref2_;
+    assert (tst_begin < tst_end);
+    assert (ref1_index < ref2_index);
 
-        EvaluationTargetPosition pos1 = refPosForTime(lower);
-        EvaluationTargetPosition pos2 = refPosForTime(upper);
-        float d_t = upper - lower;
+    float lower = ref_data_.tods_[ref1_index];
+    float upper = ref_data_.tods_[ref2_index];
 
-        logdbg << "EvaluationTargetData: addRefPositiosToMapping: d_t " << d_t;
+    EvaluationTargetPosition pos1 {ref_data_.latitudes_[ref1_index], ref_data_.longitudes_[ref1_index],
+                ref_data_.has_altitudes_[ref1_index], ref_data_.altitudes_calculated_[ref1_index],
+                ref_data_.altitudes_[ref1_index]};
+    EvaluationTargetPosition pos2 {ref_data_.latitudes_[ref2_index], ref_data_.longitudes_[ref2_index],
+                ref_data_.has_altitudes_[ref2_index], ref_data_.altitudes_calculated_[ref2_index],
+                ref_data_.altitudes_[ref2_index]};
 
-        assert (d_t > 0);
+    float d_t = upper - lower;
 
-        if (pos1.latitude_ == pos2.latitude_ && pos1.longitude_ == pos2.longitude_) // same pos
+    logdbg << "EvaluationTargetData: addRefPositionsToMappings: d_t " << d_t << " num " << tst_end - tst_begin;
+
+    assert (d_t > 0);
+
+    if (pos1.latitude_ == pos2.latitude_ && pos1.longitude_ == pos2.longitude_) // same pos
+    {
+        for (unsigned int tst_cnt=tst_begin; tst_cnt < tst_end; ++tst_cnt)
         {
+            TstDataMapping& mapping = test_data_mappings_[tst_cnt];
+
             mapping.has_ref_pos_ = true;
             mapping.pos_ref_ = pos1;
 
@@ -1858,127 +1972,95 @@ void EvaluationTargetData::addRefPositiosToMapping (TstDataMapping& mapping) con
             mapping.posbased_spd_ref_.track_angle_ = NAN;
             mapping.posbased_spd_ref_.speed_ = NAN;
         }
-        else
-        {
 
-            if (lower == upper) // same time
-            {
-                logwrn << "EvaluationTargetData: addRefPositiosToMapping: ref has same time twice";
-            }
-            else
-            {
-//                local_->SetStereographic(pos1.latitude_, pos1.longitude_, 1.0, 0.0, 0.0);
-
-//                unique_ptr<OGRCoordinateTransformation> ogr_geo2cart {
-//                    OGRCreateCoordinateTransformation(wgs84_.get(), local_.get())};
-//                assert (ogr_geo2cart);
-//                unique_ptr<OGRCoordinateTransformation> ogr_cart2geo{
-//                    OGRCreateCoordinateTransformation(local_.get(), wgs84_.get())};
-//                assert (ogr_cart2geo);
-
-                logdbg << "EvaluationTargetData: addRefPositiosToMapping: pos1 "
-                       << pos1.latitude_ << ", " << pos1.longitude_;
-                logdbg << "EvaluationTargetData: addRefPositiosToMapping: pos2 "
-                       << pos2.latitude_ << ", " << pos2.longitude_;
-
-                bool ok;
-                double x_pos, y_pos;
-
-//                if (in_appimage_) // inside appimage
-//                {
-//                    x_pos = pos2.longitude_;
-//                    y_pos = pos2.latitude_;
-//                }
-//                else
-//                {
-//                    x_pos = pos2.latitude_;
-//                    y_pos = pos2.longitude_;
-//                }
-
-                tie(ok, x_pos, y_pos) = trafo_.distanceCart(
-                            pos1.latitude_, pos1.longitude_, pos2.latitude_, pos2.longitude_);
-
-//                logdbg << "EvaluationTargetData: addRefPositiosToMapping: geo2cart";
-//                bool ret = ogr_geo2cart->Transform(1, &x_pos, &y_pos); // wgs84 to cartesian offsets
-                if (!ok)
-                {
-                    logerr << "EvaluationTargetData: addRefPositiosToMapping: error with latitude " << pos2.latitude_
-                           << " longitude " << pos2.longitude_;
-                }
-                else
-                {
+        return;
+    }
 
-                    logdbg << "EvaluationTargetData: addRefPositiosToMapping: offsets x " << fixed << x_pos
-                           << " y " << fixed << y_pos << " dist " << fixed << sqrt(pow(x_pos,2)+pow(y_pos,2));
+    bool ok;
+    double x_pos, y_pos;
 
-                    double v_x = x_pos/d_t;
-                    double v_y = y_pos/d_t;
-                    logdbg << "EvaluationTargetData: addRefPositiosToMapping: v_x " << v_x << " v_y " << v_y;
+    tie(ok, x_pos, y_pos) = trafo_.distanceCart(
+                pos1.latitude_, pos1.longitude_, pos2.latitude_, pos2.longitude_);
 
-                    float d_t2 = mapping.tod_ - lower;
-                    logdbg << "EvaluationTargetData: addRefPositiosToMapping: d_t2 " << d_t2;
+    if (!ok)
+    {
+        logerr << "EvaluationTargetData: addRefPositionsToMappings: error with latitude " << pos2.latitude_
+               << " longitude " << pos2.longitude_;
+        return;
+    }
+
+    double v_x = x_pos/d_t;
+    double v_y = y_pos/d_t;
+
+    logdbg << "EvaluationTargetData: addRefPositionsToMappings: v_x " << v_x << " v_y " << v_y;
 
-                    assert (d_t2 >= 0);
+    unsigned int num = tst_end - tst_begin;
+    float d_t2;
 
-                    x_pos = v_x * d_t2;
-                    y_pos = v_y * d_t2;
+    // interpolated offsets of all tst updates, transformed in one batch
+    vector<double> x_positions (num);
+    vector<double> y_positions (num);
 
-                    logdbg << "EvaluationTargetData: addRefPositiosToMapping: interpolated offsets x "
-                           << x_pos << " y " << y_pos;
+    for (unsigned int cnt=0; cnt < num; ++cnt)
+    {
+        d_t2 = test_data_mappings_[tst_begin+cnt].tod_ - lower;
+        assert (d_t2 >= 0);
 
-                    //ret = ogr_cart2geo->Transform(1, &x_pos, &y_pos);
+        x_positions[cnt] = v_x * d_t2;
+        y_positions[cnt] = v_y * d_t2;
+    }
 
-                    tie (ok, x_pos, y_pos) = trafo_.wgsAddCartOffset(pos1.latitude_, pos1.longitude_, x_pos, y_pos);
+    if (!trafo_.wgsAddCartOffsets(pos1.latitude_, pos1.longitude_, x_positions, y_positions))
+    {
+        // single transformations, failed ones are kept as before
+        for (unsigned int cnt=0; cnt < num; ++cnt)
+        {
+            d_t2 = test_data_mappings_[tst_begin+cnt].tod_ - lower;
 
-                    //assert (ok); TODO?
+            tie (ok, x_positions[cnt], y_positions[cnt]) = trafo_.wgsAddCartOffset(
+                        pos1.latitude_, pos1.longitude_, v_x * d_t2, v_y * d_t2);
+        }
+    }
 
-                    // x_pos long, y_pos lat
+    // calculate altitude
+    bool has_altitude = pos1.has_altitude_ || pos2.has_altitude_;
+    float v_alt = 0.0;
 
-                    logdbg << "EvaluationTargetData: addRefPositiosToMapping: interpolated lat "
-                           << x_pos << " long " << y_pos;
+    if (pos1.has_altitude_ && pos2.has_altitude_)
+        v_alt = (pos2.altitude_ - pos1.altitude_)/d_t;
 
-                    // calculate altitude
-                    bool has_altitude = false;
-                    float altitude = 0.0;
+    double track_angle = atan2(v_y,v_x);
+    double speed = sqrt(pow(v_x, 2) + pow(v_y, 2));
 
-                    if (pos1.has_altitude_ && !pos2.has_altitude_)
-                    {
-                        has_altitude = true;
-                        altitude = pos1.altitude_;
-                    }
-                    else if (!pos1.has_altitude_ && pos2.has_altitude_)
-                    {
-                        has_altitude = true;
-                        altitude = pos2.altitude_;
-                    }
-                    else if (pos1.has_altitude_ && pos2.has_altitude_)
-                    {
-                        float v_alt = (pos2.altitude_ - pos1.altitude_)/d_t;
-                        has_altitude = true;
-                        altitude = pos1.altitude_ + v_alt*d_t2;
-                    }
+    for (unsigned int cnt=0; cnt < num; ++cnt)
+    {
+        TstDataMapping& mapping = test_data_mappings_[tst_begin+cnt];
 
-                    logdbg << "EvaluationTargetData: addRefPositiosToMapping: pos1 has alt "
-                           << pos1.has_altitude_ << " alt " << pos1.altitude_
-                           << " pos2 has alt " << pos2.has_altitude_ << " alt " << pos2.altitude_
-                           << " interpolated has alt " << has_altitude << " alt " << altitude;
+        float altitude = 0.0;
 
-                    mapping.has_ref_pos_ = true;
+        if (pos1.has_altitude_ && !pos2.has_altitude_)
+            altitude = pos1.altitude_;
+        else if (!pos1.has_altitude_ && pos2.has_altitude_)
+            altitude = pos2.altitude_;
+        else if (pos1.has_altitude_ && pos2.has_altitude_)
+            altitude = pos1.altitude_ + v_alt*(mapping.tod_ - lower);
 
-//                    if (in_appimage_) // inside appimage
-//                        mapping.pos_ref_ = EvaluationTargetPosition(y_pos, x_pos, has_altitude, true, altitude);
-//                    else
-                    mapping.pos_ref_ = EvaluationTargetPosition(x_pos, y_pos, has_altitude, true, altitude);
+        mapping.has_ref_pos_ = true;
+        mapping.pos_ref_ = EvaluationTargetPosition(x_positions[cnt], y_positions[cnt], has_altitude, true, altitude);
 
-                    mapping.posbased_spd_ref_.x_ = v_x;
-                    mapping.posbased_spd_ref_.y_ = v_y;
-                    mapping.posbased_spd_ref_.track_angle_ = atan2(v_y,v_x);
-                    mapping.posbased_spd_ref_.speed_ = sqrt(pow(v_x, 2) + pow(v_y, 2));
-                }
-            }
-        }
+        mapping.posbased_spd_ref_.x_ = v_x;
+        mapping.posbased_spd_ref_.y_ = v_y;
+        mapping.posbased_spd_ref_.track_angle_ = track_angle;
+        mapping.posbased_spd_ref_.speed_ = speed;
     }
-    // else do nothing
+}
+
+unsigned int EvaluationTargetData::tstIndexForTime (float tod) const
+{
+    int index = tst_data_.index(tod);
+    assert (index != -1);
+
+    return index;
 }
 
 void EvaluationTargetData::addRefPositiosToMappingFast (TstDataMapping& mapping) const
@@ -2068,47 +2150,19 @@ DataMappingTimes EvaluationTargetData::findTstTimes(float tod_ref) const // ref
 
     ret.tod_ = tod_ref;
 
-    //    Return iterator to lower bound
-    //    Returns an iterator pointing to the first element in the container whose key is not considered to go
-    //    before k (i.e., either it is equivalent or goes after).
-
-    auto lb_it = tst_data_.lower_bound(tod_ref);
+    // first tst tod >= tod_ref, tst tods before are lower
+    auto lb_it = lower_bound(tst_data_.tods_.begin(), tst_data_.tods_.end(), tod_ref);
 
-    if (lb_it != tst_data_.end()) // upper tod found
+    if (lb_it != tst_data_.tods_.end() && lb_it != tst_data_.tods_.begin()) // upper and lower tod found
     {
-        assert (lb_it->first >= tod_ref);
-
-        // save upper value
-        ret.has_other2_ = true;
-        ret.tod_other2_ = lb_it->first;
-
-        // search lower values by decrementing iterator
-        while (lb_it != tst_data_.end() && (tod_ref < lb_it->first || lb_it->first == ret.tod_other2_))
-        {
-            if (lb_it == tst_data_.begin()) // exit condition on first value
-            {
-                if (tod_ref < lb_it->first) // set as not found
-                    lb_it = tst_data_.end();
-
-                break;
-            }
-
-            lb_it--;
-        }
+        assert (*lb_it >= tod_ref);
+        assert (*(lb_it-1) < tod_ref);
 
-        if (lb_it != tst_data_.end() && lb_it->first != ret.tod_other2_) // lower tod found
-        {
-            assert (tod_ref >= lb_it->first);
+        ret.has_other1_ = true;
+        ret.tod_other1_ = *(lb_it-1);
 
-            // add lower value
-            ret.has_other1_ = true;
-            ret.tod_other1_ = lb_it->first;
-        }
-        else // not found, clear previous
-        {
-            ret.has_other2_ = false;
-            ret.tod_other2_ = 0.0;
-        }
+        ret.has_other2_ = true;
+        ret.tod_other2_ = *lb_it;
     }
 
     return ret;
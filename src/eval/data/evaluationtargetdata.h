@@ -31,6 +31,7 @@
 class Buffer;
 class EvaluationData;
 class EvaluationManager;
+class SectorLayer;
 //class Transformation;
 
 //class OGRSpatialReference;
@@ -47,6 +48,9 @@ public:
     bool has_ref2_ {false};
     float tod_ref2_ {0};
 
+    unsigned int ref1_index_ {0}; // first ref update with tod_ref1_, if has_ref1_
+    unsigned int ref2_index_ {0}; // first ref update with tod_ref2_, if has_ref2_
+
     bool has_ref_pos_ {false};
     EvaluationTargetPosition pos_ref_;
     EvaluationTargetVelocity posbased_spd_ref_;
@@ -64,6 +68,60 @@ public:
     float tod_other2_ {0};
 };
 
+class TargetUpdates // ref or tst updates of a target sorted by time, with columns prefetched from the buffer
+{
+public:
+    std::vector<float> tods_;
+    std::vector<unsigned int> indexes_; // in ref/tst buffer
+
+    // per update, set in finalize
+    std::vector<double> latitudes_;
+    std::vector<double> longitudes_;
+
+    std::vector<bool> has_altitudes_; // position altitude, from mode c, secondary or estimated
+    std::vector<bool> altitudes_calculated_; // secondary or estimated
+    std::vector<float> altitudes_; // ft
+
+    std::vector<bool> has_mode_c_; // set
+    std::vector<bool> mode_c_valid_; // set, is v, not g
+    std::vector<int> mode_c_codes_; // ft
+
+    std::vector<bool> has_mode_a_; // set
+    std::vector<bool> mode_a_valid_; // set, is v, not g
+    std::vector<unsigned int> mode_a_codes_;
+
+    std::vector<bool> has_target_addresses_;
+    std::vector<unsigned int> target_addresses_;
+
+    std::vector<bool> has_ground_bits_;
+    std::vector<bool> ground_bits_; // true is on ground
+
+    std::vector<int> callsign_codes_; // index in callsigns_, -1 if not set
+    std::vector<std::string> callsigns_; // distinct
+
+    unsigned int size() const { return tods_.size(); }
+    int index (float tod) const; // first update with tod, -1 if none
+    unsigned int firstIndex (unsigned int index) const; // first update with same tod as update at index
+
+    void sort(); // by tod, keeps order of updates with same tod
+};
+
+class SectorInsideFlags // polygon containment of all updates in sectors of a layer, update * num sectors
+{
+public:
+    unsigned int num_sectors_ {0};
+
+    // from bounding box and altitude range of all positions of the target
+    bool outside_ {false}; // in no sector, flags are empty, all positions outside without polygon tests
+    bool constant_ {false}; // in all or none of the positions per sector polygon, flags only of one update
+
+    std::vector<bool> ref_; // ref updates, in ref data order
+    std::vector<bool> ref_interpolated_; // interpolated ref positions at tst updates, in tst data order
+    std::vector<bool> tst_; // tst updates, in tst data order
+
+    size_t offset (unsigned int index) const { return constant_ ? 0 : index * num_sectors_; }
+};
+
 class EvaluationTargetData
 {
 public:
@@ -112,8 +170,8 @@ public:
     bool use() const;
     void use(bool use);
 
-    const std::multimap<float, unsigned int>& refData() const;
-    const std::multimap<float, unsigned int>& tstData() const;
+    const TargetUpdates& refData() const;
+    const TargetUpdates& tstData() const;
 
     // ref
     bool hasRefDataForTime (float tod, float d_max) const;
@@ -125,8 +183,8 @@ public:
     bool hasRefPosForTime (float tod) const;
     EvaluationTargetPosition refPosForTime (float tod) const;
     EvaluationTargetVelocity refPosBasedSpdForTime (float tod) const;
-    std::pair<bool, float> estimateRefAltitude (float tod, unsigned int index) const;
-    // estimate ref baro alt at tod,index TODO should be replaced by real altitude reconstructor
+    std::pair<bool, float> estimateRefAltitude (unsigned int index) const;
+    // estimate ref baro alt at index in refData TODO should be replaced by real altitude reconstructor
 
     bool hasRefCallsignForTime (float tod) const;
     std::string refCallsignForTime (float tod) const;
@@ -143,10 +201,21 @@ public:
     std::pair<bool,bool> refGroundBitForTime (float tod) const; // has gbs, gbs true
     std::pair<bool,bool> interpolatedRefGroundBitForTime (float tod, float d_max) const; // has gbs, gbs true
 
+    // as the ForTime functions for the tod of the update with tst_index in tstData, without searching the tod
+    bool hasRefData (unsigned int tst_index, float d_max) const;
+    std::pair<float, float> refTimes (unsigned int tst_index, float d_max) const;
+    std::pair<EvaluationTargetPosition, bool> interpolatedRefPos (unsigned int tst_index, float d_max) const;
+    std::pair<EvaluationTargetVelocity, bool> interpolatedRefPosBasedSpd (unsigned int tst_index, float d_max) const;
+    std::pair<bool,bool> interpolatedRefGroundBit (unsigned int tst_index, float d_max) const;
+
+    // as the ForTime functions for the tod of the update with ref_index in refData
+    EvaluationTargetPosition refPos (unsigned int ref_index) const;
+    std::pair<bool,bool> refGroundBit (unsigned int ref_index) const;
+
     // test
     bool hasTstPosForTime (float tod) const;
     EvaluationTargetPosition tstPosForTime (float tod) const;
-    std::pair<bool, float> estimateTstAltitude (float tod, unsigned int index) const;
+    std::pair<bool, float> estimateTstAltitude (unsigned int index) const; // index in tstData
 
     bool hasTstCallsignForTime (float tod) const;
     std::string tstCallsignForTime (float tod) const;
@@ -175,6 +244,23 @@ public:
     bool hasTstMeasuredTrackAngleForTime (float tod) const;
     float tstMeasuredTrackAngleForTime (float tod) const; // deg
 
+    // as the ForTime functions for the tod of the update with tst_index in tstData
+    EvaluationTargetPosition tstPos (unsigned int tst_index) const;
+    bool hasTstCallsign (unsigned int tst_index) const;
+    std::string tstCallsign (unsigned int tst_index) const;
+    bool hasTstModeA (unsigned int tst_index) const;
+    unsigned int tstModeA (unsigned int tst_index) const;
+    bool hasTstModeC (unsigned int tst_index) const;
+    int tstModeC (unsigned int tst_index) const;
+    bool hasTstGroundBit (unsigned int tst_index) const;
+    bool tstGroundBit (unsigned int tst_index) const;
+    bool hasTstTA (unsigned int tst_index) const;
+    unsigned int tstTA (unsigned int tst_index) const;
+    bool hasTstTrackNum (unsigned int tst_index) const;
+    unsigned int tstTrackNum (unsigned int tst_index) const;
+    bool hasTstMeasuredSpeed (unsigned int tst_index) const;
+    float tstMeasuredSpeed (unsigned int tst_index) const; // m/s
+
     double latitudeMin() const;
     double latitudeMax() const;
     double longitudeMin() const;
@@ -186,6 +272,24 @@ public:
     std::set<unsigned int> mopsVersions() const;
     std::string mopsVersionsStr() const;
 
+    // sector containment cache, computed in finalize, has to be re-computed if sectors change
+    void computeSectorInsideFlags (const std::vector<std::shared_ptr<SectorLayer>>& sector_layers) const;
+    void clearSectorInsideFlags () const;
+    const SectorInsideFlags* sectorInsideFlags (const SectorLayer& sector_layer) const; // nullptr if not computed
+    // no position inside the layer by the sector containment cache, false if not computed
+    bool isOutside (const SectorLayer& sector_layer) const;
+
+    // SectorLayer::isInside for position of update with index in refData/tstData, using the sector containment
+    // cache if computed for the layer. pos has to be refPosForTime/interpolatedRefPosForTime/tstPosForTime.
+    // false without polygon tests if outside, requirements count and detail such updates as usual
+    bool isRefPosInside (const SectorLayer& sector_layer, unsigned int ref_index,
+                         const EvaluationTargetPosition& pos, bool has_ground_bit, bool ground_bit_set) const;
+    bool isInterpolatedRefPosInside (const SectorLayer& sector_layer, unsigned int tst_index,
+                                     const EvaluationTargetPosition& pos, bool has_ground_bit,
+                                     bool ground_bit_set) const;
+    bool isTstPosInside (const SectorLayer& sector_layer, unsigned int tst_index,
+                         const EvaluationTargetPosition& pos, bool has_ground_bit, bool ground_bit_set) const;
+
     bool hasNucpNic() const;
     std::string nucpNicStr() const;
     bool hasNacp() const;
@@ -199,11 +303,8 @@ protected:
 
     bool use_ {true};
 
-    std::multimap<float, unsigned int> ref_data_; // tod -> index
-    mutable std::vector<unsigned int> ref_indexes_;
-
-    std::multimap<float, unsigned int> tst_data_; // tod -> index
-    mutable std::vector<unsigned int> tst_indexes_;
+    mutable TargetUpdates ref_data_; // sorted in finalize
+    mutable TargetUpdates tst_data_; // sorted in finalize
 
     mutable std::vector<std::string> callsigns_;
     mutable std::vector<unsigned int> target_addresses_;
@@ -227,7 +328,9 @@ protected:
     mutable bool has_nacp {false};
     mutable unsigned int min_nacp_, max_nacp_;
 
-    mutable std::map<float, TstDataMapping> test_data_mappings_;
+    mutable std::vector<TstDataMapping> test_data_mappings_; // per tst update, as for first update with tod
+
+    mutable std::map<const SectorLayer*, SectorInsideFlags> sector_inside_flags_;
 
 //    std::unique_ptr<OGRSpatialReference> wgs84_;
 //    mutable std::unique_ptr<OGRSpatialReference> local_;
@@ -235,6 +338,8 @@ protected:
     //mutable std::unique_ptr<OGRCoordinateTransformation> ogr_cart2geo_;
     mutable Transformation trafo_;
 
+    void prefetchColumns(bool ref) const; // of sorted ref or tst data
+
     void updateCallsigns() const;
     void updateTargetAddresses() const;
     void updateModeACodes() const;
@@ -243,11 +348,19 @@ protected:
     //void updateADSBInfo() const;
 
     void calculateTestDataMappings() const;
-    TstDataMapping calculateTestDataMapping(float tod) const; // test tod
-    void addRefPositiosToMapping (TstDataMapping& mapping) const;
+    // interpolates for tst updates [tst_begin, tst_end) between the ref updates
+    void addRefPositionsToMappings (unsigned int tst_begin, unsigned int tst_end, unsigned int ref1_index,
+                                    unsigned int ref2_index) const;
     void addRefPositiosToMappingFast (TstDataMapping& mapping) const;
 
+    unsigned int tstIndexForTime (float tod) const; // first tst update with tod, has to exist
+
     DataMappingTimes findTstTimes(float tod_ref) const; // ref tod
+
+    // shared by the is*PosInside functions, flags one of the update flags of SectorInsideFlags
+    bool isPosInside (const SectorLayer& sector_layer, std::vector<bool> SectorInsideFlags::* flags,
+                      unsigned int index, const EvaluationTargetPosition& pos, bool has_ground_bit,
+                      bool ground_bit_set) const;
 };
 
 #endif // EVALUATIONTARGETDATA_H
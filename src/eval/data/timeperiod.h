@@ -131,6 +131,11 @@ public:
     TimePeriodIterator begin() { return periods_.begin(); }
     TimePeriodIterator end() { return periods_.end(); }
 
+    using TimePeriodConstIterator =
+    typename std::vector<TimePeriod>::const_iterator;
+    TimePeriodConstIterator begin() const { return periods_.begin(); }
+    TimePeriodConstIterator end() const { return periods_.end(); }
+
     float totalBegin()
     {
         assert (periods_.size());
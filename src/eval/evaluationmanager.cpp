@@ -53,6 +53,8 @@
 
 #include <memory>
 #include <fstream>
+#include <iomanip>
+#include <sstream>
 
 using namespace Utils;
 using namespace std;
@@ -437,6 +439,32 @@ void EvaluationManager::loadData ()
 
     }
 
+    // data selection as loaded, part of the results cache key
+    loaded_data_config_ = json::object();
+    loaded_data_config_["dbo_name_ref"] = dbo_name_ref_;
+    loaded_data_config_["active_sources_ref"] = activeDataSourcesRef();
+    loaded_data_config_["count_ref"] = object_man.object(dbo_name_ref_).count();
+    loaded_data_config_["dbo_name_tst"] = dbo_name_tst_;
+    loaded_data_config_["active_sources_tst"] = activeDataSourcesTst();
+    loaded_data_config_["count_tst"] = object_man.object(dbo_name_tst_).count();
+
+    loaded_data_config_["has_associations"] = object_man.hasAssociations();
+    loaded_data_config_["associations_dbo"] = object_man.associationsDBObject();
+    loaded_data_config_["associations_ds"] = object_man.associationsDataSourceName();
+    loaded_data_config_["associations_generation"] = object_man.associationsGeneration();
+
+    if (min_max_pos_set_)
+        loaded_data_config_["position"] = {latitude_min_, latitude_max_, longitude_min_, longitude_max_};
+
+    if (use_load_filter_)
+    {
+        for (auto fil_it : {"Time of Day", "ADSB Quality"})
+        {
+            if (fil_man.hasFilter(fil_it) && fil_man.getFilter(fil_it)->getActive())
+                fil_man.getFilter(fil_it)->saveViewPointConditions(loaded_data_config_["filters"]);
+        }
+    }
+
     needs_additional_variables_ = true;
 
     object_man.loadSlot();
@@ -584,6 +612,45 @@ void EvaluationManager::evaluate ()
     emit resultsChangedSignal();
 }
 
+std::string EvaluationManager::resultsCacheKey()
+{
+    assert (hasCurrentStandard());
+
+    json key_data;
+
+    key_data["version"] = 1; // increase if serialized results change
+    key_data["data"] = loaded_data_config_;
+
+    currentStandard().configuration().generateJSON(key_data["standard"]);
+    key_data["use_grp_in_sector"] = use_grp_in_sector_;
+    key_data["use_requirement"] = use_requirement_;
+
+    key_data["max_ref_time_diff"] = max_ref_time_diff_;
+    key_data["skip_no_data_details"] = results_gen_->skipNoDataDetails();
+
+    for (auto& sec_lay_it : sector_layers_)
+    {
+        json& layer_sectors = key_data["sectors"][sec_lay_it->name()];
+
+        for (auto& sec_it : sec_lay_it->sectors())
+            layer_sectors.push_back(sec_it->jsonData());
+    }
+
+    // FNV-1a, stable across runs and platforms
+    uint64_t hash = 14695981039346656037ull;
+
+    for (unsigned char c : key_data.dump())
+    {
+        hash ^= c;
+        hash *= 1099511628211ull;
+    }
+
+    stringstream ss;
+    ss << hex << setw(16) << setfill('0') << hash;
+
+    return ss.str();
+}
+
 bool EvaluationManager::canGenerateReport ()
 {
     assert (initialized_);
@@ -1576,6 +1643,18 @@ void EvaluationManager::updateResultsToChanges ()
     }
 }
 
+void EvaluationManager::updateResultsToUseChangeOf (unsigned int utn)
+{
+    if (evaluated_ && results_gen_->updateToUseChangeOf(utn))
+    {
+        if (widget_)
+        {
+            widget_->expandResults();
+            widget_->reshowLastResultId();
+        }
+    }
+}
+
 void EvaluationManager::showFullUTN (unsigned int utn)
 {
     nlohmann::json::object_t data;
@@ -1734,7 +1813,7 @@ void EvaluationManager::useUTN (unsigned int utn, bool value, bool update_td, bo
         data_.setUseTargetData(utn, value);
 
     if (update_res && update_results_)
-        updateResultsToChanges();
+        updateResultsToUseChangeOf(utn);
 }
 
 void EvaluationManager::useAllUTNs (bool value)
@@ -66,6 +66,8 @@ public:
     bool canEvaluate ();
     std::string getCannotEvaluateComment();
     void evaluate ();
+    // hash of loaded data selection, standard, sectors and settings, single results are cached under it
+    std::string resultsCacheKey();
     bool canGenerateReport ();
     void generateReport ();
 
@@ -160,6 +162,7 @@ public:
 
     //void setUseTargetData (unsigned int utn, bool value);
     void updateResultsToChanges ();
+    void updateResultsToUseChangeOf (unsigned int utn); // incremental, only results of target
     void showFullUTN (unsigned int utn);
     void showSurroundingData (unsigned int utn);
 
@@ -337,6 +340,8 @@ protected:
 
     bool evaluated_ {false};
 
+    nlohmann::json loaded_data_config_; // data selection, filters and associations used in loadData
+
     std::string dbo_name_ref_;
     std::map<int, ActiveDataSource> data_sources_ref_;
     nlohmann::json active_sources_ref_;
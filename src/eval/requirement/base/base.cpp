@@ -132,15 +132,15 @@ bool Base::compareValue (double val, double threshold, COMPARISON_TYPE check_typ
 }
 
 std::pair<ValueComparisonResult, std::string> Base::compareTi (
-        float tod, const EvaluationTargetData& target_data, float max_ref_time_diff)
+        unsigned int tst_index, const EvaluationTargetData& target_data, float max_ref_time_diff)
 {
     float ref_lower{0}, ref_upper{0};
-    tie(ref_lower, ref_upper) = target_data.refTimesFor(tod, max_ref_time_diff);
+    tie(ref_lower, ref_upper) = target_data.refTimes(tst_index, max_ref_time_diff);
     bool has_ref_data = (ref_lower != -1 || ref_upper != -1)
             && ((ref_lower != -1 && target_data.hasRefCallsignForTime(ref_lower))
                 || (ref_upper != -1 && target_data.hasRefCallsignForTime(ref_upper)));
 
-    bool has_tst_data = target_data.hasTstCallsignForTime(tod);
+    bool has_tst_data = target_data.hasTstCallsign(tst_index);
 
     if (!has_ref_data)
     {
@@ -152,7 +152,7 @@ std::pair<ValueComparisonResult, std::string> Base::compareTi (
 
     if (has_tst_data)
     {
-        string value = target_data.tstCallsignForTime(tod);
+        string value = target_data.tstCallsign(tst_index);
 
         bool value_ok;
         bool lower_nok, upper_nok;
@@ -184,7 +184,7 @@ std::pair<ValueComparisonResult, std::string> Base::compareTi (
 
             if (lower_nok)
             {
-                comment += " tst value '"+target_data.tstCallsignForTime(tod)
+                comment += " tst value '"+target_data.tstCallsign(tst_index)
                         +"' ref value at "+String::timeStringFromDouble(ref_lower)
                         + "  '"+target_data.refCallsignForTime(ref_lower)
                         + "'";
@@ -192,7 +192,7 @@ std::pair<ValueComparisonResult, std::string> Base::compareTi (
             else
             {
                 assert (upper_nok);
-                comment += " tst value '"+target_data.tstCallsignForTime(tod)
+                comment += " tst value '"+target_data.tstCallsign(tst_index)
                         +"' ref value at "+String::timeStringFromDouble(ref_upper)
                         + "  '"+target_data.refCallsignForTime(ref_upper)
                         + "'";
@@ -207,17 +207,17 @@ std::pair<ValueComparisonResult, std::string> Base::compareTi (
 }
 
 std::pair<ValueComparisonResult, std::string> Base::compareTa (
-        float tod, const EvaluationTargetData& target_data, float max_ref_time_diff)
+        unsigned int tst_index, const EvaluationTargetData& target_data, float max_ref_time_diff)
 {
     float ref_lower{0}, ref_upper{0};
 
-    tie(ref_lower, ref_upper) = target_data.refTimesFor(tod, max_ref_time_diff);
+    tie(ref_lower, ref_upper) = target_data.refTimes(tst_index, max_ref_time_diff);
 
     bool has_ref_data = (ref_lower != -1 || ref_upper != -1)
             && ((ref_lower != -1 && target_data.hasRefTAForTime(ref_lower))
                 || (ref_upper != -1 && target_data.hasRefTAForTime(ref_upper)));
 
-    bool has_tst_data = target_data.hasTstTAForTime(tod);
+    bool has_tst_data = target_data.hasTstTA(tst_index);
 
     if (!has_ref_data)
     {
@@ -230,7 +230,7 @@ std::pair<ValueComparisonResult, std::string> Base::compareTa (
 
     if (has_tst_data)
     {
-        unsigned int value = target_data.tstTAForTime(tod);
+        unsigned int value = target_data.tstTA(tst_index);
 
         bool value_ok;
         bool lower_nok, upper_nok;
@@ -262,7 +262,7 @@ std::pair<ValueComparisonResult, std::string> Base::compareTa (
 
             if (lower_nok)
             {
-                comment += " tst value '"+String::hexStringFromInt(target_data.tstTAForTime(tod))
+                comment += " tst value '"+String::hexStringFromInt(target_data.tstTA(tst_index))
                         +"' ref value at "+String::timeStringFromDouble(ref_lower)
                         + "  '"+String::hexStringFromInt(target_data.refTAForTime(ref_lower))
                         + "'";
@@ -270,7 +270,7 @@ std::pair<ValueComparisonResult, std::string> Base::compareTa (
             else
             {
                 assert (upper_nok);
-                comment += " tst value '"+String::hexStringFromInt(target_data.tstTAForTime(tod))
+                comment += " tst value '"+String::hexStringFromInt(target_data.tstTA(tst_index))
                         +"' ref value at "+String::timeStringFromDouble(ref_upper)
                         + "  '"+String::hexStringFromInt(target_data.refTAForTime(ref_upper))
                         + "'";
@@ -284,16 +284,16 @@ std::pair<ValueComparisonResult, std::string> Base::compareTa (
 }
 
 std::pair<ValueComparisonResult, std::string> Base::compareModeA (
-        float tod, const EvaluationTargetData& target_data, float max_ref_time_diff)
+        unsigned int tst_index, const EvaluationTargetData& target_data, float max_ref_time_diff)
 {
     float ref_lower{0}, ref_upper{0};
-    tie(ref_lower, ref_upper) = target_data.refTimesFor(tod, max_ref_time_diff);
+    tie(ref_lower, ref_upper) = target_data.refTimes(tst_index, max_ref_time_diff);
 
     bool has_ref_data = (ref_lower != -1 || ref_upper != -1)
             && ((ref_lower != -1 && target_data.hasRefModeAForTime(ref_lower))
                 || (ref_upper != -1 && target_data.hasRefModeAForTime(ref_upper)));
 
-    bool has_tst_data = target_data.hasTstModeAForTime(tod);
+    bool has_tst_data = target_data.hasTstModeA(tst_index);
 
     if (!has_ref_data)
     {
@@ -305,7 +305,7 @@ std::pair<ValueComparisonResult, std::string> Base::compareModeA (
 
     if (has_tst_data)
     {
-        unsigned int code = target_data.tstModeAForTime(tod);
+        unsigned int code = target_data.tstModeA(tst_index);
 
         bool value_ok;
         bool lower_nok, upper_nok;
@@ -359,14 +359,14 @@ std::pair<ValueComparisonResult, std::string> Base::compareModeA (
 }
 
 std::pair<ValueComparisonResult, std::string> Base::compareModeC (
-        float tod, const EvaluationTargetData& target_data, float max_ref_time_diff, float max_val_diff)
+        unsigned int tst_index, const EvaluationTargetData& target_data, float max_ref_time_diff, float max_val_diff)
 {
-    if (target_data.hasTstModeCForTime(tod))
+    if (target_data.hasTstModeC(tst_index))
     {
-        int code = target_data.tstModeCForTime(tod);
+        int code = target_data.tstModeC(tst_index);
 
         float ref_lower{0}, ref_upper{0};
-        tie(ref_lower, ref_upper) = target_data.refTimesFor(tod, max_ref_time_diff);
+        tie(ref_lower, ref_upper) = target_data.refTimes(tst_index, max_ref_time_diff);
 
         bool value_ok;
         bool lower_nok, upper_nok;
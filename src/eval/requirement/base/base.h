@@ -19,6 +19,7 @@
 #define EVALUATIONREQUIREMENT_H
 
 #include "eval/requirement/base/comparisontype.h"
+#include "json.hpp"
 
 #include <string>
 #include <memory>
@@ -55,6 +56,11 @@ public:
             const SectorLayer& sector_layer) = 0;
     // instance is the self-reference for the result
 
+    // result from its serialized counts and details, as created by Single::toJSON
+    virtual std::shared_ptr<EvaluationRequirementResult::Single> restore (
+            const nlohmann::json& j, const EvaluationTargetData& target_data, std::shared_ptr<Base> instance,
+            const SectorLayer& sector_layer) = 0;
+
     std::string name() const;
     std::string shortname() const;
     std::string groupName() const;
@@ -82,14 +88,18 @@ protected:
 
     bool compareValue (double val, double threshold, COMPARISON_TYPE check_type);
 
-    std::pair<ValueComparisonResult, std::string> compareTi (float tod, const EvaluationTargetData& target_data,
-                                                             float max_ref_time_diff); // tod tst
-    std::pair<ValueComparisonResult, std::string> compareTa (float tod, const EvaluationTargetData& target_data,
-                                                             float max_ref_time_diff); // tod tst
-    std::pair<ValueComparisonResult, std::string> compareModeA (float tod, const EvaluationTargetData& target_data,
-                                                             float max_ref_time_diff); // tod tst
-    std::pair<ValueComparisonResult, std::string> compareModeC (float tod, const EvaluationTargetData& target_data,
-                                                             float max_ref_time_diff, float max_val_diff); // tod tst
+    std::pair<ValueComparisonResult, std::string> compareTi (unsigned int tst_index,
+                                                             const EvaluationTargetData& target_data,
+                                                             float max_ref_time_diff); // index in tstData
+    std::pair<ValueComparisonResult, std::string> compareTa (unsigned int tst_index,
+                                                             const EvaluationTargetData& target_data,
+                                                             float max_ref_time_diff); // index in tstData
+    std::pair<ValueComparisonResult, std::string> compareModeA (unsigned int tst_index,
+                                                                const EvaluationTargetData& target_data,
+                                                                float max_ref_time_diff); // index in tstData
+    std::pair<ValueComparisonResult, std::string> compareModeC (unsigned int tst_index,
+                                                                const EvaluationTargetData& target_data,
+                                                                float max_ref_time_diff, float max_val_diff); // index in tstData
 };
 
 }
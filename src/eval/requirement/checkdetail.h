@@ -1,6 +1,7 @@
 #ifndef EVALUATIONREQUIREMENTCHECKDETAIL_H
 #define EVALUATIONREQUIREMENTCHECKDETAIL_H
 
+#include "eval/requirement/detailcolumns.h"
 #include "evaluationtargetposition.h"
 
 #include <QVariant>
@@ -42,6 +43,113 @@ namespace EvaluationRequirement
 
         std::string comment_;
     };
+
+    /// @brief Check details of a target as columns, materialized as CheckDetail on access
+    class CheckDetails
+    {
+    public:
+        typedef DetailIterator<CheckDetails, CheckDetail> const_iterator;
+
+        void push_back (const CheckDetail& detail)
+        {
+            tods_.push_back(detail.tod_);
+            pos_tst_.push_back(detail.pos_tst_);
+            ref_exists_.push_back(detail.ref_exists_);
+            pos_inside_.push_back(detail.pos_inside_);
+            is_not_ok_.push_back(detail.is_not_ok_);
+            num_updates_.push_back(detail.num_updates_);
+            num_no_ref_.push_back(detail.num_no_ref_);
+            num_inside_.push_back(detail.num_inside_);
+            num_outside_.push_back(detail.num_outside_);
+            num_unknown_id_.push_back(detail.num_unknown_id_);
+            num_correct_id_.push_back(detail.num_correct_id_);
+            num_false_id_.push_back(detail.num_false_id_);
+            comments_.push_back(detail.comment_);
+        }
+
+        CheckDetail at (size_t index) const
+        {
+            return {tods_.at(index), pos_tst_.at(index), ref_exists_.at(index), pos_inside_.at(index),
+                        is_not_ok_.at(index), num_updates_.at(index), num_no_ref_.at(index), num_inside_.at(index),
+                        num_outside_.at(index), num_unknown_id_.at(index), num_correct_id_.at(index),
+                        num_false_id_.at(index), comments_.at(index)};
+        }
+
+        size_t size() const { return tods_.size(); }
+
+        const_iterator begin() const { return {*this, 0}; }
+        const_iterator end() const { return {*this, size()}; }
+
+        void shrink_to_fit()
+        {
+            tods_.shrink_to_fit();
+            pos_tst_.shrink_to_fit();
+            ref_exists_.shrink_to_fit();
+            pos_inside_.shrink_to_fit();
+            is_not_ok_.shrink_to_fit();
+            num_updates_.shrink_to_fit();
+            num_no_ref_.shrink_to_fit();
+            num_inside_.shrink_to_fit();
+            num_outside_.shrink_to_fit();
+            num_unknown_id_.shrink_to_fit();
+            num_correct_id_.shrink_to_fit();
+            num_false_id_.shrink_to_fit();
+            comments_.shrink_to_fit();
+        }
+
+        nlohmann::json toJSON() const
+        {
+            nlohmann::json j;
+
+            j["tods"] = tods_;
+            j["pos_tst"] = pos_tst_.toJSON();
+            j["ref_exists"] = ref_exists_;
+            j["pos_inside"] = pos_inside_.toJSON();
+            j["is_not_ok"] = is_not_ok_;
+            j["num_updates"] = num_updates_;
+            j["num_no_ref"] = num_no_ref_;
+            j["num_inside"] = num_inside_;
+            j["num_outside"] = num_outside_;
+            j["num_unknown_id"] = num_unknown_id_;
+            j["num_correct_id"] = num_correct_id_;
+            j["num_false_id"] = num_false_id_;
+            j["comments"] = comments_.toJSON();
+
+            return j;
+        }
+
+        void fromJSON (const nlohmann::json& j)
+        {
+            tods_ = j.at("tods").get<std::vector<float>>();
+            pos_tst_.fromJSON(j.at("pos_tst"));
+            ref_exists_ = j.at("ref_exists").get<std::vector<bool>>();
+            pos_inside_.fromJSON(j.at("pos_inside"));
+            is_not_ok_ = j.at("is_not_ok").get<std::vector<bool>>();
+            num_updates_ = j.at("num_updates").get<std::vector<int>>();
+            num_no_ref_ = j.at("num_no_ref").get<std::vector<int>>();
+            num_inside_ = j.at("num_inside").get<std::vector<int>>();
+            num_outside_ = j.at("num_outside").get<std::vector<int>>();
+            num_unknown_id_ = j.at("num_unknown_id").get<std::vector<int>>();
+            num_correct_id_ = j.at("num_correct_id").get<std::vector<int>>();
+            num_false_id_ = j.at("num_false_id").get<std::vector<int>>();
+            comments_.fromJSON(j.at("comments"));
+        }
+
+    protected:
+        std::vector<float> tods_;
+        PositionColumn pos_tst_;
+        std::vector<bool> ref_exists_;
+        OptionalColumn<bool> pos_inside_;
+        std::vector<bool> is_not_ok_;
+        std::vector<int> num_updates_;
+        std::vector<int> num_no_ref_;
+        std::vector<int> num_inside_;
+        std::vector<int> num_outside_;
+        std::vector<int> num_unknown_id_;
+        std::vector<int> num_correct_id_;
+        std::vector<int> num_false_id_;
+        CommentColumn comments_;
+    };
 }
 
 #endif // EVALUATIONREQUIREMENTCHECKDETAIL_H
@@ -0,0 +1,135 @@
+/*
+ * This file is part of OpenATS COMPASS.
+ *
+ * COMPASS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * COMPASS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with COMPASS. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "eval/requirement/detailcolumns.h"
+
+namespace EvaluationRequirement
+{
+
+void PositionColumn::push_back (const EvaluationTargetPosition& pos)
+{
+    latitudes_.push_back(pos.latitude_);
+    longitudes_.push_back(pos.longitude_);
+    altitudes_.push_back(pos.altitude_);
+    has_altitudes_.push_back(pos.has_altitude_);
+    altitudes_calculated_.push_back(pos.altitude_calculated_);
+}
+
+EvaluationTargetPosition PositionColumn::at (size_t index) const
+{
+    return {latitudes_.at(index), longitudes_.at(index), has_altitudes_.at(index),
+                altitudes_calculated_.at(index), altitudes_.at(index)};
+}
+
+void PositionColumn::shrink_to_fit()
+{
+    latitudes_.shrink_to_fit();
+    longitudes_.shrink_to_fit();
+    altitudes_.shrink_to_fit();
+    has_altitudes_.shrink_to_fit();
+    altitudes_calculated_.shrink_to_fit();
+}
+
+nlohmann::json PositionColumn::toJSON() const
+{
+    nlohmann::json j;
+
+    j["latitudes"] = valuesToJSON(latitudes_);
+    j["longitudes"] = valuesToJSON(longitudes_);
+    j["altitudes"] = valuesToJSON(altitudes_);
+    j["has_altitudes"] = has_altitudes_;
+    j["altitudes_calculated"] = altitudes_calculated_;
+
+    return j;
+}
+
+void PositionColumn::fromJSON (const nlohmann::json& j)
+{
+    latitudes_ = valuesFromJSON<double>(j.at("latitudes"));
+    longitudes_ = valuesFromJSON<double>(j.at("longitudes"));
+    altitudes_ = valuesFromJSON<float>(j.at("altitudes"));
+    has_altitudes_ = j.at("has_altitudes").get<std::vector<bool>>();
+    altitudes_calculated_ = j.at("altitudes_calculated").get<std::vector<bool>>();
+
+    assert (longitudes_.size() == latitudes_.size());
+    assert (altitudes_.size() == latitudes_.size());
+    assert (has_altitudes_.size() == latitudes_.size());
+    assert (altitudes_calculated_.size() == latitudes_.size());
+}
+
+void CommentColumn::push_back (const std::string& comment)
+{
+    // same as previous comment, common for consecutive details
+    if (codes_.size() && comments_.at(codes_.back()) == comment)
+    {
+        codes_.push_back(codes_.back());
+        return;
+    }
+
+    if (lookup_.size() != comments_.size()) // released by shrink_to_fit
+    {
+        lookup_.clear();
+
+        for (unsigned int cnt=0; cnt < comments_.size(); ++cnt)
+            lookup_.emplace(comments_.at(cnt), cnt);
+    }
+
+    auto it = lookup_.find(comment);
+
+    if (it != lookup_.end())
+    {
+        codes_.push_back(it->second);
+        return;
+    }
+
+    unsigned int code = comments_.size();
+
+    comments_.push_back(comment);
+    lookup_.emplace(comment, code);
+    codes_.push_back(code);
+}
+
+void CommentColumn::shrink_to_fit()
+{
+    comments_.shrink_to_fit();
+    codes_.shrink_to_fit();
+
+    std::unordered_map<std::string, unsigned int>().swap(lookup_);
+}
+
+nlohmann::json CommentColumn::toJSON() const
+{
+    nlohmann::json j;
+
+    j["comments"] = comments_;
+    j["codes"] = codes_;
+
+    return j;
+}
+
+void CommentColumn::fromJSON (const nlohmann::json& j)
+{
+    comments_ = j.at("comments").get<std::vector<std::string>>();
+    codes_ = j.at("codes").get<std::vector<unsigned int>>();
+
+    lookup_.clear(); // re-built on next push_back
+
+    for (auto code_it : codes_)
+        assert (code_it < comments_.size());
+}
+
+}
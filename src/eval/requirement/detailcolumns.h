@@ -0,0 +1,254 @@
+/*
+ * This file is part of OpenATS COMPASS.
+ *
+ * COMPASS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * COMPASS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with COMPASS. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef EVALUATIONREQUIREMENTDETAILCOLUMNS_H
+#define EVALUATIONREQUIREMENTDETAILCOLUMNS_H
+
+#include "evaluationtargetposition.h"
+#include "json.hpp"
+
+#include <QVariant>
+
+#include <cassert>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+namespace EvaluationRequirement
+{
+
+/**
+ * @brief Values to json array, non-finite floating point values as "nan", "inf", "-inf"
+ *
+ * json writes non-finite numbers as null, which can not be read back as numbers.
+ */
+template <typename T>
+typename std::enable_if<std::is_floating_point<T>::value, nlohmann::json>::type
+valuesToJSON (const std::vector<T>& values)
+{
+    nlohmann::json j = nlohmann::json::array();
+
+    for (T value : values)
+    {
+        if (std::isfinite(value))
+            j.push_back(value);
+        else if (std::isnan(value))
+            j.push_back("nan");
+        else
+            j.push_back(value > 0 ? "inf" : "-inf");
+    }
+
+    return j;
+}
+
+template <typename T>
+typename std::enable_if<!std::is_floating_point<T>::value, nlohmann::json>::type
+valuesToJSON (const std::vector<T>& values)
+{
+    return values;
+}
+
+/// @brief Reverse of valuesToJSON, throws on unknown entries
+template <typename T>
+typename std::enable_if<std::is_floating_point<T>::value, std::vector<T>>::type
+valuesFromJSON (const nlohmann::json& j)
+{
+    std::vector<T> values;
+    values.reserve(j.size());
+
+    for (const nlohmann::json& j_value : j)
+    {
+        if (!j_value.is_string())
+        {
+            values.push_back(j_value.get<T>());
+            continue;
+        }
+
+        const std::string& str = j_value.get_ref<const std::string&>();
+
+        if (str == "nan")
+            values.push_back(std::numeric_limits<T>::quiet_NaN());
+        else if (str == "inf")
+            values.push_back(std::numeric_limits<T>::infinity());
+        else if (str == "-inf")
+            values.push_back(-std::numeric_limits<T>::infinity());
+        else
+            throw std::runtime_error("valuesFromJSON: unknown value '"+str+"'");
+    }
+
+    return values;
+}
+
+template <typename T>
+typename std::enable_if<!std::is_floating_point<T>::value, std::vector<T>>::type
+valuesFromJSON (const nlohmann::json& j)
+{
+    return j.get<std::vector<T>>();
+}
+
+/**
+ * @brief Positions as separate coordinate columns, altitude flags as bitsets
+ */
+class PositionColumn
+{
+public:
+    void push_back (const EvaluationTargetPosition& pos);
+    EvaluationTargetPosition at (size_t index) const;
+
+    double latitude (size_t index) const { return latitudes_.at(index); }
+    double longitude (size_t index) const { return longitudes_.at(index); }
+
+    size_t size() const { return latitudes_.size(); }
+    void shrink_to_fit();
+
+    nlohmann::json toJSON() const;
+    void fromJSON (const nlohmann::json& j);
+
+protected:
+    std::vector<double> latitudes_;
+    std::vector<double> longitudes_;
+    std::vector<float> altitudes_;
+    std::vector<bool> has_altitudes_;
+    std::vector<bool> altitudes_calculated_;
+};
+
+/**
+ * @brief QVariant column holding either invalid values or values of type T, as value and valid bitset
+ *
+ * Values of other types are converted to T, so that the materialized QVariant always has type T.
+ */
+template <typename T>
+class OptionalColumn
+{
+public:
+    void push_back (const QVariant& value)
+    {
+        valid_.push_back(value.isValid());
+        values_.push_back(value.isValid() ? value.value<T>() : T());
+    }
+
+    QVariant at (size_t index) const
+    {
+        if (!valid_.at(index))
+            return QVariant();
+
+        return QVariant(values_.at(index));
+    }
+
+    bool isValid (size_t index) const { return valid_.at(index); }
+    T value (size_t index) const { return values_.at(index); }
+
+    size_t size() const { return values_.size(); }
+
+    /// @brief Valid values in order, converted to V
+    template <typename V>
+    std::vector<V> validValues() const
+    {
+        std::vector<V> values;
+
+        for (size_t cnt=0; cnt < values_.size(); ++cnt)
+            if (valid_[cnt])
+                values.push_back(values_[cnt]);
+
+        return values;
+    }
+
+    void shrink_to_fit()
+    {
+        valid_.shrink_to_fit();
+        values_.shrink_to_fit();
+    }
+
+    nlohmann::json toJSON() const
+    {
+        nlohmann::json j;
+
+        j["valid"] = valid_;
+        j["values"] = valuesToJSON(values_);
+
+        return j;
+    }
+
+    void fromJSON (const nlohmann::json& j)
+    {
+        valid_ = j.at("valid").get<std::vector<bool>>();
+        values_ = valuesFromJSON<T>(j.at("values"));
+
+        assert (valid_.size() == values_.size());
+    }
+
+protected:
+    std::vector<bool> valid_;
+    std::vector<T> values_;
+};
+
+/**
+ * @brief String column coded by a dictionary of distinct strings
+ *
+ * Most details share a few comments (e.g. "OK", "Tst outside"), so each is stored once and referenced
+ * by index. The lookup map is only needed while adding and is released by shrink_to_fit.
+ */
+class CommentColumn
+{
+public:
+    void push_back (const std::string& comment);
+    const std::string& at (size_t index) const { return comments_.at(codes_.at(index)); }
+
+    size_t size() const { return codes_.size(); }
+    size_t numDistinct() const { return comments_.size(); }
+
+    void shrink_to_fit();
+
+    nlohmann::json toJSON() const;
+    void fromJSON (const nlohmann::json& j);
+
+protected:
+    std::vector<std::string> comments_; // distinct
+    std::vector<unsigned int> codes_; // index into comments per entry
+
+    std::unordered_map<std::string, unsigned int> lookup_; // comment -> code
+};
+
+/**
+ * @brief Forward iterator over details stored in columns, materializing each detail on dereference
+ */
+template <class Details, class Detail>
+class DetailIterator
+{
+public:
+    DetailIterator (const Details& details, size_t index)
+        : details_(&details), index_(index) {}
+
+    Detail operator* () const { return details_->at(index_); }
+
+    DetailIterator& operator++ () { ++index_; return *this; }
+
+    bool operator== (const DetailIterator& other) const { return index_ == other.index_; }
+    bool operator!= (const DetailIterator& other) const { return index_ != other.index_; }
+
+protected:
+    const Details* details_ {nullptr};
+    size_t index_ {0};
+};
+
+}
+
+#endif // EVALUATIONREQUIREMENTDETAILCOLUMNS_H
@@ -104,22 +104,22 @@ std::shared_ptr<EvaluationRequirementResult::Single> Detection::evaluate (
     bool inside, was_inside;
 
     {
-        const std::multimap<float, unsigned int>& ref_data = target_data.refData();
+        const TargetUpdates& ref_data = target_data.refData();
         bool first {true};
 
-        for (auto& ref_it : ref_data)
+        for (unsigned int ref_cnt=0; ref_cnt < ref_data.size(); ++ref_cnt)
         {
-            tod = ref_it.first;
+            tod = ref_data.tods_[ref_cnt];
             was_inside = inside;
 
             // for ref
-            tie (has_ground_bit, ground_bit_set) = target_data.refGroundBitForTime(tod);
+            tie (has_ground_bit, ground_bit_set) = target_data.refGroundBit(ref_cnt);
             // for tst
             if (!ground_bit_set)
                 tie (has_ground_bit, ground_bit_set) = target_data.tstGroundBitForTimeInterpolated(tod);
 
-            inside = target_data.hasRefPosForTime(tod)
-                    && sector_layer.isInside(target_data.refPosForTime(tod), has_ground_bit, ground_bit_set);
+            inside = target_data.isRefPosInside(sector_layer, ref_cnt, target_data.refPos(ref_cnt),
+                                                has_ground_bit, ground_bit_set);
 
             if (first)
             {
@@ -157,7 +157,7 @@ std::shared_ptr<EvaluationRequirementResult::Single> Detection::evaluate (
     last_tod = 0;
 
     // evaluate test data
-    const std::multimap<float, unsigned int>& tst_data = target_data.tstData();
+    const TargetUpdates& tst_data = target_data.tstData();
 
     int sum_uis = ref_periods.getUIs(update_interval_s_);
 
@@ -172,7 +172,7 @@ std::shared_ptr<EvaluationRequirementResult::Single> Detection::evaluate (
     //pair<EvaluationTargetPosition, bool> ret_pos;
     bool ok;
 
-    vector<DetectionDetail> details;
+    DetectionDetails details;
     EvaluationTargetPosition pos_current;
 
     unsigned int tst_data_size = tst_data.size();
@@ -237,13 +237,13 @@ std::shared_ptr<EvaluationRequirementResult::Single> Detection::evaluate (
 
     bool skip_no_data_details = eval_man_.resultsGenerator().skipNoDataDetails();
 
-    for (auto tst_it=tst_data.begin(); tst_it != tst_data.end(); ++tst_it)
+    for (unsigned int tst_cnt=0; tst_cnt < tst_data.size(); ++tst_cnt)
     {
         comment = "";
 
         last_tod = tod;
-        tod = tst_it->first;
-        pos_current = target_data.tstPosForTime(tod);
+        tod = tst_data.tods_[tst_cnt];
+        pos_current = target_data.tstPos(tst_cnt);
 
         logdbg << "EvaluationRequirementDetection '" << name_
                << "': evaluate: utn " << target_data.utn_ << " tod " << tod;
@@ -345,7 +345,7 @@ std::shared_ptr<EvaluationRequirementResult::Single> Detection::evaluate (
         // is inside period
         period_index = ref_periods.getPeriodIndex(tod);
 
-        tie(ref_pos, ok) = target_data.interpolatedRefPosForTime(tod, max_ref_time_diff);
+        tie(ref_pos, ok) = target_data.interpolatedRefPos(tst_cnt, max_ref_time_diff);
 
 //        ref_pos = ret_pos.first;
 //        ok = ret_pos.second;
@@ -362,17 +362,18 @@ std::shared_ptr<EvaluationRequirementResult::Single> Detection::evaluate (
             continue;
         }
 
-        has_ground_bit = target_data.hasTstGroundBitForTime(tod);
+        has_ground_bit = target_data.hasTstGroundBit(tst_cnt);
 
         if (has_ground_bit)
-            ground_bit_set = target_data.tstGroundBitForTime(tod);
+            ground_bit_set = target_data.tstGroundBit(tst_cnt);
         else
             ground_bit_set = false;
 
         if (!ground_bit_set)
-            tie(has_ground_bit, ground_bit_set) = target_data.interpolatedRefGroundBitForTime(tod, 15.0);
+            tie(has_ground_bit, ground_bit_set) = target_data.interpolatedRefGroundBit(tst_cnt, 15.0);
 
-        is_inside = sector_layer.isInside(ref_pos, has_ground_bit, ground_bit_set);
+        is_inside = target_data.isInterpolatedRefPosInside(
+                    sector_layer, tst_cnt, ref_pos, has_ground_bit, ground_bit_set);
 
         if (!is_inside)
         {
@@ -433,7 +434,7 @@ std::shared_ptr<EvaluationRequirementResult::Single> Detection::evaluate (
                             +", "+String::timeStringFromDouble(tod)+"]\n";
 
                     DetectionDetail detail{tod, d_tod, true,
-                                target_data.tstPosForTime(tod), is_inside_ref_time_period,
+                                target_data.tstPos(tst_cnt), is_inside_ref_time_period,
                                 sum_missed_uis, comment};
 
                     assert (target_data.hasRefPosForTime(ref_periods.period(period_index).begin()));
@@ -625,5 +626,21 @@ unsigned int Detection::getNumMisses(float d_tod)
     return floor(d_tod/update_interval_s_);
 }
 
+std::shared_ptr<EvaluationRequirementResult::Single> Detection::restore (
+        const nlohmann::json& j, const EvaluationTargetData& target_data, std::shared_ptr<Base> instance,
+        const SectorLayer& sector_layer)
+{
+    TimePeriodCollection ref_periods;
+
+    for (const auto& period_it : j.at("ref_periods"))
+        ref_periods.add({period_it.at(0).get<float>(), period_it.at(1).get<float>()});
+
+    DetectionDetails details;
+    details.fromJSON(j.at("details"));
+
+    return make_shared<EvaluationRequirementResult::SingleDetection>(
+                "UTN:"+to_string(target_data.utn_), instance, sector_layer, target_data.utn_, &target_data,
+                eval_man_, j.at("sum_uis").get<int>(), j.at("missed_uis").get<int>(), ref_periods, details);
+}
 
 }
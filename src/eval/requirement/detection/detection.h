@@ -19,6 +19,7 @@
 #define EVALUATIONREQUIREMENTDETECTION_H
 
 #include "eval/requirement/base/base.h"
+#include "eval/requirement/detailcolumns.h"
 #include "evaluationtargetposition.h"
 
 #include <QVariant>
@@ -57,6 +58,108 @@ public:
     EvaluationTargetPosition pos_last;
 };
 
+/// @brief Detection details of a target as columns, materialized as DetectionDetail on access
+class DetectionDetails
+{
+public:
+    typedef DetailIterator<DetectionDetails, DetectionDetail> const_iterator;
+
+    void push_back (const DetectionDetail& detail)
+    {
+        tods_.push_back(detail.tod_);
+        d_tod_.push_back(detail.d_tod_);
+        miss_occurred_.push_back(detail.miss_occurred_);
+        pos_current_.push_back(detail.pos_current_);
+        ref_exists_.push_back(detail.ref_exists_);
+        missed_uis_.push_back(detail.missed_uis_);
+        comments_.push_back(detail.comment_);
+        max_gap_uis_.push_back(detail.max_gap_uis_);
+        no_ref_uis_.push_back(detail.no_ref_uis_);
+        has_last_position_.push_back(detail.has_last_position_);
+        pos_last_.push_back(detail.pos_last);
+    }
+
+    DetectionDetail at (size_t index) const
+    {
+        DetectionDetail detail {tods_.at(index), d_tod_.at(index), miss_occurred_.at(index), pos_current_.at(index),
+                    ref_exists_.at(index), missed_uis_.at(index), comments_.at(index)};
+
+        detail.max_gap_uis_ = max_gap_uis_.at(index);
+        detail.no_ref_uis_ = no_ref_uis_.at(index);
+        detail.has_last_position_ = has_last_position_.at(index);
+        detail.pos_last = pos_last_.at(index);
+
+        return detail;
+    }
+
+    size_t size() const { return tods_.size(); }
+
+    const_iterator begin() const { return {*this, 0}; }
+    const_iterator end() const { return {*this, size()}; }
+
+    void shrink_to_fit()
+    {
+        tods_.shrink_to_fit();
+        d_tod_.shrink_to_fit();
+        miss_occurred_.shrink_to_fit();
+        pos_current_.shrink_to_fit();
+        ref_exists_.shrink_to_fit();
+        missed_uis_.shrink_to_fit();
+        comments_.shrink_to_fit();
+        max_gap_uis_.shrink_to_fit();
+        no_ref_uis_.shrink_to_fit();
+        has_last_position_.shrink_to_fit();
+        pos_last_.shrink_to_fit();
+    }
+
+    nlohmann::json toJSON() const
+    {
+        nlohmann::json j;
+
+        j["tods"] = tods_;
+        j["d_tod"] = d_tod_.toJSON();
+        j["miss_occurred"] = miss_occurred_;
+        j["pos_current"] = pos_current_.toJSON();
+        j["ref_exists"] = ref_exists_;
+        j["missed_uis"] = missed_uis_;
+        j["comments"] = comments_.toJSON();
+        j["max_gap_uis"] = max_gap_uis_;
+        j["no_ref_uis"] = no_ref_uis_;
+        j["has_last_position"] = has_last_position_;
+        j["pos_last"] = pos_last_.toJSON();
+
+        return j;
+    }
+
+    void fromJSON (const nlohmann::json& j)
+    {
+        tods_ = j.at("tods").get<std::vector<float>>();
+        d_tod_.fromJSON(j.at("d_tod"));
+        miss_occurred_ = j.at("miss_occurred").get<std::vector<bool>>();
+        pos_current_.fromJSON(j.at("pos_current"));
+        ref_exists_ = j.at("ref_exists").get<std::vector<bool>>();
+        missed_uis_ = j.at("missed_uis").get<std::vector<int>>();
+        comments_.fromJSON(j.at("comments"));
+        max_gap_uis_ = j.at("max_gap_uis").get<std::vector<int>>();
+        no_ref_uis_ = j.at("no_ref_uis").get<std::vector<int>>();
+        has_last_position_ = j.at("has_last_position").get<std::vector<bool>>();
+        pos_last_.fromJSON(j.at("pos_last"));
+    }
+
+protected:
+    std::vector<float> tods_;
+    OptionalColumn<float> d_tod_;
+    std::vector<bool> miss_occurred_;
+    PositionColumn pos_current_;
+    std::vector<bool> ref_exists_;
+    std::vector<int> missed_uis_;
+    CommentColumn comments_;
+    std::vector<int> max_gap_uis_;
+    std::vector<int> no_ref_uis_;
+    std::vector<bool> has_last_position_;
+    PositionColumn pos_last_;
+};
+
 class Detection : public Base
 {
 public:
@@ -89,6 +192,9 @@ public:
     virtual std::shared_ptr<EvaluationRequirementResult::Single> evaluate (
             const EvaluationTargetData& target_data, std::shared_ptr<Base> instance,
             const SectorLayer& sector_layer) override;
+    virtual std::shared_ptr<EvaluationRequirementResult::Single> restore (
+            const nlohmann::json& j, const EvaluationTargetData& target_data, std::shared_ptr<Base> instance,
+            const SectorLayer& sector_layer) override;
 
 
 
@@ -76,19 +76,19 @@ std::shared_ptr<EvaluationRequirementResult::Single> ExtraData::evaluate (
     bool inside;
 
     {
-        const std::multimap<float, unsigned int>& ref_data = target_data.refData();
+        const TargetUpdates& ref_data = target_data.refData();
 
         bool first {true};
 
-        for (auto& ref_it : ref_data)
+        for (unsigned int ref_cnt=0; ref_cnt < ref_data.size(); ++ref_cnt)
         {
-            tod = ref_it.first;
+            tod = ref_data.tods_[ref_cnt];
 
             // for ref
             tie (has_ground_bit, ground_bit_set) = target_data.tstGroundBitForTimeInterpolated(tod);
 
-            inside = target_data.hasRefPosForTime(tod)
-                    && sector_layer.isInside(target_data.refPosForTime(tod), has_ground_bit, ground_bit_set);
+            inside = target_data.isRefPosInside(sector_layer, ref_cnt, target_data.refPos(ref_cnt),
+                                                has_ground_bit, ground_bit_set);
 
             if (inside)
                 ++num_ref_inside;
@@ -120,18 +120,17 @@ std::shared_ptr<EvaluationRequirementResult::Single> ExtraData::evaluate (
     unsigned int num_extra = 0;
     EvaluationTargetPosition tst_pos;
 
-    vector<ExtraDataDetail> details;
+    ExtraDataDetails details;
     bool skip_no_data_details = eval_man_.resultsGenerator().skipNoDataDetails();
 
     {
-        const std::multimap<float, unsigned int>& tst_data = target_data.tstData();
+        const TargetUpdates& tst_data = target_data.tstData();
 
-        for (auto& tst_it : tst_data)
+        for (unsigned int tst_cnt=0; tst_cnt < tst_data.size(); ++tst_cnt)
         {
-            tod = tst_it.first;
+            tod = tst_data.tods_[tst_cnt];
 
-            assert (target_data.hasTstPosForTime(tod));
-            tst_pos = target_data.tstPosForTime(tod);
+            tst_pos = target_data.tstPos(tst_cnt);
 
             is_inside_ref_time_period = ref_periods.isInside(tod);
 
@@ -144,17 +143,18 @@ std::shared_ptr<EvaluationRequirementResult::Single> ExtraData::evaluate (
 
             // no ref
 
-            has_ground_bit = target_data.hasTstGroundBitForTime(tod);
+            has_ground_bit = target_data.hasTstGroundBit(tst_cnt);
 
             if (has_ground_bit)
-                ground_bit_set = target_data.tstGroundBitForTime(tod);
+                ground_bit_set = target_data.tstGroundBit(tst_cnt);
             else
                 ground_bit_set = false;
 
             if (!ground_bit_set)
-                tie(has_ground_bit, ground_bit_set) = target_data.interpolatedRefGroundBitForTime(tod, 15.0);
+                tie(has_ground_bit, ground_bit_set) = target_data.interpolatedRefGroundBit(tst_cnt, 15.0);
 
-            inside = sector_layer.isInside(tst_pos, has_ground_bit, ground_bit_set);
+            inside = target_data.isTstPosInside(
+                        sector_layer, tst_cnt, tst_pos, has_ground_bit, ground_bit_set);
 
             if (inside)
             {
@@ -197,4 +197,18 @@ std::shared_ptr<EvaluationRequirementResult::Single> ExtraData::evaluate (
                 "UTN:"+to_string(target_data.utn_), instance, sector_layer, target_data.utn_, &target_data,
                 eval_man_, ignore, num_extra, num_ok, has_extra_test_data, details);
 }
+
+std::shared_ptr<EvaluationRequirementResult::Single> ExtraData::restore (
+        const nlohmann::json& j, const EvaluationTargetData& target_data, std::shared_ptr<Base> instance,
+        const SectorLayer& sector_layer)
+{
+    ExtraDataDetails details;
+    details.fromJSON(j.at("details"));
+
+    return make_shared<EvaluationRequirementResult::SingleExtraData>(
+                "UTN:"+to_string(target_data.utn_), instance, sector_layer, target_data.utn_, &target_data,
+                eval_man_, j.at("ignore").get<bool>(), j.at("num_extra").get<unsigned int>(),
+                j.at("num_ok").get<unsigned int>(), j.at("has_extra_test_data").get<bool>(), details);
+}
+
 }
@@ -19,6 +19,7 @@
 #define EVALUATIONREQUIREMENTEXTRADATA_H
 
 #include "eval/requirement/base/base.h"
+#include "eval/requirement/detailcolumns.h"
 #include "evaluationtargetposition.h"
 
 #include <QVariant>
@@ -47,6 +48,76 @@ public:
     std::string comment_;
 };
 
+/// @brief Extra data details of a target as columns, materialized as ExtraDataDetail on access
+class ExtraDataDetails
+{
+public:
+    typedef DetailIterator<ExtraDataDetails, ExtraDataDetail> const_iterator;
+
+    void push_back (const ExtraDataDetail& detail)
+    {
+        tods_.push_back(detail.tod_);
+        pos_current_.push_back(detail.pos_current_);
+        inside_.push_back(detail.inside_);
+        extra_.push_back(detail.extra_);
+        ref_exists_.push_back(detail.ref_exists_);
+        comments_.push_back(detail.comment_);
+    }
+
+    ExtraDataDetail at (size_t index) const
+    {
+        return {tods_.at(index), pos_current_.at(index), inside_.at(index), extra_.at(index),
+                    ref_exists_.at(index), comments_.at(index)};
+    }
+
+    size_t size() const { return tods_.size(); }
+
+    const_iterator begin() const { return {*this, 0}; }
+    const_iterator end() const { return {*this, size()}; }
+
+    void shrink_to_fit()
+    {
+        tods_.shrink_to_fit();
+        pos_current_.shrink_to_fit();
+        inside_.shrink_to_fit();
+        extra_.shrink_to_fit();
+        ref_exists_.shrink_to_fit();
+        comments_.shrink_to_fit();
+    }
+
+    nlohmann::json toJSON() const
+    {
+        nlohmann::json j;
+
+        j["tods"] = tods_;
+        j["pos_current"] = pos_current_.toJSON();
+        j["inside"] = inside_;
+        j["extra"] = extra_;
+        j["ref_exists"] = ref_exists_;
+        j["comments"] = comments_.toJSON();
+
+        return j;
+    }
+
+    void fromJSON (const nlohmann::json& j)
+    {
+        tods_ = j.at("tods").get<std::vector<float>>();
+        pos_current_.fromJSON(j.at("pos_current"));
+        inside_ = j.at("inside").get<std::vector<bool>>();
+        extra_ = j.at("extra").get<std::vector<bool>>();
+        ref_exists_ = j.at("ref_exists").get<std::vector<bool>>();
+        comments_.fromJSON(j.at("comments"));
+    }
+
+protected:
+    std::vector<float> tods_;
+    PositionColumn pos_current_;
+    std::vector<bool> inside_;
+    std::vector<bool> extra_;
+    std::vector<bool> ref_exists_;
+    CommentColumn comments_;
+};
+
 class ExtraData : public Base
 {
 public:
@@ -64,6 +135,9 @@ public:
     virtual std::shared_ptr<EvaluationRequirementResult::Single> evaluate (
             const EvaluationTargetData& target_data, std::shared_ptr<Base> instance,
             const SectorLayer& sector_layer) override;
+    virtual std::shared_ptr<EvaluationRequirementResult::Single> restore (
+            const nlohmann::json& j, const EvaluationTargetData& target_data, std::shared_ptr<Base> instance,
+            const SectorLayer& sector_layer) override;
 
 protected:
     float min_duration_{0};
@@ -67,7 +67,7 @@ std::shared_ptr<EvaluationRequirementResult::Single> ExtraTrack::evaluate (
 
     float max_ref_time_diff = eval_man_.maxRefTimeDiff();
 
-    const std::multimap<float, unsigned int>& tst_data = target_data.tstData();
+    const TargetUpdates& tst_data = target_data.tstData();
 
     float tod{0};
     EvaluationTargetPosition tst_pos;
@@ -84,33 +84,34 @@ std::shared_ptr<EvaluationRequirementResult::Single> ExtraTrack::evaluate (
     vector<pair<unsigned int, TimePeriod>> finished_tracks;
     map<unsigned int, TimePeriod> active_tracks;
 
-    for (const auto& tst_id : tst_data)
+    for (unsigned int tst_cnt=0; tst_cnt < tst_data.size(); ++tst_cnt)
     {
-        tod = tst_id.first;
-        tst_pos = target_data.tstPosForTime(tod);
+        tod = tst_data.tods_[tst_cnt];
+        tst_pos = target_data.tstPos(tst_cnt);
 
-        if (!target_data.hasRefDataForTime (tod, max_ref_time_diff))
+        if (!target_data.hasRefData (tst_cnt, max_ref_time_diff))
             continue;
 
-        has_ground_bit = target_data.hasTstGroundBitForTime(tod);
+        has_ground_bit = target_data.hasTstGroundBit(tst_cnt);
 
         if (has_ground_bit)
-            ground_bit_set = target_data.tstGroundBitForTime(tod);
+            ground_bit_set = target_data.tstGroundBit(tst_cnt);
         else
             ground_bit_set = false;
 
         if (!ground_bit_set)
-            tie(has_ground_bit, ground_bit_set) = target_data.interpolatedRefGroundBitForTime(tod, 15.0);
+            tie(has_ground_bit, ground_bit_set) = target_data.interpolatedRefGroundBit(tst_cnt, 15.0);
 
-        is_inside = sector_layer.isInside(tst_pos, has_ground_bit, ground_bit_set);
+        is_inside = target_data.isTstPosInside(
+                    sector_layer, tst_cnt, tst_pos, has_ground_bit, ground_bit_set);
 
         if (!is_inside)
             continue;
 
-        if (!target_data.hasTstTrackNumForTime(tod))
+        if (!target_data.hasTstTrackNum(tst_cnt))
             continue;
 
-        track_num = target_data.tstTrackNumForTime(tod);
+        track_num = target_data.tstTrackNum(tst_cnt);
 
         if (!active_tracks.count(track_num)) // not yet existing
         {
@@ -151,7 +152,7 @@ std::shared_ptr<EvaluationRequirementResult::Single> ExtraTrack::evaluate (
     unsigned int num_extra {0};
     unsigned int num_ok {0};
 
-    std::vector<EvaluationRequirement::ExtraTrackDetail> details;
+    EvaluationRequirement::ExtraTrackDetails details;
 
     unsigned int extra_time_period_cnt;
     vector<string> extra_track_nums;
@@ -161,29 +162,30 @@ std::shared_ptr<EvaluationRequirementResult::Single> ExtraTrack::evaluate (
     bool has_tod {false};
     float tod_min, tod_max;
 
-    for (const auto& tst_id : tst_data)
+    for (unsigned int tst_cnt=0; tst_cnt < tst_data.size(); ++tst_cnt)
     {
         ++num_pos;
 
-        tod = tst_id.first;
-        tst_pos = target_data.tstPosForTime(tod);
+        tod = tst_data.tods_[tst_cnt];
+        tst_pos = target_data.tstPos(tst_cnt);
 
-        has_track_num = target_data.hasTstTrackNumForTime(tod);
+        has_track_num = target_data.hasTstTrackNum(tst_cnt);
 
         if (has_track_num)
-            track_num = target_data.tstTrackNumForTime(tod);
+            track_num = target_data.tstTrackNum(tst_cnt);
 
-        has_ground_bit = target_data.hasTstGroundBitForTime(tod);
+        has_ground_bit = target_data.hasTstGroundBit(tst_cnt);
 
         if (has_ground_bit)
-            ground_bit_set = target_data.tstGroundBitForTime(tod);
+            ground_bit_set = target_data.tstGroundBit(tst_cnt);
         else
             ground_bit_set = false;
 
         if (!ground_bit_set)
-            tie(has_ground_bit, ground_bit_set) = target_data.interpolatedRefGroundBitForTime(tod, 15.0);
+            tie(has_ground_bit, ground_bit_set) = target_data.interpolatedRefGroundBit(tst_cnt, 15.0);
 
-        is_inside = sector_layer.isInside(tst_pos, has_ground_bit, ground_bit_set);
+        is_inside = target_data.isTstPosInside(
+                    sector_layer, tst_cnt, tst_pos, has_ground_bit, ground_bit_set);
 
 
         if (!is_inside)
@@ -267,4 +269,18 @@ std::shared_ptr<EvaluationRequirementResult::Single> ExtraTrack::evaluate (
                 "UTN:"+to_string(target_data.utn_), instance, sector_layer, target_data.utn_, &target_data,
                 eval_man_, ignore, num_pos_inside, num_extra, num_ok, details);
 }
+
+std::shared_ptr<EvaluationRequirementResult::Single> ExtraTrack::restore (
+        const nlohmann::json& j, const EvaluationTargetData& target_data, std::shared_ptr<Base> instance,
+        const SectorLayer& sector_layer)
+{
+    ExtraTrackDetails details;
+    details.fromJSON(j.at("details"));
+
+    return make_shared<EvaluationRequirementResult::SingleExtraTrack>(
+                "UTN:"+to_string(target_data.utn_), instance, sector_layer, target_data.utn_, &target_data,
+                eval_man_, j.at("ignore").get<bool>(), j.at("num_inside").get<unsigned int>(),
+                j.at("num_extra").get<unsigned int>(), j.at("num_ok").get<unsigned int>(), details);
+}
+
 }
@@ -19,6 +19,7 @@
 #define EVALUATIONREQUIREMENTEXTRATRACK_H
 
 #include "eval/requirement/base/base.h"
+#include "eval/requirement/detailcolumns.h"
 #include "evaluationtargetposition.h"
 
 #include <QVariant>
@@ -46,6 +47,76 @@ public:
     std::string comment_;
 };
 
+/// @brief Extra track details of a target as columns, materialized as ExtraTrackDetail on access
+class ExtraTrackDetails
+{
+public:
+    typedef DetailIterator<ExtraTrackDetails, ExtraTrackDetail> const_iterator;
+
+    void push_back (const ExtraTrackDetail& detail)
+    {
+        tods_.push_back(detail.tod_);
+        pos_current_.push_back(detail.pos_current_);
+        inside_.push_back(detail.inside_);
+        track_num_.push_back(detail.track_num_);
+        extra_.push_back(detail.extra_);
+        comments_.push_back(detail.comment_);
+    }
+
+    ExtraTrackDetail at (size_t index) const
+    {
+        return {tods_.at(index), pos_current_.at(index), inside_.at(index), track_num_.at(index),
+                    extra_.at(index), comments_.at(index)};
+    }
+
+    size_t size() const { return tods_.size(); }
+
+    const_iterator begin() const { return {*this, 0}; }
+    const_iterator end() const { return {*this, size()}; }
+
+    void shrink_to_fit()
+    {
+        tods_.shrink_to_fit();
+        pos_current_.shrink_to_fit();
+        inside_.shrink_to_fit();
+        track_num_.shrink_to_fit();
+        extra_.shrink_to_fit();
+        comments_.shrink_to_fit();
+    }
+
+    nlohmann::json toJSON() const
+    {
+        nlohmann::json j;
+
+        j["tods"] = tods_;
+        j["pos_current"] = pos_current_.toJSON();
+        j["inside"] = inside_;
+        j["track_num"] = track_num_.toJSON();
+        j["extra"] = extra_;
+        j["comments"] = comments_.toJSON();
+
+        return j;
+    }
+
+    void fromJSON (const nlohmann::json& j)
+    {
+        tods_ = j.at("tods").get<std::vector<float>>();
+        pos_current_.fromJSON(j.at("pos_current"));
+        inside_ = j.at("inside").get<std::vector<bool>>();
+        track_num_.fromJSON(j.at("track_num"));
+        extra_ = j.at("extra").get<std::vector<bool>>();
+        comments_.fromJSON(j.at("comments"));
+    }
+
+protected:
+    std::vector<float> tods_;
+    PositionColumn pos_current_;
+    std::vector<bool> inside_;
+    OptionalColumn<unsigned int> track_num_;
+    std::vector<bool> extra_;
+    CommentColumn comments_;
+};
+
 class ExtraTrack : public Base
 {
 public:
@@ -63,6 +134,9 @@ public:
     virtual std::shared_ptr<EvaluationRequirementResult::Single> evaluate (
             const EvaluationTargetData& target_data, std::shared_ptr<Base> instance,
             const SectorLayer& sector_layer) override;
+    virtual std::shared_ptr<EvaluationRequirementResult::Single> restore (
+            const nlohmann::json& j, const EvaluationTargetData& target_data, std::shared_ptr<Base> instance,
+            const SectorLayer& sector_layer) override;
 
 protected:
     float min_duration_{0};
@@ -54,12 +54,12 @@ std::shared_ptr<EvaluationRequirementResult::Single> IdentificationCorrect::eval
 
         return make_shared<EvaluationRequirementResult::SingleIdentificationCorrect>(
                     "UTN:"+to_string(target_data.utn_), instance, sector_layer, target_data.utn_, &target_data,
-                    eval_man_, 0, 0, 0, 0, 0, 0, 0, vector<CorrectnessDetail>{});
+                    eval_man_, 0, 0, 0, 0, 0, 0, 0, CorrectnessDetails{});
     }
 
     float max_ref_time_diff = eval_man_.maxRefTimeDiff();
 
-    const std::multimap<float, unsigned int>& tst_data = target_data.tstData();
+    const TargetUpdates& tst_data = target_data.tstData();
 
     float tod{0};
 
@@ -71,7 +71,7 @@ std::shared_ptr<EvaluationRequirementResult::Single> IdentificationCorrect::eval
     unsigned int num_correct {0};
     unsigned int num_not_correct {0};
 
-    vector<CorrectnessDetail> details;
+    CorrectnessDetails details;
     EvaluationTargetPosition pos_current;
 
     bool ref_exists;
@@ -108,7 +108,7 @@ std::shared_ptr<EvaluationRequirementResult::Single> IdentificationCorrect::eval
     bool all_correct;
     bool result_ok;
 
-    for (const auto& tst_id : tst_data)
+    for (unsigned int tst_cnt=0; tst_cnt < tst_data.size(); ++tst_cnt)
     {
         ref_exists = false;
         is_inside = false;
@@ -118,10 +118,10 @@ std::shared_ptr<EvaluationRequirementResult::Single> IdentificationCorrect::eval
 
         ++num_updates;
 
-        tod = tst_id.first;
-        pos_current = target_data.tstPosForTime(tod);
+        tod = tst_data.tods_[tst_cnt];
+        pos_current = target_data.tstPos(tst_cnt);
 
-        if (!target_data.hasRefDataForTime (tod, max_ref_time_diff))
+        if (!target_data.hasRefData (tst_cnt, max_ref_time_diff))
         {
             if (!skip_no_data_details)
                 details.push_back({tod, pos_current,
@@ -133,7 +133,7 @@ std::shared_ptr<EvaluationRequirementResult::Single> IdentificationCorrect::eval
             continue;
         }
 
-        ret_pos = target_data.interpolatedRefPosForTime(tod, max_ref_time_diff);
+        ret_pos = target_data.interpolatedRefPos(tst_cnt, max_ref_time_diff);
 
         ref_pos = ret_pos.first;
         ok = ret_pos.second;
@@ -151,17 +151,18 @@ std::shared_ptr<EvaluationRequirementResult::Single> IdentificationCorrect::eval
         }
         ref_exists = true;
 
-        has_ground_bit = target_data.hasTstGroundBitForTime(tod);
+        has_ground_bit = target_data.hasTstGroundBit(tst_cnt);
 
         if (has_ground_bit)
-            ground_bit_set = target_data.tstGroundBitForTime(tod);
+            ground_bit_set = target_data.tstGroundBit(tst_cnt);
         else
             ground_bit_set = false;
 
         if (!ground_bit_set)
-            tie(has_ground_bit, ground_bit_set) = target_data.interpolatedRefGroundBitForTime(tod, 15.0);
+            tie(has_ground_bit, ground_bit_set) = target_data.interpolatedRefGroundBit(tst_cnt, 15.0);
 
-        is_inside = sector_layer.isInside(ref_pos, has_ground_bit, ground_bit_set);
+        is_inside = target_data.isInterpolatedRefPosInside(
+                    sector_layer, tst_cnt, ref_pos, has_ground_bit, ground_bit_set);
 
         if (!is_inside)
         {
@@ -176,9 +177,9 @@ std::shared_ptr<EvaluationRequirementResult::Single> IdentificationCorrect::eval
         }
         ++num_pos_inside;
 
-        tie(cmp_res_ti, cmp_res_ti_comment) = compareTi(tod, target_data, max_ref_time_diff);
-        tie(cmp_res_ta, cmp_res_ta_comment) = compareTa(tod, target_data, max_ref_time_diff);
-        tie(cmp_res_ma, cmp_res_ma_comment) = compareModeA(tod, target_data, max_ref_time_diff);
+        tie(cmp_res_ti, cmp_res_ti_comment) = compareTi(tst_cnt, target_data, max_ref_time_diff);
+        tie(cmp_res_ta, cmp_res_ta_comment) = compareTa(tst_cnt, target_data, max_ref_time_diff);
+        tie(cmp_res_ma, cmp_res_ma_comment) = compareModeA(tst_cnt, target_data, max_ref_time_diff);
 
         any_correct = false;
         all_correct = true;
@@ -311,4 +312,19 @@ bool IdentificationCorrect::useMsTi() const
     return use_ms_ti_;
 }
 
+std::shared_ptr<EvaluationRequirementResult::Single> IdentificationCorrect::restore (
+        const nlohmann::json& j, const EvaluationTargetData& target_data, std::shared_ptr<Base> instance,
+        const SectorLayer& sector_layer)
+{
+    CorrectnessDetails details;
+    details.fromJSON(j.at("details"));
+
+    return make_shared<EvaluationRequirementResult::SingleIdentificationCorrect>(
+                "UTN:"+to_string(target_data.utn_), instance, sector_layer, target_data.utn_, &target_data,
+                eval_man_, j.at("num_updates").get<unsigned int>(), j.at("num_no_ref_pos").get<unsigned int>(),
+                j.at("num_no_ref_id").get<unsigned int>(), j.at("num_pos_outside").get<unsigned int>(),
+                j.at("num_pos_inside").get<unsigned int>(), j.at("num_correct").get<unsigned int>(),
+                j.at("num_not_correct").get<unsigned int>(), details);
+}
+
 }
@@ -44,7 +44,7 @@ namespace EvaluationRequirement
 
         float max_ref_time_diff = eval_man_.maxRefTimeDiff();
 
-        const std::multimap<float, unsigned int>& tst_data = target_data.tstData();
+        const TargetUpdates& tst_data = target_data.tstData();
 
         float tod{0};
 
@@ -57,7 +57,7 @@ namespace EvaluationRequirement
         int num_correct {0};
         int num_false {0};
 
-        vector<CheckDetail> details;
+        CheckDetails details;
         EvaluationTargetPosition pos_current;
         bool code_ok;
 
@@ -76,7 +76,7 @@ namespace EvaluationRequirement
         bool has_ground_bit;
         bool ground_bit_set;
 
-        for (const auto& tst_id : tst_data)
+        for (unsigned int tst_cnt=0; tst_cnt < tst_data.size(); ++tst_cnt)
         {
             ref_exists = false;
             is_inside = false;
@@ -86,10 +86,10 @@ namespace EvaluationRequirement
 
             ++num_updates;
 
-            tod = tst_id.first;
-            pos_current = target_data.tstPosForTime(tod);
+            tod = tst_data.tods_[tst_cnt];
+            pos_current = target_data.tstPos(tst_cnt);
 
-            if (!target_data.hasRefDataForTime (tod, max_ref_time_diff))
+            if (!target_data.hasRefData (tst_cnt, max_ref_time_diff))
             {
                 if (!skip_no_data_details)
                     details.push_back({tod, pos_current,
@@ -101,7 +101,7 @@ namespace EvaluationRequirement
                 continue;
             }
 
-            ret_pos = target_data.interpolatedRefPosForTime(tod, max_ref_time_diff);
+            ret_pos = target_data.interpolatedRefPos(tst_cnt, max_ref_time_diff);
 
             ref_pos = ret_pos.first;
             ok = ret_pos.second;
@@ -119,17 +119,18 @@ namespace EvaluationRequirement
             }
             ref_exists = true;
 
-            has_ground_bit = target_data.hasTstGroundBitForTime(tod);
+            has_ground_bit = target_data.hasTstGroundBit(tst_cnt);
 
             if (has_ground_bit)
-                ground_bit_set = target_data.tstGroundBitForTime(tod);
+                ground_bit_set = target_data.tstGroundBit(tst_cnt);
             else
                 ground_bit_set = false;
 
             if (!ground_bit_set)
-                tie(has_ground_bit, ground_bit_set) = target_data.interpolatedRefGroundBitForTime(tod, 15.0);
+                tie(has_ground_bit, ground_bit_set) = target_data.interpolatedRefGroundBit(tst_cnt, 15.0);
 
-            is_inside = sector_layer.isInside(ref_pos, has_ground_bit, ground_bit_set);
+            is_inside = target_data.isInterpolatedRefPosInside(
+                        sector_layer, tst_cnt, ref_pos, has_ground_bit, ground_bit_set);
 
             if (!is_inside)
             {
@@ -144,7 +145,7 @@ namespace EvaluationRequirement
             }
             ++num_pos_inside;
 
-            tie(cmp_res, comment) = compareModeA(tod, target_data, max_ref_time_diff);
+            tie(cmp_res, comment) = compareModeA(tst_cnt, target_data, max_ref_time_diff);
 
             code_ok = true;
             if (cmp_res == ValueComparisonResult::Unknown_NoRefData)
@@ -199,4 +200,19 @@ namespace EvaluationRequirement
                     num_unknown, num_correct, num_false, details);
     }
 
+    std::shared_ptr<EvaluationRequirementResult::Single> ModeAFalse::restore (
+            const nlohmann::json& j, const EvaluationTargetData& target_data, std::shared_ptr<Base> instance,
+            const SectorLayer& sector_layer)
+    {
+        CheckDetails details;
+        details.fromJSON(j.at("details"));
+
+        return make_shared<EvaluationRequirementResult::SingleModeAFalse>(
+                    "UTN:"+to_string(target_data.utn_), instance, sector_layer, target_data.utn_, &target_data,
+                    eval_man_, j.at("num_updates").get<int>(), j.at("num_no_ref_pos").get<int>(),
+                    j.at("num_no_ref_val").get<int>(), j.at("num_pos_outside").get<int>(),
+                    j.at("num_pos_inside").get<int>(), j.at("num_unknown").get<int>(),
+                    j.at("num_correct").get<int>(), j.at("num_false").get<int>(), details);
+    }
+
 }
@@ -45,7 +45,7 @@ namespace EvaluationRequirement
 
         float max_ref_time_diff = eval_man_.maxRefTimeDiff();
 
-        const std::multimap<float, unsigned int>& tst_data = target_data.tstData();
+        const TargetUpdates& tst_data = target_data.tstData();
 
         float tod{0};
 
@@ -61,7 +61,7 @@ namespace EvaluationRequirement
         int num_present_id {0};
         int num_missing_id {0};
 
-        vector<PresentDetail> details;
+        PresentDetails details;
         EvaluationTargetPosition pos_current;
         //unsigned int code;
         //bool code_ok;
@@ -85,7 +85,7 @@ namespace EvaluationRequirement
         bool has_ground_bit;
         bool ground_bit_set;
 
-        for (const auto& tst_id : tst_data)
+        for (unsigned int tst_cnt=0; tst_cnt < tst_data.size(); ++tst_cnt)
         {
             //ref_exists = false;
             is_inside = false;
@@ -95,10 +95,10 @@ namespace EvaluationRequirement
 
             ++num_updates;
 
-            tod = tst_id.first;
-            pos_current = target_data.tstPosForTime(tod);
+            tod = tst_data.tods_[tst_cnt];
+            pos_current = target_data.tstPos(tst_cnt);
 
-            if (!target_data.hasRefDataForTime (tod, max_ref_time_diff))
+            if (!target_data.hasRefData (tst_cnt, max_ref_time_diff))
             {
                 if (!skip_no_data_details)
                     details.push_back({tod, pos_current,
@@ -110,7 +110,7 @@ namespace EvaluationRequirement
                 continue;
             }
 
-            ret_pos = target_data.interpolatedRefPosForTime(tod, max_ref_time_diff);
+            ret_pos = target_data.interpolatedRefPos(tst_cnt, max_ref_time_diff);
 
             ref_pos = ret_pos.first;
             ok = ret_pos.second;
@@ -126,17 +126,18 @@ namespace EvaluationRequirement
                 ++num_no_ref_pos;
                 continue;
             }
-            has_ground_bit = target_data.hasTstGroundBitForTime(tod);
+            has_ground_bit = target_data.hasTstGroundBit(tst_cnt);
 
             if (has_ground_bit)
-                ground_bit_set = target_data.tstGroundBitForTime(tod);
+                ground_bit_set = target_data.tstGroundBit(tst_cnt);
             else
                 ground_bit_set = false;
 
             if (!ground_bit_set)
-                tie(has_ground_bit, ground_bit_set) = target_data.interpolatedRefGroundBitForTime(tod, 15.0);
+                tie(has_ground_bit, ground_bit_set) = target_data.interpolatedRefGroundBit(tst_cnt, 15.0);
 
-            is_inside = sector_layer.isInside(ref_pos, has_ground_bit, ground_bit_set);
+            is_inside = target_data.isInterpolatedRefPosInside(
+                        sector_layer, tst_cnt, ref_pos, has_ground_bit, ground_bit_set);
 
             if (!is_inside)
             {
@@ -155,7 +156,7 @@ namespace EvaluationRequirement
             // check if ref code exists
             code_present_ref = false;
 
-            tie(ref_lower, ref_upper) = target_data.refTimesFor(tod, max_ref_time_diff);
+            tie(ref_lower, ref_upper) = target_data.refTimes(tst_cnt, max_ref_time_diff);
 
             if ((ref_lower != -1 || ref_upper != -1)) // ref times possible
             {
@@ -166,7 +167,7 @@ namespace EvaluationRequirement
                 }
             }
 
-            code_present_tst = target_data.hasTstModeCForTime(tod);
+            code_present_tst = target_data.hasTstModeC(tst_cnt);
 
             code_missing = false;
 
@@ -217,4 +218,20 @@ namespace EvaluationRequirement
                     eval_man_, num_updates, num_no_ref_pos, num_pos_outside, num_pos_inside,
                     num_no_ref_id, num_present_id, num_missing_id, details);
     }
+
+    std::shared_ptr<EvaluationRequirementResult::Single> ModeCPresent::restore (
+            const nlohmann::json& j, const EvaluationTargetData& target_data, std::shared_ptr<Base> instance,
+            const SectorLayer& sector_layer)
+    {
+        PresentDetails details;
+        details.fromJSON(j.at("details"));
+
+        return make_shared<EvaluationRequirementResult::SingleModeCPresent>(
+                    "UTN:"+to_string(target_data.utn_), instance, sector_layer, target_data.utn_, &target_data,
+                    eval_man_, j.at("num_updates").get<int>(), j.at("num_no_ref_pos").get<int>(),
+                    j.at("num_pos_outside").get<int>(), j.at("num_pos_inside").get<int>(),
+                    j.at("num_no_ref_id").get<int>(), j.at("num_present_id").get<int>(),
+                    j.at("num_missing_id").get<int>(), details);
+    }
+
 }
@@ -56,7 +56,7 @@ std::shared_ptr<EvaluationRequirementResult::Single> PositionAcross::evaluate (
 
     float max_ref_time_diff = eval_man_.maxRefTimeDiff();
 
-    const std::multimap<float, unsigned int>& tst_data = target_data.tstData();
+    const TargetUpdates& tst_data = target_data.tstData();
 
     unsigned int num_pos {0};
     unsigned int num_no_ref {0};
@@ -66,7 +66,7 @@ std::shared_ptr<EvaluationRequirementResult::Single> PositionAcross::evaluate (
     unsigned int num_value_ok {0};
     unsigned int num_value_nok {0};
 
-    std::vector<EvaluationRequirement::PositionDetail> details;
+    EvaluationRequirement::PositionDetails details;
 
     float tod{0};
 
@@ -101,16 +101,16 @@ std::shared_ptr<EvaluationRequirementResult::Single> PositionAcross::evaluate (
     bool has_ground_bit;
     bool ground_bit_set;
 
-    for (const auto& tst_id : tst_data)
+    for (unsigned int tst_cnt=0; tst_cnt < tst_data.size(); ++tst_cnt)
     {
         ++num_pos;
 
-        tod = tst_id.first;
-        tst_pos = target_data.tstPosForTime(tod);
+        tod = tst_data.tods_[tst_cnt];
+        tst_pos = target_data.tstPos(tst_cnt);
 
         along_ok = true;
 
-        if (!target_data.hasRefDataForTime (tod, max_ref_time_diff))
+        if (!target_data.hasRefData (tst_cnt, max_ref_time_diff))
         {
             if (!skip_no_data_details)
                 details.push_back({tod, tst_pos,
@@ -124,7 +124,7 @@ std::shared_ptr<EvaluationRequirementResult::Single> PositionAcross::evaluate (
             continue;
         }
 
-        ret_pos = target_data.interpolatedRefPosForTime(tod, max_ref_time_diff);
+        ret_pos = target_data.interpolatedRefPos(tst_cnt, max_ref_time_diff);
 
         ref_pos = ret_pos.first;
         ok = ret_pos.second;
@@ -143,22 +143,23 @@ std::shared_ptr<EvaluationRequirementResult::Single> PositionAcross::evaluate (
             continue;
         }
 
-        ret_spd = target_data.interpolatedRefPosBasedSpdForTime(tod, max_ref_time_diff);
+        ret_spd = target_data.interpolatedRefPosBasedSpd(tst_cnt, max_ref_time_diff);
 
         ref_spd = ret_spd.first;
         assert (ret_pos.second); // must be set of ref pos exists
 
-        has_ground_bit = target_data.hasTstGroundBitForTime(tod);
+        has_ground_bit = target_data.hasTstGroundBit(tst_cnt);
 
         if (has_ground_bit)
-            ground_bit_set = target_data.tstGroundBitForTime(tod);
+            ground_bit_set = target_data.tstGroundBit(tst_cnt);
         else
             ground_bit_set = false;
 
         if (!ground_bit_set)
-            tie(has_ground_bit, ground_bit_set) = target_data.interpolatedRefGroundBitForTime(tod, 15.0);
+            tie(has_ground_bit, ground_bit_set) = target_data.interpolatedRefGroundBit(tst_cnt, 15.0);
 
-        is_inside = sector_layer.isInside(ref_pos, has_ground_bit, ground_bit_set);
+        is_inside = target_data.isInterpolatedRefPosInside(
+                    sector_layer, tst_cnt, ref_pos, has_ground_bit, ground_bit_set);
 
         if (!is_inside)
         {
@@ -271,4 +272,22 @@ std::shared_ptr<EvaluationRequirementResult::Single> PositionAcross::evaluate (
                 values, details);
 }
 
+std::shared_ptr<EvaluationRequirementResult::Single> PositionAcross::restore (
+        const nlohmann::json& j, const EvaluationTargetData& target_data, std::shared_ptr<Base> instance,
+        const SectorLayer& sector_layer)
+{
+    PositionDetails details;
+    details.fromJSON(j.at("details"));
+
+    EvaluationRequirementResult::ValueGroup value_group;
+    value_group.fromJSON(j.at("value_group"));
+
+    return make_shared<EvaluationRequirementResult::SinglePositionAcross>(
+                "UTN:"+to_string(target_data.utn_), instance, sector_layer, target_data.utn_, &target_data,
+                eval_man_, j.at("num_pos").get<unsigned int>(), j.at("num_no_ref").get<unsigned int>(),
+                j.at("num_pos_outside").get<unsigned int>(), j.at("num_pos_inside").get<unsigned int>(),
+                j.at("num_value_ok").get<unsigned int>(), j.at("num_value_nok").get<unsigned int>(),
+                value_group, details);
+}
+
 }
@@ -1,6 +1,7 @@
 #ifndef EVALUATIONREQUIREMENSPEEDDETAIL_H
 #define EVALUATIONREQUIREMENSPEEDDETAIL_H
 
+#include "eval/requirement/detailcolumns.h"
 #include "evaluationtargetposition.h"
 
 #include <QVariant>
@@ -49,6 +50,120 @@ public:
 
     std::string comment_;
 };
+
+/// @brief Speed details of a target as columns, materialized as SpeedDetail on access
+class SpeedDetails
+{
+public:
+    typedef DetailIterator<SpeedDetails, SpeedDetail> const_iterator;
+
+    void push_back (const SpeedDetail& detail)
+    {
+        tods_.push_back(detail.tod_);
+        tst_pos_.push_back(detail.tst_pos_);
+        has_ref_pos_.push_back(detail.has_ref_pos_);
+        ref_pos_.push_back(detail.ref_pos_);
+        pos_inside_.push_back(detail.pos_inside_);
+        offset_.push_back(detail.offset_);
+        check_passed_.push_back(detail.check_passed_);
+        num_pos_.push_back(detail.num_pos_);
+        num_no_ref_.push_back(detail.num_no_ref_);
+        num_inside_.push_back(detail.num_inside_);
+        num_outside_.push_back(detail.num_outside_);
+        num_check_failed_.push_back(detail.num_check_failed_);
+        num_check_passed_.push_back(detail.num_check_passed_);
+        comments_.push_back(detail.comment_);
+    }
+
+    SpeedDetail at (size_t index) const
+    {
+        return {tods_.at(index), tst_pos_.at(index), has_ref_pos_.at(index), ref_pos_.at(index),
+                    pos_inside_.at(index), offset_.at(index), check_passed_.at(index), num_pos_.at(index),
+                    num_no_ref_.at(index), num_inside_.at(index), num_outside_.at(index),
+                    num_check_failed_.at(index), num_check_passed_.at(index), comments_.at(index)};
+    }
+
+    size_t size() const { return tods_.size(); }
+
+    std::vector<double> values() const { return offset_.validValues<double>(); } // valid values in order
+
+    const_iterator begin() const { return {*this, 0}; }
+    const_iterator end() const { return {*this, size()}; }
+
+    void shrink_to_fit()
+    {
+        tods_.shrink_to_fit();
+        tst_pos_.shrink_to_fit();
+        has_ref_pos_.shrink_to_fit();
+        ref_pos_.shrink_to_fit();
+        pos_inside_.shrink_to_fit();
+        offset_.shrink_to_fit();
+        check_passed_.shrink_to_fit();
+        num_pos_.shrink_to_fit();
+        num_no_ref_.shrink_to_fit();
+        num_inside_.shrink_to_fit();
+        num_outside_.shrink_to_fit();
+        num_check_failed_.shrink_to_fit();
+        num_check_passed_.shrink_to_fit();
+        comments_.shrink_to_fit();
+    }
+
+    nlohmann::json toJSON() const
+    {
+        nlohmann::json j;
+
+        j["tods"] = tods_;
+        j["tst_pos"] = tst_pos_.toJSON();
+        j["has_ref_pos"] = has_ref_pos_;
+        j["ref_pos"] = ref_pos_.toJSON();
+        j["pos_inside"] = pos_inside_.toJSON();
+        j["offset"] = offset_.toJSON();
+        j["check_passed"] = check_passed_;
+        j["num_pos"] = num_pos_;
+        j["num_no_ref"] = num_no_ref_;
+        j["num_inside"] = num_inside_;
+        j["num_outside"] = num_outside_;
+        j["num_check_failed"] = num_check_failed_;
+        j["num_check_passed"] = num_check_passed_;
+        j["comments"] = comments_.toJSON();
+
+        return j;
+    }
+
+    void fromJSON (const nlohmann::json& j)
+    {
+        tods_ = j.at("tods").get<std::vector<float>>();
+        tst_pos_.fromJSON(j.at("tst_pos"));
+        has_ref_pos_ = j.at("has_ref_pos").get<std::vector<bool>>();
+        ref_pos_.fromJSON(j.at("ref_pos"));
+        pos_inside_.fromJSON(j.at("pos_inside"));
+        offset_.fromJSON(j.at("offset"));
+        check_passed_ = j.at("check_passed").get<std::vector<bool>>();
+        num_pos_ = j.at("num_pos").get<std::vector<unsigned int>>();
+        num_no_ref_ = j.at("num_no_ref").get<std::vector<unsigned int>>();
+        num_inside_ = j.at("num_inside").get<std::vector<unsigned int>>();
+        num_outside_ = j.at("num_outside").get<std::vector<unsigned int>>();
+        num_check_failed_ = j.at("num_check_failed").get<std::vector<unsigned int>>();
+        num_check_passed_ = j.at("num_check_passed").get<std::vector<unsigned int>>();
+        comments_.fromJSON(j.at("comments"));
+    }
+
+protected:
+    std::vector<float> tods_;
+    PositionColumn tst_pos_;
+    std::vector<bool> has_ref_pos_;
+    PositionColumn ref_pos_;
+    OptionalColumn<bool> pos_inside_;
+    OptionalColumn<float> offset_;
+    std::vector<bool> check_passed_;
+    std::vector<unsigned int> num_pos_;
+    std::vector<unsigned int> num_no_ref_;
+    std::vector<unsigned int> num_inside_;
+    std::vector<unsigned int> num_outside_;
+    std::vector<unsigned int> num_check_failed_;
+    std::vector<unsigned int> num_check_passed_;
+    CommentColumn comments_;
+};
 }
 
 #endif // EVALUATIONREQUIREMENSPEEDDETAIL_H
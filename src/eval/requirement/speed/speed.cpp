@@ -81,7 +81,7 @@ std::shared_ptr<EvaluationRequirementResult::Single> Speed::evaluate (
 
     float max_ref_time_diff = eval_man_.maxRefTimeDiff();
 
-    const std::multimap<float, unsigned int>& tst_data = target_data.tstData();
+    const TargetUpdates& tst_data = target_data.tstData();
 
     unsigned int num_pos {0};
     unsigned int num_no_ref {0};
@@ -94,7 +94,7 @@ std::shared_ptr<EvaluationRequirementResult::Single> Speed::evaluate (
 
     float tmp_threshold_value;
 
-    std::vector<EvaluationRequirement::SpeedDetail> details;
+    EvaluationRequirement::SpeedDetails details;
 
     float tod{0};
 
@@ -132,16 +132,16 @@ std::shared_ptr<EvaluationRequirementResult::Single> Speed::evaluate (
     bool has_ground_bit;
     bool ground_bit_set;
 
-    for (const auto& tst_id : tst_data)
+    for (unsigned int tst_cnt=0; tst_cnt < tst_data.size(); ++tst_cnt)
     {
         ++num_pos;
 
-        tod = tst_id.first;
-        tst_pos = target_data.tstPosForTime(tod);
+        tod = tst_data.tods_[tst_cnt];
+        tst_pos = target_data.tstPos(tst_cnt);
 
         comp_passed = false;
 
-        if (!target_data.hasRefDataForTime (tod, max_ref_time_diff))
+        if (!target_data.hasRefData (tst_cnt, max_ref_time_diff))
         {
             if (!skip_no_data_details)
                 details.push_back({tod, tst_pos,
@@ -155,7 +155,7 @@ std::shared_ptr<EvaluationRequirementResult::Single> Speed::evaluate (
             continue;
         }
 
-        tie(ref_pos, ok) = target_data.interpolatedRefPosForTime(tod, max_ref_time_diff);
+        tie(ref_pos, ok) = target_data.interpolatedRefPos(tst_cnt, max_ref_time_diff);
 
         if (!ok)
         {
@@ -171,17 +171,18 @@ std::shared_ptr<EvaluationRequirementResult::Single> Speed::evaluate (
             continue;
         }
 
-        has_ground_bit = target_data.hasTstGroundBitForTime(tod);
+        has_ground_bit = target_data.hasTstGroundBit(tst_cnt);
 
         if (has_ground_bit)
-            ground_bit_set = target_data.tstGroundBitForTime(tod);
+            ground_bit_set = target_data.tstGroundBit(tst_cnt);
         else
             ground_bit_set = false;
 
         if (!ground_bit_set)
-            tie(has_ground_bit, ground_bit_set) = target_data.interpolatedRefGroundBitForTime(tod, 15.0);
+            tie(has_ground_bit, ground_bit_set) = target_data.interpolatedRefGroundBit(tst_cnt, 15.0);
 
-        is_inside = sector_layer.isInside(ref_pos, has_ground_bit, ground_bit_set);
+        is_inside = target_data.isInterpolatedRefPosInside(
+                    sector_layer, tst_cnt, ref_pos, has_ground_bit, ground_bit_set);
 
         if (!is_inside)
         {
@@ -197,7 +198,7 @@ std::shared_ptr<EvaluationRequirementResult::Single> Speed::evaluate (
         }
         ++num_pos_inside;
 
-        tie (ref_spd, ok) = target_data.interpolatedRefPosBasedSpdForTime(tod, max_ref_time_diff);
+        tie (ref_spd, ok) = target_data.interpolatedRefPosBasedSpd(tst_cnt, max_ref_time_diff);
 
         if (!ok)
         {
@@ -215,7 +216,7 @@ std::shared_ptr<EvaluationRequirementResult::Single> Speed::evaluate (
 
         // ref_spd ok
 
-        if (!target_data.hasTstMeasuredSpeedForTime(tod))
+        if (!target_data.hasTstMeasuredSpeed(tst_cnt))
         {
             if (!skip_no_data_details)
                 details.push_back({tod, tst_pos,
@@ -229,7 +230,7 @@ std::shared_ptr<EvaluationRequirementResult::Single> Speed::evaluate (
             continue;
         }
 
-        tst_spd_ms = target_data.tstMeasuredSpeedForTime (tod);
+        tst_spd_ms = target_data.tstMeasuredSpeed(tst_cnt);
         spd_diff = fabs(ref_spd.speed_ - tst_spd_ms);
 
         if (use_percent_if_higher_ && tst_spd_ms * threshold_percent_ > threshold_value_) // use percent based threshold
@@ -293,4 +294,23 @@ std::shared_ptr<EvaluationRequirementResult::Single> Speed::evaluate (
                 values, details);
 }
 
+std::shared_ptr<EvaluationRequirementResult::Single> Speed::restore (
+        const nlohmann::json& j, const EvaluationTargetData& target_data, std::shared_ptr<Base> instance,
+        const SectorLayer& sector_layer)
+{
+    SpeedDetails details;
+    details.fromJSON(j.at("details"));
+
+    EvaluationRequirementResult::ValueGroup value_group;
+    value_group.fromJSON(j.at("value_group"));
+
+    return make_shared<EvaluationRequirementResult::SingleSpeed>(
+                "UTN:"+to_string(target_data.utn_), instance, sector_layer, target_data.utn_, &target_data,
+                eval_man_, j.at("num_pos").get<unsigned int>(), j.at("num_no_ref").get<unsigned int>(),
+                j.at("num_pos_outside").get<unsigned int>(), j.at("num_pos_inside").get<unsigned int>(),
+                j.at("num_no_tst_value").get<unsigned int>(), j.at("num_comp_failed").get<unsigned int>(),
+                j.at("num_comp_passed").get<unsigned int>(), value_group,
+                details);
+}
+
 }
@@ -68,6 +68,17 @@ namespace EvaluationRequirementResult
         updatePD();
     }
 
+    void JoinedDetection::subtractFromValues (std::shared_ptr<SingleDetection> single_result)
+    {
+        assert (single_result);
+        assert (!single_result->use());
+
+        sum_uis_ -= single_result->sumUIs();
+        missed_uis_ -= single_result->missedUIs();
+
+        updatePD();
+    }
+
     void JoinedDetection::updatePD()
     {
         if (sum_uis_)
@@ -290,4 +301,16 @@ namespace EvaluationRequirementResult
             loginf << "JoinedDetection: updatesToUseChanges: updt result " << result_id_ << " has no data";
     }
 
+    void JoinedDetection::updateToUseChangeOf (std::shared_ptr<Single> result)
+    {
+        std::shared_ptr<SingleDetection> single_result =
+                std::static_pointer_cast<SingleDetection>(result);
+        assert (single_result);
+
+        if (single_result->use())
+            addToValues(single_result);
+        else
+            subtractFromValues(single_result);
+    }
+
 }
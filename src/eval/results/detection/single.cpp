@@ -41,10 +41,12 @@ SingleDetection::SingleDetection(
         const SectorLayer& sector_layer, unsigned int utn, const EvaluationTargetData* target,
         EvaluationManager& eval_man,
         int sum_uis, int missed_uis, TimePeriodCollection ref_periods,
-        std::vector<EvaluationRequirement::DetectionDetail> details)
+        EvaluationRequirement::DetectionDetails details)
     : Single("SingleDetection", result_id, requirement, sector_layer, utn, target, eval_man),
       sum_uis_(sum_uis), missed_uis_(missed_uis), ref_periods_(ref_periods), details_(details)
 {
+    details_.shrink_to_fit();
+
     updatePD();
 }
 
@@ -198,7 +200,7 @@ void SingleDetection::reportDetails(EvaluationResultsReport::Section& utn_req_se
 
     unsigned int detail_cnt = 0;
 
-    for (auto& rq_det_it : details_)
+    for (const auto& rq_det_it : details_)
     {
         if (rq_det_it.d_tod_.isValid())
             utn_req_details_table.addRow(
@@ -248,7 +250,7 @@ std::unique_ptr<nlohmann::json::object_t> SingleDetection::viewableData(
                 = eval_man_.getViewableForEvaluation(utn_, req_grp_id_, result_id_);
         assert (viewable_ptr);
 
-        const EvaluationRequirement::DetectionDetail& detail = details_.at(detail_cnt);
+        EvaluationRequirement::DetectionDetail detail = details_.at(detail_cnt);
 
         (*viewable_ptr)["position_latitude"] = detail.pos_current_.latitude_;
         (*viewable_ptr)["position_longitude"] = detail.pos_current_.longitude_;
@@ -273,7 +275,7 @@ std::unique_ptr<nlohmann::json::object_t> SingleDetection::getTargetErrorsViewab
     bool has_pos = false;
     double lat_min, lat_max, lon_min, lon_max;
 
-    for (auto& detail_it : details_)
+    for (const auto& detail_it : details_)
     {
         if (!detail_it.miss_occurred_)
             continue;
@@ -350,6 +352,22 @@ std::shared_ptr<Joined> SingleDetection::createEmptyJoined(const std::string& re
     return make_shared<JoinedDetection> (result_id, requirement_, sector_layer_, eval_man_);
 }
 
+nlohmann::json SingleDetection::toJSON() const
+{
+    nlohmann::json j;
+
+    j["sum_uis"] = sum_uis_;
+    j["missed_uis"] = missed_uis_;
+    j["ref_periods"] = nlohmann::json::array();
+
+    for (const auto& period_it : ref_periods_)
+        j["ref_periods"].push_back({period_it.begin(), period_it.end()});
+
+    j["details"] = details_.toJSON();
+
+    return j;
+}
+
 int SingleDetection::sumUIs() const
 {
     return sum_uis_;
@@ -360,7 +378,7 @@ int SingleDetection::missedUIs() const
     return missed_uis_;
 }
 
-std::vector<EvaluationRequirement::DetectionDetail>& SingleDetection::details()
+EvaluationRequirement::DetectionDetails& SingleDetection::details()
 {
     return details_;
 }
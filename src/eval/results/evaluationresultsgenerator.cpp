@@ -23,6 +23,7 @@
 #include "eval/requirement/base/baseconfig.h"
 #include "eval/requirement/base/base.h"
 #include "eval/results/single.h"
+#include "eval/results/joined.h"
 #include "eval/results/detection/joined.h"
 #include "eval/results/report/rootitem.h"
 #include "eval/results/report/section.h"
@@ -36,6 +37,7 @@
 #include "logger.h"
 #include "stringconv.h"
 #include "global.h"
+#include "jobmanager.h"
 
 #include <QProgressDialog>
 #include <QApplication>
@@ -47,11 +49,43 @@
 
 #include <tbb/tbb.h>
 
+#include <set>
+
 using namespace std;
 using namespace EvaluationRequirementResult;
 using namespace EvaluationResultsReport;
 using namespace Utils;
 
+void EvaluateRequirementItem::join(bool split_results_by_mops)
+{
+    string mops_str;
+
+    for (auto& result_it : results_)
+    {
+        assert (result_it);
+
+        if (!result_sum_)
+            result_sum_ = result_it->createEmptyJoined("Sum");
+
+        result_sum_->join(result_it);
+
+        if (split_results_by_mops)
+        {
+            mops_str = result_it->target()->mopsVersionsStr();
+
+            if (!mops_str.size())
+                mops_str = "N/A";
+
+            mops_str = "MOPS "+mops_str;
+
+            if (!mops_sums_.count(mops_str+" Sum"))
+                mops_sums_[mops_str+" Sum"] = result_it->createEmptyJoined(mops_str+" Sum");
+
+            mops_sums_.at(mops_str+" Sum")->join(result_it);
+        }
+    }
+}
+
 EvaluationResultsGenerator::EvaluationResultsGenerator(const std::string& class_id, const std::string& instance_id,
                                                        EvaluationManager& eval_man)
     : Configurable(class_id, instance_id, &eval_man, "eval_results.json"),
@@ -92,6 +126,8 @@ void EvaluationResultsGenerator::evaluate (EvaluationData& data, EvaluationStand
 
     std::vector<std::shared_ptr<SectorLayer>>& sector_layers = eval_man_.sectorsLayers();
 
+    data.updateSectorInsideFlags(); // if sectors changed after loading
+
     unsigned int num_req_evals = 0;
     for (auto& sec_it : sector_layers)
     {
@@ -131,22 +167,13 @@ void EvaluationResultsGenerator::evaluate (EvaluationData& data, EvaluationStand
 
     unsigned int num_utns = utns.size();
 
-    unsigned int eval_cnt = 0;
-
-    boost::posix_time::time_duration time_diff;
-    double elapsed_time_s;
-    double time_per_eval, remaining_time_s;
-
-    string remaining_time_str;
-
-    string mops_str;
+    // create all requirement items, evaluated together
+    vector<unique_ptr<EvaluateRequirementItem>> items;
 
     for (auto& sec_it : sector_layers)
     {
         const string& sector_layer_name = sec_it->name();
 
-        loginf << "EvaluationResultsGenerator: evaluate: sector layer " << sector_layer_name;
-
         for (auto& req_group_it : standard)
         {
             const string& requirement_group_name = req_group_it->name();
@@ -154,139 +181,118 @@ void EvaluationResultsGenerator::evaluate (EvaluationData& data, EvaluationStand
             if (!eval_man_.useGroupInSectorLayer(sector_layer_name, requirement_group_name))
                 continue; // skip if not used
 
-            loginf << "EvaluationResultsGenerator: evaluate: sector layer " << sector_layer_name
-                   << " group " << requirement_group_name;
-
             for (auto& req_cfg_it : *req_group_it)
             {
                 loginf << "EvaluationResultsGenerator: evaluate: sector layer " << sector_layer_name
                        << " group " << requirement_group_name
                        << " req '" << req_cfg_it->name() << "'";
 
-                std::shared_ptr<EvaluationRequirement::Base> req = req_cfg_it->createRequirement();
-                std::shared_ptr<Joined> result_sum;
-                map<string, std::shared_ptr<Joined>> mops_sums;
+                items.emplace_back(new EvaluateRequirementItem(req_cfg_it->createRequirement(), *sec_it, num_utns));
+            }
+        }
+    }
 
-                vector<shared_ptr<Single>> results;
-                results.resize(num_utns);
+    string cache_key = eval_man_.resultsCacheKey();
 
-                vector<bool> done_flags;
-                done_flags.resize(num_utns, false);
-                bool task_done = false;
+    loadCachedResults(cache_key, items);
 
-                // generate results
-                EvaluateTask* t = new (tbb::task::allocate_root()) EvaluateTask(
-                            results, utns, data, req, *sec_it, done_flags, task_done, false);
-                tbb::task::enqueue(*t);
+    std::atomic<unsigned int> done_cnt {0};
+    std::atomic<bool> task_done {false};
 
-                unsigned int tmp_done_cnt;
+    // generate results
+    EvaluateTask* t = new (tbb::task::allocate_root()) EvaluateTask(
+                items, utns, data, split_results_by_mops_, done_cnt, task_done, false);
+    tbb::task::enqueue(*t, JobManager::instance().arena(TaskArenaType::EVALUATION));
 
-                postprocess_dialog.setLabelText(
-                            ("Sector Layer "+sector_layer_name
-                             +":\n Requirement: "+req_group_it->name()+":\n    "+req_cfg_it->name()+"\n\n\n").c_str());
-                postprocess_dialog.setValue(eval_cnt);
+    unsigned int tmp_done_cnt;
 
-                logdbg << "EvaluationResultsGenerator: evaluate: waiting on group " << req_group_it->name()
-                       << " req '" << req_cfg_it->name() << "'";
+    boost::posix_time::time_duration time_diff;
+    double elapsed_time_s;
+    double time_per_eval, remaining_time_s;
 
-                while (!task_done)
-                {
-                    tmp_done_cnt = 0;
-
-                    for (auto done_it : done_flags)
-                    {
-                        if (done_it)
-                            tmp_done_cnt++;
-                    }
-
-                    //assert (eval_cnt+tmp_done_cnt <= num_req_evals);
-                    // hack
-                    if (eval_cnt+tmp_done_cnt <= num_req_evals && tmp_done_cnt)
-                    {
-
-                        elapsed_time = boost::posix_time::microsec_clock::local_time();
-
-                        time_diff = elapsed_time - start_time;
-                        elapsed_time_s = time_diff.total_milliseconds() / 1000.0;
-
-                        time_per_eval = elapsed_time_s/(double)(eval_cnt+tmp_done_cnt);
-                        remaining_time_s = (double)(num_req_evals-eval_cnt-tmp_done_cnt)*time_per_eval;
-
-                        postprocess_dialog.setLabelText(
-                                    ("Sector Layer "+sector_layer_name
-                                     +":\n  "+req_group_it->name()+":\n    "+req_cfg_it->name()
-                                     +"\n\nElapsed: "+String::timeStringFromDouble(elapsed_time_s, false)
-                                     +"\nRemaining: "+String::timeStringFromDouble(remaining_time_s, false)
-                                     +" (estimated)").c_str());
-
-                        postprocess_dialog.setValue(eval_cnt+tmp_done_cnt);
-                    }
-
-                    if (!task_done)
-                    {
-                        QCoreApplication::processEvents();
-                        QThread::msleep(200);
-                    }
-                }
-
-                postprocess_dialog.setLabelText(("Sector Layer "+sector_layer_name+":\nAggregating results").c_str());
-
-                for (auto& result_it : results)
-                {
-                    results_[result_it->reqGrpId()][result_it->resultId()] = result_it;
-                    results_vec_.push_back(result_it);
-
-                    if (!result_sum)
-                        result_sum = result_it->createEmptyJoined("Sum");
-
-                    result_sum->join(result_it);
-
-                    if (split_results_by_mops_)
-                    {
-                        mops_str = result_it->target()->mopsVersionsStr();
-
-                        if (!mops_str.size())
-                            mops_str = "N/A";
-
-                        mops_str = "MOPS "+mops_str;
-
-                        if (!mops_sums.count(mops_str+" Sum"))
-                            mops_sums[mops_str+" Sum"] =
-                                    result_it->createEmptyJoined(mops_str+" Sum");
-
-                        mops_sums.at(mops_str+" Sum")->join(result_it);
-                    }
-                }
-
-                if (result_sum)
-                {
-                    loginf << "EvaluationResultsGenerator: evaluate: adding result '" << result_sum->reqGrpId()
-                           << "' id '" << result_sum->resultId() << "'";
-                    assert (!results_[result_sum->reqGrpId()].count(result_sum->resultId()));
-                    results_[result_sum->reqGrpId()][result_sum->resultId()] = result_sum;
-                    results_vec_.push_back(result_sum); // has to be added after all singles
-                }
-
-                if (split_results_by_mops_)
-                {
-                    for (auto& mops_res_it : mops_sums)
-                    {
-                        loginf << "EvaluationResultsGenerator: evaluate: adding result '"
-                               << mops_res_it.second->reqGrpId()
-                               << "' id '" << mops_res_it.second->resultId() << "'";
-
-                        assert (!results_[mops_res_it.second->reqGrpId()].count(mops_res_it.second->resultId()));
-                        results_[mops_res_it.second->reqGrpId()][mops_res_it.second->resultId()] = mops_res_it.second;
-                        results_vec_.push_back(mops_res_it.second); // has to be added after all singles
-                    }
-                }
-
-                assert (eval_cnt <= num_req_evals);
-                eval_cnt = results_vec_.size();
-            }
+    postprocess_dialog.setLabelText(("Requirements: "+to_string(items.size())+"\n\n\n").c_str());
+    postprocess_dialog.setValue(0);
+
+    logdbg << "EvaluationResultsGenerator: evaluate: waiting on " << items.size() << " requirements";
+
+    while (!task_done)
+    {
+        tmp_done_cnt = done_cnt;
+
+        if (tmp_done_cnt && tmp_done_cnt <= num_req_evals)
+        {
+            elapsed_time = boost::posix_time::microsec_clock::local_time();
+
+            time_diff = elapsed_time - start_time;
+            elapsed_time_s = time_diff.total_milliseconds() / 1000.0;
+
+            time_per_eval = elapsed_time_s/(double)(tmp_done_cnt);
+            remaining_time_s = (double)(num_req_evals-tmp_done_cnt)*time_per_eval;
+
+            postprocess_dialog.setLabelText(
+                        ("Requirements: "+to_string(items.size())
+                         +"\n\nElapsed: "+String::timeStringFromDouble(elapsed_time_s, false)
+                         +"\nRemaining: "+String::timeStringFromDouble(remaining_time_s, false)
+                         +" (estimated)").c_str());
+
+            postprocess_dialog.setValue(tmp_done_cnt);
+        }
+
+        if (!task_done)
+        {
+            QCoreApplication::processEvents();
+            QThread::msleep(200);
+        }
+    }
+
+    postprocess_dialog.setLabelText("Adding results");
+
+    // add in requirement order, singles before their sums
+    for (auto& item_it : items)
+    {
+        for (auto& result_it : item_it->results_)
+        {
+            results_[result_it->reqGrpId()][result_it->resultId()] = result_it;
+            results_vec_.push_back(result_it);
+        }
+
+        if (item_it->result_sum_)
+        {
+            loginf << "EvaluationResultsGenerator: evaluate: adding result '" << item_it->result_sum_->reqGrpId()
+                   << "' id '" << item_it->result_sum_->resultId() << "'";
+            assert (!results_[item_it->result_sum_->reqGrpId()].count(item_it->result_sum_->resultId()));
+            results_[item_it->result_sum_->reqGrpId()][item_it->result_sum_->resultId()] = item_it->result_sum_;
+            results_vec_.push_back(item_it->result_sum_); // has to be added after all singles
+        }
+
+        for (auto& mops_res_it : item_it->mops_sums_)
+        {
+            loginf << "EvaluationResultsGenerator: evaluate: adding result '"
+                   << mops_res_it.second->reqGrpId()
+                   << "' id '" << mops_res_it.second->resultId() << "'";
+
+            assert (!results_[mops_res_it.second->reqGrpId()].count(mops_res_it.second->resultId()));
+            results_[mops_res_it.second->reqGrpId()][mops_res_it.second->resultId()] = mops_res_it.second;
+            results_vec_.push_back(mops_res_it.second); // has to be added after all singles
         }
     }
 
+    updateTargetResults();
+
+    unsigned int num_restored = 0;
+
+    for (auto& item_it : items)
+        num_restored += item_it->num_restored_;
+
+    loginf << "EvaluationResultsGenerator: evaluate: restored " << num_restored << " of "
+           << items.size() * num_utns << " single results";
+
+    if (num_restored < items.size() * num_utns)
+    {
+        postprocess_dialog.setLabelText("Caching results");
+        saveCachedResults(cache_key, items, utns);
+    }
+
     elapsed_time = boost::posix_time::microsec_clock::local_time();
 
     time_diff = elapsed_time - start_time;
@@ -310,6 +316,77 @@ void EvaluationResultsGenerator::evaluate (EvaluationData& data, EvaluationStand
     QApplication::restoreOverrideCursor();
 }
 
+void EvaluationResultsGenerator::loadCachedResults (const std::string& cache_key,
+                                                    std::vector<std::unique_ptr<EvaluateRequirementItem>>& items)
+{
+    DBInterface& db_interface = COMPASS::instance().interface();
+
+    if (db_interface.evaluationResultsKey() != cache_key)
+    {
+        loginf << "EvaluationResultsGenerator: loadCachedResults: no cached results for key " << cache_key;
+        return;
+    }
+
+    map<string, string> cached_results = db_interface.evaluationResults();
+
+    try
+    {
+        for (auto& item_it : items)
+        {
+            if (cached_results.count(item_it->id()))
+                item_it->cached_results_ = nlohmann::json::parse(cached_results.at(item_it->id()));
+        }
+    }
+    catch (nlohmann::json::exception& e)
+    {
+        logwrn << "EvaluationResultsGenerator: loadCachedResults: cached results not usable: " << e.what();
+
+        for (auto& item_it : items)
+            item_it->cached_results_ = nlohmann::json();
+    }
+}
+
+void EvaluationResultsGenerator::saveCachedResults (const std::string& cache_key,
+                                                    std::vector<std::unique_ptr<EvaluateRequirementItem>>& items,
+                                                    const std::vector<unsigned int>& utns)
+{
+    set<string> ids;
+
+    for (auto& item_it : items)
+    {
+        if (ids.count(item_it->id()))
+        {
+            logwrn << "EvaluationResultsGenerator: saveCachedResults: duplicate requirement '" << item_it->id()
+                   << "', results not cached";
+            return;
+        }
+
+        ids.insert(item_it->id());
+    }
+
+    vector<pair<string, string>> item_jsons (items.size()); // id -> json
+
+    tbb::parallel_for(size_t(0), items.size(), [&](size_t item_cnt)
+    {
+        EvaluateRequirementItem& item = *items.at(item_cnt);
+
+        nlohmann::json j = nlohmann::json::object();
+
+        for (unsigned int utn_cnt=0; utn_cnt < utns.size(); ++utn_cnt)
+            j[to_string(utns.at(utn_cnt))] = item.results_.at(utn_cnt)->toJSON();
+
+        item_jsons[item_cnt] = {item.id(), j.dump()};
+    });
+
+    DBInterface& db_interface = COMPASS::instance().interface();
+
+    // results and key in one transaction, partially written results are never used
+    db_interface.setEvaluationResults(cache_key, item_jsons);
+
+    loginf << "EvaluationResultsGenerator: saveCachedResults: saved " << items.size() << " requirements for key "
+           << cache_key;
+}
+
 void EvaluationResultsGenerator::clear()
 {
     // clear everything
@@ -317,6 +394,7 @@ void EvaluationResultsGenerator::clear()
     results_model_.clear();
     results_.clear();
     results_vec_.clear();
+    target_results_.clear();
     results_model_.endReset();
 }
 
@@ -361,6 +439,13 @@ void EvaluationResultsGenerator::generateResultsReportGUI()
     assert (eval_man_.hasCurrentStandard());
     gen_table.addRow({"Standard", "Standard name", eval_man_.currentStandardName().c_str()}, nullptr);
 
+    // targets outside by the sector containment pre-filter, their updates need no polygon tests
+    EvaluationData& data = eval_man_.getData();
+
+    for (auto& sec_it : eval_man_.sectorsLayers())
+        gen_table.addRow({("Outside "+sec_it->name()).c_str(), "Targets outside of sector layer by bounding box",
+                          data.numOutsideTargets(*sec_it)}, nullptr);
+
     // generate results
 
     // first add all joined
@@ -448,6 +533,98 @@ void EvaluationResultsGenerator::updateToChanges ()
     generateResultsReportGUI();
 }
 
+bool EvaluationResultsGenerator::updateToUseChangeOf (unsigned int utn)
+{
+    loginf << "EvaluationResultsGenerator: updateToUseChangeOf: utn " << utn;
+
+    bool use;
+
+    vector<shared_ptr<Single>> changed_results;
+    vector<shared_ptr<Joined>> changed_joined;
+    set<Joined*> changed_joined_set;
+
+    auto range = target_results_.equal_range(utn);
+
+    for (auto result_it = range.first; result_it != range.second; ++result_it)
+    {
+        shared_ptr<Single>& result = result_it->second.first;
+
+        use = result->use();
+        result->updateUseFromTarget();
+
+        if (result->use() == use)
+            continue;
+
+        changed_results.push_back(result);
+
+        for (auto& joined_it : result_it->second.second)
+        {
+            joined_it->updateToUseChangeOf(result);
+
+            if (changed_joined_set.insert(joined_it.get()).second)
+                changed_joined.push_back(joined_it);
+        }
+    }
+
+    if (!changed_results.size())
+        return false;
+
+    // only update report parts of target and affected joined results
+    results_model_.beginReset();
+
+    std::shared_ptr<EvaluationResultsReport::RootItem> root_item = results_model_.rootItem();
+
+    for (auto& result_it : changed_results)
+        result_it->removeFromReport(root_item);
+
+    for (auto& joined_it : changed_joined)
+        joined_it->updateReport(root_item);
+
+    for (auto& result_it : changed_results)
+    {
+        if (result_it->use()) // unused singles are not added, as in generateResultsReportGUI
+            result_it->addToReport(root_item);
+    }
+
+    results_model_.endReset();
+
+    loginf << "EvaluationResultsGenerator: updateToUseChangeOf: updated " << changed_results.size()
+           << " target results, " << changed_joined.size() << " joined results";
+
+    return true;
+}
+
+void EvaluationResultsGenerator::updateTargetResults()
+{
+    target_results_.clear();
+
+    map<const Single*, vector<shared_ptr<Joined>>> result_joins;
+
+    for (auto& result_it : results_vec_)
+    {
+        if (!result_it->isJoined())
+            continue;
+
+        shared_ptr<Joined> joined = static_pointer_cast<Joined>(result_it);
+
+        for (auto& sub_result_it : joined->results())
+        {
+            assert (sub_result_it->isSingle());
+            result_joins[static_cast<const Single*>(sub_result_it.get())].push_back(joined);
+        }
+    }
+
+    for (auto& result_it : results_vec_)
+    {
+        if (!result_it->isSingle())
+            continue;
+
+        shared_ptr<Single> result = static_pointer_cast<Single>(result_it);
+
+        target_results_.emplace(result->utn(), make_pair(result, move(result_joins[result.get()])));
+    }
+}
+
 bool EvaluationResultsGenerator::skipNoDataDetails() const
 {
     return skip_no_data_details_;
@@ -26,9 +26,12 @@
 #include "sectorlayer.h"
 #include "logger.h"
 #include "configurable.h"
+#include "tracer.h"
 
 #include <tbb/tbb.h>
 
+#include <atomic>
+
 class EvaluationManager;
 class EvaluationStandard;
 
@@ -36,20 +39,49 @@ namespace EvaluationRequirementResult
 {
     class Base;
     class Single;
+    class Joined;
 }
 
+/// @brief Evaluation of one requirement in one sector layer, sums are joined when all targets are done
+class EvaluateRequirementItem
+{
+public:
+    EvaluateRequirementItem(std::shared_ptr<EvaluationRequirement::Base> req, const SectorLayer& sector_layer,
+                            unsigned int num_utns)
+        : req_(req), sector_layer_(sector_layer), results_(num_utns), remaining_utns_(num_utns)
+    {
+    }
+
+    std::shared_ptr<EvaluationRequirement::Base> req_;
+    const SectorLayer& sector_layer_;
+
+    std::vector<std::shared_ptr<EvaluationRequirementResult::Single>> results_; // in utns order
+    std::atomic<unsigned int> remaining_utns_; // join is done by thread finishing the last target
+
+    nlohmann::json cached_results_; // utn -> serialized single, restored instead of evaluated
+    std::atomic<unsigned int> num_restored_ {0};
+
+    std::shared_ptr<EvaluationRequirementResult::Joined> result_sum_;
+    std::map<std::string, std::shared_ptr<EvaluationRequirementResult::Joined>> mops_sums_;
+
+    void join(bool split_results_by_mops);
+
+    std::string id() const // key in results cache
+    {
+        return sector_layer_.name()+":"+req_->groupName()+":"+req_->name();
+    }
+};
+
+/// @brief Evaluates all requirement items for all targets as one parallel loop, without barriers in between
 class EvaluateTask : public tbb::task {
 
 public:
-    EvaluateTask(std::vector<std::shared_ptr<EvaluationRequirementResult::Single>>& results,
+    EvaluateTask(std::vector<std::unique_ptr<EvaluateRequirementItem>>& items,
                  std::vector<unsigned int>& utns,
-                 EvaluationData& data,
-                 std::shared_ptr<EvaluationRequirement::Base> req,
-                 const SectorLayer& sector_layer,
-                 std::vector<bool>& done_flags, bool& task_done, bool single_thread)
-        : results_(results), utns_(utns), data_(data), req_(req), sector_layer_(sector_layer),
-          done_flags_(done_flags), task_done_(task_done),
-          single_thread_(single_thread)
+                 EvaluationData& data, bool split_results_by_mops,
+                 std::atomic<unsigned int>& done_cnt, std::atomic<bool>& task_done, bool single_thread)
+        : items_(items), utns_(utns), data_(data), split_results_by_mops_(split_results_by_mops),
+          done_cnt_(done_cnt), task_done_(task_done), single_thread_(single_thread)
     {
     }
 
@@ -58,29 +90,24 @@ public:
 
         loginf << "EvaluateTask: execute: starting";
 
-        unsigned int num_utns = utns_.size();
-        assert (done_flags_.size() == num_utns);
+        TraceSpan span("evaluation", "evaluateRequirements");
+
+        size_t num_utns = utns_.size();
+        size_t num_evals = items_.size() * num_utns; // requirement item major, earlier items finish first
 
         if (single_thread_)
         {
-            for(unsigned int utn_cnt=0; utn_cnt < num_utns; ++utn_cnt)
-            {
-                results_[utn_cnt] = req_->evaluate(data_.targetData(utns_.at(utn_cnt)), req_, sector_layer_);
-                done_flags_[utn_cnt] = true;
-            }
+            for(size_t eval_cnt=0; eval_cnt < num_evals; ++eval_cnt)
+                evaluate(eval_cnt / num_utns, eval_cnt % num_utns);
         }
         else
         {
-            tbb::parallel_for(uint(0), num_utns, [&](unsigned int utn_cnt)
+            tbb::parallel_for(size_t(0), num_evals, [&](size_t eval_cnt)
             {
-                results_[utn_cnt] = req_->evaluate(data_.targetData(utns_.at(utn_cnt)), req_, sector_layer_);
-                done_flags_[utn_cnt] = true;
+                evaluate(eval_cnt / num_utns, eval_cnt % num_utns);
             });
         }
 
-        for(unsigned int utn_cnt=0; utn_cnt < num_utns; ++utn_cnt)
-            assert (results_[utn_cnt]);
-
         loginf << "EvaluateTask: execute: done";
         task_done_ = true;
 
@@ -88,14 +115,57 @@ public:
     }
 
 protected:
-    std::vector<std::shared_ptr<EvaluationRequirementResult::Single>>& results_;
+    std::vector<std::unique_ptr<EvaluateRequirementItem>>& items_;
     std::vector<unsigned int>& utns_;
     EvaluationData& data_;
-    std::shared_ptr<EvaluationRequirement::Base> req_;
-    const SectorLayer& sector_layer_;
-    std::vector<bool>& done_flags_;
-    bool& task_done_;
+    bool split_results_by_mops_;
+    std::atomic<unsigned int>& done_cnt_; // number of target evaluations and joins done
+    std::atomic<bool>& task_done_;
     bool single_thread_;
+
+    void evaluate(size_t item_cnt, size_t utn_cnt)
+    {
+        TraceSpan target_span("evaluation", "evaluateTarget");
+
+        EvaluateRequirementItem& item = *items_.at(item_cnt);
+
+        const EvaluationTargetData& target_data = data_.targetData(utns_.at(utn_cnt));
+        const nlohmann::json& cached_results = item.cached_results_;
+        std::string utn_str = std::to_string(utns_.at(utn_cnt));
+
+        bool restored = false;
+
+        if (cached_results.contains(utn_str))
+        {
+            try
+            {
+                item.results_[utn_cnt] = item.req_->restore(cached_results.at(utn_str), target_data, item.req_,
+                                                            item.sector_layer_);
+                ++item.num_restored_;
+                restored = true;
+            }
+            catch (std::exception& e)
+            {
+                logwrn << "EvaluateTask: evaluate: restoring utn " << utn_str << " of '" << item.id()
+                       << "' failed, re-evaluating: " << e.what();
+            }
+        }
+
+        if (!restored)
+            item.results_[utn_cnt] = item.req_->evaluate(target_data, item.req_, item.sector_layer_);
+
+        assert (item.results_[utn_cnt]);
+
+        ++done_cnt_;
+
+        if (--item.remaining_utns_ == 0)
+        {
+            TraceSpan join_span("evaluation", "joinRequirement", item.req_->name());
+
+            item.join(split_results_by_mops_);
+            ++done_cnt_;
+        }
+    }
 };
 
 class EvaluationResultsGenerator : public Configurable
@@ -122,6 +192,7 @@ public:
     const { return results_; } ;
 
     void updateToChanges();
+    bool updateToUseChangeOf (unsigned int utn); // only results of target, returns true if any changed
 
     void generateResultsReportGUI();
 
@@ -153,9 +224,21 @@ protected:
     std::map<std::string, std::map<std::string, std::shared_ptr<EvaluationRequirementResult::Base>>> results_;
     std::vector<std::shared_ptr<EvaluationRequirementResult::Base>> results_vec_; // ordered as generated
 
+    // utn -> single result, joined results containing it, for updates to use changes of targets
+    std::multimap<unsigned int, std::pair<std::shared_ptr<EvaluationRequirementResult::Single>,
+    std::vector<std::shared_ptr<EvaluationRequirementResult::Joined>>>> target_results_;
+
     virtual void checkSubConfigurables() override;
 
+    // single results of previous evaluation with same key, from database
+    void loadCachedResults (const std::string& cache_key,
+                            std::vector<std::unique_ptr<EvaluateRequirementItem>>& items);
+    void saveCachedResults (const std::string& cache_key,
+                            std::vector<std::unique_ptr<EvaluateRequirementItem>>& items,
+                            const std::vector<unsigned int>& utns);
+
     void addNonResultsContent (std::shared_ptr<EvaluationResultsReport::RootItem> root_item);
+    void updateTargetResults();
 };
 
 #endif // EVALUATIONRESULTSGENERATOR_H
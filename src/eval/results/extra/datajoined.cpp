@@ -68,6 +68,17 @@ namespace EvaluationRequirementResult
         updateProb();
     }
 
+    void JoinedExtraData::subtractFromValues (std::shared_ptr<SingleExtraData> single_result)
+    {
+        assert (single_result);
+        assert (!single_result->use());
+
+        num_extra_ -= single_result->numExtra();
+        num_ok_ -= single_result->numOK();
+
+        updateProb();
+    }
+
     void JoinedExtraData::updateProb()
     {
         if (num_extra_ + num_ok_)
@@ -256,4 +267,16 @@ namespace EvaluationRequirementResult
         }
     }
 
+    void JoinedExtraData::updateToUseChangeOf (std::shared_ptr<Single> result)
+    {
+        std::shared_ptr<SingleExtraData> single_result =
+                std::static_pointer_cast<SingleExtraData>(result);
+        assert (single_result);
+
+        if (single_result->use())
+            addToValues(single_result);
+        else
+            subtractFromValues(single_result);
+    }
+
 }
@@ -41,11 +41,13 @@ SingleExtraData::SingleExtraData(
         const SectorLayer& sector_layer, unsigned int utn, const EvaluationTargetData* target,
         EvaluationManager& eval_man,
         bool ignore, unsigned int num_extra, unsigned int num_ok, bool has_extra_test_data,
-        std::vector<EvaluationRequirement::ExtraDataDetail> details)
+        EvaluationRequirement::ExtraDataDetails details)
     : Single("SingleExtraData", result_id, requirement, sector_layer, utn, target, eval_man),
       ignore_(ignore), num_extra_(num_extra), num_ok_(num_ok), has_extra_test_data_(has_extra_test_data),
       details_(details)
 {
+    details_.shrink_to_fit();
+
     //result_usable_ = !ignore;
 
     updateProb();
@@ -190,7 +192,7 @@ void SingleExtraData::reportDetails(EvaluationResultsReport::Section& utn_req_se
 
     unsigned int detail_cnt = 0;
 
-    for (auto& rq_det_it : details_)
+    for (const auto& rq_det_it : details_)
     {
         utn_req_details_table.addRow(
                     {String::timeStringFromDouble(rq_det_it.tod_).c_str(),
@@ -230,7 +232,7 @@ std::unique_ptr<nlohmann::json::object_t> SingleExtraData::viewableData(
                 = eval_man_.getViewableForEvaluation(utn_, req_grp_id_, result_id_);
         assert (viewable_ptr);
 
-        const EvaluationRequirement::ExtraDataDetail& detail = details_.at(detail_cnt);
+        EvaluationRequirement::ExtraDataDetail detail = details_.at(detail_cnt);
 
         (*viewable_ptr)["position_latitude"] = detail.pos_current_.latitude_;
         (*viewable_ptr)["position_longitude"] = detail.pos_current_.longitude_;
@@ -252,7 +254,7 @@ std::unique_ptr<nlohmann::json::object_t> SingleExtraData::getTargetErrorsViewab
     //    bool has_pos = false;
     //    double lat_min, lat_max, lon_min, lon_max;
 
-    //    for (auto& detail_it : details_)
+    //    for (const auto& detail_it : details_)
     //    {
     //        if (!detail_it.miss_occurred_)
     //            continue;
@@ -329,6 +331,20 @@ std::shared_ptr<Joined> SingleExtraData::createEmptyJoined(const std::string& re
     return make_shared<JoinedExtraData> (result_id, requirement_, sector_layer_, eval_man_);
 }
 
+nlohmann::json SingleExtraData::toJSON() const
+{
+    nlohmann::json j;
+
+    j["ignore"] = ignore_;
+    j["num_extra"] = num_extra_;
+    j["num_ok"] = num_ok_;
+    j["has_extra_test_data"] = has_extra_test_data_;
+
+    j["details"] = details_.toJSON();
+
+    return j;
+}
+
 bool SingleExtraData::ignore() const
 {
     return ignore_;
@@ -339,7 +355,7 @@ bool SingleExtraData::hasExtraTestData() const
     return has_extra_test_data_;
 }
 
-const std::vector<EvaluationRequirement::ExtraDataDetail>& SingleExtraData::details() const
+const EvaluationRequirement::ExtraDataDetails& SingleExtraData::details() const
 {
     return details_;
 }
@@ -32,12 +32,14 @@ public:
             const SectorLayer& sector_layer, unsigned int utn, const EvaluationTargetData* target,
             EvaluationManager& eval_man,
             bool ignore, unsigned int num_extra, unsigned int num_ok, bool has_extra_test_data,
-            std::vector<EvaluationRequirement::ExtraDataDetail> details);
+            EvaluationRequirement::ExtraDataDetails details);
 
     virtual void addToReport (std::shared_ptr<EvaluationResultsReport::RootItem> root_item) override;
 
     virtual std::shared_ptr<Joined> createEmptyJoined(const std::string& result_id) override;
 
+    virtual nlohmann::json toJSON() const override;
+
     virtual bool hasViewableData (
             const EvaluationResultsReport::SectionContentTable& table, const QVariant& annotation) override;
     virtual std::unique_ptr<nlohmann::json::object_t> viewableData(
@@ -53,14 +55,14 @@ public:
     unsigned int numOK() const;
     bool hasExtraTestData() const;
 
-    const std::vector<EvaluationRequirement::ExtraDataDetail>& details() const;
+    const EvaluationRequirement::ExtraDataDetails& details() const;
 
 protected:
     bool ignore_ {false};
     unsigned int num_extra_ {0};
     unsigned int num_ok_ {0};
     bool has_extra_test_data_ {false};
-    std::vector<EvaluationRequirement::ExtraDataDetail> details_;
+    EvaluationRequirement::ExtraDataDetails details_;
 
     bool has_prob_ {false};
     float prob_{0};
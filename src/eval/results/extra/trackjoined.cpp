@@ -69,6 +69,18 @@ namespace EvaluationRequirementResult
         updateProb();
     }
 
+    void JoinedExtraTrack::subtractFromValues (std::shared_ptr<SingleExtraTrack> single_result)
+    {
+        assert (single_result);
+        assert (!single_result->use());
+
+        num_inside_ -= single_result->numInside();
+        num_extra_ -= single_result->numExtra();
+        num_ok_ -= single_result->numOK();
+
+        updateProb();
+    }
+
     void JoinedExtraTrack::updateProb()
     {
         assert (num_inside_ >= num_extra_ + num_ok_);
@@ -263,4 +275,16 @@ namespace EvaluationRequirementResult
         }
     }
 
+    void JoinedExtraTrack::updateToUseChangeOf (std::shared_ptr<Single> result)
+    {
+        std::shared_ptr<SingleExtraTrack> single_result =
+                std::static_pointer_cast<SingleExtraTrack>(result);
+        assert (single_result);
+
+        if (single_result->use())
+            addToValues(single_result);
+        else
+            subtractFromValues(single_result);
+    }
+
 }
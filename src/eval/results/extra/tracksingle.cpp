@@ -41,10 +41,12 @@ SingleExtraTrack::SingleExtraTrack(
         const SectorLayer& sector_layer, unsigned int utn, const EvaluationTargetData* target,
         EvaluationManager& eval_man,
         bool ignore, unsigned int num_inside, unsigned int num_extra, unsigned int num_ok,
-        std::vector<EvaluationRequirement::ExtraTrackDetail> details)
+        EvaluationRequirement::ExtraTrackDetails details)
     : Single("SingleExtraTrack", result_id, requirement, sector_layer, utn, target, eval_man),
       ignore_(ignore), num_inside_(num_inside), num_extra_(num_extra), num_ok_(num_ok), details_(details)
 {
+    details_.shrink_to_fit();
+
     //loginf << "SingleTrack: ctor: result_id " << result_id_ << " ignore " << ignore_;
 
     updateProb();
@@ -189,7 +191,7 @@ void SingleExtraTrack::reportDetails(EvaluationResultsReport::Section& utn_req_s
 
     unsigned int detail_cnt = 0;
 
-    for (auto& rq_det_it : details_)
+    for (const auto& rq_det_it : details_)
     {
         utn_req_details_table.addRow(
                     {String::timeStringFromDouble(rq_det_it.tod_).c_str(),
@@ -229,7 +231,7 @@ std::unique_ptr<nlohmann::json::object_t> SingleExtraTrack::viewableData(
                 = eval_man_.getViewableForEvaluation(utn_, req_grp_id_, result_id_);
         assert (viewable_ptr);
 
-        const EvaluationRequirement::ExtraTrackDetail& detail = details_.at(detail_cnt);
+        EvaluationRequirement::ExtraTrackDetail detail = details_.at(detail_cnt);
 
         (*viewable_ptr)["position_latitude"] = detail.pos_current_.latitude_;
         (*viewable_ptr)["position_longitude"] = detail.pos_current_.longitude_;
@@ -251,7 +253,7 @@ std::unique_ptr<nlohmann::json::object_t> SingleExtraTrack::getTargetErrorsViewa
     //    bool has_pos = false;
     //    double lat_min, lat_max, lon_min, lon_max;
 
-    //    for (auto& detail_it : details_)
+    //    for (const auto& detail_it : details_)
     //    {
     //        if (!detail_it.miss_occurred_)
     //            continue;
@@ -328,6 +330,20 @@ std::shared_ptr<Joined> SingleExtraTrack::createEmptyJoined(const std::string& r
     return make_shared<JoinedExtraTrack> (result_id, requirement_, sector_layer_, eval_man_);
 }
 
+nlohmann::json SingleExtraTrack::toJSON() const
+{
+    nlohmann::json j;
+
+    j["ignore"] = ignore_;
+    j["num_inside"] = num_inside_;
+    j["num_extra"] = num_extra_;
+    j["num_ok"] = num_ok_;
+
+    j["details"] = details_.toJSON();
+
+    return j;
+}
+
 bool SingleExtraTrack::ignore() const
 {
     return ignore_;
@@ -348,7 +364,7 @@ unsigned int SingleExtraTrack::numOK() const
     return num_ok_;
 }
 
-const std::vector<EvaluationRequirement::ExtraTrackDetail>& SingleExtraTrack::details() const
+const EvaluationRequirement::ExtraTrackDetails& SingleExtraTrack::details() const
 {
     return details_;
 }
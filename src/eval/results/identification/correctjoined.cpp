@@ -73,6 +73,22 @@ namespace EvaluationRequirementResult
         updatePID();
     }
 
+    void JoinedIdentificationCorrect::subtractFromValues (std::shared_ptr<SingleIdentificationCorrect> single_result)
+    {
+        assert (single_result);
+        assert (!single_result->use());
+
+        num_updates_ -= single_result->numUpdates();
+        num_no_ref_pos_ -= single_result->numNoRefPos();
+        num_no_ref_id_ -= single_result->numNoRefId();
+        num_pos_outside_ -= single_result->numPosOutside();
+        num_pos_inside_ -= single_result->numPosInside();
+        num_correct_ -= single_result->numCorrect();
+        num_not_correct_ -= single_result->numNotCorrect();
+
+        updatePID();
+    }
+
     void JoinedIdentificationCorrect::updatePID()
     {
         assert (num_updates_ - num_no_ref_pos_ == num_pos_inside_ + num_pos_outside_);
@@ -280,4 +296,16 @@ namespace EvaluationRequirementResult
         }
     }
 
+    void JoinedIdentificationCorrect::updateToUseChangeOf (std::shared_ptr<Single> result)
+    {
+        std::shared_ptr<SingleIdentificationCorrect> single_result =
+                std::static_pointer_cast<SingleIdentificationCorrect>(result);
+        assert (single_result);
+
+        if (single_result->use())
+            addToValues(single_result);
+        else
+            subtractFromValues(single_result);
+    }
+
 }
@@ -43,12 +43,14 @@ namespace EvaluationRequirementResult
             unsigned int num_updates, unsigned int num_no_ref_pos, unsigned int num_no_ref_id,
             unsigned int num_pos_outside, unsigned int num_pos_inside,
             unsigned int num_correct, unsigned int num_not_correct,
-            std::vector<EvaluationRequirement::CorrectnessDetail> details)
+            EvaluationRequirement::CorrectnessDetails details)
         : Single("SingleIdentificationCorrect", result_id, requirement, sector_layer, utn, target, eval_man),
           num_updates_(num_updates), num_no_ref_pos_(num_no_ref_pos), num_no_ref_id_(num_no_ref_id),
           num_pos_outside_(num_pos_outside), num_pos_inside_(num_pos_inside),
           num_correct_(num_correct), num_not_correct_(num_not_correct), details_(details)
     {
+        details_.shrink_to_fit();
+
         updatePID();
     }
 
@@ -189,7 +191,7 @@ namespace EvaluationRequirementResult
 
         unsigned int detail_cnt = 0;
 
-        for (auto& rq_det_it : details_)
+        for (const auto& rq_det_it : details_)
         {
             utn_req_details_table.addRow(
             {String::timeStringFromDouble(rq_det_it.tod_).c_str(), rq_det_it.ref_exists_,
@@ -234,7 +236,7 @@ namespace EvaluationRequirementResult
                     = eval_man_.getViewableForEvaluation(utn_, req_grp_id_, result_id_);
             assert (viewable_ptr);
 
-            const EvaluationRequirement::CorrectnessDetail& detail = details_.at(detail_cnt);
+            EvaluationRequirement::CorrectnessDetail detail = details_.at(detail_cnt);
 
             (*viewable_ptr)["position_latitude"] = detail.pos_tst_.latitude_;
             (*viewable_ptr)["position_longitude"] = detail.pos_tst_.longitude_;
@@ -259,7 +261,7 @@ namespace EvaluationRequirementResult
         bool has_pos = false;
         double lat_min, lat_max, lon_min, lon_max;
 
-        for (auto& detail_it : details_)
+        for (const auto& detail_it : details_)
         {
             if (!detail_it.is_not_correct_)
                 continue;
@@ -327,6 +329,23 @@ namespace EvaluationRequirementResult
         return make_shared<JoinedIdentificationCorrect> (result_id, requirement_, sector_layer_, eval_man_);
     }
 
+    nlohmann::json SingleIdentificationCorrect::toJSON() const
+    {
+        nlohmann::json j;
+
+        j["num_updates"] = num_updates_;
+        j["num_no_ref_pos"] = num_no_ref_pos_;
+        j["num_no_ref_id"] = num_no_ref_id_;
+        j["num_pos_outside"] = num_pos_outside_;
+        j["num_pos_inside"] = num_pos_inside_;
+        j["num_correct"] = num_correct_;
+        j["num_not_correct"] = num_not_correct_;
+
+        j["details"] = details_.toJSON();
+
+        return j;
+    }
+
     unsigned int SingleIdentificationCorrect::numNoRefPos() const
     {
         return num_no_ref_pos_;
@@ -362,7 +381,7 @@ namespace EvaluationRequirementResult
         return num_not_correct_;
     }
 
-    std::vector<EvaluationRequirement::CorrectnessDetail>& SingleIdentificationCorrect::details()
+    EvaluationRequirement::CorrectnessDetails& SingleIdentificationCorrect::details()
     {
         return details_;
     }
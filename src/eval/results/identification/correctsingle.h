@@ -35,13 +35,15 @@ public:
             unsigned int num_updates, unsigned int num_no_ref_pos, unsigned int num_no_ref_id,
             unsigned int num_pos_outside, unsigned int num_pos_inside,
             unsigned int num_correct, unsigned int num_not_correct,
-            std::vector<EvaluationRequirement::CorrectnessDetail> details);
+            EvaluationRequirement::CorrectnessDetails details);
 
     //irtual void print() override;
     virtual void addToReport (std::shared_ptr<EvaluationResultsReport::RootItem> root_item) override;
 
     virtual std::shared_ptr<Joined> createEmptyJoined(const std::string& result_id) override;
 
+    virtual nlohmann::json toJSON() const override;
+
     unsigned int numUpdates() const;
     unsigned int numNoRefPos() const;
     unsigned int numNoRefId() const;
@@ -50,7 +52,7 @@ public:
     unsigned int numCorrect() const;
     unsigned int numNotCorrect() const;
 
-    std::vector<EvaluationRequirement::CorrectnessDetail>& details();
+    EvaluationRequirement::CorrectnessDetails& details();
 
     virtual bool hasViewableData (
             const EvaluationResultsReport::SectionContentTable& table, const QVariant& annotation) override;
@@ -75,7 +77,7 @@ protected:
     bool has_pid_ {false};
     float pid_{0};
 
-    std::vector<EvaluationRequirement::CorrectnessDetail> details_;
+    EvaluationRequirement::CorrectnessDetails details_;
 
     void updatePID();
     void addTargetToOverviewTable(std::shared_ptr<EvaluationResultsReport::RootItem> root_item);
@@ -73,6 +73,23 @@ void JoinedIdentificationFalse::addToValues (std::shared_ptr<SingleIdentificatio
     updateProbabilities();
 }
 
+void JoinedIdentificationFalse::subtractFromValues (std::shared_ptr<SingleIdentificationFalse> single_result)
+{
+    assert (single_result);
+    assert (!single_result->use());
+
+    num_updates_ -= single_result->numUpdates();
+    num_no_ref_pos_ -= single_result->numNoRefPos();
+    num_no_ref_val_ -= single_result->numNoRefValue();
+    num_pos_outside_ -= single_result->numPosOutside();
+    num_pos_inside_ -= single_result->numPosInside();
+    num_unknown_ -= single_result->numUnknown();
+    num_correct_ -= single_result->numCorrect();
+    num_false_ -= single_result->numFalse();
+
+    updateProbabilities();
+}
+
 void JoinedIdentificationFalse::updateProbabilities()
 {
     assert (num_updates_ - num_no_ref_pos_ == num_pos_inside_ + num_pos_outside_);
@@ -289,4 +306,16 @@ void JoinedIdentificationFalse::updatesToUseChanges()
     }
 }
 
+void JoinedIdentificationFalse::updateToUseChangeOf (std::shared_ptr<Single> result)
+{
+    std::shared_ptr<SingleIdentificationFalse> single_result =
+            std::static_pointer_cast<SingleIdentificationFalse>(result);
+    assert (single_result);
+
+    if (single_result->use())
+        addToValues(single_result);
+    else
+        subtractFromValues(single_result);
+}
+
 }
@@ -42,13 +42,15 @@ namespace EvaluationRequirementResult
             unsigned int utn, const EvaluationTargetData* target, EvaluationManager& eval_man,
             int num_updates, int num_no_ref_pos, int num_no_ref_val, int num_pos_outside, int num_pos_inside,
             int num_unknown, int num_correct, int num_false,
-            std::vector<EvaluationRequirement::CheckDetail> details)
+            EvaluationRequirement::CheckDetails details)
         : Single("SingleIdentificationFalse", result_id, requirement, sector_layer, utn, target, eval_man),
           num_updates_(num_updates), num_no_ref_pos_(num_no_ref_pos), num_no_ref_val_(num_no_ref_val),
           num_pos_outside_(num_pos_outside), num_pos_inside_(num_pos_inside),
           num_unknown_(num_unknown),
           num_correct_(num_correct), num_false_(num_false), details_(details)
     {
+        details_.shrink_to_fit();
+
         updateProbabilities();
     }
 
@@ -194,7 +196,7 @@ namespace EvaluationRequirementResult
 
         unsigned int detail_cnt = 0;
 
-        for (auto& rq_det_it : details_)
+        for (const auto& rq_det_it : details_)
         {
             utn_req_details_table.addRow(
             {String::timeStringFromDouble(rq_det_it.tod_).c_str(), rq_det_it.ref_exists_,
@@ -240,7 +242,7 @@ namespace EvaluationRequirementResult
                     = eval_man_.getViewableForEvaluation(utn_, req_grp_id_, result_id_);
             assert (viewable_ptr);
 
-            const EvaluationRequirement::CheckDetail& detail = details_.at(detail_cnt);
+            EvaluationRequirement::CheckDetail detail = details_.at(detail_cnt);
 
             (*viewable_ptr)["position_latitude"] = detail.pos_tst_.latitude_;
             (*viewable_ptr)["position_longitude"] = detail.pos_tst_.longitude_;
@@ -265,7 +267,7 @@ namespace EvaluationRequirementResult
         bool has_pos = false;
         double lat_min, lat_max, lon_min, lon_max;
 
-        for (auto& detail_it : details_)
+        for (const auto& detail_it : details_)
         {
             if (!detail_it.is_not_ok_)
                 continue;
@@ -333,6 +335,24 @@ namespace EvaluationRequirementResult
         return make_shared<JoinedIdentificationFalse> (result_id, requirement_, sector_layer_, eval_man_);
     }
 
+    nlohmann::json SingleIdentificationFalse::toJSON() const
+    {
+        nlohmann::json j;
+
+        j["num_updates"] = num_updates_;
+        j["num_no_ref_pos"] = num_no_ref_pos_;
+        j["num_no_ref_val"] = num_no_ref_val_;
+        j["num_pos_outside"] = num_pos_outside_;
+        j["num_pos_inside"] = num_pos_inside_;
+        j["num_unknown"] = num_unknown_;
+        j["num_correct"] = num_correct_;
+        j["num_false"] = num_false_;
+
+        j["details"] = details_.toJSON();
+
+        return j;
+    }
+
     int SingleIdentificationFalse::numNoRefPos() const
     {
         return num_no_ref_pos_;
@@ -373,7 +393,7 @@ namespace EvaluationRequirementResult
         return num_false_;
     }
 
-    std::vector<EvaluationRequirement::CheckDetail>& SingleIdentificationFalse::details()
+    EvaluationRequirement::CheckDetails& SingleIdentificationFalse::details()
     {
         return details_;
     }
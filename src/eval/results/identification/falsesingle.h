@@ -34,12 +34,14 @@ public:
             unsigned int utn, const EvaluationTargetData* target, EvaluationManager& eval_man,
             int num_updates, int num_no_ref_pos, int num_no_ref, int num_pos_outside, int num_pos_inside,
             int num_unknown, int num_correct, int num_false,
-            std::vector<EvaluationRequirement::CheckDetail> details);
+            EvaluationRequirement::CheckDetails details);
 
     virtual void addToReport (std::shared_ptr<EvaluationResultsReport::RootItem> root_item) override;
 
     virtual std::shared_ptr<Joined> createEmptyJoined(const std::string& result_id) override;
 
+    virtual nlohmann::json toJSON() const override;
+
     int numUpdates() const;
     int numNoRefPos() const;
     int numNoRefValue() const;
@@ -49,7 +51,7 @@ public:
     int numCorrect() const;
     int numFalse() const;
 
-    std::vector<EvaluationRequirement::CheckDetail>& details();
+    EvaluationRequirement::CheckDetails& details();
 
     virtual bool hasViewableData (
             const EvaluationResultsReport::SectionContentTable& table, const QVariant& annotation) override;
@@ -75,7 +77,7 @@ protected:
     bool has_p_false_ {false};
     float p_false_{0};
 
-    std::vector<EvaluationRequirement::CheckDetail> details_;
+    EvaluationRequirement::CheckDetails details_;
 
     void updateProbabilities();
     void addTargetToOverviewTable(std::shared_ptr<EvaluationResultsReport::RootItem> root_item);
@@ -16,10 +16,14 @@
  */
 
 #include "eval/results/joined.h"
+#include "eval/results/report/rootitem.h"
+#include "eval/results/report/section.h"
 #include "eval/results/report/sectioncontenttable.h"
 #include "eval/requirement/base/base.h"
 #include "sectorlayer.h"
 
+#include <algorithm>
+
 namespace EvaluationRequirementResult
 {
 
@@ -63,6 +67,32 @@ namespace EvaluationRequirementResult
         return cnt;
     }
 
+    void Joined::updateReport (std::shared_ptr<EvaluationResultsReport::RootItem> root_item)
+    {
+        EvaluationResultsReport::SectionContentTable& ov_table = getReqOverviewTable(root_item);
+        EvaluationResultsReport::Section& sector_section = getRequirementSection(root_item);
+
+        // rows are removed and re-added, shown tables are reset once
+        ov_table.beginReset();
+        sector_section.beginResetTables();
+
+        ov_table.removeRowsOf(this);
+        sector_section.removeResultRows(this);
+
+        // errors figure or text is re-added at the same position
+        unsigned int content_pos = std::min(sector_section.removeContent("sector_errors_overview"),
+                                            sector_section.removeContent("sector_errors_overview_no_figure"));
+        unsigned int num_content = sector_section.content().size();
+
+        addToReport(root_item);
+
+        if (sector_section.content().size() > num_content)
+            sector_section.moveLastContentTo(content_pos);
+
+        sector_section.endResetTables();
+        ov_table.endReset();
+    }
+
     void Joined::addCommonDetails (EvaluationResultsReport::SectionContentTable& sector_details_table)
     {
         sector_details_table.addRow({"Sector Layer", "Name of the sector layer", sector_layer_.name().c_str()}, this);
@@ -23,6 +23,8 @@
 namespace EvaluationRequirementResult
 {
 
+class Single;
+
 class Joined : public Base
 {
 public:
@@ -36,10 +38,14 @@ public:
     virtual void join(std::shared_ptr<Base> other);
 
     virtual void addToReport (std::shared_ptr<EvaluationResultsReport::RootItem> root_item) = 0;
+    // replaces overview row and sector details, after values changed
+    void updateReport (std::shared_ptr<EvaluationResultsReport::RootItem> root_item);
 
     std::vector<std::shared_ptr<Base>>& results() { return results_; }
 
     virtual void updatesToUseChanges() = 0;
+    // adds or subtracts values of contained result, after its use changed
+    virtual void updateToUseChangeOf (std::shared_ptr<Single> result) = 0;
 
     unsigned int numResults();
     unsigned int numUsableResults();
@@ -73,6 +73,23 @@ void JoinedModeAFalse::addToValues (std::shared_ptr<SingleModeAFalse> single_res
     updateProbabilities();
 }
 
+void JoinedModeAFalse::subtractFromValues (std::shared_ptr<SingleModeAFalse> single_result)
+{
+    assert (single_result);
+    assert (!single_result->use());
+
+    num_updates_ -= single_result->numUpdates();
+    num_no_ref_pos_ -= single_result->numNoRefPos();
+    num_no_ref_val_ -= single_result->numNoRefValue();
+    num_pos_outside_ -= single_result->numPosOutside();
+    num_pos_inside_ -= single_result->numPosInside();
+    num_unknown_ -= single_result->numUnknown();
+    num_correct_ -= single_result->numCorrect();
+    num_false_ -= single_result->numFalse();
+
+    updateProbabilities();
+}
+
 void JoinedModeAFalse::updateProbabilities()
 {
     assert (num_updates_ - num_no_ref_pos_ == num_pos_inside_ + num_pos_outside_);
@@ -311,4 +328,16 @@ void JoinedModeAFalse::updatesToUseChanges()
     //            loginf << "JoinedModeA: updatesToUseChanges: updt result " << result_id_ << " has no data";
 }
 
+void JoinedModeAFalse::updateToUseChangeOf (std::shared_ptr<Single> result)
+{
+    std::shared_ptr<SingleModeAFalse> single_result =
+            std::static_pointer_cast<SingleModeAFalse>(result);
+    assert (single_result);
+
+    if (single_result->use())
+        addToValues(single_result);
+    else
+        subtractFromValues(single_result);
+}
+
 }
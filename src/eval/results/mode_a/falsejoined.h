@@ -36,6 +36,7 @@ namespace EvaluationRequirementResult
         virtual void addToReport (std::shared_ptr<EvaluationResultsReport::RootItem> root_item) override;
 
         virtual void updatesToUseChanges() override;
+        virtual void updateToUseChangeOf (std::shared_ptr<Single> result) override;
 
         virtual bool hasViewableData (
                 const EvaluationResultsReport::SectionContentTable& table, const QVariant& annotation) override;
@@ -61,6 +62,7 @@ namespace EvaluationRequirementResult
         float p_false_{0};
 
         void addToValues (std::shared_ptr<SingleModeAFalse> single_result);
+        void subtractFromValues (std::shared_ptr<SingleModeAFalse> single_result);
         void updateProbabilities();
         void addToOverviewTable(std::shared_ptr<EvaluationResultsReport::RootItem> root_item);
         void addDetails(std::shared_ptr<EvaluationResultsReport::RootItem> root_item);
@@ -72,6 +72,22 @@ namespace EvaluationRequirementResult
         updateProbabilities();
     }
 
+    void JoinedModeAPresent::subtractFromValues (std::shared_ptr<SingleModeAPresent> single_result)
+    {
+        assert (single_result);
+        assert (!single_result->use());
+
+        num_updates_ -= single_result->numUpdates();
+        num_no_ref_pos_ -= single_result->numNoRefPos();
+        num_pos_outside_ -= single_result->numPosOutside();
+        num_pos_inside_ -= single_result->numPosInside();
+        num_no_ref_id_ -= single_result->numNoRefId();
+        num_present_id_ -= single_result->numPresent();
+        num_missing_id_ -= single_result->numMissing();
+
+        updateProbabilities();
+    }
+
     void JoinedModeAPresent::updateProbabilities()
     {
         assert (num_updates_ - num_no_ref_pos_ == num_pos_inside_ + num_pos_outside_);
@@ -311,4 +327,16 @@ namespace EvaluationRequirementResult
 //            loginf << "JoinedModeA: updatesToUseChanges: updt result " << result_id_ << " has no data";
     }
 
+    void JoinedModeAPresent::updateToUseChangeOf (std::shared_ptr<Single> result)
+    {
+        std::shared_ptr<SingleModeAPresent> single_result =
+                std::static_pointer_cast<SingleModeAPresent>(result);
+        assert (single_result);
+
+        if (single_result->use())
+            addToValues(single_result);
+        else
+            subtractFromValues(single_result);
+    }
+
 }
@@ -72,6 +72,22 @@ namespace EvaluationRequirementResult
         updateProbabilities();
     }
 
+    void JoinedModeCPresent::subtractFromValues (std::shared_ptr<SingleModeCPresent> single_result)
+    {
+        assert (single_result);
+        assert (!single_result->use());
+
+        num_updates_ -= single_result->numUpdates();
+        num_no_ref_pos_ -= single_result->numNoRefPos();
+        num_pos_outside_ -= single_result->numPosOutside();
+        num_pos_inside_ -= single_result->numPosInside();
+        num_no_ref_id_ -= single_result->numNoRefC();
+        num_present_id_ -= single_result->numPresent();
+        num_missing_id_ -= single_result->numMissing();
+
+        updateProbabilities();
+    }
+
     void JoinedModeCPresent::updateProbabilities()
     {
         assert (num_updates_ - num_no_ref_pos_ == num_pos_inside_ + num_pos_outside_);
@@ -311,4 +327,16 @@ namespace EvaluationRequirementResult
 //            loginf << "JoinedModeC: updatesToUseChanges: updt result " << result_id_ << " has no data";
     }
 
+    void JoinedModeCPresent::updateToUseChangeOf (std::shared_ptr<Single> result)
+    {
+        std::shared_ptr<SingleModeCPresent> single_result =
+                std::static_pointer_cast<SingleModeCPresent>(result);
+        assert (single_result);
+
+        if (single_result->use())
+            addToValues(single_result);
+        else
+            subtractFromValues(single_result);
+    }
+
 }
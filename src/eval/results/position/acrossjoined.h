@@ -19,6 +19,7 @@
 #define EVALUATIONREQUIREMENPOSITIONJOINEDPOSITIONACROSS_H
 
 #include "eval/results/joined.h"
+#include "eval/results/valuestatistics.h"
 
 namespace EvaluationRequirementResult
 {
@@ -39,6 +40,7 @@ namespace EvaluationRequirementResult
         virtual void addToReport (std::shared_ptr<EvaluationResultsReport::RootItem> root_item) override;
 
         virtual void updatesToUseChanges() override;
+        virtual void updateToUseChangeOf (std::shared_ptr<Single> result) override;
 
         virtual bool hasViewableData (
                 const EvaluationResultsReport::SectionContentTable& table, const QVariant& annotation) override;
@@ -60,7 +62,7 @@ namespace EvaluationRequirementResult
         unsigned int num_value_ok_ {0};
         unsigned int num_value_nok_ {0};
 
-        vector<double> values_;
+        ValueStatistics value_stats_;
 
         double value_min_ {0};
         double value_max_ {0};
@@ -71,6 +73,7 @@ namespace EvaluationRequirementResult
         float p_min_{0};
 
         void addToValues (std::shared_ptr<SinglePositionAcross> single_result);
+        void subtractFromValues (std::shared_ptr<SinglePositionAcross> single_result);
         void update();
 
         void addToOverviewTable(std::shared_ptr<EvaluationResultsReport::RootItem> root_item);
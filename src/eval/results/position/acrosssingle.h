@@ -20,6 +20,7 @@
 
 
 #include "eval/results/single.h"
+#include "eval/results/valuestatistics.h"
 #include "eval/requirement/position/across.h"
 
 namespace EvaluationRequirementResult
@@ -35,13 +36,15 @@ public:
             unsigned int num_pos, unsigned int num_no_ref,
             unsigned int num_pos_outside, unsigned int num_pos_inside,
             unsigned int num_value_ok, unsigned int num_value_nok,
-            vector<double> values,
-            std::vector<EvaluationRequirement::PositionDetail> details);
+            ValueGroup value_group,
+            EvaluationRequirement::PositionDetails details);
 
     virtual void addToReport (std::shared_ptr<EvaluationResultsReport::RootItem> root_item) override;
 
     virtual std::shared_ptr<Joined> createEmptyJoined(const std::string& result_id) override;
 
+    virtual nlohmann::json toJSON() const override;
+
     unsigned int numPos() const;
     unsigned int numNoRef() const;
     unsigned int numPosOutside() const;
@@ -49,9 +52,10 @@ public:
     unsigned int numValueOk() const;
     unsigned int numValueNOk() const;
 
-    const vector<double>& values() const;
+    const ValueGroup& valueGroup() const;
+    vector<double> values() const; // exact values from details, only for exports
 
-    std::vector<EvaluationRequirement::PositionDetail>& details();
+    EvaluationRequirement::PositionDetails& details();
 
     virtual bool hasViewableData (
             const EvaluationResultsReport::SectionContentTable& table, const QVariant& annotation) override;
@@ -72,7 +76,7 @@ protected:
     unsigned int num_value_ok_ {0};
     unsigned int num_value_nok_ {0};
 
-    vector<double> values_;
+    ValueGroup value_group_; // instead of values, bounded size
 
     double value_min_ {0};
     double value_max_ {0};
@@ -82,7 +86,7 @@ protected:
     bool has_p_min_ {false};
     float p_min_{0};
 
-    std::vector<EvaluationRequirement::PositionDetail> details_;
+    EvaluationRequirement::PositionDetails details_;
 
     void update();
 
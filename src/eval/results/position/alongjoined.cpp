@@ -72,9 +72,24 @@ void JoinedPositionAlong::addToValues (std::shared_ptr<SinglePositionAlong> sing
     num_value_ok_ += single_result->numValueOk();
     num_value_nok_ += single_result->numValueNOk();
 
-    const vector<double>& other_values = single_result->values();
+    value_stats_.add(single_result->utn(), single_result->valueGroup());
 
-    values_.insert(values_.end(), other_values.begin(), other_values.end());
+    update();
+}
+
+void JoinedPositionAlong::subtractFromValues (std::shared_ptr<SinglePositionAlong> single_result)
+{
+    assert (single_result);
+    assert (!single_result->use());
+
+    num_pos_ -= single_result->numPos();
+    num_no_ref_ -= single_result->numNoRef();
+    num_pos_outside_ -= single_result->numPosOutside();
+    num_pos_inside_ -= single_result->numPosInside();
+    num_value_ok_ -= single_result->numValueOk();
+    num_value_nok_ -= single_result->numValueNOk();
+
+    value_stats_.subtract(single_result->utn(), single_result->valueGroup());
 
     update();
 }
@@ -84,20 +99,16 @@ void JoinedPositionAlong::update()
     assert (num_no_ref_ <= num_pos_);
     assert (num_pos_ - num_no_ref_ == num_pos_inside_ + num_pos_outside_);
 
-    assert (values_.size() == num_value_ok_+num_value_nok_);
+    assert (value_stats_.count() == num_value_ok_+num_value_nok_);
 
-    unsigned int num_distances = values_.size();
+    unsigned int num_distances = value_stats_.count();
 
     if (num_distances)
     {
-        value_min_ = *min_element(values_.begin(), values_.end());
-        value_max_ = *max_element(values_.begin(), values_.end());
-        value_avg_ = std::accumulate(values_.begin(), values_.end(), 0.0) / (float) num_distances;
-
-        value_var_ = 0;
-        for(auto val : values_)
-            value_var_ += pow(val - value_avg_, 2);
-        value_var_ /= (float)num_distances;
+        value_min_ = value_stats_.min();
+        value_max_ = value_stats_.max();
+        value_avg_ = value_stats_.avg();
+        value_var_ = value_stats_.var();
 
         assert (num_value_ok_ <= num_distances);
         p_min_ = (float)num_value_ok_/(float)num_distances;
@@ -200,6 +211,19 @@ void JoinedPositionAlong::addDetails(std::shared_ptr<EvaluationResultsReport::Ro
                           String::doubleToStringPrecision(sqrt(value_var_),2).c_str()}, this);
     sec_det_table.addRow({"ALVar [m^2]", "Variance of along-track error",
                           String::doubleToStringPrecision(value_var_,2).c_str()}, this);
+
+    // percentiles, estimated from sketch
+    QVariant p95_var, p99_var;
+
+    if (value_stats_.count())
+    {
+        p95_var = String::doubleToStringPrecision(value_stats_.quantile(0.95),2).c_str();
+        p99_var = String::doubleToStringPrecision(value_stats_.quantile(0.99),2).c_str();
+    }
+
+    sec_det_table.addRow({"ALP95 [m]", "95th percentile of along-track error (estimated)", p95_var}, this);
+    sec_det_table.addRow({"ALP99 [m]", "99th percentile of along-track error (estimated)", p99_var}, this);
+
     sec_det_table.addRow({"#ALOK [1]", "Number of updates with along-track error", num_value_ok_}, this);
     sec_det_table.addRow({"#ALNOK [1]", "Number of updates with unacceptable along-track error ", num_value_nok_},
                          this);
@@ -310,7 +334,7 @@ void JoinedPositionAlong::updatesToUseChanges()
     num_value_ok_ = 0;
     num_value_nok_ = 0;
 
-    values_.clear();
+    value_stats_.clear();
 
     for (auto result_it : results_)
     {
@@ -322,6 +346,18 @@ void JoinedPositionAlong::updatesToUseChanges()
     }
 }
 
+void JoinedPositionAlong::updateToUseChangeOf (std::shared_ptr<Single> result)
+{
+    std::shared_ptr<SinglePositionAlong> single_result =
+            std::static_pointer_cast<SinglePositionAlong>(result);
+    assert (single_result);
+
+    if (single_result->use())
+        addToValues(single_result);
+    else
+        subtractFromValues(single_result);
+}
+
 void JoinedPositionAlong::exportAsCSV()
 {
     loginf << "JoinedPositionAlong: exportAsCSV";
@@ -346,10 +382,19 @@ void JoinedPositionAlong::exportAsCSV()
         if (output_file)
         {
             output_file << "d_along\n";
-            unsigned int size = values_.size();
 
-            for (unsigned int cnt=0; cnt < size; ++cnt)
-                output_file << values_.at(cnt) << "\n";
+            for (auto& result_it : results_)
+            {
+                if (!result_it->use())
+                    continue;
+
+                std::shared_ptr<SinglePositionAlong> result =
+                        std::static_pointer_cast<SinglePositionAlong>(result_it);
+                assert (result);
+
+                for (auto value : result->values())
+                    output_file << value << "\n";
+            }
         }
     }
 }
@@ -72,9 +72,24 @@ void JoinedPositionDistance::addToValues (std::shared_ptr<SinglePositionDistance
     num_comp_failed_ += single_result->numCompFailed();
     num_comp_passed_ += single_result->numCompPassed();
 
-    const vector<double>& other_values = single_result->values();
+    value_stats_.add(single_result->utn(), single_result->valueGroup());
 
-    values_.insert(values_.end(), other_values.begin(), other_values.end());
+    update();
+}
+
+void JoinedPositionDistance::subtractFromValues (std::shared_ptr<SinglePositionDistance> single_result)
+{
+    assert (single_result);
+    assert (!single_result->use());
+
+    num_pos_ -= single_result->numPos();
+    num_no_ref_ -= single_result->numNoRef();
+    num_pos_outside_ -= single_result->numPosOutside();
+    num_pos_inside_ -= single_result->numPosInside();
+    num_comp_failed_ -= single_result->numCompFailed();
+    num_comp_passed_ -= single_result->numCompPassed();
+
+    value_stats_.subtract(single_result->utn(), single_result->valueGroup());
 
     update();
 }
@@ -84,20 +99,16 @@ void JoinedPositionDistance::update()
     assert (num_no_ref_ <= num_pos_);
     assert (num_pos_ - num_no_ref_ == num_pos_inside_ + num_pos_outside_);
 
-    assert (values_.size() == num_comp_failed_+num_comp_passed_);
+    assert (value_stats_.count() == num_comp_failed_+num_comp_passed_);
 
-    unsigned int num_distances = values_.size();
+    unsigned int num_distances = value_stats_.count();
 
     if (num_distances)
     {
-        value_min_ = *min_element(values_.begin(), values_.end());
-        value_max_ = *max_element(values_.begin(), values_.end());
-        value_avg_ = std::accumulate(values_.begin(), values_.end(), 0.0) / (float) num_distances;
-
-        value_var_ = 0;
-        for(auto val : values_)
-            value_var_ += pow(val - value_avg_, 2);
-        value_var_ /= (float)num_distances;
+        value_min_ = value_stats_.min();
+        value_max_ = value_stats_.max();
+        value_avg_ = value_stats_.avg();
+        value_var_ = value_stats_.var();
 
         assert (num_comp_failed_ <= num_distances);
         p_passed_ = (float)num_comp_passed_/(float)num_distances;
@@ -200,6 +211,19 @@ void JoinedPositionDistance::addDetails(std::shared_ptr<EvaluationResultsReport:
                           String::doubleToStringPrecision(sqrt(value_var_),2).c_str()}, this);
     sec_det_table.addRow({"DVar [m^2]", "Variance of distance",
                           String::doubleToStringPrecision(value_var_,2).c_str()}, this);
+
+    // percentiles, estimated from sketch
+    QVariant p95_var, p99_var;
+
+    if (value_stats_.count())
+    {
+        p95_var = String::doubleToStringPrecision(value_stats_.quantile(0.95),2).c_str();
+        p99_var = String::doubleToStringPrecision(value_stats_.quantile(0.99),2).c_str();
+    }
+
+    sec_det_table.addRow({"DP95 [m]", "95th percentile of distance (estimated)", p95_var}, this);
+    sec_det_table.addRow({"DP99 [m]", "99th percentile of distance (estimated)", p99_var}, this);
+
     sec_det_table.addRow({"#CF [1]", "Number of updates with failed comparison", num_comp_failed_}, this);
     sec_det_table.addRow({"#CP [1]", "Number of updates with passed comparison ", num_comp_passed_},
                          this);
@@ -225,7 +249,7 @@ void JoinedPositionDistance::addDetails(std::shared_ptr<EvaluationResultsReport:
     }
 
     // figure
-    if (values_.size()) // TODO
+    if (value_stats_.count()) // TODO
     {
         sector_section.addFigure("sector_errors_overview", "Sector Errors Overview",
                                  getErrorsViewable());
@@ -310,7 +334,7 @@ void JoinedPositionDistance::updatesToUseChanges()
     num_comp_failed_ = 0;
     num_comp_passed_ = 0;
 
-    values_.clear();
+    value_stats_.clear();
 
     for (auto result_it : results_)
     {
@@ -322,6 +346,18 @@ void JoinedPositionDistance::updatesToUseChanges()
     }
 }
 
+void JoinedPositionDistance::updateToUseChangeOf (std::shared_ptr<Single> result)
+{
+    std::shared_ptr<SinglePositionDistance> single_result =
+            std::static_pointer_cast<SinglePositionDistance>(result);
+    assert (single_result);
+
+    if (single_result->use())
+        addToValues(single_result);
+    else
+        subtractFromValues(single_result);
+}
+
 void JoinedPositionDistance::exportAsCSV()
 {
     loginf << "JoinedPositionDistance: exportAsCSV";
@@ -346,10 +382,19 @@ void JoinedPositionDistance::exportAsCSV()
         if (output_file)
         {
             output_file << "distance\n";
-            unsigned int size = values_.size();
 
-            for (unsigned int cnt=0; cnt < size; ++cnt)
-                output_file << values_.at(cnt) << "\n";
+            for (auto& result_it : results_)
+            {
+                if (!result_it->use())
+                    continue;
+
+                std::shared_ptr<SinglePositionDistance> result =
+                        std::static_pointer_cast<SinglePositionDistance>(result_it);
+                assert (result);
+
+                for (auto value : result->values())
+                    output_file << value << "\n";
+            }
         }
     }
 }
@@ -45,13 +45,15 @@ namespace EvaluationRequirementResult
             unsigned int num_pos, unsigned int num_no_ref,
             unsigned int num_pos_outside, unsigned int num_pos_inside,
             unsigned int num_comp_failed, unsigned int num_comp_passed,
-            vector<double> values,
-            std::vector<EvaluationRequirement::PositionDetail> details)
+            ValueGroup value_group,
+            EvaluationRequirement::PositionDetails details)
         : Single("SinglePositionDistance", result_id, requirement, sector_layer, utn, target, eval_man),
           num_pos_(num_pos), num_no_ref_(num_no_ref), num_pos_outside_(num_pos_outside),
           num_pos_inside_(num_pos_inside), num_comp_failed_(num_comp_failed), num_comp_passed_(num_comp_passed),
-          values_(values), details_(details)
+          value_group_(value_group), details_(details)
     {
+        details_.shrink_to_fit();
+
         update();
     }
 
@@ -61,20 +63,16 @@ namespace EvaluationRequirementResult
         assert (num_no_ref_ <= num_pos_);
         assert (num_pos_ - num_no_ref_ == num_pos_inside_ + num_pos_outside_);
 
-        assert (values_.size() == num_comp_failed_+num_comp_passed_);
+        assert (value_group_.count() == num_comp_failed_+num_comp_passed_);
 
-        unsigned int num_distances = values_.size();
+        unsigned int num_distances = value_group_.count();
 
         if (num_distances)
         {
-            value_min_ = *min_element(values_.begin(), values_.end());
-            value_max_ = *max_element(values_.begin(), values_.end());
-            value_avg_ = std::accumulate(values_.begin(), values_.end(), 0.0) / (float) num_distances;
-
-            value_var_ = 0;
-            for(auto val : values_)
-                value_var_ += pow(val - value_avg_, 2);
-            value_var_ /= (float)num_distances;
+            value_min_ = value_group_.min();
+            value_max_ = value_group_.max();
+            value_avg_ = value_group_.avg();
+            value_var_ = value_group_.var();
 
             assert (num_comp_failed_ <= num_distances);
             p_passed_ = (float)num_comp_passed_/(float)num_distances;
@@ -301,7 +299,7 @@ namespace EvaluationRequirementResult
 
         unsigned int detail_cnt = 0;
 
-        for (auto& rq_det_it : details_)
+        for (const auto& rq_det_it : details_)
         {
             utn_req_details_table.addRow(
             {String::timeStringFromDouble(rq_det_it.tod_).c_str(),
@@ -348,7 +346,7 @@ namespace EvaluationRequirementResult
                     = eval_man_.getViewableForEvaluation(utn_, req_grp_id_, result_id_);
             assert (viewable_ptr);
 
-            const EvaluationRequirement::PositionDetail& detail = details_.at(detail_cnt);
+            EvaluationRequirement::PositionDetail detail = details_.at(detail_cnt);
 
             (*viewable_ptr)["position_latitude"] = detail.tst_pos_.latitude_;
             (*viewable_ptr)["position_longitude"] = detail.tst_pos_.longitude_;
@@ -375,7 +373,7 @@ namespace EvaluationRequirementResult
 
         bool failed_values_of_interest = req()->failedValuesOfInterest();
 
-        for (auto& detail_it : details_)
+        for (const auto& detail_it : details_)
         {
             if ((failed_values_of_interest && detail_it.check_passed_)
                     || (!failed_values_of_interest && !detail_it.check_passed_))
@@ -459,9 +457,14 @@ namespace EvaluationRequirementResult
     }
 
 
-    const vector<double>& SinglePositionDistance::values() const
+    const ValueGroup& SinglePositionDistance::valueGroup() const
+    {
+        return value_group_;
+    }
+
+    vector<double> SinglePositionDistance::values() const
     {
-        return values_;
+        return details_.values();
     }
 
     unsigned int SinglePositionDistance::numPosOutside() const
@@ -479,6 +482,23 @@ namespace EvaluationRequirementResult
         return make_shared<JoinedPositionDistance> (result_id, requirement_, sector_layer_, eval_man_);
     }
 
+    nlohmann::json SinglePositionDistance::toJSON() const
+    {
+        nlohmann::json j;
+
+        j["num_pos"] = num_pos_;
+        j["num_no_ref"] = num_no_ref_;
+        j["num_pos_outside"] = num_pos_outside_;
+        j["num_pos_inside"] = num_pos_inside_;
+        j["num_comp_failed"] = num_comp_failed_;
+        j["num_comp_passed"] = num_comp_passed_;
+        j["value_group"] = value_group_.toJSON();
+
+        j["details"] = details_.toJSON();
+
+        return j;
+    }
+
     unsigned int SinglePositionDistance::numPos() const
     {
         return num_pos_;
@@ -489,7 +509,7 @@ namespace EvaluationRequirementResult
         return num_no_ref_;
     }
 
-    std::vector<EvaluationRequirement::PositionDetail>& SinglePositionDistance::details()
+    EvaluationRequirement::PositionDetails& SinglePositionDistance::details()
     {
         return details_;
     }
@@ -45,13 +45,15 @@ namespace EvaluationRequirementResult
             unsigned int num_pos, unsigned int num_no_ref,
             unsigned int num_pos_outside, unsigned int num_pos_inside,
             unsigned int num_value_ok, unsigned int num_value_nok,
-            vector<double> values,
-            std::vector<EvaluationRequirement::PositionDetail> details)
+            ValueGroup value_group,
+            EvaluationRequirement::PositionDetails details)
         : Single("SinglePositionLatency", result_id, requirement, sector_layer, utn, target, eval_man),
           num_pos_(num_pos), num_no_ref_(num_no_ref), num_pos_outside_(num_pos_outside),
           num_pos_inside_(num_pos_inside), num_value_ok_(num_value_ok), num_value_nok_(num_value_nok),
-          values_(values), details_(details)
+          value_group_(value_group), details_(details)
     {
+        details_.shrink_to_fit();
+
         update();
     }
 
@@ -61,20 +63,16 @@ namespace EvaluationRequirementResult
         assert (num_no_ref_ <= num_pos_);
         assert (num_pos_ - num_no_ref_ == num_pos_inside_ + num_pos_outside_);
 
-        assert (values_.size() == num_value_ok_+num_value_nok_);
+        assert (value_group_.count() == num_value_ok_+num_value_nok_);
 
-        unsigned int num_distances = values_.size();
+        unsigned int num_distances = value_group_.count();
 
         if (num_distances)
         {
-            value_min_ = *min_element(values_.begin(), values_.end());
-            value_max_ = *max_element(values_.begin(), values_.end());
-            value_avg_ = std::accumulate(values_.begin(), values_.end(), 0.0) / (float) num_distances;
-
-            value_var_ = 0;
-            for(auto val : values_)
-                value_var_ += pow(val - value_avg_, 2);
-            value_var_ /= (float)num_distances;
+            value_min_ = value_group_.min();
+            value_max_ = value_group_.max();
+            value_avg_ = value_group_.avg();
+            value_var_ = value_group_.var();
 
             assert (num_value_ok_ <= num_distances);
             p_min_ = (float)num_value_ok_/(float)num_distances;
@@ -286,7 +284,7 @@ namespace EvaluationRequirementResult
 
         unsigned int detail_cnt = 0;
 
-        for (auto& rq_det_it : details_)
+        for (const auto& rq_det_it : details_)
         {
             utn_req_details_table.addRow(
             {String::timeStringFromDouble(rq_det_it.tod_).c_str(),
@@ -333,7 +331,7 @@ namespace EvaluationRequirementResult
                     = eval_man_.getViewableForEvaluation(utn_, req_grp_id_, result_id_);
             assert (viewable_ptr);
 
-            const EvaluationRequirement::PositionDetail& detail = details_.at(detail_cnt);
+            EvaluationRequirement::PositionDetail detail = details_.at(detail_cnt);
 
             (*viewable_ptr)["position_latitude"] = detail.tst_pos_.latitude_;
             (*viewable_ptr)["position_longitude"] = detail.tst_pos_.longitude_;
@@ -358,7 +356,7 @@ namespace EvaluationRequirementResult
         bool has_pos = false;
         double lat_min, lat_max, lon_min, lon_max;
 
-        for (auto& detail_it : details_)
+        for (const auto& detail_it : details_)
         {
             if (detail_it.check_passed_)
                 continue;
@@ -441,9 +439,14 @@ namespace EvaluationRequirementResult
     }
 
 
-    const vector<double>& SinglePositionLatency::values() const
+    const ValueGroup& SinglePositionLatency::valueGroup() const
+    {
+        return value_group_;
+    }
+
+    vector<double> SinglePositionLatency::values() const
     {
-        return values_;
+        return details_.values();
     }
 
     unsigned int SinglePositionLatency::numPosOutside() const
@@ -461,6 +464,23 @@ namespace EvaluationRequirementResult
         return make_shared<JoinedPositionLatency> (result_id, requirement_, sector_layer_, eval_man_);
     }
 
+    nlohmann::json SinglePositionLatency::toJSON() const
+    {
+        nlohmann::json j;
+
+        j["num_pos"] = num_pos_;
+        j["num_no_ref"] = num_no_ref_;
+        j["num_pos_outside"] = num_pos_outside_;
+        j["num_pos_inside"] = num_pos_inside_;
+        j["num_value_ok"] = num_value_ok_;
+        j["num_value_nok"] = num_value_nok_;
+        j["value_group"] = value_group_.toJSON();
+
+        j["details"] = details_.toJSON();
+
+        return j;
+    }
+
     unsigned int SinglePositionLatency::numPos() const
     {
         return num_pos_;
@@ -471,7 +491,7 @@ namespace EvaluationRequirementResult
         return num_no_ref_;
     }
 
-    std::vector<EvaluationRequirement::PositionDetail>& SinglePositionLatency::details()
+    EvaluationRequirement::PositionDetails& SinglePositionLatency::details()
     {
         return details_;
     }
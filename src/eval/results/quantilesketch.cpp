@@ -0,0 +1,221 @@
+/*
+ * This file is part of OpenATS COMPASS.
+ *
+ * COMPASS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * COMPASS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with COMPASS. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "eval/results/quantilesketch.h"
+#include "eval/requirement/detailcolumns.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+namespace EvaluationRequirementResult
+{
+
+QuantileSketch::QuantileSketch(double compression)
+    : compression_(compression)
+{
+    assert (compression_ > 0);
+}
+
+void QuantileSketch::add (const std::vector<double>& values)
+{
+    if (!values.size())
+        return;
+
+    std::vector<Centroid> incoming;
+    incoming.reserve(values.size());
+
+    for (auto val : values)
+        incoming.push_back({val, 1.0});
+
+    compress(incoming);
+}
+
+void QuantileSketch::merge (const QuantileSketch& other)
+{
+    if (!other.total_weight_)
+        return;
+
+    std::vector<Centroid> incoming = other.centroids_;
+
+    double min = other.min_;
+    double max = other.max_;
+
+    compress(incoming);
+
+    min_ = std::min(min_, min); // exact extremes of other
+    max_ = std::max(max_, max);
+}
+
+void QuantileSketch::clear()
+{
+    centroids_.clear();
+    total_weight_ = 0;
+    min_ = 0;
+    max_ = 0;
+}
+
+double QuantileSketch::quantile (double q) const
+{
+    assert (total_weight_ > 0);
+    assert (centroids_.size());
+
+    q = std::min(std::max(q, 0.0), 1.0);
+
+    if (centroids_.size() == 1)
+        return centroids_.front().mean_;
+
+    double index = q * total_weight_;
+
+    // between min and center of first centroid
+    const Centroid& first = centroids_.front();
+
+    if (index < first.weight_ / 2)
+        return min_ + (first.mean_ - min_) * index / (first.weight_ / 2);
+
+    // between centers of neighbouring centroids
+    double weight_so_far = 0;
+    double left_center, right_center;
+
+    for (unsigned int cnt=0; cnt < centroids_.size() - 1; ++cnt)
+    {
+        const Centroid& left = centroids_[cnt];
+        const Centroid& right = centroids_[cnt+1];
+
+        left_center = weight_so_far + left.weight_ / 2;
+        right_center = weight_so_far + left.weight_ + right.weight_ / 2;
+
+        if (index < right_center)
+            return left.mean_ + (right.mean_ - left.mean_) * (index - left_center) / (right_center - left_center);
+
+        weight_so_far += left.weight_;
+    }
+
+    // between center of last centroid and max
+    const Centroid& last = centroids_.back();
+    double last_center = total_weight_ - last.weight_ / 2;
+
+    if (index >= total_weight_)
+        return max_;
+
+    return last.mean_ + (max_ - last.mean_) * (index - last_center) / (last.weight_ / 2);
+}
+
+nlohmann::json QuantileSketch::toJSON() const
+{
+    std::vector<double> means, weights;
+
+    for (auto& centroid_it : centroids_)
+    {
+        means.push_back(centroid_it.mean_);
+        weights.push_back(centroid_it.weight_);
+    }
+
+    nlohmann::json j;
+
+    j["compression"] = compression_;
+    j["means"] = EvaluationRequirement::valuesToJSON(means);
+    j["weights"] = weights;
+    j["min_max"] = EvaluationRequirement::valuesToJSON(std::vector<double>{min_, max_});
+
+    return j;
+}
+
+void QuantileSketch::fromJSON (const nlohmann::json& j)
+{
+    compression_ = j.at("compression").get<double>();
+
+    std::vector<double> means = EvaluationRequirement::valuesFromJSON<double>(j.at("means"));
+    std::vector<double> weights = j.at("weights").get<std::vector<double>>();
+    std::vector<double> min_max = EvaluationRequirement::valuesFromJSON<double>(j.at("min_max"));
+
+    assert (means.size() == weights.size());
+    assert (min_max.size() == 2);
+
+    centroids_.clear();
+    total_weight_ = 0;
+
+    for (unsigned int cnt=0; cnt < means.size(); ++cnt)
+    {
+        centroids_.push_back({means.at(cnt), weights.at(cnt)});
+        total_weight_ += weights.at(cnt);
+    }
+
+    min_ = min_max.at(0);
+    max_ = min_max.at(1);
+}
+
+void QuantileSketch::compress (std::vector<Centroid>& incoming)
+{
+    assert (incoming.size());
+
+    std::sort(incoming.begin(), incoming.end());
+
+    double incoming_min = incoming.front().mean_;
+    double incoming_max = incoming.back().mean_;
+
+    if (total_weight_)
+    {
+        min_ = std::min(min_, incoming_min);
+        max_ = std::max(max_, incoming_max);
+    }
+    else
+    {
+        min_ = incoming_min;
+        max_ = incoming_max;
+    }
+
+    std::vector<Centroid> all;
+    all.reserve(centroids_.size() + incoming.size());
+    std::merge(centroids_.begin(), centroids_.end(), incoming.begin(), incoming.end(), std::back_inserter(all));
+
+    for (auto& centroid_it : incoming)
+        total_weight_ += centroid_it.weight_;
+
+    // scale function k1, centroid sizes limited to one unit of k, so smaller at the tails
+    auto k = [this](double q) { return compression_ / (2 * M_PI) * asin(2 * q - 1); };
+    auto k_inv = [this](double k) { return (sin(k * 2 * M_PI / compression_) + 1) / 2; };
+
+    centroids_.clear();
+
+    Centroid current = all.front();
+    double weight_so_far = 0;
+    double q_limit = k_inv(k(0) + 1) * total_weight_;
+
+    for (unsigned int cnt=1; cnt < all.size(); ++cnt)
+    {
+        const Centroid& next = all[cnt];
+
+        if (weight_so_far + current.weight_ + next.weight_ <= q_limit)
+        {
+            current.mean_ += (next.mean_ - current.mean_) * next.weight_ / (current.weight_ + next.weight_);
+            current.weight_ += next.weight_;
+        }
+        else
+        {
+            weight_so_far += current.weight_;
+            centroids_.push_back(current);
+
+            q_limit = k_inv(k(weight_so_far / total_weight_) + 1) * total_weight_;
+            current = next;
+        }
+    }
+
+    centroids_.push_back(current);
+}
+
+}
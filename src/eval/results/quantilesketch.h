@@ -0,0 +1,72 @@
+/*
+ * This file is part of OpenATS COMPASS.
+ *
+ * COMPASS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * COMPASS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with COMPASS. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef EVALUATIONREQUIREMENTRESULTQUANTILESKETCH_H
+#define EVALUATIONREQUIREMENTRESULTQUANTILESKETCH_H
+
+#include "json.hpp"
+
+#include <vector>
+
+namespace EvaluationRequirementResult
+{
+
+/**
+ * @brief Mergeable approximation of the distribution of values (merging t-digest)
+ *
+ * Values are summarized by weighted centroids, their number is bounded by about the compression. Centroids
+ * near the tails are kept small, so that high percentiles (e.g. 95%, 99%) are accurate. Sketches of several
+ * results can be merged, subtraction is not possible.
+ */
+class QuantileSketch
+{
+public:
+    QuantileSketch(double compression=200.0);
+
+    void add (const std::vector<double>& values);
+    void merge (const QuantileSketch& other);
+    void clear();
+
+    double count() const { return total_weight_; }
+    double quantile (double q) const; // q in [0,1], count has to be > 0
+
+    nlohmann::json toJSON() const;
+    void fromJSON (const nlohmann::json& j);
+
+protected:
+    struct Centroid
+    {
+        double mean_;
+        double weight_;
+
+        bool operator<(const Centroid& other) const { return mean_ < other.mean_; }
+    };
+
+    double compression_;
+
+    std::vector<Centroid> centroids_; // sorted by mean
+    double total_weight_ {0};
+
+    double min_ {0};
+    double max_ {0};
+
+    void compress (std::vector<Centroid>& incoming); // merges incoming into centroids
+};
+
+}
+
+#endif // EVALUATIONREQUIREMENTRESULTQUANTILESKETCH_H
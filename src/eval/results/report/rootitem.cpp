@@ -107,4 +107,26 @@ namespace EvaluationResultsReport
         assert (tmp);
         return *tmp;
     }
+
+    void RootItem::removeSection (const std::string& id)
+    {
+        logdbg << "RootItem: removeSection: id '" << id << "'";
+
+        assert (id.size());
+        std::vector<std::string> parts = String::split(id, ':');
+        assert (parts.size());
+
+        Section* tmp = root_section_.get();
+
+        for (unsigned int cnt=0; cnt < parts.size() - 1; ++cnt)
+        {
+            if (!tmp->hasSubSection(parts.at(cnt)))
+                return;
+
+            tmp = &tmp->getSubSection(parts.at(cnt));
+        }
+
+        if (tmp->hasSubSection(parts.back()))
+            tmp->removeSubSection(parts.back());
+    }
 }
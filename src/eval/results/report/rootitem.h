@@ -44,6 +44,7 @@ namespace EvaluationResultsReport
         std::shared_ptr<Section> rootSection();
 
         Section& getSection (const std::string& id); // bla:bla2
+        void removeSection (const std::string& id); // bla:bla2, if existing
 
     protected:
         EvaluationManager& eval_man_;
@@ -25,6 +25,8 @@
 
 #include <QVBoxLayout>
 
+#include <algorithm>
+
 namespace EvaluationResultsReport
 {
 
@@ -119,6 +121,17 @@ namespace EvaluationResultsReport
         assert (hasSubSection(heading));
     }
 
+    void Section::removeSubSection (const std::string& heading)
+    {
+        logdbg << "Section " << heading_ << ": removeSubSection: removing " << heading;
+
+        assert (hasSubSection(heading));
+
+        sub_sections_.erase(std::find_if(sub_sections_.begin(), sub_sections_.end(),
+                                         [&heading](const shared_ptr<Section>& sec)
+                                         { return sec->heading() == heading; }));
+    }
+
     QWidget* Section::getContentWidget()
     {
         if (!content_widget_)
@@ -190,6 +203,72 @@ namespace EvaluationResultsReport
         assert (hasFigure(name));
     }
 
+    void Section::removeResultRows (EvaluationRequirementResult::Base* result_ptr)
+    {
+        SectionContentTable* tmp;
+
+        for (auto& cont_it : content_)
+        {
+            tmp = dynamic_cast<SectionContentTable*>(cont_it.get());
+
+            if (tmp)
+                tmp->removeRowsOf(result_ptr);
+        }
+    }
+
+    void Section::beginResetTables()
+    {
+        SectionContentTable* tmp;
+
+        for (auto& cont_it : content_)
+        {
+            tmp = dynamic_cast<SectionContentTable*>(cont_it.get());
+
+            if (tmp)
+                tmp->beginReset();
+        }
+    }
+
+    void Section::endResetTables()
+    {
+        SectionContentTable* tmp;
+
+        for (auto& cont_it : content_)
+        {
+            tmp = dynamic_cast<SectionContentTable*>(cont_it.get());
+
+            if (tmp)
+                tmp->endReset();
+        }
+    }
+
+    unsigned int Section::removeContent (const std::string& name)
+    {
+        for (unsigned int cnt=0; cnt < content_.size(); ++cnt)
+        {
+            if (content_.at(cnt)->name() == name)
+            {
+                content_.erase(content_.begin() + cnt);
+                content_widget_ = nullptr; // re-created on next show
+
+                return cnt;
+            }
+        }
+
+        return content_.size();
+    }
+
+    void Section::moveLastContentTo (unsigned int pos)
+    {
+        assert (content_.size());
+
+        if (pos >= content_.size() - 1)
+            return;
+
+        std::rotate(content_.begin() + pos, content_.end() - 1, content_.end());
+        content_widget_ = nullptr;
+    }
+
     unsigned int Section::numSections()
     {
         unsigned int num = 1; // me
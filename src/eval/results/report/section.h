@@ -30,6 +30,11 @@
 class EvaluationManager;
 class LatexVisitor;
 
+namespace EvaluationRequirementResult
+{
+    class Base;
+}
+
 namespace EvaluationResultsReport
 {
     using namespace std;
@@ -59,6 +64,7 @@ namespace EvaluationResultsReport
         bool hasSubSection (const std::string& heading);
         Section& getSubSection (const std::string& heading);
         void addSubSection (const std::string& heading);
+        void removeSubSection (const std::string& heading);
 
         QWidget* getContentWidget();
 
@@ -76,6 +82,15 @@ namespace EvaluationResultsReport
         void addFigure (const std::string& name, const string& caption,
                         std::unique_ptr<nlohmann::json::object_t> viewable_data);
 
+        // removes table rows of result in this section, used when updating a single result
+        void removeResultRows (EvaluationRequirementResult::Base* result_ptr);
+        // row changes of tables in this section are notified by one reset per table in endResetTables
+        void beginResetTables();
+        void endResetTables();
+        // returns position of removed content, number of contents if not found
+        unsigned int removeContent (const std::string& name);
+        void moveLastContentTo (unsigned int pos); // to replace removed content at same position
+
         unsigned int numSections(); // all sections contained
         void addSectionsFlat (vector<shared_ptr<Section>>& result, bool include_target_details);
 
@@ -35,6 +35,7 @@
 #include <QClipboard>
 #include <QApplication>
 
+#include <algorithm>
 #include <cassert>
 #include <type_traits>
 #include <iostream>
@@ -59,12 +60,102 @@ namespace EvaluationResultsReport
     {
         assert (row.size() == num_columns_);
 
-        rows_.push_back(row);
-        result_ptrs_.push_back(result_ptr);
-        annotations_.push_back(annotation);
+        unsigned int row_order;
+
+        auto removed_it = removed_row_orders_.find(result_ptr);
+
+        if (removed_it != removed_row_orders_.end()) // re-added
+        {
+            row_order = removed_it->second.front();
+            removed_it->second.erase(removed_it->second.begin());
+
+            if (!removed_it->second.size())
+                removed_row_orders_.erase(removed_it);
+        }
+        else
+            row_order = next_row_order_++;
+
+        unsigned int index = lower_bound(row_orders_.begin(), row_orders_.end(), row_order) - row_orders_.begin();
+
+        bool notify = proxy_model_ && !resetting_; // only if may be shown
+
+        if (notify)
+            beginInsertRows(QModelIndex(), index, index);
+
+        rows_.insert(rows_.begin() + index, move(row));
+        result_ptrs_.insert(result_ptrs_.begin() + index, result_ptr);
+        annotations_.insert(annotations_.begin() + index, annotation);
+        row_orders_.insert(row_orders_.begin() + index, row_order);
+
+        if (notify)
+            endInsertRows();
 
         assert (annotations_.size() == rows_.size());
         assert (result_ptrs_.size() == rows_.size());
+        assert (row_orders_.size() == rows_.size());
+    }
+
+    void SectionContentTable::removeRowsOf (EvaluationRequirementResult::Base* result_ptr)
+    {
+        assert (result_ptr);
+
+        if (std::find(result_ptrs_.begin(), result_ptrs_.end(), result_ptr) == result_ptrs_.end())
+            return;
+
+        bool notify = proxy_model_ && !resetting_;
+
+        if (notify)
+            beginResetModel();
+
+        vector<unsigned int>& removed_orders = removed_row_orders_[result_ptr];
+        unsigned int new_size = 0;
+
+        for (unsigned int cnt=0; cnt < rows_.size(); ++cnt)
+        {
+            if (result_ptrs_.at(cnt) == result_ptr)
+            {
+                removed_orders.push_back(row_orders_.at(cnt));
+                continue;
+            }
+
+            if (new_size != cnt)
+            {
+                rows_.at(new_size) = move(rows_.at(cnt));
+                result_ptrs_.at(new_size) = result_ptrs_.at(cnt);
+                annotations_.at(new_size) = move(annotations_.at(cnt));
+                row_orders_.at(new_size) = row_orders_.at(cnt);
+            }
+
+            ++new_size;
+        }
+
+        rows_.resize(new_size);
+        result_ptrs_.resize(new_size);
+        annotations_.resize(new_size);
+        row_orders_.resize(new_size);
+
+        sort(removed_orders.begin(), removed_orders.end()); // if not all were re-added before
+
+        if (notify)
+            endResetModel();
+    }
+
+    void SectionContentTable::beginReset()
+    {
+        if (resetting_)
+            return;
+
+        beginResetModel();
+        resetting_ = true;
+    }
+
+    void SectionContentTable::endReset()
+    {
+        if (!resetting_)
+            return;
+
+        resetting_ = false;
+        endResetModel();
     }
 
     void SectionContentTable::addToLayout (QVBoxLayout* layout)
@@ -405,8 +496,7 @@ namespace EvaluationResultsReport
 
     void SectionContentTable::registerCallBack (const std::string& name, std::function<void()> func)
     {
-        assert (!callback_map_.count(name));
-        callback_map_.emplace(name, func);
+        callback_map_[name] = func; // replaced if result is re-added to report
     }
     void SectionContentTable::executeCallBack (const std::string& name)
     {
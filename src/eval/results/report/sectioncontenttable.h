@@ -24,9 +24,11 @@
 #include <QAbstractItemModel>
 #include <QSortFilterProxyModel>
 #include <QBrush>
+#include <QPointer>
 
 #include "json.hpp"
 
+#include <map>
 #include <vector>
 
 class ViewableDataConfig;
@@ -111,8 +113,14 @@ namespace EvaluationResultsReport
                             vector<string> headings, Section* parent_section, EvaluationManager& eval_man,
                             bool sortable=true, unsigned int sort_column=0, Qt::SortOrder order=Qt::AscendingOrder);
 
+        // rows of a removed result are re-added at their previous position
         void addRow (vector<QVariant> row, EvaluationRequirementResult::Base* result_ptr,
                      QVariant annotation = {});
+        void removeRowsOf (EvaluationRequirementResult::Base* result_ptr);
+
+        // row changes in between are notified by one model reset
+        void beginReset();
+        void endReset();
 
         virtual void addToLayout (QVBoxLayout* layout) override;
 
@@ -153,13 +161,19 @@ namespace EvaluationResultsReport
         vector<vector<QVariant>> rows_;
         vector<EvaluationRequirementResult::Base*> result_ptrs_;
         vector<QVariant> annotations_;
+        vector<unsigned int> row_orders_; // sorted, order in which rows were first added
+
+        unsigned int next_row_order_ {0};
+        map<EvaluationRequirementResult::Base*, vector<unsigned int>> removed_row_orders_;
+
+        bool resetting_ {false};
 
 //        mutable QPushButton* toogle_show_unused_button_ {nullptr};
 //        mutable QPushButton* copy_button_ {nullptr};
          mutable QPushButton* options_button_ {nullptr};
 
         mutable TableQSortFilterProxyModel* proxy_model_ {nullptr};
-        mutable QTableView* table_view_ {nullptr}; // for reset
+        mutable QPointer<QTableView> table_view_; // for reset, null after content widget was re-created
 
         std::map<std::string, std::function<void()>> callback_map_;
     };
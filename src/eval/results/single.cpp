@@ -53,6 +53,16 @@ void Single::updateUseFromTarget ()
     use_ = result_usable_ && target_->use();
 }
 
+void Single::removeFromReport (std::shared_ptr<EvaluationResultsReport::RootItem> root_item)
+{
+    getRequirementSection(root_item).removeResultRows(this);
+
+    if (eval_man_.resultsGenerator().splitResultsByMOPS()) // added to general sum table
+        root_item->getSection(getRequirementSumSectionID()).removeResultRows(this);
+
+    root_item->removeSection(getTargetSectionID()); // all requirements of target, if not yet removed
+}
+
 std::string Single::getTargetSectionID()
 {
     return "Targets:UTN "+to_string(utn_);
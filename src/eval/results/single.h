@@ -37,9 +37,14 @@ namespace EvaluationRequirementResult
         virtual bool isJoined() const override { return false; }
 
         virtual void addToReport (std::shared_ptr<EvaluationResultsReport::RootItem> root_item) = 0;
+        // removes target rows and target details, e.g. after use changed
+        void removeFromReport (std::shared_ptr<EvaluationResultsReport::RootItem> root_item);
 
         virtual std::shared_ptr<Joined> createEmptyJoined(const std::string& result_id) = 0;
 
+        // counts and details, as passed to the constructor by the requirement, see Base::restore
+        virtual nlohmann::json toJSON() const = 0;
+
         unsigned int utn() const;
         const EvaluationTargetData* target() const;
 
@@ -73,9 +73,25 @@ void JoinedSpeed::addToValues (std::shared_ptr<SingleSpeed> single_result)
     num_comp_failed_ += single_result->numCompFailed();
     num_comp_passed_ += single_result->numCompPassed();
 
-    const vector<double>& other_values = single_result->values();
+    value_stats_.add(single_result->utn(), single_result->valueGroup());
 
-    values_.insert(values_.end(), other_values.begin(), other_values.end());
+    update();
+}
+
+void JoinedSpeed::subtractFromValues (std::shared_ptr<SingleSpeed> single_result)
+{
+    assert (single_result);
+    assert (!single_result->use());
+
+    num_pos_ -= single_result->numPos();
+    num_no_ref_ -= single_result->numNoRef();
+    num_pos_outside_ -= single_result->numPosOutside();
+    num_pos_inside_ -= single_result->numPosInside();
+    num_no_tst_value_ -= single_result->numNoTstValues();
+    num_comp_failed_ -= single_result->numCompFailed();
+    num_comp_passed_ -= single_result->numCompPassed();
+
+    value_stats_.subtract(single_result->utn(), single_result->valueGroup());
 
     update();
 }
@@ -85,20 +101,16 @@ void JoinedSpeed::update()
     assert (num_no_ref_ <= num_pos_);
     assert (num_pos_ - num_no_ref_ == num_pos_inside_ + num_pos_outside_);
 
-    assert (values_.size() == num_comp_failed_+num_comp_passed_);
+    assert (value_stats_.count() == num_comp_failed_+num_comp_passed_);
 
-    unsigned int num_speeds = values_.size();
+    unsigned int num_speeds = value_stats_.count();
 
     if (num_speeds)
     {
-        value_min_ = *min_element(values_.begin(), values_.end());
-        value_max_ = *max_element(values_.begin(), values_.end());
-        value_avg_ = std::accumulate(values_.begin(), values_.end(), 0.0) / (float) num_speeds;
-
-        value_var_ = 0;
-        for(auto val : values_)
-            value_var_ += pow(val - value_avg_, 2);
-        value_var_ /= (float)num_speeds;
+        value_min_ = value_stats_.min();
+        value_max_ = value_stats_.max();
+        value_avg_ = value_stats_.avg();
+        value_var_ = value_stats_.var();
 
         assert (num_comp_failed_ <= num_speeds);
         p_passed_ = (float)num_comp_passed_/(float)num_speeds;
@@ -202,6 +214,19 @@ void JoinedSpeed::addDetails(std::shared_ptr<EvaluationResultsReport::RootItem>
                           String::doubleToStringPrecision(sqrt(value_var_),2).c_str()}, this);
     sec_det_table.addRow({"OVar [m^2/s^2]", "Variance of speed offset",
                           String::doubleToStringPrecision(value_var_,2).c_str()}, this);
+
+    // percentiles, estimated from sketch
+    QVariant p95_var, p99_var;
+
+    if (value_stats_.count())
+    {
+        p95_var = String::doubleToStringPrecision(value_stats_.quantile(0.95),2).c_str();
+        p99_var = String::doubleToStringPrecision(value_stats_.quantile(0.99),2).c_str();
+    }
+
+    sec_det_table.addRow({"OP95 [m/s]", "95th percentile of speed offset (estimated)", p95_var}, this);
+    sec_det_table.addRow({"OP99 [m/s]", "99th percentile of speed offset (estimated)", p99_var}, this);
+
     sec_det_table.addRow({"#CF [1]", "Number of updates with failed comparison", num_comp_failed_}, this);
     sec_det_table.addRow({"#CP [1]", "Number of updates with passed comparison ", num_comp_passed_},
                          this);
@@ -313,7 +338,7 @@ void JoinedSpeed::updatesToUseChanges()
     num_comp_failed_ = 0;
     num_comp_passed_ = 0;
 
-    values_.clear();
+    value_stats_.clear();
 
     for (auto result_it : results_)
     {
@@ -325,6 +350,18 @@ void JoinedSpeed::updatesToUseChanges()
     }
 }
 
+void JoinedSpeed::updateToUseChangeOf (std::shared_ptr<Single> result)
+{
+    std::shared_ptr<SingleSpeed> single_result =
+            std::static_pointer_cast<SingleSpeed>(result);
+    assert (single_result);
+
+    if (single_result->use())
+        addToValues(single_result);
+    else
+        subtractFromValues(single_result);
+}
+
 void JoinedSpeed::exportAsCSV()
 {
     loginf << "JoinedSpeed: exportAsCSV";
@@ -349,10 +386,19 @@ void JoinedSpeed::exportAsCSV()
         if (output_file)
         {
             output_file << "speed_offset\n";
-            unsigned int size = values_.size();
 
-            for (unsigned int cnt=0; cnt < size; ++cnt)
-                output_file << values_.at(cnt) << "\n";
+            for (auto& result_it : results_)
+            {
+                if (!result_it->use())
+                    continue;
+
+                std::shared_ptr<SingleSpeed> result =
+                        std::static_pointer_cast<SingleSpeed>(result_it);
+                assert (result);
+
+                for (auto value : result->values())
+                    output_file << value << "\n";
+            }
         }
     }
 }
@@ -19,6 +19,7 @@
 #define EVALUATIONREQUIREMENTJOINEDSPEED_H
 
 #include "eval/results/joined.h"
+#include "eval/results/valuestatistics.h"
 
 namespace EvaluationRequirementResult
 {
@@ -39,6 +40,7 @@ namespace EvaluationRequirementResult
         virtual void addToReport (std::shared_ptr<EvaluationResultsReport::RootItem> root_item) override;
 
         virtual void updatesToUseChanges() override;
+        virtual void updateToUseChangeOf (std::shared_ptr<Single> result) override;
 
         virtual bool hasViewableData (
                 const EvaluationResultsReport::SectionContentTable& table, const QVariant& annotation) override;
@@ -61,7 +63,7 @@ namespace EvaluationRequirementResult
         unsigned int num_comp_failed_ {0};
         unsigned int num_comp_passed_ {0};
 
-        vector<double> values_;
+        ValueStatistics value_stats_;
 
         double value_min_ {0};
         double value_max_ {0};
@@ -72,6 +74,7 @@ namespace EvaluationRequirementResult
         float p_passed_{0};
 
         void addToValues (std::shared_ptr<SingleSpeed> single_result);
+        void subtractFromValues (std::shared_ptr<SingleSpeed> single_result);
         void update();
 
         void addToOverviewTable(std::shared_ptr<EvaluationResultsReport::RootItem> root_item);
@@ -45,14 +45,16 @@ namespace EvaluationRequirementResult
             unsigned int num_pos, unsigned int num_no_ref,
             unsigned int num_pos_outside, unsigned int num_pos_inside, unsigned int num_no_tst_value,
             unsigned int num_comp_failed, unsigned int num_comp_passed,
-            vector<double> values,
-            std::vector<EvaluationRequirement::SpeedDetail> details)
+            ValueGroup value_group,
+            EvaluationRequirement::SpeedDetails details)
         : Single("SingleSpeed", result_id, requirement, sector_layer, utn, target, eval_man),
           num_pos_(num_pos), num_no_ref_(num_no_ref), num_pos_outside_(num_pos_outside),
           num_pos_inside_(num_pos_inside), num_no_tst_value_(num_no_tst_value),
           num_comp_failed_(num_comp_failed), num_comp_passed_(num_comp_passed),
-          values_(values), details_(details)
+          value_group_(value_group), details_(details)
     {
+        details_.shrink_to_fit();
+
         update();
     }
 
@@ -62,20 +64,16 @@ namespace EvaluationRequirementResult
         assert (num_no_ref_ <= num_pos_);
         assert (num_pos_ - num_no_ref_ == num_pos_inside_ + num_pos_outside_);
 
-        assert (values_.size() == num_comp_failed_+num_comp_passed_);
+        assert (value_group_.count() == num_comp_failed_+num_comp_passed_);
 
-        unsigned int num_speeds = values_.size();
+        unsigned int num_speeds = value_group_.count();
 
         if (num_speeds)
         {
-            value_min_ = *min_element(values_.begin(), values_.end());
-            value_max_ = *max_element(values_.begin(), values_.end());
-            value_avg_ = std::accumulate(values_.begin(), values_.end(), 0.0) / (float) num_speeds;
-
-            value_var_ = 0;
-            for(auto val : values_)
-                value_var_ += pow(val - value_avg_, 2);
-            value_var_ /= (float)num_speeds;
+            value_min_ = value_group_.min();
+            value_max_ = value_group_.max();
+            value_avg_ = value_group_.avg();
+            value_var_ = value_group_.var();
 
             assert (num_comp_failed_ <= num_speeds);
             p_passed_ = (float)num_comp_passed_/(float)num_speeds;
@@ -303,7 +301,7 @@ namespace EvaluationRequirementResult
 
         unsigned int detail_cnt = 0;
 
-        for (auto& rq_det_it : details_)
+        for (const auto& rq_det_it : details_)
         {
             utn_req_details_table.addRow(
             {String::timeStringFromDouble(rq_det_it.tod_).c_str(),
@@ -350,7 +348,7 @@ namespace EvaluationRequirementResult
                     = eval_man_.getViewableForEvaluation(utn_, req_grp_id_, result_id_);
             assert (viewable_ptr);
 
-            const EvaluationRequirement::SpeedDetail& detail = details_.at(detail_cnt);
+            EvaluationRequirement::SpeedDetail detail = details_.at(detail_cnt);
 
             (*viewable_ptr)["position_latitude"] = detail.tst_pos_.latitude_;
             (*viewable_ptr)["position_longitude"] = detail.tst_pos_.longitude_;
@@ -377,7 +375,7 @@ namespace EvaluationRequirementResult
 
         bool failed_values_of_interest = req()->failedValuesOfInterest();
 
-        for (auto& detail_it : details_)
+        for (const auto& detail_it : details_)
         {
             if ((failed_values_of_interest && detail_it.check_passed_)
                     || (!failed_values_of_interest && !detail_it.check_passed_))
@@ -461,9 +459,14 @@ namespace EvaluationRequirementResult
     }
 
 
-    const vector<double>& SingleSpeed::values() const
+    const ValueGroup& SingleSpeed::valueGroup() const
+    {
+        return value_group_;
+    }
+
+    vector<double> SingleSpeed::values() const
     {
-        return values_;
+        return details_.values();
     }
 
     unsigned int SingleSpeed::numPosOutside() const
@@ -486,6 +489,24 @@ namespace EvaluationRequirementResult
         return make_shared<JoinedSpeed> (result_id, requirement_, sector_layer_, eval_man_);
     }
 
+    nlohmann::json SingleSpeed::toJSON() const
+    {
+        nlohmann::json j;
+
+        j["num_pos"] = num_pos_;
+        j["num_no_ref"] = num_no_ref_;
+        j["num_pos_outside"] = num_pos_outside_;
+        j["num_pos_inside"] = num_pos_inside_;
+        j["num_no_tst_value"] = num_no_tst_value_;
+        j["num_comp_failed"] = num_comp_failed_;
+        j["num_comp_passed"] = num_comp_passed_;
+        j["value_group"] = value_group_.toJSON();
+
+        j["details"] = details_.toJSON();
+
+        return j;
+    }
+
     unsigned int SingleSpeed::numPos() const
     {
         return num_pos_;
@@ -496,7 +517,7 @@ namespace EvaluationRequirementResult
         return num_no_ref_;
     }
 
-    std::vector<EvaluationRequirement::SpeedDetail>& SingleSpeed::details()
+    EvaluationRequirement::SpeedDetails& SingleSpeed::details()
     {
         return details_;
     }
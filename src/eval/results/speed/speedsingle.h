@@ -20,6 +20,7 @@
 
 
 #include "eval/results/single.h"
+#include "eval/results/valuestatistics.h"
 #include "eval/requirement/speed/speed.h"
 
 namespace EvaluationRequirementResult
@@ -35,13 +36,15 @@ public:
             unsigned int num_pos, unsigned int num_no_ref,
             unsigned int num_pos_outside, unsigned int num_pos_inside, unsigned int num_no_tst_value,
             unsigned int num_comp_failed, unsigned int num_comp_passed,
-            vector<double> values,
-            std::vector<EvaluationRequirement::SpeedDetail> details);
+            ValueGroup value_group,
+            EvaluationRequirement::SpeedDetails details);
 
     virtual void addToReport (std::shared_ptr<EvaluationResultsReport::RootItem> root_item) override;
 
     virtual std::shared_ptr<Joined> createEmptyJoined(const std::string& result_id) override;
 
+    virtual nlohmann::json toJSON() const override;
+
     unsigned int numPos() const;
     unsigned int numNoRef() const;
     unsigned int numPosOutside() const;
@@ -50,9 +53,10 @@ public:
     unsigned int numCompFailed() const;
     unsigned int numCompPassed() const;
 
-    const vector<double>& values() const;
+    const ValueGroup& valueGroup() const;
+    vector<double> values() const; // exact values from details, only for exports
 
-    std::vector<EvaluationRequirement::SpeedDetail>& details();
+    EvaluationRequirement::SpeedDetails& details();
 
     virtual bool hasViewableData (
             const EvaluationResultsReport::SectionContentTable& table, const QVariant& annotation) override;
@@ -75,7 +79,7 @@ protected:
     unsigned int num_comp_failed_ {0};
     unsigned int num_comp_passed_ {0};
 
-    vector<double> values_;
+    ValueGroup value_group_; // instead of values, bounded size
 
     double value_min_ {0};
     double value_max_ {0};
@@ -85,7 +89,7 @@ protected:
     bool has_p_min_ {false};
     float p_passed_{0};
 
-    std::vector<EvaluationRequirement::SpeedDetail> details_;
+    EvaluationRequirement::SpeedDetails details_;
 
     void update();
 
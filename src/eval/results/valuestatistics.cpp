@@ -0,0 +1,205 @@
+/*
+ * This file is part of OpenATS COMPASS.
+ *
+ * COMPASS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * COMPASS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with COMPASS. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "eval/results/valuestatistics.h"
+#include "eval/requirement/detailcolumns.h"
+
+#include <cassert>
+#include <algorithm>
+
+namespace EvaluationRequirementResult
+{
+
+ValueGroup::ValueGroup (const std::vector<double>& values)
+{
+    if (!values.size())
+        return;
+
+    min_ = values.front();
+    max_ = values.front();
+
+    double delta;
+
+    for (auto val : values) // welford
+    {
+        ++count_;
+        delta = val - mean_;
+        mean_ += delta / count_;
+        m2_ += delta * (val - mean_);
+
+        min_ = std::min(min_, val);
+        max_ = std::max(max_, val);
+    }
+
+    sketch_.add(values);
+}
+
+nlohmann::json ValueGroup::toJSON() const
+{
+    nlohmann::json j;
+
+    j["count"] = count_;
+    j["moments"] = EvaluationRequirement::valuesToJSON(std::vector<double>{mean_, m2_, min_, max_});
+    j["sketch"] = sketch_.toJSON();
+
+    return j;
+}
+
+void ValueGroup::fromJSON (const nlohmann::json& j)
+{
+    count_ = j.at("count").get<unsigned int>();
+
+    std::vector<double> moments = EvaluationRequirement::valuesFromJSON<double>(j.at("moments"));
+    assert (moments.size() == 4);
+
+    mean_ = moments.at(0);
+    m2_ = moments.at(1);
+    min_ = moments.at(2);
+    max_ = moments.at(3);
+
+    sketch_.fromJSON(j.at("sketch"));
+
+    assert (sketch_.count() == count_);
+}
+
+void ValueStatistics::add (unsigned int key, const ValueGroup& group)
+{
+    if (!group.count())
+        return;
+
+    // merge with existing moments
+    double count_other = group.count();
+    double count = count_ + count_other;
+    double delta = group.avg() - mean_;
+
+    mean_ += delta * count_other / count;
+    m2_ += group.m2() + delta * delta * count_ * count_other / count;
+    count_ += group.count();
+
+    mins_.insert(group.min());
+    maxs_.insert(group.max());
+
+    assert (!groups_.count(key));
+
+    bool in_key_order = !groups_.size() || key > groups_.rbegin()->first;
+
+    groups_[key] = &group;
+
+    if (sketch_valid_ && in_key_order) // same as re-build
+        sketch_.merge(group.sketch());
+    else
+    {
+        sketch_.clear();
+        sketch_valid_ = false;
+    }
+}
+
+void ValueStatistics::subtract (unsigned int key, const ValueGroup& group)
+{
+    if (!group.count())
+        return;
+
+    assert (group.count() <= count_);
+
+    auto min_it = mins_.find(group.min());
+    assert (min_it != mins_.end());
+    mins_.erase(min_it);
+
+    auto max_it = maxs_.find(group.max());
+    assert (max_it != maxs_.end());
+    maxs_.erase(max_it);
+
+    assert (groups_.count(key) && groups_.at(key) == &group);
+    groups_.erase(key);
+
+    sketch_.clear();
+    sketch_valid_ = false;
+
+    if (group.count() == count_)
+    {
+        count_ = 0;
+        mean_ = 0;
+        m2_ = 0;
+        return;
+    }
+
+    // reverse of merge
+    double count_other = group.count();
+    double count = count_;
+    double count_rest = count - count_other;
+    double mean_rest = (count * mean_ - count_other * group.avg()) / count_rest;
+    double delta = group.avg() - mean_rest;
+
+    m2_ -= group.m2() + delta * delta * count_rest * count_other / count;
+    m2_ = std::max(m2_, 0.0); // rounding
+    mean_ = mean_rest;
+    count_ -= group.count();
+}
+
+void ValueStatistics::clear()
+{
+    count_ = 0;
+    mean_ = 0;
+    m2_ = 0;
+
+    mins_.clear();
+    maxs_.clear();
+
+    groups_.clear();
+
+    sketch_.clear();
+    sketch_valid_ = true;
+}
+
+double ValueStatistics::min() const
+{
+    assert (mins_.size());
+    return *mins_.begin();
+}
+
+double ValueStatistics::max() const
+{
+    assert (maxs_.size());
+    return *maxs_.rbegin();
+}
+
+double ValueStatistics::var() const
+{
+    if (!count_)
+        return 0;
+
+    return m2_ / count_;
+}
+
+double ValueStatistics::quantile (double q) const
+{
+    assert (count_);
+
+    if (!sketch_valid_)
+    {
+        for (auto& group_it : groups_)
+            sketch_.merge(group_it.second->sketch());
+
+        sketch_valid_ = true;
+    }
+
+    assert (sketch_.count() == count_);
+
+    return sketch_.quantile(q);
+}
+
+}
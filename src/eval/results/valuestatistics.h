@@ -0,0 +1,107 @@
+/*
+ * This file is part of OpenATS COMPASS.
+ *
+ * COMPASS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * COMPASS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with COMPASS. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef EVALUATIONREQUIREMENTRESULTVALUESTATISTICS_H
+#define EVALUATIONREQUIREMENTRESULTVALUESTATISTICS_H
+
+#include "eval/results/quantilesketch.h"
+#include "json.hpp"
+
+#include <map>
+#include <set>
+#include <vector>
+
+namespace EvaluationRequirementResult
+{
+
+/**
+ * @brief Count, mean, variance, min, max and quantile sketch of the values of one result
+ *
+ * Kept by single results instead of their values, exact values are only materialized from the details when
+ * requested (e.g. for a CSV export). Size is bounded by the sketch compression.
+ */
+class ValueGroup
+{
+public:
+    ValueGroup() {}
+    ValueGroup (const std::vector<double>& values);
+
+    unsigned int count() const { return count_; }
+
+    double min() const { return min_; }
+    double max() const { return max_; }
+    double avg() const { return mean_; }
+    double m2() const { return m2_; }
+    double var() const { return count_ ? m2_ / count_ : 0; } // population variance
+
+    const QuantileSketch& sketch() const { return sketch_; }
+
+    nlohmann::json toJSON() const;
+    void fromJSON (const nlohmann::json& j);
+
+protected:
+    unsigned int count_ {0};
+    double mean_ {0};
+    double m2_ {0}; // sum of squared differences from mean
+    double min_ {0};
+    double max_ {0};
+
+    QuantileSketch sketch_;
+};
+
+/**
+ * @brief Count, min, max, average, variance and quantiles of the values of several results
+ *
+ * Value groups of results are added or subtracted by merging their moments, so that a joined result can be
+ * updated for a changed result without re-visiting all other results. Min/max are kept per added group.
+ * Quantiles are estimated by merging the group sketches, on add in key order and otherwise re-built from the
+ * groups in key order on the next access, so that quantiles do not depend on the order of adds and subtracts.
+ */
+class ValueStatistics
+{
+public:
+    // groups have to stay valid while added, since their sketches are used to re-build quantiles. key is unique
+    // per group, e.g. the utn of the result
+    void add (unsigned int key, const ValueGroup& group);
+    void subtract (unsigned int key, const ValueGroup& group); // group has to be added before
+    void clear();
+
+    unsigned int count() const { return count_; }
+
+    double min() const;
+    double max() const;
+    double avg() const { return mean_; }
+    double var() const; // population variance
+    double quantile (double q) const; // q in [0,1], count has to be > 0
+
+protected:
+    unsigned int count_ {0};
+    double mean_ {0};
+    double m2_ {0}; // sum of squared differences from mean
+
+    std::multiset<double> mins_; // per added group
+    std::multiset<double> maxs_;
+
+    std::map<unsigned int, const ValueGroup*> groups_; // key -> group, sketch is merged in key order
+
+    mutable QuantileSketch sketch_;
+    mutable bool sketch_valid_ {true};
+};
+
+}
+
+#endif // EVALUATIONREQUIREMENTRESULTVALUESTATISTICS_H
@@ -39,6 +39,7 @@
 #include "mysqlserver.h"
 #include "sqliteconnection.h"
 #include "stringconv.h"
+#include "tracer.h"
 #include "unit.h"
 #include "unitmanager.h"
 #include "sector.h"
@@ -1405,6 +1406,149 @@ void DBInterface::deleteAllViewPoints()
     clearTableContent(TABLE_NAME_VIEWPOINTS);
 }
 
+bool DBInterface::existsEvaluationResultsTable()
+{
+    return existsTable(TABLE_NAME_EVALUATION_RESULTS);
+}
+
+void DBInterface::createEvaluationResultsTable()
+{
+    assert(!existsEvaluationResultsTable());
+
+    setProperty("evaluation_results_version", "0.1");
+
+    connection_mutex_.lock();
+    current_connection_->executeSQL(sql_generator_.getTableEvaluationResultsCreateStatement());
+    connection_mutex_.unlock();
+
+    updateTableInfo();
+}
+
+void DBInterface::setEvaluationResults(const std::string& key,
+                                       const std::vector<std::pair<std::string, std::string>>& results)
+{
+    if (!current_connection_)
+    {
+        logwrn << "DBInterface: setEvaluationResults: failed since no database connection exists";
+        return;
+    }
+
+    assert(current_connection_);
+
+    if (!existsEvaluationResultsTable())
+        createEvaluationResultsTable();
+
+    string bind_statement = sql_generator_.getReplaceEvaluationResultStatementBind();
+
+    QMutexLocker locker(&connection_mutex_);
+
+    // old results, new results and key in one transaction, so that the key never refers to other results
+    current_connection_->beginBindTransaction();
+
+    // before prepare, mysql does not allow other queries while a statement is prepared
+    current_connection_->executeSQL("DELETE FROM " + TABLE_NAME_EVALUATION_RESULTS + ";");
+
+    current_connection_->prepareBindStatement(bind_statement);
+
+    for (auto& result_it : results)
+    {
+        assert (result_it.first != EVALUATION_RESULTS_KEY_ID);
+
+        logdbg << "DBInterface: setEvaluationResults: id '" << result_it.first << "' size "
+               << result_it.second.size();
+
+        current_connection_->bindVariable(1, result_it.first);
+        current_connection_->bindVariable(2, result_it.second);
+        current_connection_->stepAndClearBindings();
+    }
+
+    current_connection_->bindVariable(1, EVALUATION_RESULTS_KEY_ID);
+    current_connection_->bindVariable(2, key);
+    current_connection_->stepAndClearBindings();
+
+    current_connection_->endBindTransaction();
+    current_connection_->finalizeBindStatement();
+}
+
+std::string DBInterface::evaluationResultsKey()
+{
+    if (!existsEvaluationResultsTable())
+        return "";
+
+    QMutexLocker locker(&connection_mutex_);
+
+    DBCommand command;
+    command.set(sql_generator_.getSelectEvaluationResultsKeyStatement());
+
+    PropertyList list;
+    list.addProperty("json", PropertyDataType::STRING);
+    command.list(list);
+
+    shared_ptr<DBResult> result = current_connection_->execute(command);
+
+    assert(result->containsData());
+
+    shared_ptr<Buffer> buffer = result->buffer();
+
+    assert(buffer);
+    assert(buffer->has<string>("json"));
+
+    if (!buffer->size() || buffer->get<string>("json").isNull(0))
+        return "";
+
+    return buffer->get<string>("json").get(0);
+}
+
+map<string, string> DBInterface::evaluationResults()
+{
+    loginf << "DBInterface: evaluationResults";
+
+    assert (existsEvaluationResultsTable());
+
+    QMutexLocker locker(&connection_mutex_);
+
+    DBCommand command;
+    command.set(sql_generator_.getSelectAllEvaluationResultsStatement());
+
+    PropertyList list;
+    list.addProperty("id", PropertyDataType::STRING);
+    list.addProperty("json", PropertyDataType::STRING);
+    command.list(list);
+
+    shared_ptr<DBResult> result = current_connection_->execute(command);
+
+    assert(result->containsData());
+
+    shared_ptr<Buffer> buffer = result->buffer();
+
+    assert(buffer);
+    assert(buffer->has<string>("id"));
+    assert(buffer->has<string>("json"));
+
+    NullableVector<string> id_vec = buffer->get<string>("id");
+    NullableVector<string> json_vec = buffer->get<string>("json");
+
+    map<string, string> results;
+
+    for (size_t cnt = 0; cnt < buffer->size(); ++cnt)
+    {
+        assert(!id_vec.isNull(cnt));
+        assert(!results.count(id_vec.get(cnt)));
+        if (id_vec.get(cnt) != EVALUATION_RESULTS_KEY_ID && !json_vec.isNull(cnt))
+            results[id_vec.get(cnt)] = json_vec.get(cnt);
+    }
+
+    loginf << "DBInterface: evaluationResults: loaded " << results.size() << " results";
+
+    return results;
+}
+
+void DBInterface::deleteAllEvaluationResults()
+{
+    if (existsEvaluationResultsTable())
+        clearTableContent(TABLE_NAME_EVALUATION_RESULTS);
+}
+
 
 bool DBInterface::existsSectorsTable()
 {
@@ -1590,6 +1734,8 @@ void DBInterface::insertBuffer(DBTable& table, shared_ptr<Buffer> buffer)
 
 void DBInterface::insertBuffer(const string& table_name, shared_ptr<Buffer> buffer)
 {
+    TraceSpan span("db", "insertBuffer", table_name);
+
     loginf << "DBInterface: insertBuffer: table name " << table_name << " buffer size "
            << buffer->size();
 
@@ -1752,6 +1898,8 @@ void DBInterface::updateBuffer(MetaDBTable& meta_table, const DBTableColumn& key
 void DBInterface::updateBuffer(DBTable& table, const DBTableColumn& key_col,
                                shared_ptr<Buffer> buffer, int from_index, int to_index)
 {
+    TraceSpan span("db", "updateBuffer", table.name());
+
     logdbg << "DBInterface: updateBuffer: table " << table.name() << " buffer size "
            << buffer->size() << " key " << key_col.identifier();
 
@@ -1831,6 +1979,8 @@ void DBInterface::prepareRead(const DBObject& dbobject, DBOVariableSet read_list
  */
 shared_ptr<Buffer> DBInterface::readDataChunk(const DBObject& dbobject)
 {
+    TraceSpan span("db", "readDataChunk", dbobject.name());
+
     // locked by prepareRead
     assert(current_connection_);
 
@@ -2069,4 +2219,105 @@ DBOAssociationCollection DBInterface::getAssociations(const string& table_name)
     return associations;
 }
 
+bool DBInterface::existsRetiredTargetsTable()
+{
+    return existsTable(TABLE_NAME_RETIRED_TARGETS);
+}
+
+void DBInterface::createRetiredTargetsTable()
+{
+    assert(!existsRetiredTargetsTable());
+
+    connection_mutex_.lock();
+    current_connection_->executeSQL(sql_generator_.getTableRetiredTargetsCreateStatement());
+    connection_mutex_.unlock();
+
+    updateTableInfo();
+}
+
+void DBInterface::setRetiredTargets(const std::vector<std::tuple<unsigned int, int, std::string>>& targets)
+{
+    logdbg << "DBInterface: setRetiredTargets: " << targets.size() << " targets";
+
+    assert(current_connection_);
+
+    if (!targets.size())
+        return;
+
+    if (!existsRetiredTargetsTable())
+        createRetiredTargetsTable();
+
+    string bind_statement = sql_generator_.getReplaceRetiredTargetStatementBind();
+
+    QMutexLocker locker(&connection_mutex_);
+
+    current_connection_->prepareBindStatement(bind_statement);
+    current_connection_->beginBindTransaction();
+
+    for (auto& target_it : targets)
+    {
+        current_connection_->bindVariable(1, (int) get<0>(target_it));
+
+        if (get<1>(target_it) >= 0)
+            current_connection_->bindVariable(2, get<1>(target_it));
+        else
+            current_connection_->bindVariableNull(2);
+
+        current_connection_->bindVariable(3, get<2>(target_it));
+        current_connection_->stepAndClearBindings();
+    }
+
+    current_connection_->endBindTransaction();
+    current_connection_->finalizeBindStatement();
+}
+
+std::map<unsigned int, std::string> DBInterface::retiredTargets(const std::set<unsigned int>& tas)
+{
+    map<unsigned int, string> targets;
+
+    if (!tas.size() || !existsRetiredTargetsTable())
+        return targets;
+
+    QMutexLocker locker(&connection_mutex_);
+
+    DBCommand command;
+    command.set(sql_generator_.getSelectRetiredTargetsStatement(tas));
+
+    PropertyList list;
+    list.addProperty("utn", PropertyDataType::INT);
+    list.addProperty("json", PropertyDataType::STRING);
+    command.list(list);
+
+    shared_ptr<DBResult> result = current_connection_->execute(command);
+
+    assert(result->containsData());
+
+    shared_ptr<Buffer> buffer = result->buffer();
+
+    assert(buffer);
+    assert(buffer->has<int>("utn"));
+    assert(buffer->has<string>("json"));
+
+    NullableVector<int> utn_vec = buffer->get<int>("utn");
+    NullableVector<string> json_vec = buffer->get<string>("json");
+
+    for (size_t cnt = 0; cnt < buffer->size(); ++cnt)
+    {
+        assert(!utn_vec.isNull(cnt));
+        assert(!json_vec.isNull(cnt));
+        targets[utn_vec.get(cnt)] = json_vec.get(cnt);
+    }
+
+    logdbg << "DBInterface: retiredTargets: loaded " << targets.size() << " targets for " << tas.size()
+           << " target addresses";
+
+    return targets;
+}
+
+void DBInterface::deleteAllRetiredTargets()
+{
+    if (existsRetiredTargetsTable())
+        clearTableContent(TABLE_NAME_RETIRED_TARGETS);
+}
+
 
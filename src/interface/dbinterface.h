@@ -35,6 +35,9 @@ static const std::string TABLE_NAME_PROPERTIES = "atsdb_properties";
 static const std::string TABLE_NAME_MINMAX = "atsdb_minmax";
 static const std::string TABLE_NAME_SECTORS = "atsdb_sectors";
 static const std::string TABLE_NAME_VIEWPOINTS = "atsdb_viewpoints";
+static const std::string TABLE_NAME_EVALUATION_RESULTS = "atsdb_evaluation_results";
+static const std::string EVALUATION_RESULTS_KEY_ID = "key"; // key row in results table, result ids contain ':'
+static const std::string TABLE_NAME_RETIRED_TARGETS = "atsdb_retired_targets";
 
 class COMPASS;
 class Buffer;
@@ -173,6 +176,15 @@ class DBInterface : public QObject, public Configurable
     void deleteViewPoint(const unsigned int id);
     void deleteAllViewPoints();
 
+    bool existsEvaluationResultsTable();
+    void createEvaluationResultsTable();
+    // replaces all results (id -> json) and the key in one transaction
+    void setEvaluationResults(const std::string& key,
+                              const std::vector<std::pair<std::string, std::string>>& results);
+    std::string evaluationResultsKey(); // empty if not set
+    std::map<std::string, std::string> evaluationResults(); // without key
+    void deleteAllEvaluationResults(); // also clears key, cached results are not used anymore
+
     bool existsSectorsTable();
     void createSectorsTable();
     std::vector<std::shared_ptr<SectorLayer>> loadSectors ();
@@ -201,6 +213,14 @@ class DBInterface : public QObject, public Configurable
     void createAssociationsTable(const std::string& table_name);
     DBOAssociationCollection getAssociations(const std::string& table_name);
 
+    // targets evicted from the incremental association state, restored when their target address is seen again
+    bool existsRetiredTargetsTable();
+    void createRetiredTargetsTable();
+    // (utn, target address or -1, json), replaces retired targets with same utn
+    void setRetiredTargets(const std::vector<std::tuple<unsigned int, int, std::string>>& targets);
+    std::map<unsigned int, std::string> retiredTargets(const std::set<unsigned int>& tas); // utn -> json
+    void deleteAllRetiredTargets();
+
 protected:
     std::map<std::string, DBConnection*> connections_;
 
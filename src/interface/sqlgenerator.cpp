@@ -69,6 +69,16 @@ SQLGenerator::SQLGenerator(DBInterface& db_interface) : db_interface_(db_interfa
        << "(id INT, json TEXT, PRIMARY KEY (id));";
     table_view_points_create_statement_ = ss.str();
     ss.str(std::string());
+
+    ss << "CREATE TABLE " << TABLE_NAME_EVALUATION_RESULTS
+       << "(id VARCHAR(255), json TEXT, PRIMARY KEY (id));";
+    table_evaluation_results_create_statement_ = ss.str();
+    ss.str(std::string());
+
+    ss << "CREATE TABLE " << TABLE_NAME_RETIRED_TARGETS
+       << "(utn INT, ta INT, json TEXT, PRIMARY KEY (utn));";
+    table_retired_targets_create_statement_ = ss.str();
+    ss.str(std::string());
 }
 
 SQLGenerator::~SQLGenerator() {}
@@ -546,6 +556,78 @@ std::string SQLGenerator::getSelectAllViewPointsStatement()
     return ss.str();
 }
 
+std::string SQLGenerator::getReplaceEvaluationResultStatementBind()
+{
+    string connection_type = db_interface_.connection().type();
+
+    if (connection_type != SQLITE_IDENTIFIER && connection_type != MYSQL_IDENTIFIER)
+        throw runtime_error(
+                "SQLGenerator: getReplaceEvaluationResultStatementBind: not yet implemented db type " +
+                connection_type);
+
+    stringstream ss;
+
+    // ids and json contain free text, so both are bound
+    ss << "REPLACE INTO " << TABLE_NAME_EVALUATION_RESULTS << " (id, json) VALUES (";
+
+    if (connection_type == SQLITE_IDENTIFIER)
+        ss << "@VAR1, @VAR2);";
+    else
+        ss << "%1, %2);";
+
+    return ss.str();
+}
+
+std::string SQLGenerator::getSelectEvaluationResultsKeyStatement()
+{
+    stringstream ss;
+    ss << "SELECT json FROM " << TABLE_NAME_EVALUATION_RESULTS << " WHERE id = '" << EVALUATION_RESULTS_KEY_ID
+       << "';";
+    return ss.str();
+}
+
+std::string SQLGenerator::getSelectAllEvaluationResultsStatement()
+{
+    stringstream ss;
+    ss << "SELECT id, json FROM " << TABLE_NAME_EVALUATION_RESULTS << ";";
+    return ss.str();
+}
+
+std::string SQLGenerator::getReplaceRetiredTargetStatementBind()
+{
+    string connection_type = db_interface_.connection().type();
+
+    if (connection_type != SQLITE_IDENTIFIER && connection_type != MYSQL_IDENTIFIER)
+        throw runtime_error(
+                "SQLGenerator: getReplaceRetiredTargetStatementBind: not yet implemented db type " +
+                connection_type);
+
+    stringstream ss;
+
+    ss << "REPLACE INTO " << TABLE_NAME_RETIRED_TARGETS << " (utn, ta, json) VALUES (";
+
+    if (connection_type == SQLITE_IDENTIFIER)
+        ss << "@VAR1, @VAR2, @VAR3);";
+    else
+        ss << "%1, %2, %3);";
+
+    return ss.str();
+}
+
+std::string SQLGenerator::getSelectRetiredTargetsStatement(const std::set<unsigned int>& tas)
+{
+    assert (tas.size());
+
+    stringstream ss;
+    ss << "SELECT utn, json FROM " << TABLE_NAME_RETIRED_TARGETS << " WHERE ta IN (";
+
+    for (auto ta_it = tas.begin(); ta_it != tas.end(); ++ta_it)
+        ss << (ta_it == tas.begin() ? "" : ",") << *ta_it;
+
+    ss << ");";
+    return ss.str();
+}
+
 std::string SQLGenerator::getReplaceSectorStatement(const unsigned int id, const std::string& name,
                                                     const std::string& layer_name, const std::string& json)
 {
@@ -626,6 +708,16 @@ std::string SQLGenerator::getTableViewPointsCreateStatement()
     return table_view_points_create_statement_;
 }
 
+std::string SQLGenerator::getTableEvaluationResultsCreateStatement()
+{
+    return table_evaluation_results_create_statement_;
+}
+
+std::string SQLGenerator::getTableRetiredTargetsCreateStatement()
+{
+    return table_retired_targets_create_statement_;
+}
+
 
 std::string SQLGenerator::insertDBUpdateStringBind(std::shared_ptr<Buffer> buffer,
                                                    std::string tablename)
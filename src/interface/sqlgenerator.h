@@ -19,6 +19,7 @@
 #define SQLGENERATOR_H_
 
 #include <memory>
+#include <set>
 
 #include "dbovariableset.h"
 
@@ -92,6 +93,8 @@ class SQLGenerator
     std::string getTablePropertiesCreateStatement();
     std::string getTableSectorsCreateStatement();
     std::string getTableViewPointsCreateStatement();
+    std::string getTableEvaluationResultsCreateStatement();
+    std::string getTableRetiredTargetsCreateStatement();
     std::string getDeleteStatement (const std::string& table, const std::string& filter);
 
     /// @brief Returns property insertion statement
@@ -114,6 +117,13 @@ class SQLGenerator
     std::string getInsertViewPointStatement(const unsigned int id, const std::string& json);
     std::string getSelectAllViewPointsStatement();
 
+    std::string getReplaceEvaluationResultStatementBind(); // id, json bound
+    std::string getSelectEvaluationResultsKeyStatement();
+    std::string getSelectAllEvaluationResultsStatement();
+
+    std::string getReplaceRetiredTargetStatementBind(); // utn, ta, json bound
+    std::string getSelectRetiredTargetsStatement(const std::set<unsigned int>& tas);
+
     std::string getReplaceSectorStatement(const unsigned int id, const std::string& name,
                                           const std::string& layer_name, const std::string& json);
     std::string getSelectAllSectorsStatement();
@@ -152,6 +162,8 @@ class SQLGenerator
     std::string table_properties_create_statement_;
     std::string table_sectors_create_statement_;
     std::string table_view_points_create_statement_;
+    std::string table_evaluation_results_create_statement_;
+    std::string table_retired_targets_create_statement_;
 
     /// @brief Returns SQL where clause with all used meta sub-tables
     std::string subTablesWhereClause(const MetaDBTable& meta_table,
@@ -0,0 +1,231 @@
+/*
+ * This file is part of OpenATS COMPASS.
+ *
+ * COMPASS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * COMPASS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with COMPASS. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "artashashtable.h"
+#include "logger.h"
+
+#include <tbb/tbb.h>
+
+#include <cassert>
+#include <functional>
+
+using namespace std;
+
+namespace
+{
+uint64_t hashOf(const std::string& key)
+{
+    // std::hash is not required to mix well, finalize so that prefix and low bits are usable
+    uint64_t hash = std::hash<std::string>()(key);
+
+    hash ^= hash >> 33;
+    hash *= 0xff51afd7ed558ccdULL;
+    hash ^= hash >> 33;
+    hash *= 0xc4ceb9fe1a85ec53ULL;
+    hash ^= hash >> 33;
+
+    return hash;
+}
+}  // namespace
+
+ARTASHashTable::ARTASHashTable() {}
+
+void ARTASHashTable::reserve(size_t size)
+{
+    hashes_.reserve(size);
+    keys_.reserve(size);
+    entries_.reserve(size);
+}
+
+void ARTASHashTable::add(unsigned int dbo_index, const std::string& hash, int rec_num, float tod)
+{
+    assert(!built_);
+
+    hashes_.push_back(hashOf(hash));
+    keys_.push_back(hash);
+    entries_.push_back({dbo_index, rec_num, tod});
+}
+
+void ARTASHashTable::build()
+{
+    assert(!built_);
+
+    unsigned int num_partitions = 1 << partition_bits_;
+    size_t num_entries = entries_.size();
+
+    // stable partitioning by hash prefix
+    vector<unsigned int> partition_offsets(num_partitions + 1, 0);
+
+    for (uint64_t hash : hashes_)
+        ++partition_offsets[partition(hash) + 1];
+
+    for (unsigned int cnt = 0; cnt < num_partitions; ++cnt)
+        partition_offsets[cnt + 1] += partition_offsets[cnt];
+
+    vector<unsigned int> order(num_entries);  // partitioned entry indexes
+    vector<unsigned int> cursors(partition_offsets.begin(), partition_offsets.end() - 1);
+
+    for (unsigned int cnt = 0; cnt < num_entries; ++cnt)
+        order[cursors[partition(hashes_[cnt])]++] = cnt;
+
+    partitions_.resize(num_partitions);
+    grouped_entries_.resize(num_entries);
+
+    vector<size_t> num_hashes(num_partitions, 0);
+    vector<size_t> num_duplicate_hashes(num_partitions, 0);
+    vector<size_t> num_collisions(num_partitions, 0);
+
+    tbb::parallel_for(uint(0), num_partitions, [&](unsigned int part_cnt) {
+        unsigned int begin = partition_offsets[part_cnt];
+        unsigned int end = partition_offsets[part_cnt + 1];
+
+        // load factor at most 0.5
+        size_t capacity = 16;
+        while (capacity < 2 * (size_t)(end - begin))
+            capacity <<= 1;
+
+        Partition& part = partitions_[part_cnt];
+        part.slots_.assign(capacity, Slot());
+        part.mask_ = capacity - 1;
+
+        vector<unsigned int> entry_slots(end - begin);  // partition entry -> slot
+
+        // count entries per hash
+        for (unsigned int cnt = begin; cnt < end; ++cnt)
+        {
+            unsigned int index = order[cnt];
+            uint64_t hash = hashes_[index];
+            uint64_t pos = hash & part.mask_;
+
+            while (true)
+            {
+                Slot& slot = part.slots_[pos];
+
+                if (!slot.count)  // new hash
+                {
+                    slot.hash = hash;
+                    slot.key_index = index;
+                    slot.count = 1;
+                    ++num_hashes[part_cnt];
+                    break;
+                }
+
+                if (slot.hash == hash && keys_[slot.key_index] == keys_[index])  // duplicate
+                {
+                    if (slot.count == 1)
+                        ++num_duplicate_hashes[part_cnt];
+
+                    ++slot.count;
+                    break;
+                }
+
+                ++num_collisions[part_cnt];
+                pos = (pos + 1) & part.mask_;
+            }
+
+            entry_slots[cnt - begin] = pos;
+        }
+
+        // assign ranges, partition entries are stored in partition range
+        unsigned int offset = begin;
+
+        for (Slot& slot : part.slots_)
+        {
+            if (slot.count)
+            {
+                slot.begin = offset;
+                offset += slot.count;
+            }
+        }
+        assert(offset == end);
+
+        // fill in order of addition
+        vector<unsigned int> filled(capacity, 0);
+
+        for (unsigned int cnt = begin; cnt < end; ++cnt)
+        {
+            unsigned int pos = entry_slots[cnt - begin];
+            const Slot& slot = part.slots_[pos];
+
+            grouped_entries_[slot.begin + filled[pos]++] = entries_[order[cnt]];
+        }
+    });
+
+    for (unsigned int cnt = 0; cnt < num_partitions; ++cnt)
+    {
+        num_hashes_ += num_hashes[cnt];
+        num_duplicate_hashes_ += num_duplicate_hashes[cnt];
+        num_collisions_ += num_collisions[cnt];
+    }
+
+    // only needed for building
+    hashes_.clear();
+    hashes_.shrink_to_fit();
+    entries_.clear();
+    entries_.shrink_to_fit();
+
+    built_ = true;
+
+    logdbg << "ARTASHashTable: build: " << num_entries << " entries, " << num_hashes_ << " hashes, "
+           << num_duplicate_hashes_ << " duplicate hashes, " << num_collisions_ << " collisions";
+}
+
+std::pair<const ARTASHashTable::Entry*, const ARTASHashTable::Entry*> ARTASHashTable::find(
+    const std::string& hash) const
+{
+    assert(built_);
+
+    const Slot* slot = findSlot(hashOf(hash), hash);
+
+    if (!slot)
+        return {nullptr, nullptr};
+
+    const Entry* begin = grouped_entries_.data() + slot->begin;
+    return {begin, begin + slot->count};
+}
+
+size_t ARTASHashTable::size() const { return grouped_entries_.size(); }
+
+size_t ARTASHashTable::numHashes() const { return num_hashes_; }
+
+size_t ARTASHashTable::numDuplicateHashes() const { return num_duplicate_hashes_; }
+
+size_t ARTASHashTable::numCollisions() const { return num_collisions_; }
+
+unsigned int ARTASHashTable::partition(uint64_t hash) const
+{
+    return hash >> (64 - partition_bits_);
+}
+
+const ARTASHashTable::Slot* ARTASHashTable::findSlot(uint64_t hash, const std::string& key) const
+{
+    const Partition& part = partitions_[partition(hash)];
+    uint64_t pos = hash & part.mask_;
+
+    while (true)
+    {
+        const Slot& slot = part.slots_[pos];
+
+        if (!slot.count)
+            return nullptr;
+
+        if (slot.hash == hash && keys_[slot.key_index] == key)
+            return &slot;
+
+        pos = (pos + 1) & part.mask_;
+    }
+}
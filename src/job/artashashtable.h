@@ -0,0 +1,94 @@
+/*
+ * This file is part of OpenATS COMPASS.
+ *
+ * COMPASS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * COMPASS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with COMPASS. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef ARTASHASHTABLE_H
+#define ARTASHASHTABLE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Flat open-addressing lookup of sensor target report hashes
+ *
+ * Entries are added serially, then build() partitions them by hash prefix and creates one
+ * open-addressing table per partition in parallel. All entries of a hash are stored contiguously
+ * in the order of addition, so lookups enumerate matches in the same order as a std::multimap.
+ */
+class ARTASHashTable
+{
+  public:
+    struct Entry
+    {
+        unsigned int dbo_index;
+        int rec_num;
+        float tod;
+    };
+
+    ARTASHashTable();
+
+    void reserve(size_t size);
+    void add(unsigned int dbo_index, const std::string& hash, int rec_num, float tod);
+    /// @brief Creates lookup tables, has to be called once after all entries were added
+    void build();
+
+    /// @brief Returns [begin, end) of entries with given hash, empty range if not found
+    std::pair<const Entry*, const Entry*> find(const std::string& hash) const;
+
+    size_t size() const;
+    size_t numHashes() const;           // distinct hashes
+    size_t numDuplicateHashes() const;  // distinct hashes with more than one entry
+    size_t numCollisions() const;       // additional probes during build
+
+  protected:
+    struct Slot
+    {
+        uint64_t hash{0};
+        unsigned int key_index{0};  // entry index of first occurrence, for key comparison
+        unsigned int begin{0};      // index into grouped_entries_
+        unsigned int count{0};      // 0 if empty
+    };
+
+    struct Partition
+    {
+        std::vector<Slot> slots_;  // size is power of 2
+        uint64_t mask_{0};
+    };
+
+    static const unsigned int partition_bits_{6};
+
+    bool built_{false};
+
+    // in order of addition
+    std::vector<uint64_t> hashes_;
+    std::vector<std::string> keys_;
+    std::vector<Entry> entries_;
+
+    std::vector<Partition> partitions_;
+    std::vector<Entry> grouped_entries_;  // grouped by hash, in order of addition per hash
+
+    size_t num_hashes_{0};
+    size_t num_duplicate_hashes_{0};
+    size_t num_collisions_{0};
+
+    unsigned int partition(uint64_t hash) const;
+    const Slot* findSlot(uint64_t hash, const std::string& key) const;
+};
+
+#endif  // ARTASHASHTABLE_H
@@ -19,10 +19,10 @@
 
 #include <jasterix/jasterix.h>
 
-#include <QThread>
 #include <memory>
 
 #include "asteriximporttask.h"
+#include "jobmanager.h"
 #include "json.h"
 #include "logger.h"
 #include "stringconv.h"
@@ -58,10 +58,13 @@ void ASTERIXDecodeJob::run()
 
     try
     {
-        if (framing_ == "")
-            task_.jASTERIX()->decodeFile(filename_, callback);
-        else
-            task_.jASTERIX()->decodeFile(filename_, framing_, callback);
+        // decoder parallelism runs isolated from other subsystems
+        JobManager::instance().arena(TaskArenaType::IMPORT).execute([&] {
+            if (framing_ == "")
+                task_.jASTERIX()->decodeFile(filename_, callback);
+            else
+                task_.jASTERIX()->decodeFile(filename_, framing_, callback);
+        });
     }
     catch (std::exception& e)
     {
@@ -70,8 +73,6 @@ void ASTERIXDecodeJob::run()
         error_message_ = e.what();
     }
 
-    assert(extracted_data_ == nullptr);
-
     done_ = true;
 
     logdbg << "ASTERIXDecodeJob: run: done";
@@ -86,10 +87,8 @@ void ASTERIXDecodeJob::jasterix_callback(std::unique_ptr<nlohmann::json> data, s
         return;
     }
 
-    assert(!extracted_data_);
-    extracted_data_ = std::move(data);
-    assert(extracted_data_);
-    assert(extracted_data_->is_object());
+    assert(data);
+    assert(data->is_object());
 
     num_frames_ = num_frames;
     num_records_ = num_records;
@@ -110,12 +109,12 @@ void ASTERIXDecodeJob::jasterix_callback(std::unique_ptr<nlohmann::json> data, s
 
     if (framing_ == "")
     {
-        assert(extracted_data_->contains("data_blocks"));
-        assert(extracted_data_->at("data_blocks").is_array());
+        assert(data->contains("data_blocks"));
+        assert(data->at("data_blocks").is_array());
 
         std::vector<std::string> keys{"content", "records"};
 
-        for (json& data_block : extracted_data_->at("data_blocks"))
+        for (json& data_block : data->at("data_blocks"))
         {
             if (!data_block.contains("category"))
             {
@@ -136,12 +135,12 @@ void ASTERIXDecodeJob::jasterix_callback(std::unique_ptr<nlohmann::json> data, s
     }
     else
     {
-        assert(extracted_data_->contains("frames"));
-        assert(extracted_data_->at("frames").is_array());
+        assert(data->contains("frames"));
+        assert(data->at("frames").is_array());
 
         std::vector<std::string> keys{"content", "records"};
 
-        for (json& frame : extracted_data_->at("frames"))
+        for (json& frame : data->at("frames"))
         {
             if (!frame.contains("content"))  // frame with errors
                 continue;
@@ -173,15 +172,17 @@ void ASTERIXDecodeJob::jasterix_callback(std::unique_ptr<nlohmann::json> data, s
         }
     }
 
-    while (pause_)  // block decoder until unpaused
-        QThread::msleep(1);
+    // blocks decoder while all credits are in use downstream, data only moved if pushed
+    while (!task_.decodedData().push(std::move(data), 100))
+    {
+        if (obsolete_ || task_.decodedData().closed())
+        {
+            loginf << "ASTERIXDecodeJob: jasterix_callback: discarding decoded data";
+            return;
+        }
+    }
 
     emit decodedASTERIXSignal();
-
-    while (extracted_data_)  // block decoder until extracted records have been moved out
-        QThread::msleep(1);
-
-    assert(!extracted_data_);
 }
 
 size_t ASTERIXDecodeJob::numFrames() const { return num_frames_; }
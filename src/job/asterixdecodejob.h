@@ -43,16 +43,11 @@ class ASTERIXDecodeJob : public Job
     size_t numRecords() const;
     size_t numErrors() const;
 
-    void pause() { pause_ = true; }
-    void unpause() { pause_ = false; }
-
     bool error() const;
     std::string errorMessage() const;
 
     std::map<unsigned int, size_t> categoryCounts() const;
 
-    std::unique_ptr<nlohmann::json> extractedData() { return std::move(extracted_data_); }
-
   private:
     ASTERIXImportTask& task_;
     std::string filename_;
@@ -60,8 +55,6 @@ class ASTERIXDecodeJob : public Job
     bool test_{false};
     ASTERIXPostProcess& post_process_;
 
-    volatile bool pause_{false};
-
     size_t num_frames_{0};
     size_t num_records_{0};
     size_t num_errors_{0};
@@ -69,8 +62,6 @@ class ASTERIXDecodeJob : public Job
     bool error_{false};
     std::string error_message_;
 
-    std::unique_ptr<nlohmann::json> extracted_data_;
-
     std::map<unsigned int, size_t> category_counts_;
 
     void jasterix_callback(std::unique_ptr<nlohmann::json> data, size_t num_frames,
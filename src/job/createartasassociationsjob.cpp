@@ -24,11 +24,15 @@
 #include "dbobject.h"
 #include "dbobjectmanager.h"
 #include "dbovariable.h"
+#include "jobmanager.h"
 #include "metadbovariable.h"
 #include "stringconv.h"
+#include "tracer.h"
 
 #include <math.h>
 
+#include <tbb/tbb.h>
+
 #include <QThread>
 #include <algorithm>
 
@@ -39,6 +43,9 @@ CreateARTASAssociationsJob::CreateARTASAssociationsJob(
     std::map<std::string, std::shared_ptr<Buffer>> buffers)
     : Job("CreateARTASAssociationsJob"), task_(task), db_interface_(db_interface), buffers_(buffers)
 {
+    for (auto& buf_it : buffers_)  // not to be spilled while job runs
+        buf_it.second->pin();
+
     misses_acceptable_time_ = task_.missesAcceptableTime();
 
     association_time_past_ = task_.associationTimePast();
@@ -50,7 +57,11 @@ CreateARTASAssociationsJob::CreateARTASAssociationsJob(
         task_.associationDubiousCloseTimeFuture();  // will be negative time diff
 }
 
-CreateARTASAssociationsJob::~CreateARTASAssociationsJob() {}
+CreateARTASAssociationsJob::~CreateARTASAssociationsJob()
+{
+    for (auto& buf_it : buffers_)
+        buf_it.second->unpin();
+}
 
 void CreateARTASAssociationsJob::run()
 {
@@ -79,8 +90,9 @@ void CreateARTASAssociationsJob::run()
     emit statusSignal("Creating ARTAS Associations");
     createARTASAssociations();
 
-    // create associations for sensors
-    createSensorAssociations();
+    // create associations for sensors, parallel steps run isolated from other subsystems
+    JobManager::instance().arena(TaskArenaType::ASSOCIATION).execute(
+        [&] { createSensorAssociations(); });
 
     if (missing_hashes_cnt_ || dubious_associations_cnt_)
     {
@@ -373,8 +385,21 @@ void CreateARTASAssociationsJob::createSensorAssociations()
     loginf << "CreateARTASAssociationsJob: createSensorAssociations";
     // for each rec_num + tri, find sensor hash + rec_num
 
+    TraceSpan span("association", "createSensorAssociations");
+
     DBObjectManager& object_man = COMPASS::instance().objectManager();
 
+    // reserve once for all sensor buffers, size() only counts entries after build
+    size_t num_sensor_entries = 0;
+
+    for (auto& dbo_it : object_man)
+    {
+        if (dbo_it.first != tracker_dbo_name_ && dbo_it.second->hasData() && buffers_.count(dbo_it.first))
+            num_sensor_entries += buffers_.at(dbo_it.first)->size();
+    }
+
+    sensor_hashes_.reserve(num_sensor_entries);
+
     for (auto& dbo_it : object_man)
     {
         if (dbo_it.first != tracker_dbo_name_ && dbo_it.second->hasData())
@@ -385,158 +410,92 @@ void CreateARTASAssociationsJob::createSensorAssociations()
         }
     }
 
-    std::vector<std::string> tri_splits;
-    bool match_found;
-    bool best_match_dubious;
-    std::string best_match_dubious_comment;
-
-    std::string best_match_dbo_name;
-    int best_match_rec_num{-1};
-    float best_match_tod{0};
-    float tri_tod;
+    emit statusSignal("Creating Hash Table");
+    sensor_hashes_.build();
 
-    typedef std::multimap<std::string, std::pair<int, float>>::iterator HashIterator;
-    std::pair<HashIterator, HashIterator> possible_hash_matches;
+    loginf << "CreateARTASAssociationsJob: createSensorAssociations: " << sensor_hashes_.size()
+           << " sensor target reports with " << sensor_hashes_.numHashes() << " hashes, "
+           << sensor_hashes_.numDuplicateHashes() << " duplicate hashes, "
+           << sensor_hashes_.numCollisions() << " hash table collisions";
 
     assert(first_track_tod_ > 0);  // has to be set
 
     emit statusSignal("Creating Associations");
-    for (auto& ut_it : finished_tracks_)  // utn -> UAT, for each unqique target
+
+    // track updates in utn and rec_num order, matched in parallel, associated in this order
+    struct TrackUpdate
     {
-        logdbg << "CreateARTASAssociationsJob: createSensorAssociations: utn " << ut_it.first;
+        unsigned int utn;
+        int rec_num;
+        const std::string* tris;
+        float tod;
+        std::vector<HashMatch> matches;  // per referenced hash
+    };
 
+    std::vector<TrackUpdate> track_updates;
+
+    for (auto& ut_it : finished_tracks_)  // utn -> UAT, for each unqique target
+    {
         for (auto& assoc_it :
              ut_it.second.rec_nums_tris_)  // rec_num -> (tri, tod), for each TRIs compound string
         {
             if (!assoc_it.second.first.size())  // empty tri, ignored update
                 continue;
 
-            tri_splits = String::split(assoc_it.second.first, ';');
-            tri_tod = assoc_it.second.second;
+            track_updates.push_back({(unsigned int)ut_it.first, assoc_it.first,
+                                     &assoc_it.second.first, assoc_it.second.second, {}});
+        }
+    }
+
+    tbb::parallel_for(size_t(0), track_updates.size(), [&](size_t cnt) {
+        TrackUpdate& update = track_updates[cnt];
 
-            for (auto& tri : tri_splits)  // for each referenced hash
-            {
-                match_found = false;  // indicates if there was already a (previous) match found
-                best_match_dubious = false;  // indicates if the association is dubious
-                best_match_dubious_comment = "";
+        std::vector<std::string> tri_splits = String::split(*update.tris, ';');
+        update.matches.resize(tri_splits.size());
 
-                for (auto& dbo_it : object_man)  // iterate over all dbos
-                {
-                    if (!dbo_it.second->hasData())
-                        continue;
-
-                    if (sensor_hashes_.count(dbo_it.first))  // if dbo has hash values
-                    {
-                        possible_hash_matches = sensor_hashes_.at(dbo_it.first).equal_range(tri);
-
-                        for (HashIterator it = possible_hash_matches.first;
-                             it != possible_hash_matches.second; ++it)
-                        {
-                            std::pair<int, float>& match = it->second;  // rec_num, tod
-
-                            if (!isPossibleAssociation(tri_tod, match.second))
-                                continue;
-
-                            if (match_found)
-                            {
-                                logdbg << "CreateARTASAssociationsJob: createSensorAssociations: "
-                                          "found duplicate hash '"
-                                       << tri << "' in dbo " << dbo_it.first << " rec num "
-                                       << match.first;
-
-                                if (isAssociationHashCollisionInDubiousTime(tri_tod,
-                                                                            best_match_tod) &&
-                                    isAssociationHashCollisionInDubiousTime(tri_tod, match.second))
-                                {
-                                    best_match_dubious = true;
-                                    best_match_dubious_comment =
-                                        tri + " has multiple matches in close time at " +
-                                        String::timeStringFromDouble(tri_tod);
-                                }
-                                else  // not dubious
-                                {
-                                    best_match_dubious = false;
-                                    best_match_dubious_comment = "";
-                                }
-
-                                // store if closer in time
-                                if (fabs(tri_tod - match.second) < fabs(tri_tod - best_match_tod))
-                                {
-                                    if (isAssociationInDubiousDistantTime(tri_tod, match.second))
-                                    {
-                                        best_match_dubious = true;
-                                        best_match_dubious_comment =
-                                            tri + " in too distant time (" +
-                                            std::to_string(tri_tod - match.second) + "s) at " +
-                                            String::timeStringFromDouble(tri_tod);
-                                    }
-                                    else  // not dubious
-                                    {
-                                        best_match_dubious = false;
-                                        best_match_dubious_comment = "";
-                                    }
-
-                                    best_match_dbo_name = dbo_it.first;
-                                    best_match_rec_num = match.first;  // rec_num
-                                    best_match_tod = match.second;     // tod
-                                    match_found = true;
-                                }
-
-                                found_hash_duplicates_cnt_++;
-                            }
-                            else  // store as best match
-                            {
-                                if (isAssociationInDubiousDistantTime(tri_tod, match.second))
-                                {
-                                    best_match_dubious = true;
-                                    best_match_dubious_comment =
-                                        tri + " in too distant time (" +
-                                        std::to_string(tri_tod - match.second) + "s) at " +
-                                        String::timeStringFromDouble(tri_tod);
-                                }
-
-                                best_match_dbo_name = dbo_it.first;
-                                best_match_rec_num = match.first;  // rec_num
-                                best_match_tod = match.second;     // tod
-                                match_found = true;
-                            }
-                        }
-                    }
-                }
+        for (unsigned int tri_cnt = 0; tri_cnt < tri_splits.size(); ++tri_cnt)  // each hash
+        {
+            update.matches[tri_cnt].tri = tri_splits[tri_cnt];
+            findSensorMatch(update.matches[tri_cnt], update.tod);
+        }
+    });
 
-                if (match_found)
+    for (auto& update : track_updates)
+    {
+        for (auto& match : update.matches)
+        {
+            found_hash_duplicates_cnt_ += match.duplicates;
+
+            if (match.match_found)
+            {
+                if (match.dubious)
                 {
-                    if (best_match_dubious)
-                    {
-                        loginf << "CreateARTASAssociationsJob: createSensorAssociations: utn "
-                               << ut_it.first << " match rec_num " << best_match_rec_num
-                               << " is dubious because " << best_match_dubious_comment;
-                        ++dubious_associations_cnt_;
-                    }
-
-                    object_man.object(best_match_dbo_name)
-                        .addAssociation(best_match_rec_num, ut_it.first, true, assoc_it.first);
-                    ++found_hashes_cnt_;
+                    loginf << "CreateARTASAssociationsJob: createSensorAssociations: utn "
+                           << update.utn << " match rec_num " << match.rec_num
+                           << " is dubious because " << match.dubious_comment;
+                    ++dubious_associations_cnt_;
                 }
+
+                object_man.object(sensor_dbo_names_.at(match.dbo_index))
+                    .addAssociation(match.rec_num, update.utn, true, update.rec_num);
+                ++found_hashes_cnt_;
+            }
+            else
+            {
+                logdbg << "CreateARTASAssociationsJob: createSensorAssociations: utn "
+                       << update.utn << " has missing hash '" << match.tri << "' at "
+                       << String::timeStringFromDouble(update.tod);
+
+                if (isTimeAtBeginningOrEnd(update.tod))
+                    ++acceptable_missing_hashes_cnt_;
                 else
                 {
-                    logdbg << "CreateARTASAssociationsJob: createSensorAssociations: utn "
-                           << ut_it.first << " has missing hash '" << tri << "' at "
-                           << String::timeStringFromDouble(tri_tod);
-
-                    // assert (tri_tod-first_track_tod_ >= 0);
-
-                    if (isTimeAtBeginningOrEnd(tri_tod))
-                        ++acceptable_missing_hashes_cnt_;
-                    else
-                    {
-                        loginf << "CreateARTASAssociationsJob: createSensorAssociations: utn "
-                               << ut_it.first << " has missing hash '" << tri << "' at "
-                               << String::timeStringFromDouble(tri_tod);
-
-                        missing_hashes_.emplace(tri, std::make_pair(ut_it.first, assoc_it.first));
-                        ++missing_hashes_cnt_;
-                    }
+                    loginf << "CreateARTASAssociationsJob: createSensorAssociations: utn "
+                           << update.utn << " has missing hash '" << match.tri << "' at "
+                           << String::timeStringFromDouble(update.tod);
+
+                    missing_hashes_.emplace(match.tri, std::make_pair(update.utn, update.rec_num));
+                    ++missing_hashes_cnt_;
                 }
             }
         }
@@ -548,7 +507,83 @@ void CreateARTASAssociationsJob::createSensorAssociations()
            << found_hash_duplicates_cnt_ << " duplicates";
 }
 
-bool CreateARTASAssociationsJob::isPossibleAssociation(float tod_track, float tod_target)
+void CreateARTASAssociationsJob::findSensorMatch(HashMatch& match, float tri_tod) const
+{
+    const std::string& tri = match.tri;
+
+    float best_match_tod{0};
+
+    // in dbo and buffer order, as added
+    std::pair<const ARTASHashTable::Entry*, const ARTASHashTable::Entry*> possible_hash_matches =
+        sensor_hashes_.find(tri);
+
+    for (const ARTASHashTable::Entry* it = possible_hash_matches.first;
+         it != possible_hash_matches.second; ++it)
+    {
+        if (!isPossibleAssociation(tri_tod, it->tod))
+            continue;
+
+        if (match.match_found)
+        {
+            logdbg << "CreateARTASAssociationsJob: findSensorMatch: found duplicate hash '" << tri
+                   << "' in dbo " << sensor_dbo_names_.at(it->dbo_index) << " rec num "
+                   << it->rec_num;
+
+            if (isAssociationHashCollisionInDubiousTime(tri_tod, best_match_tod) &&
+                isAssociationHashCollisionInDubiousTime(tri_tod, it->tod))
+            {
+                match.dubious = true;
+                match.dubious_comment = tri + " has multiple matches in close time at " +
+                                        String::timeStringFromDouble(tri_tod);
+            }
+            else  // not dubious
+            {
+                match.dubious = false;
+                match.dubious_comment = "";
+            }
+
+            // store if closer in time
+            if (fabs(tri_tod - it->tod) < fabs(tri_tod - best_match_tod))
+            {
+                if (isAssociationInDubiousDistantTime(tri_tod, it->tod))
+                {
+                    match.dubious = true;
+                    match.dubious_comment = tri + " in too distant time (" +
+                                            std::to_string(tri_tod - it->tod) + "s) at " +
+                                            String::timeStringFromDouble(tri_tod);
+                }
+                else  // not dubious
+                {
+                    match.dubious = false;
+                    match.dubious_comment = "";
+                }
+
+                match.dbo_index = it->dbo_index;
+                match.rec_num = it->rec_num;
+                best_match_tod = it->tod;
+            }
+
+            ++match.duplicates;
+        }
+        else  // store as best match
+        {
+            if (isAssociationInDubiousDistantTime(tri_tod, it->tod))
+            {
+                match.dubious = true;
+                match.dubious_comment = tri + " in too distant time (" +
+                                        std::to_string(tri_tod - it->tod) + "s) at " +
+                                        String::timeStringFromDouble(tri_tod);
+            }
+
+            match.dbo_index = it->dbo_index;
+            match.rec_num = it->rec_num;
+            best_match_tod = it->tod;
+            match.match_found = true;
+        }
+    }
+}
+
+bool CreateARTASAssociationsJob::isPossibleAssociation(float tod_track, float tod_target) const
 {
     if (tod_target > tod_track)  // target update in the future
         return tod_target - tod_track <= association_time_future_;
@@ -557,7 +592,7 @@ bool CreateARTASAssociationsJob::isPossibleAssociation(float tod_track, float to
 }
 
 bool CreateARTASAssociationsJob::isAssociationInDubiousDistantTime(float tod_track,
-                                                                   float tod_target)
+                                                                   float tod_target) const
 {
     if (tod_target > tod_track)  // target update in the future
         return false;            // only measured in the past
@@ -566,7 +601,7 @@ bool CreateARTASAssociationsJob::isAssociationInDubiousDistantTime(float tod_tra
 }
 
 bool CreateARTASAssociationsJob::isAssociationHashCollisionInDubiousTime(float tod_track,
-                                                                         float tod_target)
+                                                                         float tod_target) const
 {
     if (tod_target > tod_track)  // target update in the future
         return tod_target - tod_track <= association_dubious_close_time_future_;
@@ -574,7 +609,7 @@ bool CreateARTASAssociationsJob::isAssociationHashCollisionInDubiousTime(float t
         return tod_track - tod_target <= association_dubious_close_time_past_;
 }
 
-bool CreateARTASAssociationsJob::isTimeAtBeginningOrEnd(float tod_track)
+bool CreateARTASAssociationsJob::isTimeAtBeginningOrEnd(float tod_track) const
 {
     return (fabs(tod_track - first_track_tod_) <= misses_acceptable_time_) ||
            (fabs(last_track_tod_ - tod_track) <= misses_acceptable_time_);
@@ -610,6 +645,9 @@ void CreateARTASAssociationsJob::createSensorHashes(DBObject& object)
     NullableVector<std::string> hashes = buffer->get<std::string>(hash_var.name());
     NullableVector<float> tods = buffer->get<float>(tod_var.name());
 
+    unsigned int dbo_index = sensor_dbo_names_.size();
+    sensor_dbo_names_.push_back(dbo_name);
+
     for (size_t cnt = 0; cnt < buffer_size; ++cnt)
     {
         assert(!rec_nums.isNull(cnt));
@@ -624,11 +662,7 @@ void CreateARTASAssociationsJob::createSensorHashes(DBObject& object)
 
         assert(!tods.isNull(cnt));
 
-        // dbo -> hash -> rec_num, tod
-        // std::map <std::string, std::multimap<std::string, std::pair<int, float>>> sensor_hashes_;
-
-        sensor_hashes_[dbo_name].emplace(hashes.get(cnt),
-                                         std::make_pair(rec_nums.get(cnt), tods.get(cnt)));
+        sensor_hashes_.add(dbo_index, hashes.get(cnt), rec_nums.get(cnt), tods.get(cnt));
     }
 }
 
@@ -19,6 +19,7 @@
 #define CREATEARTASASSOCIATIONSJOB_H
 
 #include "job.h"
+#include "artashashtable.h"
 
 class CreateARTASAssociationsTask;
 class DBInterface;
@@ -82,8 +83,8 @@ class CreateARTASAssociationsJob : public Job
     const std::string tracker_dbo_name_{"Tracker"};
     std::map<int, UniqueARTASTrack> finished_tracks_;  // utn -> unique track
 
-    // dbo -> hash -> rec_num, tod
-    std::map<std::string, std::multimap<std::string, std::pair<int, float>>> sensor_hashes_;
+    std::vector<std::string> sensor_dbo_names_;  // dbo index -> dbo name
+    ARTASHashTable sensor_hashes_;               // hash -> dbo index, rec_num, tod
 
     float first_track_tod_{0};
     float last_track_tod_{0};
@@ -105,12 +106,26 @@ class CreateARTASAssociationsJob : public Job
     void createSensorAssociations();
     void createSensorHashes(DBObject& object);
 
+    struct HashMatch
+    {
+        std::string tri;
+        bool match_found{false};
+        bool dubious{false};
+        std::string dubious_comment;
+        unsigned int dbo_index{0};
+        int rec_num{-1};
+        size_t duplicates{0};
+    };
+
+    void findSensorMatch(HashMatch& match, float tri_tod) const;
+    // finds best match for tri at time of track update
+
     std::map<unsigned int, unsigned int> track_rec_num_utns_;  // track rec num -> utn
 
-    bool isPossibleAssociation(float tod_track, float tod_target);
-    bool isAssociationInDubiousDistantTime(float tod_track, float tod_target);
-    bool isAssociationHashCollisionInDubiousTime(float tod_track, float tod_target);
-    bool isTimeAtBeginningOrEnd(float tod_track);
+    bool isPossibleAssociation(float tod_track, float tod_target) const;
+    bool isAssociationInDubiousDistantTime(float tod_track, float tod_target) const;
+    bool isAssociationHashCollisionInDubiousTime(float tod_track, float tod_target) const;
+    bool isTimeAtBeginningOrEnd(float tod_track) const;
 };
 
 #endif  // CREATEARTASASSOCIATIONSJOB_H
@@ -27,10 +27,14 @@
 #include "stringconv.h"
 #include "projection/transformation.h"
 #include "evaluationmanager.h"
+#include "jobmanager.h"
+#include "tracer.h"
+#include "json.hpp"
 
 //#include <ogr_spatialref.h>
 
 #include <cassert>
+#include <algorithm>
 
 #include <tbb/tbb.h>
 
@@ -40,11 +44,17 @@ using namespace std;
 using namespace Utils;
 
 bool CreateAssociationsJob::in_appimage_ {getenv("APPDIR") != nullptr};
+const float CreateAssociationsJob::tracker_time_bucket_size_ {300.0};
 
 CreateAssociationsJob::CreateAssociationsJob(CreateAssociationsTask& task, DBInterface& db_interface,
                                              std::map<std::string, std::shared_ptr<Buffer>> buffers)
     : Job("CreateAssociationsJob"), task_(task), db_interface_(db_interface), buffers_(buffers)
 {
+    for (auto& buf_it : buffers_)  // not to be spilled while job runs
+        buf_it.second->pin();
+
+    if (task_.hasIncrementalState())
+        previous_state_ = db_interface_.getProperty(CreateAssociationsTask::STATE_PROPERTY_NAME);
 }
 
 CreateAssociationsJob::~CreateAssociationsJob()
@@ -53,6 +63,9 @@ CreateAssociationsJob::~CreateAssociationsJob()
 
     target_reports_.clear();
 
+    for (auto& buf_it : buffers_)
+        buf_it.second->unpin();
+
     logdbg << "CreateAssociationsJob: dtor: done";
 }
 
@@ -67,24 +80,48 @@ void CreateAssociationsJob::run()
 
     start_time = boost::posix_time::microsec_clock::local_time();
 
-    loginf << "CreateAssociationsJob: run: clearing associations";
-
     DBObjectManager& object_man = COMPASS::instance().objectManager();
 
-    object_man.removeAssociations();
+    bool incremental = previous_state_.size();
+
+    if (incremental) // keep existing associations in database, only new ones are appended
+    {
+        loginf << "CreateAssociationsJob: run: appending to existing associations";
+
+        for (auto& dbo_it : object_man)
+            dbo_it.second->clearAssociations();
+    }
+    else
+    {
+        loginf << "CreateAssociationsJob: run: clearing associations";
+
+        object_man.removeAssociations();
+        db_interface_.deleteAllRetiredTargets();
+    }
+
+    // parallel steps run isolated from other subsystems
+    tbb::task_arena& arena = JobManager::instance().arena(TaskArenaType::ASSOCIATION);
 
     // create target reports
     emit statusSignal("Creating Target Reports");
     createTargetReports();
 
+    std::map<unsigned int, Association::Target> targets;
+
+    if (incremental)
+    {
+        emit statusSignal("Restoring UTNs");
+        restoreTargets(targets);
+    }
+
     // create reference utns
     emit statusSignal("Creating Reference UTNs");
-    std::map<unsigned int, Association::Target> targets = createReferenceUTNs();
+    arena.execute([&] { createReferenceUTNs(targets); });
 
 
     // create tracker utns
     emit statusSignal("Creating Tracker UTNs");
-    createTrackerUTNs(targets);
+    arena.execute([&] { createTrackerUTNs(targets); });
 
     unsigned int multiple_associated {0};
     unsigned int single_associated {0};
@@ -103,7 +140,7 @@ void CreateAssociationsJob::run()
     // create non-tracker utns
 
     emit statusSignal("Creating non-Tracker UTNs");
-    createNonTrackerUTNS(targets);
+    arena.execute([&] { createNonTrackerUTNS(targets); });
 
     multiple_associated = 0;
     single_associated = 0;
@@ -125,18 +162,25 @@ void CreateAssociationsJob::run()
 
     // save associations
     emit statusSignal("Saving Associations");
+    TraceSpan save_span("association", "saveAssociations");
     for (auto& dbo_it : object_man)
     {
         loginf << "CreateAssociationsJob: run: processing object " << dbo_it.first
                << " associated " << dbo_it.second->associations().size() << " of "
                << dbo_it.second->count();
-        dbo_it.second->saveAssociations();
+        dbo_it.second->saveAssociations(incremental);
+
+        if (incremental) // only new ones in memory, all are read from database again when required
+            dbo_it.second->clearAssociations();
     }
 
     object_man.setAssociationsByAll(); // no specific dbo or data source
 
+    storeState(targets);
+
     loginf << "CreateAssociationsJob: run: clearing tmp data";
     targets.clear(); // removes from assoc target reports
+    restored_trs_.clear();
 
     stop_time = boost::posix_time::microsec_clock::local_time();
 
@@ -153,11 +197,12 @@ void CreateAssociationsJob::createTargetReports()
 {
     loginf << "CreateAssociationsJob: createTargetReports";
 
+    TraceSpan span("association", "createTargetReports");
+
     MetaDBOVariable* meta_key_var = task_.keyVar();
     MetaDBOVariable* meta_ds_id_var = task_.dsIdVar();
     MetaDBOVariable* meta_tod_var = task_.todVar();
     MetaDBOVariable* meta_ta_var = task_.targetAddrVar();
-    MetaDBOVariable* meta_ti_var = task_.targetIdVar();
     MetaDBOVariable* meta_tn_var = task_.trackNumVar();
     MetaDBOVariable* meta_tr_end_var = task_.trackEndVar();
     MetaDBOVariable* meta_mode_3a_var = task_.mode3AVar();
@@ -169,7 +214,6 @@ void CreateAssociationsJob::createTargetReports()
     assert (meta_ds_id_var);
     assert (meta_tod_var);
     assert (meta_ta_var);
-    assert (meta_ti_var);
     assert (meta_tn_var);
     assert (meta_tr_end_var);
     assert (meta_mode_3a_var);
@@ -201,9 +245,6 @@ void CreateAssociationsJob::createTargetReports()
         assert (meta_ta_var->existsIn(dbo_name));
         DBOVariable& ta_var = meta_ta_var->getFor(dbo_name);
 
-        assert (meta_ti_var->existsIn(dbo_name));
-        DBOVariable& ti_var = meta_ti_var->getFor(dbo_name);
-
         DBOVariable* tn_var {nullptr}; // not in ads-b
         if (meta_tn_var->existsIn(dbo_name))
             tn_var = &meta_tn_var->getFor(dbo_name);
@@ -237,9 +278,6 @@ void CreateAssociationsJob::createTargetReports()
         assert (buffer->has<int>(ta_var.name()));
         NullableVector<int>& tas = buffer->get<int>(ta_var.name());
 
-        assert (buffer->has<string>(ti_var.name()));
-        NullableVector<string>& tis = buffer->get<string>(ti_var.name());
-
         NullableVector<int>* tns {nullptr};
         if (tn_var)
         {
@@ -266,50 +304,60 @@ void CreateAssociationsJob::createTargetReports()
         assert (buffer->has<double>(longitude_var.name()));
         NullableVector<double>& longs = buffer->get<double>(longitude_var.name());
 
+        // count per data source first, so that target reports are stored without reallocation
+        vector<bool> valid (buffer_size, false);
+        map<unsigned int, size_t> ds_id_counts; // ds_id -> number of target reports
+
         for (size_t cnt = 0; cnt < buffer_size; ++cnt)
         {
             assert (!rec_nums.isNull(cnt));
             assert (!ds_ids.isNull(cnt));
 
-            tr.dbo_name_ = dbo_name;
-            tr.rec_num_ = rec_nums.get(cnt);
-            tr.ds_id_ = ds_ids.get(cnt);
-
             if (tods.isNull(cnt))
             {
                 logwrn << "CreateAssociationsJob: createTargetReports: target report w/o time: dbo "
-                       << dbo_name << " rec_num " << tr.rec_num_  << " ds_id " << tr.ds_id_;
-                continue;
-            }
-
-            if (tods.isNull(cnt))
-            {
-                logwrn << "CreateAssociationsJob: createTargetReports: target report w/o time: dbo "
-                       << dbo_name << " rec_num " << tr.rec_num_  << " ds_id " << tr.ds_id_;
+                       << dbo_name << " rec_num " << rec_nums.get(cnt) << " ds_id " << ds_ids.get(cnt);
                 continue;
             }
 
             if (lats.isNull(cnt))
             {
                 logwrn << "CreateAssociationsJob: createTargetReports: target report w/o latitude: dbo "
-                       << dbo_name << " rec_num " << tr.rec_num_  << " ds_id " << tr.ds_id_;
+                       << dbo_name << " rec_num " << rec_nums.get(cnt) << " ds_id " << ds_ids.get(cnt);
                 continue;
             }
             if (longs.isNull(cnt))
             {
                 logwrn << "CreateAssociationsJob: createTargetReports: target report w/o longitude: dbo "
-                       << dbo_name << " rec_num " << tr.rec_num_  << " ds_id " << tr.ds_id_;
+                       << dbo_name << " rec_num " << rec_nums.get(cnt) << " ds_id " << ds_ids.get(cnt);
                 continue;
             }
 
+            valid[cnt] = true;
+            ++ds_id_counts[ds_ids.get(cnt)];
+        }
+
+        std::map<unsigned int, std::vector<Association::TargetReport>>& ds_id_trs = target_reports_[dbo_name];
+
+        for (auto& ds_cnt_it : ds_id_counts)
+            ds_id_trs[ds_cnt_it.first].reserve(ds_id_trs[ds_cnt_it.first].size() + ds_cnt_it.second);
+
+        // key of target_reports_, not moved
+        tr.dbo_name_ = &target_reports_.find(dbo_name)->first;
+
+        for (size_t cnt = 0; cnt < buffer_size; ++cnt)
+        {
+            if (!valid[cnt])
+                continue;
+
+            tr.rec_num_ = rec_nums.get(cnt);
+            tr.ds_id_ = ds_ids.get(cnt);
+
             tr.tod_ = tods.get(cnt);
 
             tr.has_ta_ = !tas.isNull(cnt);
             tr.ta_ = tr.has_ta_ ? tas.get(cnt) : 0;
 
-            tr.has_ti_ = !tis.isNull(cnt);
-            tr.ti_ = tr.has_ti_ ? tis.get(cnt) : "";
-
             tr.has_tn_ = tns && !tns->isNull(cnt);
             tr.tn_ = tr.has_tn_ ? tns->get(cnt) : 0;
 
@@ -330,21 +378,262 @@ void CreateAssociationsJob::createTargetReports()
             tr.latitude_ = lats.get(cnt);
             tr.longitude_ = longs.get(cnt);
 
-            target_reports_[dbo_name][tr.ds_id_].push_back(tr);
+            ds_id_trs[tr.ds_id_].push_back(tr);
+        }
+
+        // all needed data was copied, release loaded data
+        buf_it.second = nullptr;
+    }
+}
+
+const std::string& CreateAssociationsJob::state() const
+{
+    return state_;
+}
+
+void CreateAssociationsJob::restoreTargets(std::map<unsigned int, Association::Target>& targets)
+{
+    loginf << "CreateAssociationsJob: restoreTargets";
+
+    TraceSpan span("association", "restoreTargets");
+
+    assert (previous_state_.size());
+    assert (!targets.size());
+
+    nlohmann::json state = nlohmann::json::parse(previous_state_);
+
+    assert (state.contains("targets"));
+    nlohmann::json& targets_j = state.at("targets");
+
+    // retired targets only continue by target address, restore those seen again from the database
+
+    std::set<unsigned int> live_utns;
+    std::set<unsigned int> live_tas;
+
+    for (auto& target_j : targets_j)
+    {
+        live_utns.insert(target_j.at("utn").get<unsigned int>());
+
+        if (target_j.contains("ta") && !target_j.at("ta").is_null())
+            live_tas.insert(target_j.at("ta").get<unsigned int>());
+    }
+
+    std::set<unsigned int> tas;
+
+    for (auto& dbo_it : target_reports_)
+    {
+        for (auto& ds_it : dbo_it.second)
+        {
+            for (auto& tr_it : ds_it.second)
+            {
+                if (tr_it.has_ta_ && !live_tas.count(tr_it.ta_))
+                    tas.insert(tr_it.ta_);
+            }
+        }
+    }
+
+    nlohmann::json retired_j = nlohmann::json::array();
+
+    for (auto& retired_it : db_interface_.retiredTargets(tas))
+    {
+        if (!live_utns.count(retired_it.first)) // older copy of a target restored before
+            retired_j.push_back(nlohmann::json::parse(retired_it.second));
+    }
+
+    // target reports are referenced by the targets, must not be reallocated
+    size_t num_updates = 0;
+
+    for (auto& target_j : targets_j)
+        num_updates += target_j.at("updates").size();
+
+    for (auto& target_j : retired_j)
+        num_updates += target_j.at("updates").size();
+
+    restored_trs_.clear();
+    restored_trs_.reserve(num_updates);
+
+    for (auto& target_j : targets_j)
+        restoreTarget(target_j, targets);
+
+    for (auto& target_j : retired_j)
+        restoreTarget(target_j, targets);
+
+    if (state.contains("utn_end"))
+        restored_utn_end_ = state.at("utn_end");
+    else if (targets.size()) // state without retired targets
+        restored_utn_end_ = targets.rbegin()->first + 1;
+
+    loginf << "CreateAssociationsJob: restoreTargets: restored " << targets.size() << " targets ("
+           << retired_j.size() << " retired) with " << restored_trs_.size() << " updates";
+}
+
+void CreateAssociationsJob::restoreTarget(const nlohmann::json& target_j,
+                                          std::map<unsigned int, Association::Target>& targets)
+{
+    unsigned int utn = target_j.at("utn");
+
+    // tods are relative to the day of the chunk they were stored in, made relative to the current one
+    float tod_offset = (target_j.value("day", 0) - task_.streamingChunkDay())
+            * CreateAssociationsTask::SECONDS_PER_DAY;
+
+    targets.emplace(
+                std::piecewise_construct,
+                std::forward_as_tuple(utn),   // args for key
+                std::forward_as_tuple(utn, false));  // args for mapped value
+
+    vector<Association::TargetReport*> trs;
+    Association::TargetReport tr;
+
+    for (auto& update_j : target_j.at("updates")) // [dbo, ds_id, tod, lat, lon, ta, tn, ma, mc]
+    {
+        assert (update_j.size() == 9);
+
+        tr.dbo_name_ = &*restored_dbo_names_.insert(update_j.at(0).get<std::string>()).first;
+        tr.ds_id_ = update_j.at(1);
+        tr.tod_ = update_j.at(2).get<float>() + tod_offset;
+        tr.latitude_ = update_j.at(3);
+        tr.longitude_ = update_j.at(4);
+
+        tr.has_ta_ = !update_j.at(5).is_null();
+        tr.ta_ = tr.has_ta_ ? update_j.at(5).get<unsigned int>() : 0;
+
+        tr.has_tn_ = !update_j.at(6).is_null();
+        tr.tn_ = tr.has_tn_ ? update_j.at(6).get<unsigned int>() : 0;
+
+        tr.has_ma_ = !update_j.at(7).is_null();
+        tr.ma_ = tr.has_ma_ ? update_j.at(7).get<unsigned int>() : 0;
+
+        tr.has_mc_ = !update_j.at(8).is_null();
+        tr.mc_ = tr.has_mc_ ? update_j.at(8).get<float>() : 0;
+
+        restored_trs_.push_back(tr);
+        trs.push_back(&restored_trs_.back());
+    }
+
+    targets.at(utn).addAssociated(trs);
+}
+
+void CreateAssociationsJob::storeState(const std::map<unsigned int, Association::Target>& targets)
+{
+    loginf << "CreateAssociationsJob: storeState";
+
+    TraceSpan span("association", "storeState");
+
+    nlohmann::json state;
+
+    // highest associated rec_num per dbo, all below were processed
+
+    std::map<std::string, unsigned int> watermarks;
+
+    if (previous_state_.size())
+        watermarks = nlohmann::json::parse(previous_state_).at("watermarks")
+                .get<std::map<std::string, unsigned int>>();
+
+    for (auto& dbo_it : target_reports_)
+    {
+        for (auto& ds_it : dbo_it.second)
+        {
+            for (auto& tr_it : ds_it.second)
+            {
+                if (!watermarks.count(dbo_it.first) || tr_it.rec_num_ > watermarks.at(dbo_it.first))
+                    watermarks[dbo_it.first] = tr_it.rec_num_;
+            }
+        }
+    }
+
+    state["watermarks"] = watermarks;
+    state["utn_end"] = newUTN(targets); // also above retired targets not restored in this run
+
+    // per target first update, to keep time span, and last updates within association time window.
+    // targets not updated within the time window are retired, only their first and last update are kept
+    // and written to the database, so that the state only holds live targets
+
+    double time_window = max(max(task_.maxTimeDiffTracker(), task_.maxTimeDiffSensor()),
+                             task_.contMaxTimeDiffTracker());
+
+    int day = task_.streamingChunkDay();
+
+    float tod_max = 0;
+
+    for (auto& target_it : targets)
+    {
+        if (target_it.second.has_tod_ && target_it.second.tod_max_ > tod_max)
+            tod_max = target_it.second.tod_max_;
+    }
+
+    std::vector<std::tuple<unsigned int, int, std::string>> retired; // utn, ta or -1, json
+
+    nlohmann::json& targets_j = state["targets"];
+    targets_j = nlohmann::json::array();
+
+    for (auto& target_it : targets)
+    {
+        const Association::Target& target = target_it.second;
+
+        if (!target.has_tod_)
+            continue;
+
+        nlohmann::json target_j;
+        target_j["utn"] = target.utn_;
+        target_j["ta"] = target.hasTA() ? nlohmann::json(*target.tas_.begin()) : nlohmann::json();
+        target_j["day"] = day;
+
+        nlohmann::json& updates_j = target_j["updates"];
+        updates_j = nlohmann::json::array();
+
+        unsigned int num_updates = target.tods_.size();
+        bool is_retired = target.tod_max_ < tod_max - time_window;
+
+        for (unsigned int cnt=0; cnt < num_updates; ++cnt)
+        {
+            if (cnt && is_retired && cnt != num_updates - 1)
+                continue;
+
+            if (cnt && !is_retired && target.tods_.at(cnt) < target.tod_max_ - time_window)
+                continue;
+
+            const Association::TargetReport& tr = *target.assoc_trs_.at(target.tr_indexes_.at(cnt));
+
+            updates_j.push_back({*tr.dbo_name_, tr.ds_id_, tr.tod_, tr.latitude_, tr.longitude_,
+                                 tr.has_ta_ ? nlohmann::json(tr.ta_) : nlohmann::json(),
+                                 tr.has_tn_ ? nlohmann::json(tr.tn_) : nlohmann::json(),
+                                 tr.has_ma_ ? nlohmann::json(tr.ma_) : nlohmann::json(),
+                                 tr.has_mc_ ? nlohmann::json(tr.mc_) : nlohmann::json()});
         }
+
+        if (is_retired)
+            retired.emplace_back(target.utn_, target.hasTA() ? (int) *target.tas_.begin() : -1,
+                                 target_j.dump());
+        else
+            targets_j.push_back(target_j);
     }
+
+    db_interface_.setRetiredTargets(retired);
+
+    state_ = state.dump();
+
+    loginf << "CreateAssociationsJob: storeState: stored " << targets_j.size() << " targets, "
+           << retired.size() << " retired, size " << state_.size();
 }
 
-std::map<unsigned int, Association::Target> CreateAssociationsJob::createReferenceUTNs()
+unsigned int CreateAssociationsJob::newUTN(const std::map<unsigned int, Association::Target>& targets) const
+{
+    if (targets.size())
+        return max(targets.rbegin()->first + 1, restored_utn_end_);
+
+    return restored_utn_end_;
+}
+
+void CreateAssociationsJob::createReferenceUTNs(std::map<unsigned int, Association::Target>& sum_targets)
 {
     loginf << "CreateAssociationsJob: createReferenceUTNs";
 
-    std::map<unsigned int, Association::Target> sum_targets;
+    TraceSpan span("association", "createReferenceUTNs");
 
     if (!target_reports_.count("RefTraj"))
     {
         loginf << "CreateAssociationsJob: createReferenceUTNs: no tracker data";
-        return sum_targets;
+        return;
     }
 
     DBObjectManager& object_man = COMPASS::instance().objectManager();
@@ -390,14 +679,12 @@ std::map<unsigned int, Association::Target> CreateAssociationsJob::createReferen
     }
 
     emit statusSignal("Self-associating Sum Reference Targets");
-    map<unsigned int, Association::Target> final_targets = selfAssociateTrackerUTNs(sum_targets);
+    sum_targets = selfAssociateTrackerUTNs(sum_targets);
 
     emit statusSignal("Checking Final Reference Targets");
-    cleanTrackerUTNs(final_targets);
-
-    markDubiousUTNs (final_targets);
+    cleanTrackerUTNs(sum_targets);
 
-    return final_targets;
+    markDubiousUTNs (sum_targets);
 }
 
 
@@ -405,6 +692,8 @@ void CreateAssociationsJob::createTrackerUTNs(std::map<unsigned int, Association
 {
     loginf << "CreateAssociationsJob: createTrackerUTNs";
 
+    TraceSpan span("association", "createTrackerUTNs");
+
     //std::map<unsigned int, Association::Target> sum_targets;
 
     if (!target_reports_.count("Tracker"))
@@ -470,261 +759,268 @@ void CreateAssociationsJob::createNonTrackerUTNS(std::map<unsigned int, Associat
 {
     loginf << "CreateAssociationsJob: createNonTrackerUTNS";
 
-    unsigned int num_data_sources = 0;
+    TraceSpan span("association", "createNonTrackerUTNS");
+
+    // data sources are processed concurrently where possible, results are merged in this order, so that
+    // utns are the same as for one data source after the other
+    vector<std::vector<Association::TargetReport>*> ds_target_reports;
 
     for (auto& dbo_it : target_reports_)
     {
         if (dbo_it.first == "RefTraj" || dbo_it.first == "Tracker") // already associated
             continue;
 
-        num_data_sources += dbo_it.second.size();
+        for (auto& ds_it : dbo_it.second) // ds_id -> trs
+            ds_target_reports.push_back(&ds_it.second);
     }
 
+    unsigned int num_data_sources = ds_target_reports.size();
+
     loginf << "CreateAssociationsJob: createNonTrackerUTNS: num_data_sources " << num_data_sources;
 
     // get ta lookup map
     std::map<unsigned int, unsigned int> ta_2_utn = getTALookupMap(targets);
 
-    DBObjectManager& object_man = COMPASS::instance().objectManager();
-
     const bool associate_non_mode_s = task_.associateNonModeS();
-    const double max_time_diff_sensor = task_.maxTimeDiffSensor();
-    const double max_altitude_diff_sensor = task_.maxAltitudeDiffSensor();
-    const double max_distance_acceptable_sensor = task_.maxDistanceAcceptableSensor();
-
-    unsigned int ds_cnt = 0;
-    unsigned int done_perc;
-
-    for (auto& dbo_it : target_reports_)
-    {
-        if (dbo_it.first == "RefTraj" || dbo_it.first == "Tracker") // already associated
-            continue;
-
-        for (auto& ds_it : dbo_it.second) // ds_id -> trs
-        {
-            loginf << "CreateAssociationsJob: createNonTrackerUTNS: ds " << ds_it.first;
-
-            assert (num_data_sources);
-            done_perc = (unsigned int)(100.0 * (float)ds_cnt/(float)num_data_sources);
 
-            string ds_name = object_man.object(dbo_it.first).dataSources().at(ds_it.first).name();
-            emit statusSignal(("Creating "+dbo_it.first+" "+ds_name+" UTNs ("+to_string(done_perc)+"%)").c_str());
+    vector<vector<int>> tmp_assoc_utns (num_data_sources); // ds index -> tr_cnt -> utn, -1 if none
+    vector<map<unsigned int, vector<unsigned int>>> create_todos (num_data_sources); // ds index -> ta -> tr_cnts
 
-            std::vector<Association::TargetReport>& target_reports = ds_it.second;
-            unsigned int num_target_reports = target_reports.size();
-            vector<int> tmp_assoc_utns; // tr_cnt -> utn
-            tmp_assoc_utns.resize(num_target_reports);
+    // mode s target reports, associated by target address
 
-            map<unsigned int, vector<Association::TargetReport*>> create_todos; // ta -> trs
-            boost::mutex create_todos_mutex;
+    emit statusSignal("Associating Mode S Target Reports");
 
-            //for (unsigned int tr_cnt=0; tr_cnt < num_target_reports; ++tr_cnt)
-            tbb::parallel_for(uint(0), num_target_reports, [&](unsigned int tr_cnt)
-            {
-                Association::TargetReport& tr_it = target_reports[tr_cnt];
+    tbb::parallel_for(uint(0), num_data_sources, [&](unsigned int ds_cnt)
+    {
+        std::vector<Association::TargetReport>& target_reports = *ds_target_reports.at(ds_cnt);
+        unsigned int num_target_reports = target_reports.size();
 
-                tmp_assoc_utns[tr_cnt] = -1; // set as not associated
+        vector<int>& assoc_utns = tmp_assoc_utns.at(ds_cnt);
+        assoc_utns.assign(num_target_reports, -1);
 
-                //int tmp_utn = -1;
+        for (unsigned int tr_cnt=0; tr_cnt < num_target_reports; ++tr_cnt)
+        {
+            Association::TargetReport& tr_it = target_reports[tr_cnt];
 
-                if (tr_it.has_ta_ && ta_2_utn.count(tr_it.ta_)) // check ta with lookup
-                {
-                    unsigned int tmp_utn = ta_2_utn.at(tr_it.ta_);
+            if (!tr_it.has_ta_)
+                continue;
 
-                    assert (targets.count(tmp_utn));
-                    //association_todos.push_back({tmp_utn, &tr_it});
-                    tmp_assoc_utns[tr_cnt] = tmp_utn;
-                    return;
-                }
+            if (ta_2_utn.count(tr_it.ta_)) // check ta with lookup
+                assoc_utns[tr_cnt] = ta_2_utn.at(tr_it.ta_);
+            else
+                create_todos.at(ds_cnt)[tr_it.ta_].push_back(tr_cnt);
+        }
+    });
 
-                //tmp_utn = findUTNForTargetReport(tr_it);
+    emit statusSignal("Creating Mode S UTNs");
 
-                //                if (tmp_utn != -1) // existing target found
-                //                {
-                //                    assert (targets.count(tmp_utn));
-                //                    //association_todos.push_back({tmp_utn, &tr_it});
-                //                    tmp_assoc_utns[tr_cnt] = tmp_utn;
-                //                    return;
-                //                }
+    // create new targets in data source and target address order, same as one source after the other. targets
+    // of later data sources have no target reports until added, so they are no candidates for earlier ones
+    for (unsigned int ds_cnt=0; ds_cnt < num_data_sources; ++ds_cnt)
+    {
+        for (auto& todo_it : create_todos.at(ds_cnt)) // ta -> tr_cnts
+        {
+            if (!ta_2_utn.count(todo_it.first))
+            {
+                unsigned int new_utn = newUTN(targets);
 
-                if (tr_it.has_ta_)
-                {
-                    //addTargetByTargetReport(tr_it);
+                targets.emplace(
+                            std::piecewise_construct,
+                            std::forward_as_tuple(new_utn),   // args for key
+                            std::forward_as_tuple(new_utn, false));  // args for mapped value
 
-                    boost::mutex::scoped_lock lock(create_todos_mutex);
-                    create_todos[tr_it.ta_].push_back(&tr_it);
+                ta_2_utn[todo_it.first] = new_utn;
+            }
 
-                    return;
-                }
+            for (auto tr_cnt : todo_it.second)
+                tmp_assoc_utns.at(ds_cnt).at(tr_cnt) = ta_2_utn.at(todo_it.first);
+        }
+    }
 
-                // tr non mode s
+    if (!associate_non_mode_s)
+    {
+        emit statusSignal("Creating Mode S Associations");
 
-                if (!associate_non_mode_s)
-                    return;
+        addAssociations(tmp_assoc_utns, ds_target_reports, 0, num_data_sources, targets);
 
-                float tod;
-                vector<tuple<bool, unsigned int, double>> results;
-                // usable, utn, distance
+        loginf << "CreateAssociationsJob: createNonTrackerUTNS: done";
+        return;
+    }
 
-                results.resize(targets.size());
+    // non mode s target reports, associated by position to the target reports of the earlier data sources,
+    // so one data source after the other, parallel per target report
 
-                tod = tr_it.tod_;
+    const double max_time_diff_sensor = task_.maxTimeDiffSensor();
+    const double max_distance_acceptable_sensor = task_.maxDistanceAcceptableSensor();
 
-                EvaluationTargetPosition tst_pos;
+    // targets in utn order, index for non mode s candidates
+    vector<Association::Target*> target_ptrs;
+    target_ptrs.reserve(targets.size());
 
-                tst_pos.latitude_ = tr_it.latitude_;
-                tst_pos.longitude_ = tr_it.longitude_;
-                tst_pos.has_altitude_ = tr_it.has_mc_;
-                tst_pos.altitude_ = tr_it.mc_;
+    for (auto& target_it : targets)
+        target_ptrs.push_back(&target_it.second);
 
-                FixedTransformation trafo (tst_pos.latitude_, tst_pos.longitude_);
+    unsigned int done_perc;
 
-                //loginf << "UGA: checking tr a/c/pos";
+    for (unsigned int ds_cnt=0; ds_cnt < num_data_sources; ++ds_cnt)
+    {
+        done_perc = (unsigned int)(100.0 * (float)ds_cnt/(float)num_data_sources);
+        emit statusSignal(("Associating non-Mode S Target Reports ("+to_string(done_perc)+"%)").c_str());
 
-                double x_pos, y_pos;
-                double distance;
+        std::vector<Association::TargetReport>& target_reports = *ds_target_reports.at(ds_cnt);
+        unsigned int num_target_reports = target_reports.size();
 
-                EvaluationTargetPosition ref_pos;
-                bool ok;
+        vector<int>& assoc_utns = tmp_assoc_utns.at(ds_cnt);
 
-                for (unsigned int target_cnt=0; target_cnt < targets.size(); ++target_cnt)
-                {
-                    //assert (targets.count(target_cnt));
-                    //Association::Target& other = targets.at(target_cnt);
-                    Association::Target& other = std::next(targets.begin(), target_cnt)->second;
+        bool has_non_mode_s = any_of(target_reports.begin(), target_reports.end(),
+                                     [](const Association::TargetReport& tr) { return !tr.has_ta_; });
 
-                    results[target_cnt] = tuple<bool, unsigned int, double>(false, other.utn_, 0);
+        if (has_non_mode_s)
+        {
+            // targets were changed by the previous data source
+            Association::TargetPositionIndex position_index (
+                        target_ptrs, max_time_diff_sensor, max_distance_acceptable_sensor);
 
-                    if ((tr_it.has_ta_ && other.hasTA())) // only try if not both mode s
-                        continue;
+            tbb::parallel_for(uint(0), num_target_reports, [&](unsigned int tr_cnt)
+            {
+                if (!target_reports[tr_cnt].has_ta_)
+                    assoc_utns[tr_cnt] = findUTNForNonModeSTargetReport(
+                                target_reports[tr_cnt], target_ptrs, position_index);
+            });
+        }
 
-                    if (!other.isTimeInside(tod))
-                        continue;
+        addAssociations(tmp_assoc_utns, ds_target_reports, ds_cnt, ds_cnt+1, targets);
+    }
 
-                    if (tr_it.has_ma_ || tr_it.has_mc_) // mode a/c based
-                    {
-                        // check mode a code
-                        Association::CompareResult ma_res = other.compareModeACode(tr_it.has_ma_, tr_it.ma_, tod,
-                                                                                   max_time_diff_sensor);
+    loginf << "CreateAssociationsJob: createNonTrackerUTNS: done";
+}
 
-                        if (ma_res != Association::CompareResult::SAME)
-                            continue;
-                        //loginf << "UGA3 same mode a";
+void CreateAssociationsJob::addAssociations(
+        const std::vector<std::vector<int>>& tmp_assoc_utns,
+        const std::vector<std::vector<Association::TargetReport>*>& ds_target_reports,
+        unsigned int ds_begin, unsigned int ds_end,
+        std::map<unsigned int, Association::Target>& targets)
+{
+    assert (tmp_assoc_utns.size() == ds_target_reports.size());
+    assert (ds_begin <= ds_end && ds_end <= ds_target_reports.size());
 
-                        // check mode c code
-                        Association::CompareResult mc_res = other.compareModeCCode(
-                                    tr_it.has_mc_, tr_it.mc_, tod,
-                                    max_time_diff_sensor, max_altitude_diff_sensor, false);
+    // collect in data source order, so order of associated target reports is fixed
+    map<unsigned int, vector<Association::TargetReport*>> assoc_todos; // utn -> trs
+    int tmp_utn;
 
-                        if (mc_res != Association::CompareResult::SAME)
-                            continue;
-                    }
+    for (unsigned int ds_cnt=ds_begin; ds_cnt < ds_end; ++ds_cnt)
+    {
+        const vector<int>& assoc_utns = tmp_assoc_utns.at(ds_cnt);
+        std::vector<Association::TargetReport>& target_reports = *ds_target_reports.at(ds_cnt);
 
-                    // check positions
+        assert (assoc_utns.size() == target_reports.size());
 
-                    tie(ref_pos, ok) = other.interpolatedPosForTimeFast(tod, max_time_diff_sensor);
+        for (unsigned int tr_cnt=0; tr_cnt < assoc_utns.size(); ++tr_cnt) // tr_cnt -> utn
+        {
+            tmp_utn = assoc_utns.at(tr_cnt);
+            if (tmp_utn != -1)
+                assoc_todos[tmp_utn].push_back(&target_reports.at(tr_cnt));
+        }
+    }
 
-                    tie(ok, x_pos, y_pos) = trafo.distanceCart(ref_pos.latitude_, ref_pos.longitude_);
+    // targets are independent, added in batch each
+    vector<pair<Association::Target*, vector<Association::TargetReport*>*>> todos;
 
-                    if (!ok)
-                        continue;
+    for (auto& todo_it : assoc_todos)
+    {
+        assert (targets.count(todo_it.first));
+        todos.push_back({&targets.at(todo_it.first), &todo_it.second});
+    }
 
-                    distance = sqrt(pow(x_pos,2)+pow(y_pos,2));
+    tbb::parallel_for(size_t(0), todos.size(), [&](size_t cnt)
+    {
+        todos[cnt].first->addAssociated(*todos[cnt].second);
+    });
+}
 
-                    //loginf << "UGA3 distance " << distance;
+int CreateAssociationsJob::findUTNForNonModeSTargetReport (
+        const Association::TargetReport& tr, const std::vector<Association::Target*>& target_ptrs,
+        const Association::TargetPositionIndex& position_index)
+// tries to find existing utn for non mode s target report, -1 if failed
+{
+    const double max_time_diff_sensor = task_.maxTimeDiffSensor();
+    const double max_altitude_diff_sensor = task_.maxAltitudeDiffSensor();
+    const double max_distance_acceptable_sensor = task_.maxDistanceAcceptableSensor();
 
-                    if (distance < max_distance_acceptable_sensor)
-                        results[target_cnt] = tuple<bool, unsigned int, double>(true, other.utn_, distance);
-                }
+    float tod = tr.tod_;
 
-                // find best match
-                bool usable;
-                unsigned int other_utn;
+    FixedTransformation trafo (tr.latitude_, tr.longitude_);
 
-                bool first = true;
-                unsigned int best_other_utn;
-                double best_distance;
+    double x_pos, y_pos;
+    double distance;
 
-                for (auto& res_it : results) // usable, other utn, num updates, avg distance
-                {
-                    tie(usable, other_utn, distance) = res_it;
+    EvaluationTargetPosition ref_pos;
+    bool ok;
 
-                    if (!usable)
-                        continue;
+    bool first = true;
+    unsigned int best_other_utn;
+    double best_distance;
 
-                    if (first || distance < best_distance)
-                    {
-                        best_other_utn = other_utn;
-                        best_distance = distance;
+    // candidates are in utn order, so first best match is kept
+    for (unsigned int target_cnt : position_index.candidates(tod, tr.latitude_, tr.longitude_))
+    {
+        const Association::Target& other = *target_ptrs.at(target_cnt);
 
-                        first = false;
-                    }
-                }
+        if (!other.isTimeInside(tod))
+            continue;
 
-                if (!first)
-                {
-                    tmp_assoc_utns[tr_cnt] = best_other_utn;
-                }
-            });
+        if (tr.has_ma_ || tr.has_mc_) // mode a/c based
+        {
+            // check mode a code
+            Association::CompareResult ma_res = other.compareModeACode(tr.has_ma_, tr.ma_, tod,
+                                                                       max_time_diff_sensor);
 
-            emit statusSignal(("Creating "+dbo_it.first+" "+ds_name+" Associations ("
-                               +to_string(done_perc)+"%)").c_str());
+            if (ma_res != Association::CompareResult::SAME)
+                continue;
 
-            // create associations
-            int tmp_utn;
-            for (unsigned int tr_cnt=0; tr_cnt < num_target_reports; ++tr_cnt) // tr_cnt -> utn
-            {
-                tmp_utn = tmp_assoc_utns.at(tr_cnt);
-                if (tmp_utn != -1)
-                {
-                    assert (targets.count(tmp_utn));
-                    targets.at(tmp_utn).addAssociated(&target_reports.at(tr_cnt));
-                }
-            }
+            // check mode c code
+            Association::CompareResult mc_res = other.compareModeCCode(
+                        tr.has_mc_, tr.mc_, tod, max_time_diff_sensor, max_altitude_diff_sensor, false);
 
-            // create new targets
-            for (auto& todo_it : create_todos) // ta -> trs
-            {
-                vector<Association::TargetReport*>& trs = todo_it.second;
-                assert (trs.size());
+            if (mc_res != Association::CompareResult::SAME)
+                continue;
+        }
 
-                unsigned int new_utn;
+        // check positions
 
-                if (targets.size())
-                    new_utn = targets.rbegin()->first + 1;
-                else
-                    new_utn = 0;
+        tie(ref_pos, ok) = other.interpolatedPosForTimeFast(tod, max_time_diff_sensor);
 
-                //addTargetByTargetReport(*trs.at(0));
+        if (!ok)
+            continue;
 
-                targets.emplace(
-                            std::piecewise_construct,
-                            std::forward_as_tuple(new_utn),   // args for key
-                            std::forward_as_tuple(new_utn, false));  // args for mapped value
+        tie(ok, x_pos, y_pos) = trafo.distanceCart(ref_pos.latitude_, ref_pos.longitude_);
 
-                if (trs.at(0)->has_ta_)
-                    ta_2_utn[trs.at(0)->ta_] = {new_utn};
+        if (!ok)
+            continue;
 
-                targets.at(new_utn).addAssociated(trs.at(0));
+        distance = sqrt(pow(x_pos,2)+pow(y_pos,2));
 
-                for (unsigned int tr_cnt=1; tr_cnt < trs.size(); ++tr_cnt)
-                {
-                    assert (targets.count(new_utn));
-                    targets.at(new_utn).addAssociated(trs.at(tr_cnt));
-                }
-            }
+        if (distance < max_distance_acceptable_sensor && (first || distance < best_distance))
+        {
+            best_other_utn = other.utn_;
+            best_distance = distance;
 
-            ++ds_cnt;
+            first = false;
         }
     }
 
-    loginf << "CreateAssociationsJob: createNonTrackerUTNS: done";
+    if (first)
+        return -1;
+
+    return best_other_utn;
 }
 
 void CreateAssociationsJob::createAssociations()
 {
     loginf << "CreateAssociationsJob: createAssociations";
 
+    TraceSpan span("association", "createAssociations");
+
     DBObjectManager& object_man = COMPASS::instance().objectManager();
 
     for (auto& dbo_it : target_reports_)
@@ -923,6 +1219,7 @@ std::map<unsigned int, Association::Target> CreateAssociationsJob::selfAssociate
     loginf << "CreateAssociationsJob: selfAssociateTrackerUTNs: num targets " << targets.size();
 
     std::map<unsigned int, Association::Target> new_targets;
+    Association::TargetTimeIndex new_targets_index (tracker_time_bucket_size_);
 
     while (targets.size())
     {
@@ -930,15 +1227,19 @@ std::map<unsigned int, Association::Target> CreateAssociationsJob::selfAssociate
 
         loginf << "CreateAssociationsJob: selfAssociateTrackerUTNs: processing target utn " << tgt_it.first;
 
-        int tmp_utn = findUTNForTrackerTarget(tgt_it.second, new_targets);
+        int tmp_utn {-1};
 
-        if (tmp_utn == -1)
-        {
+        bool restored = tgt_it.first < restored_utn_end_; // from previous association, keep utn
+
+        if (!restored)
+            tmp_utn = findUTNForTrackerTarget(tgt_it.second, new_targets, new_targets_index);
 
-            if (new_targets.size())
-                tmp_utn = new_targets.rbegin()->first + 1;
+        if (restored || tmp_utn == -1)
+        {
+            if (restored)
+                tmp_utn = tgt_it.first;
             else
-                tmp_utn = 0;
+                tmp_utn = newUTN(new_targets);
 
             loginf << "CreateAssociationsJob: selfAssociateTrackerUTNs: no associatble utn found,"
                       " keeping target as utn " << tmp_utn;
@@ -956,6 +1257,7 @@ std::map<unsigned int, Association::Target> CreateAssociationsJob::selfAssociate
 
         // move to other map
         new_targets.at(tmp_utn).addAssociated(tgt_it.second.assoc_trs_);
+        new_targets_index.update(new_targets.at(tmp_utn));
         targets.erase(tgt_it.first);
     }
 
@@ -1011,6 +1313,11 @@ void CreateAssociationsJob::addTrackerUTNs(const std::string& ds_name,
     unsigned int target_cnt = 0;
     unsigned int from_targets_size = from_targets.size();
 
+    Association::TargetTimeIndex to_targets_index (tracker_time_bucket_size_);
+
+    for (auto& target_it : to_targets)
+        to_targets_index.update(target_it.second);
+
     while (from_targets.size())
     {
         done_ratio = (float)target_cnt / (float)from_targets_size;
@@ -1026,17 +1333,14 @@ void CreateAssociationsJob::addTrackerUTNs(const std::string& ds_name,
         {
             logdbg << "CreateAssociationsJob: addTrackerUTNs: creating utn for tmp utn " << tmp_target->first;
 
-            tmp_utn = findUTNForTrackerTarget(tmp_target->second, to_targets);
+            tmp_utn = findUTNForTrackerTarget(tmp_target->second, to_targets, to_targets_index);
 
             logdbg << "CreateAssociationsJob: addTrackerUTNs: tmp utn " << tmp_target->first
                    << " tmp_utn " << tmp_utn;
 
             if (tmp_utn == -1) // none found, create new target
             {
-                if (to_targets.size())
-                    tmp_utn  = to_targets.rbegin()->first + 1;
-                else
-                    tmp_utn = 0;
+                tmp_utn = newUTN(to_targets);
 
                 // add the target
                 to_targets.emplace(
@@ -1056,6 +1360,8 @@ void CreateAssociationsJob::addTrackerUTNs(const std::string& ds_name,
                 assert (to_targets.count(tmp_utn));
                 to_targets.at(tmp_utn).addAssociated(tmp_target->second.assoc_trs_);
             }
+
+            to_targets_index.update(to_targets.at(tmp_utn));
         }
 
         // remove target
@@ -1186,7 +1492,8 @@ int CreateAssociationsJob::findContinuationUTNForTrackerUpdate (
 }
 
 int CreateAssociationsJob::findUTNForTrackerTarget (const Association::Target& target,
-                                                    const std::map<unsigned int, Association::Target>& targets)
+                                                    const std::map<unsigned int, Association::Target>& targets,
+                                                    const Association::TargetTimeIndex& targets_index)
 // tries to find existing utn for target, -1 if failed
 {
     if (!targets.size()) // check if targets exist
@@ -1206,9 +1513,6 @@ int CreateAssociationsJob::findUTNForTrackerTarget (const Association::Target& t
     vector<tuple<bool, unsigned int, unsigned int, double>> results;
     // usable, other utn, num updates, avg distance
 
-    unsigned int num_utns = targets.size();
-    results.resize(num_utns);
-
     const double prob_min_time_overlap_tracker = task_.probMinTimeOverlapTracker();
     const double max_time_diff_tracker = task_.maxTimeDiffTracker();
     const unsigned int min_updates_tracker = task_.minUpdatesTracker();
@@ -1218,10 +1522,16 @@ int CreateAssociationsJob::findUTNForTrackerTarget (const Association::Target& t
     const double max_distance_dubious_tracker = task_.maxDistanceDubiousTracker();
     const double max_distance_acceptable_tracker = task_.maxDistanceAcceptableTracker();
 
+    // only time overlapping targets, with bounding box within quit distance, can be associated
+    vector<const Association::Target*> candidates = targets_index.candidates(target, max_distance_quit_tracker);
+
+    unsigned int num_utns = candidates.size();
+    results.resize(num_utns);
+
     tbb::parallel_for(uint(0), num_utns, [&](unsigned int cnt)
                       //for (unsigned int cnt=0; cnt < utn_cnt_; ++cnt)
     {
-        const Association::Target& other = targets.at(cnt);
+        const Association::Target& other = *candidates.at(cnt);
         Transformation trafo;
 
         results[cnt] = tuple<bool, unsigned int, unsigned int, double>(false, other.utn_, 0, 0);
@@ -1242,41 +1552,33 @@ int CreateAssociationsJob::findUTNForTrackerTarget (const Association::Target& t
                 if (print_debug)
                     loginf << "\ttarget " << target.utn_ << " other " << other.utn_ << " overlap passed";
 
-                vector<float> ma_unknown;
-                vector<float> ma_same;
-                vector<float> ma_different;
-
-                tie (ma_unknown, ma_same, ma_different) = target.compareModeACodes(other, max_time_diff_tracker);
+                Association::CompareCounts counts = target.compareModeACCodeCounts(
+                            other, max_time_diff_tracker, max_altitude_diff_tracker, min_updates_tracker, true);
 
                 if (print_debug)
                 {
                     loginf << "\ttarget " << target.utn_ << " other " << other.utn_
-                           << " ma unknown " << ma_unknown.size()
-                           << " same " << ma_same.size() << " diff " << ma_different.size();
+                           << " ma unknown " << counts.ma_unknown_
+                           << " same " << counts.ma_same_ << " diff " << counts.ma_different_
+                           << " stopped " << counts.stopped_;
                 }
 
-                if (ma_same.size() > ma_different.size() && ma_same.size() >= min_updates_tracker)
+                if (!counts.stopped_ && counts.ma_same_ > counts.ma_different_
+                        && counts.ma_same_ >= min_updates_tracker)
                 {
                     if (print_debug)
                         loginf << "\ttarget " << target.utn_ << " other " << other.utn_ << " mode a check passed";
 
                     // check mode c codes
 
-                    vector<float> mc_unknown;
-                    vector<float> mc_same;
-                    vector<float> mc_different;
-
-                    tie (mc_unknown, mc_same, mc_different) = target.compareModeCCodes(
-                                other, ma_same, max_time_diff_tracker, max_altitude_diff_tracker, print_debug);
-
                     if (print_debug)
                     {
                         loginf << "\ttarget " << target.utn_ << " other " << other.utn_
-                               << " ma same " << ma_same.size() << " diff " << ma_different.size()
-                               << " mc same " << mc_same.size() << " diff " << mc_different.size();
+                               << " ma same " << counts.ma_same_ << " diff " << counts.ma_different_
+                               << " mc same " << counts.mc_same_ << " diff " << counts.mc_different_;
                     }
 
-                    if (mc_same.size() > mc_different.size() && mc_same.size() >= min_updates_tracker)
+                    if (counts.mc_same_ > counts.mc_different_ && counts.mc_same_ >= min_updates_tracker)
                     {
                         if (print_debug)
                             loginf << "\ttarget " << target.utn_ << " other " << other.utn_ << " mode c check passed";
@@ -1295,12 +1597,27 @@ int CreateAssociationsJob::findUTNForTrackerTarget (const Association::Target& t
                         EvaluationTargetPosition ref_pos;
                         bool ok;
 
-                        for (auto tod_it : mc_same)
+                        float tod;
+
+                        for (unsigned int index=0; index < target.tods_.size(); ++index)
                         {
-                            assert (target.hasDataForExactTime(tod_it));
-                            tst_pos = target.posForExactTime(tod_it);
+                            // only updates with same mode a and c
+                            tod = target.tods_[index];
+
+                            if (other.compareModeACode(target.flags_[index] & Association::Target::HAS_MA,
+                                                       target.mode_as_[index], tod, max_time_diff_tracker)
+                                    != Association::CompareResult::SAME)
+                                continue;
+
+                            if (other.compareModeCCode(target.flags_[index] & Association::Target::HAS_MC,
+                                                       target.mcs_[index], tod, max_time_diff_tracker,
+                                                       max_altitude_diff_tracker, print_debug)
+                                    != Association::CompareResult::SAME)
+                                continue;
+
+                            tst_pos = target.posForIndex(index);
 
-                            tie(ref_pos, ok) = other.interpolatedPosForTimeFast(tod_it, max_time_diff_tracker);
+                            tie(ref_pos, ok) = other.interpolatedPosForTimeFast(tod, max_time_diff_tracker);
 
                             if (!ok)
                             {
@@ -1356,7 +1673,7 @@ int CreateAssociationsJob::findUTNForTrackerTarget (const Association::Target& t
 
                             //loginf << "\tdist " << distance;
 
-                            same_distances.push_back({tod_it, distance});
+                            same_distances.push_back({tod, distance});
                             distances_sum += distance;
                         }
 
@@ -21,6 +21,12 @@
 #include "job.h"
 #include "assoc/targetreport.h"
 #include "assoc/target.h"
+#include "assoc/targetpositionindex.h"
+#include "assoc/targettimeindex.h"
+#include "json.hpp"
+
+#include <map>
+#include <set>
 
 class CreateAssociationsTask;
 class DBInterface;
@@ -42,8 +48,11 @@ public:
 
     virtual void run();
 
+    const std::string& state() const; // target state after run, for next incremental association
+
 protected:
     static bool in_appimage_;
+    static const float tracker_time_bucket_size_; // s, for candidate lookup in tracker association
 
     CreateAssociationsTask& task_;
     DBInterface& db_interface_;
@@ -52,12 +61,32 @@ protected:
     std::map<std::string, std::map<unsigned int, std::vector<Association::TargetReport>>> target_reports_;
     //dbo name->ds_id->trs
 
+    std::string previous_state_; // empty if not incremental
+    std::string state_;
+
+    std::vector<Association::TargetReport> restored_trs_; // from previous state, not saved as associations
+    std::set<std::string> restored_dbo_names_; // referenced by restored target reports
+    unsigned int restored_utn_end_ {0}; // utns below are restored targets, kept as they are
+
+    // live targets from state, retired ones from database if their target address is in the target reports
+    void restoreTargets(std::map<unsigned int, Association::Target>& targets);
+    void restoreTarget(const nlohmann::json& target_j, std::map<unsigned int, Association::Target>& targets);
+    // live targets to state, retired ones to database
+    void storeState(const std::map<unsigned int, Association::Target>& targets);
+    // next free utn, above all targets and all utns of previous associations
+    unsigned int newUTN(const std::map<unsigned int, Association::Target>& targets) const;
+
     void createTargetReports();
-    std::map<unsigned int, Association::Target> createReferenceUTNs();
+    void createReferenceUTNs(std::map<unsigned int, Association::Target>& sum_targets);
 
     void createTrackerUTNs(std::map<unsigned int, Association::Target>& sum_targets);
 
     void createNonTrackerUTNS(std::map<unsigned int, Association::Target>& targets);
+    void addAssociations(const std::vector<std::vector<int>>& tmp_assoc_utns,
+                         const std::vector<std::vector<Association::TargetReport>*>& ds_target_reports,
+                         unsigned int ds_begin, unsigned int ds_end,
+                         std::map<unsigned int, Association::Target>& targets);
+    // adds ds index -> tr_cnt -> utn associations of data sources [ds_begin, ds_end), in data source order
     void createAssociations();
 
     std::map<unsigned int, Association::Target> createTrackedTargets(const std::string& dbo_name, unsigned int ds_id);
@@ -76,8 +105,13 @@ protected:
                                              const std::map<unsigned int, Association::Target>& targets);
     // tries to find existing utn for tracker update, -1 if failed
     int findUTNForTrackerTarget (const Association::Target& target,
-                                 const std::map<unsigned int, Association::Target>& targets);
-    // tries to find existing utn for target, -1 if failed
+                                 const std::map<unsigned int, Association::Target>& targets,
+                                 const Association::TargetTimeIndex& targets_index);
+    // tries to find existing utn for target, -1 if failed, only candidates from index are checked
+    int findUTNForNonModeSTargetReport (const Association::TargetReport& tr,
+                                        const std::vector<Association::Target*>& target_ptrs,
+                                        const Association::TargetPositionIndex& position_index);
+    // tries to find existing utn for non mode s target report, -1 if failed, only candidates from index
     int findUTNForTargetByTA (const Association::Target& target,
                               const std::map<unsigned int, Association::Target>& targets);
     // tries to find existing utn for target by target address, -1 if failed
@@ -88,6 +88,16 @@ void DBOReadDBJob::run()
 
         assert(buffer->dboName() == dbobject_.name());
 
+        // blocks while all credits are in use by unfinalized buffers
+        while (!obsolete_ && !dbobject_.readCredits().acquire(100))
+            ;
+
+        if (obsolete_)
+        {
+            loginf << "DBOReadDBJob: run: " << dbobject_.name() << ": obsolete while waiting";
+            break;
+        }
+
         logdbg << "DBOReadDBJob: run: " << dbobject_.name() << ": intermediate signal, #buffers "
                << cnt << " last one " << buffer->lastOne();
         row_count_ += buffer->size();
@@ -20,7 +20,9 @@
 
 #include <QObject>
 #include <QRunnable>
+#include <atomic>
 #include <memory>
+#include <vector>
 
 /**
  * @brief Encapsulates a work-package
@@ -29,6 +31,9 @@
  * Job was canceled (set as obsolete) or was completed (done). The work itself is defined in the
  * execute function, which must be overridden (and MUST set the done_ flag to true).
  *
+ * Jobs can depend on other jobs, in which case they are only started by the JobManager after all
+ * dependencies are done or obsolete. The priority is used when queueing at the thread pool.
+ *
  * Important: The Job and the contained data must be deleted in the callback functions.
  */
 class Job : public QObject, public QRunnable
@@ -51,22 +56,45 @@ class Job : public QObject, public QRunnable
     // @brief Returns done flag
     bool done() { return done_; }
     void emitDone() { emit doneSignal(); }
-    // @brief Sets obsolete flag
-    void setObsolete() { obsolete_ = true; }
+    // @brief Sets obsolete flag, notifies JobManager
+    void setObsolete();
     // @brief Returns obsolete flag
     bool obsolete() { return obsolete_; }
     void emitObsolete() { emit doneSignal(); }
 
     const std::string& name() { return name_; }
 
+    int priority() const { return priority_; }
+    void priority(int value) { priority_ = value; }
+
+    /// @brief Adds job which has to be done or obsolete before this one is started
+    void addDependency(std::shared_ptr<Job> job) { dependencies_.push_back(job); }
+    /// @brief Returns if all dependencies are done, obsolete or deleted
+    bool dependenciesDone()
+    {
+        for (auto& dep_it : dependencies_)
+        {
+            std::shared_ptr<Job> dependency = dep_it.lock();
+
+            if (dependency && !dependency->done() && !dependency->obsolete())
+                return false;
+        }
+
+        return true;
+    }
+
   protected:
     std::string name_;
     ///
-    bool started_{false};
+    std::atomic<bool> started_{false};
     /// Done flag
-    bool done_{false};
+    std::atomic<bool> done_{false};
     /// Obsolete flag
-    bool obsolete_{false};
+    std::atomic<bool> obsolete_{false};
+    /// Thread pool priority, higher is started first
+    int priority_{0};
+
+    std::vector<std::weak_ptr<Job>> dependencies_;
 
     virtual void setDone() { done_ = true; }
 };
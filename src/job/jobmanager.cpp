@@ -22,13 +22,102 @@
 #include <QCoreApplication>
 #include <QThreadPool>
 
+#include <chrono>
+#include <thread>
+
+#include <pthread.h>
+#include <sched.h>
+
 #include "job.h"
 #include "jobmanagerwidget.h"
 #include "logger.h"
 #include "stringconv.h"
+#include "tracer.h"
 
 using namespace Utils;
 
+// fallback wakeup interval, e.g. for widget updates
+const unsigned int max_wait_ms = 500;
+
+/**
+ * @brief Thread pool wrapper for a Job
+ *
+ * Holds a reference to the job while it is run and notifies the JobManager when run returns.
+ */
+class JobRunner : public QRunnable
+{
+  public:
+    JobRunner(std::shared_ptr<Job> job) : job_(job) { setAutoDelete(true); }
+
+    virtual void run()
+    {
+        {
+            TraceSpan span("job", "run", job_->name());
+            job_->run();
+        }
+
+        JobManager::instance().notifyJobChanged();
+    }
+
+  protected:
+    std::shared_ptr<Job> job_;
+};
+
+/**
+ * @brief Pins worker threads entering a task arena to the cores of the arena, in round robin
+ */
+class ArenaPinningObserver : public tbb::task_scheduler_observer
+{
+  public:
+    ArenaPinningObserver(tbb::task_arena& arena, const std::vector<int>& cores)
+        : tbb::task_scheduler_observer(arena), cores_(cores)
+    {
+        assert(cores_.size());
+        observe(true);
+    }
+
+    virtual void on_scheduler_entry(bool is_worker)
+    {
+        if (!is_worker)  // do not pin calling threads
+            return;
+
+        cpu_set_t cpu_set;
+        CPU_ZERO(&cpu_set);
+        CPU_SET(cores_.at(next_core_++ % cores_.size()), &cpu_set);
+
+        if (pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &cpu_set))
+            logwrn << "ArenaPinningObserver: on_scheduler_entry: pinning failed";
+    }
+
+  protected:
+    std::vector<int> cores_;
+    std::atomic<unsigned int> next_core_{0};
+};
+
+/// @brief Returns the cores the process may run on, e.g. restricted by taskset or a container
+static std::vector<int> allowedCores()
+{
+    std::vector<int> cores;
+
+    cpu_set_t cpu_set;
+    CPU_ZERO(&cpu_set);
+
+    if (!sched_getaffinity(0, sizeof(cpu_set_t), &cpu_set))
+    {
+        for (int core = 0; core < CPU_SETSIZE; ++core)
+            if (CPU_ISSET(core, &cpu_set))
+                cores.push_back(core);
+    }
+    else
+        logwrn << "JobManager: allowedCores: affinity unknown, using all cores";
+
+    if (!cores.size())
+        for (unsigned int core = 0; core < std::max(std::thread::hardware_concurrency(), 1u); ++core)
+            cores.push_back(core);
+
+    return cores;
+}
+
 JobManager::JobManager()
     : Configurable("JobManager", "JobManager0", 0, "threads.json"),
       stop_requested_(false),
@@ -36,6 +125,12 @@ JobManager::JobManager()
       widget_(nullptr)
 {
     logdbg << "JobManager: constructor";
+
+    registerParameter("max_threads", &max_threads_, 0);
+    registerParameter("import_threads", &import_threads_, 0);
+    registerParameter("association_threads", &association_threads_, 0);
+    registerParameter("evaluation_threads", &evaluation_threads_, 0);
+    registerParameter("pin_threads", &pin_threads_, false);
 }
 
 JobManager::~JobManager() { logdbg << "JobManager: destructor"; }
@@ -45,6 +140,8 @@ void JobManager::addBlockingJob(std::shared_ptr<Job> job)
     logdbg << "JobManager: addJob: " << job->name() << " num " << blocking_jobs_.unsafe_size();
 
     blocking_jobs_.push(job);  // only add, do not start
+    notifyJobChanged();
+
     updateWidget();
 }
 
@@ -53,8 +150,14 @@ void JobManager::addNonBlockingJob(std::shared_ptr<Job> job)
     logdbg << "JobManager: addNonBlockingJob: " << job->name() << " num "
            << non_blocking_jobs_.unsafe_size();
 
-    non_blocking_jobs_.push(job);  // add and start
-    QThreadPool::globalInstance()->start(job.get());
+    non_blocking_jobs_.push(job);
+
+    if (job->dependenciesDone())  // start immediately
+        startJob(job);
+    else  // started by manager thread
+        new_waiting_jobs_.push(job);
+
+    notifyJobChanged();
 
     updateWidget();
 }
@@ -62,6 +165,7 @@ void JobManager::addNonBlockingJob(std::shared_ptr<Job> job)
 void JobManager::addDBJob(std::shared_ptr<Job> job)
 {
     queued_db_jobs_.push(job);
+    notifyJobChanged();
 
     updateWidget();
 
@@ -70,6 +174,16 @@ void JobManager::addDBJob(std::shared_ptr<Job> job)
 
 void JobManager::cancelJob(std::shared_ptr<Job> job) { job->setObsolete(); }
 
+void JobManager::notifyJobChanged()
+{
+    {
+        std::lock_guard<std::mutex> lock(notify_mutex_);
+        notified_ = true;
+    }
+
+    notify_condition_.notify_one();
+}
+
 bool JobManager::hasAnyJobs() { return hasBlockingJobs() || hasNonBlockingJobs() || hasDBJobs(); }
 
 bool JobManager::hasBlockingJobs() { return active_blocking_job_ || !blocking_jobs_.empty(); }
@@ -104,7 +218,10 @@ void JobManager::run()
             handleBlockingJobs();
 
         if (hasNonBlockingJobs())
+        {
+            handleWaitingJobs();
             handleNonBlockingJobs();
+        }
 
         if (hasDBJobs())
             handleDBJobs();
@@ -116,7 +233,8 @@ void JobManager::run()
             updateWidget(really_update_widget_);
 
         // QCoreApplication::processEvents(QEventLoop::ExcludeUserInputEvents);
-        msleep(1);
+        if (!changed_)  // otherwise check again, e.g. for started jobs
+            waitForNotification();
 
 //        if ((boost::posix_time::microsec_clock::local_time() - log_time_).total_seconds() > 1)
 //        {
@@ -157,6 +275,7 @@ void JobManager::handleBlockingJobs()
             }
 
             active_blocking_job_ = nullptr;
+            active_blocking_job_started_ = false;
         }
     }
 
@@ -165,12 +284,19 @@ void JobManager::handleBlockingJobs()
         if (blocking_jobs_.try_pop(active_blocking_job_))
         {
             assert(!active_blocking_job_->started());
-            QThreadPool::globalInstance()->start(active_blocking_job_.get());
+            active_blocking_job_started_ = false;
 
             changed_ = true;
             really_update_widget_ = !hasBlockingJobs();
         }
     }
+
+    if (active_blocking_job_ && !active_blocking_job_started_ &&
+        !active_blocking_job_->obsolete() && active_blocking_job_->dependenciesDone())
+    {
+        startJob(active_blocking_job_);
+        active_blocking_job_started_ = true;
+    }
 }
 void JobManager::handleNonBlockingJobs()
 {
@@ -220,6 +346,26 @@ void JobManager::handleNonBlockingJobs()
             break;
     }
 }
+void JobManager::handleWaitingJobs()
+{
+    std::shared_ptr<Job> job;
+
+    while (new_waiting_jobs_.try_pop(job))
+        waiting_jobs_.push_back(job);
+
+    for (auto job_it = waiting_jobs_.begin(); job_it != waiting_jobs_.end();)
+    {
+        if ((*job_it)->obsolete())  // flushed in order without being started
+            job_it = waiting_jobs_.erase(job_it);
+        else if ((*job_it)->dependenciesDone())
+        {
+            startJob(*job_it);
+            job_it = waiting_jobs_.erase(job_it);
+        }
+        else
+            ++job_it;
+    }
+}
 void JobManager::handleDBJobs()
 {
     if (active_db_job_)  // see if active one exists
@@ -244,6 +390,7 @@ void JobManager::handleDBJobs()
             }
 
             active_db_job_ = nullptr;
+            active_db_job_started_ = false;
         }
     }
 
@@ -251,12 +398,35 @@ void JobManager::handleDBJobs()
     {
         if (queued_db_jobs_.try_pop(active_db_job_))
         {
-            QThreadPool::globalInstance()->start(active_db_job_.get());
+            active_db_job_started_ = false;
 
             changed_ = true;
             really_update_widget_ = !hasDBJobs();
         }
     }
+
+    if (active_db_job_ && !active_db_job_started_ && !active_db_job_->obsolete() &&
+        active_db_job_->dependenciesDone())
+    {
+        startJob(active_db_job_);
+        active_db_job_started_ = true;
+    }
+}
+
+void JobManager::startJob(std::shared_ptr<Job> job)
+{
+    logdbg << "JobManager: startJob: " << job->name() << " priority " << job->priority();
+
+    QThreadPool::globalInstance()->start(new JobRunner(job), job->priority());
+}
+
+void JobManager::waitForNotification()
+{
+    std::unique_lock<std::mutex> lock(notify_mutex_);
+
+    notify_condition_.wait_for(lock, std::chrono::milliseconds(max_wait_ms),
+                               [this] { return notified_; });
+    notified_ = false;
 }
 
 void JobManager::shutdown()
@@ -264,6 +434,7 @@ void JobManager::shutdown()
     loginf << "JobManager: shutdown: setting jobs obsolete";
 
     stop_requested_ = true;
+    notifyJobChanged();
 
     if (active_db_job_)
         active_db_job_->setObsolete();
@@ -344,6 +515,179 @@ unsigned int JobManager::numDBJobs()
     return active_db_job_ ? queued_db_jobs_.unsafe_size() + 1 : queued_db_jobs_.unsafe_size();
 }
 
+tbb::task_arena& JobManager::arena(TaskArenaType type)
+{
+    std::lock_guard<std::mutex> lock(arena_mutex_);
+
+    if (!arenas_.size())
+        createArenas();
+
+    assert(arenas_.count(type));
+    return *arenas_.at(type);
+}
+
+unsigned int JobManager::maxThreads() const { return max_threads_; }
+
+void JobManager::maxThreads(unsigned int value)
+{
+    loginf << "JobManager: maxThreads: " << value;
+
+    std::lock_guard<std::mutex> lock(arena_mutex_);
+
+    if (arenas_.size())
+        logwrn << "JobManager: maxThreads: arenas already created, applied after restart";
+
+    max_threads_ = value;
+}
+
+unsigned int JobManager::importThreads() const { return import_threads_; }
+
+void JobManager::importThreads(unsigned int value)
+{
+    loginf << "JobManager: importThreads: " << value;
+
+    std::lock_guard<std::mutex> lock(arena_mutex_);
+
+    if (arenas_.size())
+        logwrn << "JobManager: importThreads: arenas already created, applied after restart";
+
+    import_threads_ = value;
+}
+
+unsigned int JobManager::associationThreads() const { return association_threads_; }
+
+void JobManager::associationThreads(unsigned int value)
+{
+    loginf << "JobManager: associationThreads: " << value;
+
+    std::lock_guard<std::mutex> lock(arena_mutex_);
+
+    if (arenas_.size())
+        logwrn << "JobManager: associationThreads: arenas already created, applied after restart";
+
+    association_threads_ = value;
+}
+
+unsigned int JobManager::evaluationThreads() const { return evaluation_threads_; }
+
+void JobManager::evaluationThreads(unsigned int value)
+{
+    loginf << "JobManager: evaluationThreads: " << value;
+
+    std::lock_guard<std::mutex> lock(arena_mutex_);
+
+    if (arenas_.size())
+        logwrn << "JobManager: evaluationThreads: arenas already created, applied after restart";
+
+    evaluation_threads_ = value;
+}
+
+bool JobManager::pinThreads() const { return pin_threads_; }
+
+void JobManager::pinThreads(bool value)
+{
+    loginf << "JobManager: pinThreads: " << value;
+
+    std::lock_guard<std::mutex> lock(arena_mutex_);
+
+    if (arenas_.size())
+        logwrn << "JobManager: pinThreads: arenas already created, applied after restart";
+
+    pin_threads_ = value;
+}
+
+void JobManager::overrideThreads(unsigned int max_threads, unsigned int import_threads,
+                                 unsigned int association_threads, unsigned int evaluation_threads,
+                                 bool pin_threads)
+{
+    loginf << "JobManager: overrideThreads: max " << max_threads << " import " << import_threads
+           << " association " << association_threads << " evaluation " << evaluation_threads
+           << " pinning " << pin_threads;
+
+    std::lock_guard<std::mutex> lock(arena_mutex_);
+
+    if (arenas_.size())
+        logwrn << "JobManager: overrideThreads: arenas already created, not applied";
+
+    max_threads_override_ = max_threads;
+    import_threads_override_ = import_threads;
+    association_threads_override_ = association_threads;
+    evaluation_threads_override_ = evaluation_threads;
+    pin_threads_override_ = pin_threads;
+}
+
+unsigned int JobManager::effectiveThreads(unsigned int threads, unsigned int threads_override) const
+{
+    unsigned int max_threads = std::max(std::thread::hardware_concurrency(), 1u);
+    unsigned int max_threads_cfg = max_threads_override_ ? max_threads_override_ : max_threads_;
+
+    if (max_threads_cfg && max_threads_cfg < max_threads)
+        max_threads = max_threads_cfg;
+
+    if (threads_override)
+        threads = threads_override;
+
+    if (threads && threads < max_threads)
+        return threads;
+
+    return max_threads;
+}
+
+void JobManager::createArenas()
+{
+    assert(!arenas_.size());
+
+    unsigned int max_threads = effectiveThreads(0, 0);
+    unsigned int import_threads = effectiveThreads(import_threads_, import_threads_override_);
+    unsigned int association_threads =
+        effectiveThreads(association_threads_, association_threads_override_);
+    unsigned int evaluation_threads =
+        effectiveThreads(evaluation_threads_, evaluation_threads_override_);
+    bool pin_threads = pin_threads_ || pin_threads_override_;
+
+    loginf << "JobManager: createArenas: max threads " << max_threads << " import "
+           << import_threads << " association " << association_threads << " evaluation "
+           << evaluation_threads << " pinning " << pin_threads;
+
+    // limits all arenas and implicit usage
+    global_control_.reset(
+        new tbb::global_control(tbb::global_control::max_allowed_parallelism, max_threads));
+
+    arenas_[TaskArenaType::IMPORT].reset(new tbb::task_arena(import_threads));
+    arenas_[TaskArenaType::ASSOCIATION].reset(new tbb::task_arena(association_threads));
+    arenas_[TaskArenaType::EVALUATION].reset(new tbb::task_arena(evaluation_threads));
+
+    if (pin_threads)
+    {
+        // consecutive slices of the allowed cores per arena, overlapping only if there are not enough
+        std::vector<int> cores = allowedCores();
+        std::vector<int> arena_cores;
+        std::string cores_str;
+        unsigned int offset = 0;
+
+        for (auto& arena_it : arenas_)
+        {
+            arena_it.second->initialize();
+
+            arena_cores.clear();
+            cores_str.clear();
+
+            for (int cnt = 0; cnt < arena_it.second->max_concurrency(); ++cnt)
+            {
+                arena_cores.push_back(cores.at((offset + cnt) % cores.size()));
+                cores_str += (cnt ? "," : "") + std::to_string(arena_cores.back());
+            }
+
+            offset += arena_cores.size();
+
+            loginf << "JobManager: createArenas: pinning arena " << (int)arena_it.first
+                   << " to cores " << cores_str;
+
+            arena_observers_.emplace_back(new ArenaPinningObserver(*arena_it.second, arena_cores));
+        }
+    }
+}
+
 unsigned int JobManager::numJobs() { return numBlockingJobs() + numNonBlockingJobs(); }
 
 int JobManager::numThreads() { return QThreadPool::globalInstance()->activeThreadCount(); }
@@ -357,7 +701,8 @@ void JobManager::updateWidget(bool really)
 
         if (diff.total_milliseconds() > 500 || really)
         {
-            widget_->updateSlot();
+            // may be called from manager thread, so update in widget's thread
+            QMetaObject::invokeMethod(widget_, "updateSlot", Qt::QueuedConnection);
             last_update_time_ = current_time;
         }
     }
@@ -23,11 +23,18 @@
 #endif
 
 #include <tbb/concurrent_queue.h>
+#include <tbb/global_control.h>
+#include <tbb/task_arena.h>
+#include <tbb/task_scheduler_observer.h>
 
 #include <QMutex>
 #include <QThread>
+#include <condition_variable>
 #include <list>
+#include <map>
 #include <memory>
+#include <mutex>
+#include <vector>
 
 #include "configurable.h"
 #include "singleton.h"
@@ -37,13 +44,27 @@ class WorkerThread;
 class Job;
 class JobManagerWidget;
 
+/// @brief Subsystems with isolated TBB task arenas
+enum class TaskArenaType
+{
+    IMPORT = 0,
+    ASSOCIATION,
+    EVALUATION
+};
+
 /**
- * @brief Manages execution of TransformationJobs
+ * @brief Manages execution of Jobs
  *
- * Allows addition of TransformationJobs, which are held in a list and assigned to any active
- * TransformationWorkers. A number of such TransformationWorkers are generated and managed. Using a
- * timer event, jobs are checked if earlier jobs are done and flushed in the order of addition. Jobs
- * may be done, but can be blocked by unfinished jobs which were added earlier.
+ * Allows addition of Jobs, which are held in queues and started in the global thread pool. The
+ * manager thread sleeps until notified that a job was added, finished or set obsolete, then checks
+ * if earlier jobs are done and flushes them in the order of addition. Jobs may be done, but can be
+ * blocked by unfinished jobs which were added earlier. Jobs with unfinished dependencies are only
+ * started once all their dependencies are done or obsolete.
+ *
+ * Also holds the TBB task arenas of the subsystems, so that e.g. a running evaluation can not
+ * starve an import. The arenas are created on first use with the configured thread counts, limited
+ * by the global maximum number of threads, and optionally pin their worker threads to
+ * separate slices of the cores the process may run on.
  *
  */
 class JobManager : public QThread, public Singleton, public Configurable
@@ -66,6 +87,9 @@ class JobManager : public QThread, public Singleton, public Configurable
     void addDBJob(std::shared_ptr<Job> job);
     void cancelJob(std::shared_ptr<Job> job);
 
+    /// @brief Wakes up manager thread, called if jobs were added, finished or set obsolete
+    void notifyJobChanged();
+
     bool hasAnyJobs();
     bool hasBlockingJobs();
     bool hasNonBlockingJobs();
@@ -87,6 +111,29 @@ class JobManager : public QThread, public Singleton, public Configurable
 
     JobManagerWidget* widget();
 
+    /// @brief Returns task arena of subsystem, created on first use
+    tbb::task_arena& arena(TaskArenaType type);
+
+    /// @brief Maximum number of TBB threads, 0 for all cores
+    unsigned int maxThreads() const;
+    void maxThreads(unsigned int value);
+    /// @brief Subsystem thread counts, 0 for maximum
+    unsigned int importThreads() const;
+    void importThreads(unsigned int value);
+    unsigned int associationThreads() const;
+    void associationThreads(unsigned int value);
+    unsigned int evaluationThreads() const;
+    void evaluationThreads(unsigned int value);
+    /// @brief Pins TBB worker threads to cores within maximum
+    bool pinThreads() const;
+    void pinThreads(bool value);
+
+    /// @brief Overrides thread settings for this run only (e.g. from command line), not persisted.
+    /// 0 or false keep the configured value. Applied when the arenas are created.
+    void overrideThreads(unsigned int max_threads, unsigned int import_threads,
+                         unsigned int association_threads, unsigned int evaluation_threads,
+                         bool pin_threads);
+
   protected:
     /// Flag indicating if thread should stop.
     volatile bool stop_requested_;
@@ -95,30 +142,68 @@ class JobManager : public QThread, public Singleton, public Configurable
     bool changed_{false};
     bool really_update_widget_{false};
 
+    std::mutex notify_mutex_;
+    std::condition_variable notify_condition_;
+    bool notified_{false};
+
     std::shared_ptr<Job> active_blocking_job_;
+    bool active_blocking_job_started_{false};
     tbb::concurrent_queue<std::shared_ptr<Job>> blocking_jobs_;
 
     std::shared_ptr<Job> active_non_blocking_job_;
     tbb::concurrent_queue<std::shared_ptr<Job>> non_blocking_jobs_;
+    // non-blocking jobs with unfinished dependencies, added to waiting list by manager thread
+    tbb::concurrent_queue<std::shared_ptr<Job>> new_waiting_jobs_;
+    std::list<std::shared_ptr<Job>> waiting_jobs_;
 
     std::shared_ptr<Job> active_db_job_;
+    bool active_db_job_started_{false};
     tbb::concurrent_queue<std::shared_ptr<Job>> queued_db_jobs_;
 
     JobManagerWidget* widget_;
 
     boost::posix_time::ptime last_update_time_;
 
+    unsigned int max_threads_{0};
+    unsigned int import_threads_{0};
+    unsigned int association_threads_{0};
+    unsigned int evaluation_threads_{0};
+    bool pin_threads_{false};
+
+    // not persisted, 0 or false for configured value
+    unsigned int max_threads_override_{0};
+    unsigned int import_threads_override_{0};
+    unsigned int association_threads_override_{0};
+    unsigned int evaluation_threads_override_{0};
+    bool pin_threads_override_{false};
+
+    std::mutex arena_mutex_;  // guards arenas and thread settings, arenas immutable once created
+    std::unique_ptr<tbb::global_control> global_control_;
+    std::map<TaskArenaType, std::unique_ptr<tbb::task_arena>> arenas_;
+    // destroyed before arenas
+    std::vector<std::unique_ptr<tbb::task_scheduler_observer>> arena_observers_;
+
     /// @brief Constructor
     JobManager();
 
     void updateWidget(bool really = false);
 
+    // returns effective number of threads, override if set, limited by maximum
+    unsigned int effectiveThreads(unsigned int threads, unsigned int threads_override) const;
+    void createArenas();  // arena_mutex_ has to be locked
+
+    // starts job in thread pool using its priority, notifies when run returns
+    void startJob(std::shared_ptr<Job> job);
+    // waits until notified or timeout
+    void waitForNotification();
+
   private:
     void run();
 
     // set change flags as appropriate
     void handleBlockingJobs();
     void handleNonBlockingJobs();
+    void handleWaitingJobs();
     void handleDBJobs();
 };
 
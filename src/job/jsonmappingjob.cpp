@@ -123,8 +123,11 @@ void JSONMappingJob::run()
 
     assert(data_);
     logdbg << "JSONMappingJob: run: applying JSON function";
-    JSON::applyFunctionToValues(*data_.get(), data_record_keys_, data_record_keys_.begin(),
-                                process_lambda, false);
+    {
+        TraceSpan span("mapping", "mapRecords");
+        JSON::applyFunctionToValues(*data_.get(), data_record_keys_, data_record_keys_.begin(),
+                                    process_lambda, false);
+    }
 
     std::map<std::string, std::shared_ptr<Buffer>> not_empty_buffers;
 
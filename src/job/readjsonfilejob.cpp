@@ -20,7 +20,6 @@
 #include <archive.h>
 #include <archive_entry.h>
 
-#include <QThread>
 #include <regex>
 
 #include "logger.h"
@@ -28,8 +27,12 @@
 
 using namespace Utils;
 
-ReadJSONFileJob::ReadJSONFileJob(const std::string& file_name, unsigned int num_objects)
-    : Job("ReadJSONFileJob"), file_name_(file_name), num_objects_(num_objects)
+ReadJSONFileJob::ReadJSONFileJob(const std::string& file_name, unsigned int num_objects,
+                                 BoundedChannel<std::vector<std::string>>& objects_channel)
+    : Job("ReadJSONFileJob"),
+      file_name_(file_name),
+      num_objects_(num_objects),
+      objects_channel_(objects_channel)
 {
     archive_ = String::hasEnding(file_name_, ".zip") || String::hasEnding(file_name_, ".gz") ||
                String::hasEnding(file_name_, ".tgz") || String::hasEnding(file_name_, ".tar");
@@ -62,18 +65,27 @@ void ReadJSONFileJob::run()
 
     while (!file_read_done_)  //&& objects_.size() < num_objects_
     {
-        while (pause_)
-            QThread::msleep(1);
-
         bytes_read_tmp_ = 0;
         readFilePart();
 
         if(objects_.size())
         {
-            emit readJSONFilePartSignal();
+            // blocks while all credits are in use downstream, objects only moved if pushed
+            while (!objects_channel_.push(std::move(objects_), 100))
+            {
+                if (obsolete_ || objects_channel_.closed())
+                {
+                    loginf << "ReadJSONFileJob: run: discarding read objects";
 
-            while (objects_.size())
-                QThread::msleep(1);
+                    objects_.clear();
+                    done_ = true;
+                    return;
+                }
+            }
+
+            objects_.clear();
+
+            emit readJSONFilePartSignal();
         }
     }
 
@@ -305,10 +317,6 @@ void ReadJSONFileJob::readFilePart()
     loginf << "ReadJSONFileJob: readFilePart: done";
 }
 
-void ReadJSONFileJob::pause() { pause_ = true; }
-
-void ReadJSONFileJob::unpause() { pause_ = false; }
-
 // void ReadJSONFileJob::resetDone ()
 //{
 //    assert (!file_read_done_);
@@ -322,8 +330,6 @@ void ReadJSONFileJob::unpause() { pause_ = false; }
 //    return file_read_done_;
 //}
 
-std::vector<std::string> ReadJSONFileJob::objects() { return std::move(objects_); }
-
 size_t ReadJSONFileJob::bytesRead() const { return bytes_read_; }
 
 size_t ReadJSONFileJob::bytesToRead() const { return bytes_to_read_; }
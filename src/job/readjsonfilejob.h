@@ -23,6 +23,7 @@
 #include <string>
 #include <vector>
 
+#include "boundedchannel.h"
 #include "job.h"
 
 class ReadJSONFileJob : public Job
@@ -32,16 +33,12 @@ class ReadJSONFileJob : public Job
     void readJSONFilePartSignal();
 
   public:
-    ReadJSONFileJob(const std::string& file_name, unsigned int num_objects);
+    ReadJSONFileJob(const std::string& file_name, unsigned int num_objects,
+                    BoundedChannel<std::vector<std::string>>& objects_channel);
     virtual ~ReadJSONFileJob();
 
     virtual void run();
 
-    void pause();
-    void unpause();
-
-    std::vector<std::string> objects();  // for moving out
-
     size_t bytesRead() const;
     size_t bytesToRead() const;
 
@@ -69,8 +66,8 @@ class ReadJSONFileJob : public Job
     size_t bytes_read_{0};
     size_t bytes_read_tmp_{0};
     std::vector<std::string> objects_;
-
-    volatile bool pause_{false};
+    // read objects are pushed into, blocks while downstream is full
+    BoundedChannel<std::vector<std::string>>& objects_channel_;
 
     void performInit();
     void readFilePart();
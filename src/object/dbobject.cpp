@@ -49,6 +49,8 @@
 
 using namespace Utils;
 
+const unsigned int read_chunks_in_flight = 4;  // read buffers not yet finalized
+
 /**
  * Registers parameters, creates sub configurables
  */
@@ -798,6 +800,8 @@ void DBObject::load(DBOVariableSet& read_set, std::string custom_filter_clause,
         JobManager::instance().cancelJob(job_it);
     finalize_jobs_.clear();
 
+    read_credits_generation_ = read_credits_.reset(read_chunks_in_flight);
+
     clearData();
 
     //    DBInterface &db_interface, DBObject &dbobject, DBOVariableSet read_list, std::string
@@ -832,6 +836,8 @@ void DBObject::clearData()
 {
     logdbg << "DBObject " << name_ << ": clearData";
 
+    memory_size_ = 0;
+
     if (data_)
     {
         data_ = nullptr;
@@ -1060,6 +1066,10 @@ void DBObject::finalizeReadJobDoneSlot()
     }
     assert(found);
 
+    read_credits_.release(read_credits_generation_);  // read job can continue
+
+    memory_size_ += buffer->memorySize();  // only the chunk is counted, not the whole data
+
     if (!data_)
         data_ = buffer;
     else
@@ -1068,6 +1078,16 @@ void DBObject::finalizeReadJobDoneSlot()
     logdbg << "DBObject: " << name_ << " finalizeReadJobDoneSlot: got buffer with size "
            << data_->size();
 
+    if (!isLoading())  // recount once, chunks do not include capacity growth of the columns
+        memory_size_ = data_->memorySize();
+
+    if (!manager_.checkMemoryBudget())
+    {
+        logwrn << "DBObject: " << name_
+               << " finalizeReadJobDoneSlot: memory budget exceeded, stopping loading";
+        manager_.quitLoading();
+    }
+
     if (info_widget_)
         info_widget_->updateSlot();
 
@@ -1159,6 +1179,14 @@ size_t DBObject::loadedCount()
         return 0;
 }
 
+size_t DBObject::spilledSize()
+{
+    if (data_)
+        return data_->spilledSize();
+    else
+        return 0;
+}
+
 bool DBObject::existsInDB() const
 {
     if (!hasCurrentMetaTable())
@@ -1302,16 +1330,19 @@ void DBObject::clearAssociations()
     associations_loaded_ = false;
 }
 
-void DBObject::saveAssociations()
+void DBObject::saveAssociations(bool append)
 {
-    loginf << "DBObject " << name_ << ": saveAssociations";
+    loginf << "DBObject " << name_ << ": saveAssociations: append " << append;
 
     DBInterface& db_interface = COMPASS::instance().interface();
 
     assert(associations_table_name_.size());
 
     if (db_interface.existsTable(associations_table_name_))
-        db_interface.clearTableContent(associations_table_name_);
+    {
+        if (!append)
+            db_interface.clearTableContent(associations_table_name_);
+    }
     else
         db_interface.createAssociationsTable(associations_table_name_);
 
@@ -24,6 +24,7 @@
 #include <string>
 
 #include "configurable.h"
+#include "creditgate.h"
 #include "dboassociationcollection.h"
 #include "dbodatasource.h"
 #include "dbodatasourcedefinition.h"
@@ -175,12 +176,20 @@ class DBObject : public QObject, public Configurable
 
     /// @brief Returns if incremental read for DBO type was prepared
     bool isLoading();
+    /// @brief Returns credits for read buffers, acquired by read job and released when finalized
+    CreditGate& readCredits() { return read_credits_; }
     bool isPostProcessing();
     /// @brief Returns if DBO exists and has data in the database
     bool hasData();
     /// @brief Returns number of elements for DBO type
     size_t count();
     size_t loadedCount();
+    /// @brief Returns number of bytes of loaded data held in memory, tracked per chunk
+    size_t memorySize() { return memory_size_; }
+    /// @brief Sets number of bytes held in memory, after a recount by the memory budget check
+    void memorySize(size_t size) { memory_size_ = size; }
+    /// @brief Returns number of bytes of loaded data swapped out to spill files
+    size_t spilledSize();
 
     /// @brief Returns container with all meta tables
     const std::map<std::string, DBOSchemaMetaTableDefinition>& metaTables() const
@@ -263,7 +272,7 @@ class DBObject : public QObject, public Configurable
     void addAssociation(unsigned int rec_num, unsigned int utn, bool has_src, unsigned int src_rec_num);
     const DBOAssociationCollection& associations() { return associations_; }
     void clearAssociations();
-    void saveAssociations();
+    void saveAssociations(bool append=false); // if append, existing ones in database are kept
 
     void updateToDatabaseContent();
 
@@ -285,11 +294,15 @@ protected:
     std::shared_ptr<DBOReadDBJob> read_job_{nullptr};
     std::vector<std::shared_ptr<Buffer>> read_job_data_;
     std::vector<std::shared_ptr<FinalizeDBOReadJob>> finalize_jobs_;
+    CreditGate read_credits_{1};  // capacity set in load
+    unsigned int read_credits_generation_{0};  // of current load, finalize jobs of it release credits
 
     std::shared_ptr<InsertBufferDBJob> insert_job_{nullptr};
     std::shared_ptr<UpdateBufferDBJob> update_job_{nullptr};
 
     std::shared_ptr<Buffer> data_;
+    /// Bytes held by data_, added per chunk and recounted when loading is done
+    size_t memory_size_{0};
 
     /// Container with all DBOSchemaMetaTableDefinitions
     std::map<std::string, DBOSchemaMetaTableDefinition> meta_table_definitions_;
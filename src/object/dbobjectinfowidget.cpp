@@ -27,10 +27,14 @@
 #include <QTextEdit>
 #include <QVBoxLayout>
 
+#include "buffer.h"
 #include "dbobject.h"
 #include "dbovariable.h"
 #include "global.h"
 #include "logger.h"
+#include "stringconv.h"
+
+using namespace Utils::String;
 
 DBObjectInfoWidget::DBObjectInfoWidget(DBObject& object, QWidget* parent, Qt::WindowFlags f)
     : QWidget(parent, f), object_(object)
@@ -93,6 +97,12 @@ void DBObjectInfoWidget::updateSlot()
         loaded_count_label_->setAlignment(Qt::AlignRight);
         main_layout_->addWidget(loaded_count_label_, 1, 1);
 
+        main_layout_->addWidget(new QLabel("Memory"), 2, 0);
+
+        memory_label_ = new QLabel("?");
+        memory_label_->setAlignment(Qt::AlignRight);
+        main_layout_->addWidget(memory_label_, 2, 1);
+
         object_.loadingWanted(true);
     }
 
@@ -108,4 +118,35 @@ void DBObjectInfoWidget::updateSlot()
 
     loaded_count_label_->setText(QString::number(object_.loadedCount()) + " / " +
                                  QString::number(object_.count()));
+
+    assert(memory_label_);
+
+    std::string memory_str = doubleToStringPrecision(object_.memorySize() * 1e-6, 2) + " MB";
+    size_t spilled_size = object_.spilledSize();
+
+    if (spilled_size)
+        memory_str += " (" + doubleToStringPrecision(spilled_size * 1e-6, 2) + " MB spilled)";
+
+    memory_label_->setText(memory_str.c_str());
+
+    std::string tooltip;
+
+    if (object_.data())
+    {
+        for (auto& col_it : object_.data()->columnMemorySizes())
+        {
+            if (tooltip.size())
+                tooltip += "\n";
+
+            tooltip += col_it.first + ": ";
+
+            if (std::get<1>(col_it.second))
+                tooltip += doubleToStringPrecision(std::get<1>(col_it.second) * 1e-6, 2) +
+                           " MB spilled";
+            else
+                tooltip += doubleToStringPrecision(std::get<0>(col_it.second) * 1e-6, 2) + " MB";
+        }
+    }
+
+    memory_label_->setToolTip(tooltip.c_str());
 }
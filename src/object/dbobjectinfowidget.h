@@ -56,6 +56,7 @@ class DBObjectInfoWidget : public QWidget
 
     QLabel* status_label_{nullptr};
     QLabel* loaded_count_label_{nullptr};
+    QLabel* memory_label_{nullptr};
 };
 
 #endif /* DBOBJECTINFOWIDGET_H_ */
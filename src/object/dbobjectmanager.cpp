@@ -19,6 +19,7 @@
 
 #include "compass.h"
 #include "configurationmanager.h"
+#include "buffer.h"
 #include "dbinterface.h"
 #include "dbobject.h"
 #include "dbobjectmanagerloadwidget.h"
@@ -38,6 +39,9 @@
 
 using namespace Utils::String;
 
+const size_t min_spill_size = 1e6;  // bytes, smaller columns are not worth a spill file
+const double spill_target_ratio = 0.8;  // of budget, spilled down to when exceeded
+
 /**
  * Creates sub-configurables.
  */
@@ -56,6 +60,10 @@ DBObjectManager::DBObjectManager(const std::string& class_id, const std::string&
     registerParameter("limit_min", &limit_min_, 0);
     registerParameter("limit_max", &limit_max_, 100000);
 
+    registerParameter("use_memory_budget", &use_memory_budget_, false);
+    registerParameter("memory_budget_mb", &memory_budget_mb_, 8000);
+    registerParameter("spill_directory", &spill_directory_, "/tmp");
+
     createSubConfigurables();
 
     // lock();
@@ -241,6 +249,157 @@ void DBObjectManager::limitMax(unsigned int limit_max)
     loginf << "DBObjectManager: limitMax: " << limit_max_;
 }
 
+bool DBObjectManager::useMemoryBudget() const { return use_memory_budget_; }
+
+void DBObjectManager::useMemoryBudget(bool value)
+{
+    loginf << "DBObjectManager: useMemoryBudget: " << value;
+    use_memory_budget_ = value;
+}
+
+unsigned int DBObjectManager::memoryBudgetMB() const { return memory_budget_mb_; }
+
+void DBObjectManager::memoryBudgetMB(unsigned int value)
+{
+    loginf << "DBObjectManager: memoryBudgetMB: " << value;
+    memory_budget_mb_ = value;
+}
+
+const std::string& DBObjectManager::spillDirectory() const { return spill_directory_; }
+
+size_t DBObjectManager::memorySize()
+{
+    size_t size = 0;
+
+    for (auto& object_it : objects_)
+        size += object_it.second->memorySize();
+
+    return size;
+}
+
+size_t DBObjectManager::spilledSize()
+{
+    size_t size = 0;
+
+    for (auto& object_it : objects_)
+        size += object_it.second->spilledSize();
+
+    return size;
+}
+
+bool DBObjectManager::checkMemoryBudget()
+{
+    if (!use_memory_budget_)
+        return true;
+
+    size_t budget = static_cast<size_t>(memory_budget_mb_) * 1e6;
+    size_t used = memorySize();  // tracked per object, no iteration over the data
+
+    if (used <= budget)
+        return true;
+
+    // columns of objects still being loaded are not spilled, since the next chunk pages them back in
+    size_t loading_size = 0;
+
+    for (auto& object_it : objects_)
+        if (object_it.second->isLoading())
+            loading_size += object_it.second->memorySize();
+
+    if (loading_size > budget)  // spilling other objects can not help
+    {
+        logwrn << "DBObjectManager: checkMemoryBudget: loading data of " << loading_size
+               << " bytes exceeds budget of " << memory_budget_mb_ << " MB";
+        memory_budget_exceeded_ = true;
+
+        if (load_widget_)
+            load_widget_->updateSlot();
+
+        return false;
+    }
+
+    // spill below the budget, so that not every following chunk triggers another spill
+    size_t target = budget * spill_target_ratio;
+
+    loginf << "DBObjectManager: checkMemoryBudget: " << used << " bytes used, budget " << budget
+           << ", spilling columns";
+
+    // pinned buffers are read by jobs holding references, spilling them would free data in use
+    std::multimap<unsigned long, std::tuple<DBObject*, Buffer*, std::string, size_t>>
+        columns;  // last access
+    std::shared_ptr<Buffer> buffer;
+    size_t object_size;
+
+    used = loading_size;
+
+    for (auto& object_it : objects_)
+    {
+        buffer = object_it.second->data();
+
+        if (!buffer || object_it.second->isLoading())
+            continue;
+
+        // recount, accessed columns may have been paged back in
+        std::map<std::string, std::tuple<size_t, size_t, unsigned long>> sizes =
+            buffer->columnMemorySizes();
+
+        object_size = 0;
+
+        for (auto& col_it : sizes)
+            object_size += std::get<0>(col_it.second);
+
+        object_it.second->memorySize(object_size);
+        used += object_size;
+
+        if (buffer->pinned())
+            continue;
+
+        for (auto& col_it : sizes)
+        {
+            if (std::get<0>(col_it.second) < min_spill_size)
+                continue;
+
+            columns.emplace(std::get<2>(col_it.second),
+                            std::make_tuple(object_it.second, buffer.get(), col_it.first,
+                                            std::get<0>(col_it.second)));
+        }
+    }
+
+    for (auto& col_it : columns)  // least recently used first
+    {
+        if (used <= target)
+            break;
+
+        DBObject* object = std::get<0>(col_it.second);
+        size_t size = std::get<3>(col_it.second);
+
+        try
+        {
+            std::get<1>(col_it.second)->spill(std::get<2>(col_it.second), spill_directory_);
+            used -= size;
+            object->memorySize(object->memorySize() - size);
+        }
+        catch (std::exception& e)
+        {
+            logerr << "DBObjectManager: checkMemoryBudget: spilling failed: " << e.what();
+            break;
+        }
+    }
+
+    if (used > budget)
+    {
+        logwrn << "DBObjectManager: checkMemoryBudget: budget of " << memory_budget_mb_
+               << " MB exceeded after spilling";
+        memory_budget_exceeded_ = true;
+    }
+
+    if (load_widget_)
+        load_widget_->updateSlot();
+
+    return used <= budget;
+}
+
+bool DBObjectManager::memoryBudgetExceeded() const { return memory_budget_exceeded_; }
+
 bool DBObjectManager::useOrder() const { return use_order_; }
 
 void DBObjectManager::useOrder(bool use_order) { use_order_ = use_order; }
@@ -337,6 +496,7 @@ void DBObjectManager::loadSlot()
     logdbg << "DBObjectManager: loadSlot";
 
     load_in_progress_ = true;
+    memory_budget_exceeded_ = false;
 
     bool load_job_created = false;
 
@@ -472,6 +632,12 @@ void DBObjectManager::databaseContentChangedSlot()
         associations_ds_ = "";
     }
 
+    if (COMPASS::instance().interface().hasProperty("associations_generation"))
+        associations_generation_ =
+            std::stoul(COMPASS::instance().interface().getProperty("associations_generation"));
+    else
+        associations_generation_ = 0;
+
     for (auto& object : objects_)
         object.second->updateToDatabaseContent();
 
@@ -515,7 +681,10 @@ void DBObjectManager::finishLoading()
     emit allLoadingDoneSignal();
 
     if (load_widget_)
+    {
         load_widget_->loadingDone();
+        load_widget_->updateSlot();
+    }
 
     QApplication::restoreOverrideCursor();
 }
@@ -574,6 +743,8 @@ bool DBObjectManager::hasAssociations() const { return has_associations_; }
 
 void DBObjectManager::setAssociationsDataSource(const std::string& dbo, const std::string& data_source_name)
 {
+    associationsChanged();
+
     COMPASS::instance().interface().setProperty("associations_generated", "1");
     COMPASS::instance().interface().setProperty("associations_dbo", dbo);
     COMPASS::instance().interface().setProperty("associations_ds", data_source_name);
@@ -589,6 +760,8 @@ void DBObjectManager::setAssociationsDataSource(const std::string& dbo, const st
 
 void DBObjectManager::setAssociationsByAll()
 {
+    associationsChanged();
+
     COMPASS::instance().interface().setProperty("associations_generated", "1");
     COMPASS::instance().interface().setProperty("associations_dbo", "");
     COMPASS::instance().interface().setProperty("associations_ds", "");
@@ -603,6 +776,8 @@ void DBObjectManager::setAssociationsByAll()
 
 void DBObjectManager::removeAssociations()
 {
+    associationsChanged();
+
     COMPASS::instance().interface().setProperty("associations_generated", "0");
     COMPASS::instance().interface().setProperty("associations_dbo", "");
     COMPASS::instance().interface().setProperty("associations_ds", "");
@@ -627,6 +802,19 @@ std::string DBObjectManager::associationsDBObject() const { return associations_
 
 std::string DBObjectManager::associationsDataSourceName() const { return associations_ds_; }
 
+unsigned int DBObjectManager::associationsGeneration() const { return associations_generation_; }
+
+void DBObjectManager::associationsChanged()
+{
+    DBInterface& db_interface = COMPASS::instance().interface();
+
+    ++associations_generation_;
+    db_interface.setProperty("associations_generation", std::to_string(associations_generation_));
+
+    // cached evaluation results are per utn of the previous associations
+    db_interface.deleteAllEvaluationResults();
+}
+
 bool DBObjectManager::isOtherDBObjectPostProcessing(DBObject& object)
 {
     for (auto& dbo_it : objects_)
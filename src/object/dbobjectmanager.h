@@ -130,12 +130,32 @@ class DBObjectManager : public QObject, public Configurable
     bool hasAssociationsDataSource() const;
     std::string associationsDBObject() const;
     std::string associationsDataSourceName() const;
+    // increased whenever associations are saved or removed, changes utns of the same data
+    unsigned int associationsGeneration() const;
 
     bool isOtherDBObjectPostProcessing(DBObject& object);
 
     bool loadInProgress() const;
 
+    bool useMemoryBudget() const;
+    void useMemoryBudget(bool value);
+
+    unsigned int memoryBudgetMB() const;
+    void memoryBudgetMB(unsigned int value);
+
+    const std::string& spillDirectory() const;
+
+    /// @brief Returns number of bytes of loaded data held in memory by all DBObjects
+    size_t memorySize();
+    /// @brief Returns number of bytes of loaded data swapped out to spill files by all DBObjects
+    size_t spilledSize();
+    /// @brief Spills least recently used columns if over budget, returns false if still over budget
+    bool checkMemoryBudget();
+    bool memoryBudgetExceeded() const;
+
   protected:
+    void associationsChanged();
+
     COMPASS& compass_;
 
     bool use_order_{false};
@@ -152,9 +172,15 @@ class DBObjectManager : public QObject, public Configurable
     bool has_associations_{false};
     std::string associations_dbo_;
     std::string associations_ds_;
+    unsigned int associations_generation_ {0};
 
     bool load_in_progress_{false};
 
+    bool use_memory_budget_{false};
+    unsigned int memory_budget_mb_{8000};
+    std::string spill_directory_;
+    bool memory_budget_exceeded_{false};
+
     /// Container with all DBOs (DBO name -> DBO pointer)
     std::map<std::string, DBObject*> objects_;
     std::map<std::string, MetaDBOVariable*> meta_variables_;
@@ -67,6 +67,14 @@ DBObjectManagerLoadWidget::DBObjectManagerLoadWidget(DBObjectManager& object_man
     associations_label_->setAlignment(Qt::AlignRight);
     assoc_layout->addWidget(associations_label_, 0, 1);
 
+    QLabel* memory_label = new QLabel("Memory");
+    memory_label->setFont(font_bold);
+    assoc_layout->addWidget(memory_label, 1, 0);
+
+    memory_label_ = new QLabel();
+    memory_label_->setAlignment(Qt::AlignRight);
+    assoc_layout->addWidget(memory_label_, 1, 1);
+
     main_layout->addLayout(assoc_layout);
 
     updateSlot();
@@ -148,6 +156,23 @@ DBObjectManagerLoadWidget::DBObjectManagerLoadWidget(DBObjectManager& object_man
 
     main_layout->addWidget(limit_widget_);
 
+    // memory budget
+    QGridLayout* memory_layout = new QGridLayout();
+
+    memory_budget_check_ = new QCheckBox("Use Memory Budget [MB]");
+    memory_budget_check_->setChecked(object_manager_.useMemoryBudget());
+    connect(memory_budget_check_, &QCheckBox::clicked, this,
+            &DBObjectManagerLoadWidget::toggleUseMemoryBudget);
+    memory_layout->addWidget(memory_budget_check_, 0, 0);
+
+    memory_budget_edit_ = new QLineEdit();
+    memory_budget_edit_->setText(std::to_string(object_manager_.memoryBudgetMB()).c_str());
+    memory_budget_edit_->setEnabled(object_manager_.useMemoryBudget());
+    connect(memory_budget_edit_, SIGNAL(textChanged(QString)), this, SLOT(memoryBudgetChanged()));
+    memory_layout->addWidget(memory_budget_edit_, 0, 1);
+
+    main_layout->addLayout(memory_layout);
+
     // load
     load_button_ = new QPushButton("Load");
     connect(load_button_, &QPushButton::clicked, this, &DBObjectManagerLoadWidget::loadButtonSlot);
@@ -225,6 +250,32 @@ void DBObjectManagerLoadWidget::limitMaxChanged()
     object_manager_.limitMax(max);
 }
 
+void DBObjectManagerLoadWidget::toggleUseMemoryBudget()
+{
+    assert(memory_budget_check_);
+    assert(memory_budget_edit_);
+
+    bool checked = memory_budget_check_->checkState() == Qt::Checked;
+    logdbg << "DBObjectManagerLoadWidget: toggleUseMemoryBudget: setting use budget to " << checked;
+    object_manager_.useMemoryBudget(checked);
+
+    memory_budget_edit_->setEnabled(checked);
+}
+
+void DBObjectManagerLoadWidget::memoryBudgetChanged()
+{
+    assert(memory_budget_edit_);
+
+    if (memory_budget_edit_->text().size() == 0)
+        return;
+
+    bool ok;
+    unsigned int budget = memory_budget_edit_->text().toUInt(&ok);
+
+    if (ok)
+        object_manager_.memoryBudgetMB(budget);
+}
+
 void DBObjectManagerLoadWidget::loadButtonSlot()
 {
     loginf << "DBObjectManagerLoadWidget: loadButtonSlot";
@@ -288,4 +339,18 @@ void DBObjectManagerLoadWidget::updateSlot()
     }
     else
         associations_label_->setText("None");
+
+    assert(memory_label_);
+
+    std::string memory_str =
+        doubleToStringPrecision(object_manager_.memorySize() * 1e-6, 2) + " MB";
+    size_t spilled_size = object_manager_.spilledSize();
+
+    if (spilled_size)
+        memory_str += " (" + doubleToStringPrecision(spilled_size * 1e-6, 2) + " MB spilled)";
+
+    if (object_manager_.memoryBudgetExceeded())
+        memory_str += ", budget exceeded";
+
+    memory_label_->setText(memory_str.c_str());
 }
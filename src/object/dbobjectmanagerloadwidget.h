@@ -53,6 +53,9 @@ class DBObjectManagerLoadWidget : public QFrame
     /// @brief Called when limit maximum is changed
     void limitMaxChanged();
 
+    void toggleUseMemoryBudget();
+    void memoryBudgetChanged();
+
     void loadButtonSlot();
     void updateSlot();
 
@@ -69,6 +72,7 @@ class DBObjectManagerLoadWidget : public QFrame
     QVBoxLayout* info_layout_{nullptr};
 
     QLabel* associations_label_{nullptr};
+    QLabel* memory_label_{nullptr};
 
     //QCheckBox* order_check_{nullptr};
     //QCheckBox* order_ascending_check_{nullptr};
@@ -82,6 +86,10 @@ class DBObjectManagerLoadWidget : public QFrame
     /// Limit maximum edit field
     QLineEdit* limit_max_edit_{nullptr};
 
+    QCheckBox* memory_budget_check_{nullptr};
+    /// Memory budget edit field in MB
+    QLineEdit* memory_budget_edit_{nullptr};
+
     QPushButton* load_button_{nullptr};
 
     bool loading_{false};
@@ -3,6 +3,8 @@
 
 #include <ogr_spatialref.h>
 
+#include <cassert>
+
 bool Transformation::in_appimage_ {getenv("APPDIR") != nullptr};
 const double Transformation::max_wgs_dist_ {0.5};
 
@@ -143,6 +145,52 @@ std::tuple<bool, double, double> Transformation::wgsAddCartOffset (
     return ret;
 }
 
+bool Transformation::wgsAddCartOffsets (double lat1, double long1, std::vector<double>& x_pos2,
+                                        std::vector<double>& y_pos2)
+{
+    assert (x_pos2.size() == y_pos2.size());
+
+    logdbg << "Transformation: wgsAddCartOffsets: lat1 " << lat1 << " long1 " << long1
+           << " num " << x_pos2.size();
+
+    if (!x_pos2.size())
+        return true;
+
+    updateIfRequired(lat1, long1);
+
+    // calc pos 1 cart
+    double x_pos1, y_pos1;
+
+    if (in_appimage_) // inside appimage
+    {
+        x_pos1 = long1;
+        y_pos1 = lat1;
+    }
+    else
+    {
+        x_pos1 = lat1;
+        y_pos1 = long1;
+    }
+
+    if (!ogr_geo2cart_->Transform(1, &x_pos1, &y_pos1)) // wgs84 to cartesian offsets
+        return false;
+
+    // add origin offset
+    for (size_t cnt=0; cnt < x_pos2.size(); ++cnt)
+    {
+        x_pos2[cnt] += x_pos1;
+        y_pos2[cnt] += y_pos1;
+    }
+
+    if (!ogr_cart2geo_->Transform(x_pos2.size(), x_pos2.data(), y_pos2.data()))
+        return false;
+
+    if (in_appimage_) // inside appimage, long, lat
+        x_pos2.swap(y_pos2);
+
+    return true;
+}
+
 void Transformation::updateIfRequired(double lat1, double long1)
 {
     if (!has_pos1_ || sqrt(pow(lat1_-lat1, 2)+pow(long1_-long1, 2)) > max_wgs_dist_) // set
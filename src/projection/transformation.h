@@ -2,6 +2,7 @@
 #define TRANSFORMATION_H
 
 #include <memory>
+#include <vector>
 
 class OGRSpatialReference;
 class OGRCoordinateTransformation;
@@ -18,6 +19,8 @@ public:
     // ok, dist x, dist y
     std::tuple<bool, double, double> wgsAddCartOffset (double lat1, double long1, double x_pos2, double y_pos2);
     // ok, lat, long
+    bool wgsAddCartOffsets (double lat1, double long1, std::vector<double>& x_pos2, std::vector<double>& y_pos2);
+    // ok if all transformed, offsets are replaced by lat, long
 
 protected:
     static bool in_appimage_;
@@ -247,6 +247,14 @@ void Sector::save()
 }
 
 bool Sector::isInside(const EvaluationTargetPosition& pos, bool has_ground_bit, bool ground_bit_set) const
+{
+    if (!isInsideAltitude(pos, has_ground_bit, ground_bit_set))
+        return false;
+
+    return isInsidePolygon(pos.latitude_, pos.longitude_);
+}
+
+bool Sector::isInsideAltitude(const EvaluationTargetPosition& pos, bool has_ground_bit, bool ground_bit_set) const
 {
     if (pos.has_altitude_)
     {
@@ -259,8 +267,30 @@ bool Sector::isInside(const EvaluationTargetPosition& pos, bool has_ground_bit,
     if (has_ground_bit && ground_bit_set && has_min_altitude_)
         return false;
 
-    OGRPoint ogr_pos (pos.latitude_, pos.longitude_);
-    return ogr_polygon_->Contains(&ogr_pos);
+    return true;
+}
+
+bool Sector::isInsidePolygon(double latitude, double longitude) const
+{
+    return polygon_->isInside(latitude, longitude);
+}
+
+void Sector::isInsidePolygon(const std::vector<double>& latitudes, const std::vector<double>& longitudes,
+                             std::vector<bool>& flags) const
+{
+    polygon_->isInside(latitudes, longitudes, flags);
+}
+
+SectorPolygon::BoxContainment Sector::boxContainment(double latitude_min, double latitude_max,
+                                                     double longitude_min, double longitude_max) const
+{
+    return polygon_->boxContainment(latitude_min, latitude_max, longitude_min, longitude_max);
+}
+
+bool Sector::isOutsideAltitude(double altitude_min, double altitude_max) const
+{
+    return (has_min_altitude_ && altitude_max < min_altitude_)
+            || (has_max_altitude_ && altitude_min > max_altitude_);
 }
 
 
@@ -322,16 +352,6 @@ void Sector::exclude(bool value)
 
 void Sector::createPolygon()
 {
-    ogr_polygon_.reset(new OGRPolygon());
-    //ogr_polygon_->addRingDirectly()
-    OGRLinearRing* ring = new OGRLinearRing();
-
-    for (auto& point_it : points_)
-        ring->addPoint(point_it.first, point_it.second);
-
-    if (*points_.begin() != *points_.rbegin())
-        ring->addPoint(points_.begin()->first, points_.begin()->second); // close if not not closed
-
-    ogr_polygon_->addRingDirectly(ring);
+    polygon_.reset(new SectorPolygon(points_));
 }
 
@@ -19,11 +19,10 @@
 #define SECTOR_H
 
 #include "json.hpp"
+#include "sectorpolygon.h"
 
 #include <QColor>
 
-#include <ogr_geometry.h>
-
 #include <memory>
 
 class DBInterface;
@@ -73,6 +72,17 @@ public:
     void save();
 
     bool isInside(const EvaluationTargetPosition& pos, bool has_ground_bit, bool ground_bit_set) const;
+    // altitude limits and ground bit only, isInside is both and polygon containment
+    bool isInsideAltitude(const EvaluationTargetPosition& pos, bool has_ground_bit, bool ground_bit_set) const;
+    bool isInsidePolygon(double latitude, double longitude) const;
+    // appends one flag per position
+    void isInsidePolygon(const std::vector<double>& latitudes, const std::vector<double>& longitudes,
+                         std::vector<bool>& flags) const;
+    // polygon containment of all positions in box
+    SectorPolygon::BoxContainment boxContainment(double latitude_min, double latitude_max,
+                                                 double longitude_min, double longitude_max) const;
+    // all altitudes in range below minimum or above maximum altitude
+    bool isOutsideAltitude(double altitude_min, double altitude_max) const;
 
     std::pair<double, double> getMinMaxLatitude() const;
     std::pair<double, double> getMinMaxLongitude() const;
@@ -93,7 +103,7 @@ protected:
     bool has_max_altitude_ {false};
     double max_altitude_{0.0};
 
-    std::unique_ptr<OGRPolygon> ogr_polygon_;
+    std::unique_ptr<SectorPolygon> polygon_;
 
     void createPolygon();
 };
@@ -125,6 +125,115 @@ bool SectorLayer::isInside(const EvaluationTargetPosition& pos,
     return !is_inside_exclude; // true if in no exlcude, false if in include
 }
 
+void SectorLayer::polygonInsideFlags(double latitude, double longitude, std::vector<bool>& flags) const
+{
+    for (auto& sec_it : sectors_)
+        flags.push_back(sec_it->isInsidePolygon(latitude, longitude));
+}
+
+std::vector<SectorPolygon::BoxContainment> SectorLayer::boxContainment(
+        double latitude_min, double latitude_max, double longitude_min, double longitude_max) const
+{
+    std::vector<SectorPolygon::BoxContainment> box_containment;
+
+    for (auto& sec_it : sectors_)
+        box_containment.push_back(sec_it->boxContainment(latitude_min, latitude_max, longitude_min, longitude_max));
+
+    return box_containment;
+}
+
+std::vector<SectorPolygon::BoxContainment> SectorLayer::boxContainment(
+        double latitude_min, double latitude_max, double longitude_min, double longitude_max,
+        double altitude_min, double altitude_max) const
+{
+    std::vector<SectorPolygon::BoxContainment> box_containment;
+
+    for (auto& sec_it : sectors_)
+    {
+        if (sec_it->isOutsideAltitude(altitude_min, altitude_max))
+            box_containment.push_back(SectorPolygon::BoxContainment::Outside);
+        else
+            box_containment.push_back(
+                        sec_it->boxContainment(latitude_min, latitude_max, longitude_min, longitude_max));
+    }
+
+    return box_containment;
+}
+
+void SectorLayer::polygonInsideFlags(const std::vector<double>& latitudes, const std::vector<double>& longitudes,
+                                     const std::vector<SectorPolygon::BoxContainment>& box_containment,
+                                     std::vector<bool>& flags) const
+{
+    assert (box_containment.size() == sectors_.size());
+    assert (latitudes.size() == longitudes.size());
+
+    size_t num_positions = latitudes.size();
+    size_t num_sectors = sectors_.size();
+    size_t offset = flags.size();
+
+    flags.resize(offset + num_positions * num_sectors);
+
+    std::vector<bool> sector_flags;
+
+    for (unsigned int sec_cnt=0; sec_cnt < num_sectors; ++sec_cnt)
+    {
+        if (box_containment[sec_cnt] == SectorPolygon::BoxContainment::Mixed)
+        {
+            sector_flags.clear();
+            sectors_[sec_cnt]->isInsidePolygon(latitudes, longitudes, sector_flags);
+
+            for (size_t pos_cnt=0; pos_cnt < num_positions; ++pos_cnt)
+                flags[offset + pos_cnt * num_sectors + sec_cnt] = sector_flags[pos_cnt];
+        }
+        else
+        {
+            bool inside = box_containment[sec_cnt] == SectorPolygon::BoxContainment::Inside;
+
+            for (size_t pos_cnt=0; pos_cnt < num_positions; ++pos_cnt)
+                flags[offset + pos_cnt * num_sectors + sec_cnt] = inside;
+        }
+    }
+}
+
+bool SectorLayer::isInside(const EvaluationTargetPosition& pos, bool has_ground_bit, bool ground_bit_set,
+                           const std::vector<bool>& polygon_flags, size_t offset) const
+{
+    assert (offset + sectors_.size() <= polygon_flags.size());
+
+    bool is_inside = false;
+
+    // check if inside normal ones
+    for (unsigned int cnt=0; cnt < sectors_.size(); ++cnt)
+    {
+        if (sectors_.at(cnt)->exclude())
+            continue;
+
+        if (polygon_flags[offset+cnt] && sectors_.at(cnt)->isInsideAltitude(pos, has_ground_bit, ground_bit_set))
+        {
+            is_inside = true;
+            break;
+        }
+    }
+
+    if (!is_inside) // not inside normal sector
+        return false;
+
+    if (!has_exclude_sector_) // nothin more to check
+        return true;
+
+    // check if inside exclude ones
+    for (unsigned int cnt=0; cnt < sectors_.size(); ++cnt)
+    {
+        if (!sectors_.at(cnt)->exclude())
+            continue;
+
+        if (polygon_flags[offset+cnt] && sectors_.at(cnt)->isInsideAltitude(pos, has_ground_bit, ground_bit_set))
+            return false;
+    }
+
+    return true;
+}
+
 std::pair<double, double> SectorLayer::getMinMaxLatitude() const
 {
     double min, max;
@@ -18,6 +18,8 @@
 #ifndef SECTORLAYER_H
 #define SECTORLAYER_H
 
+#include "sectorpolygon.h"
+
 #include <string>
 #include <vector>
 #include <memory>
@@ -37,13 +39,31 @@ public:
     std::shared_ptr<Sector> sector (const std::string& name);
     void removeSector (std::shared_ptr<Sector> sector);
 
-    unsigned int size () { return sectors_.size(); };
+    unsigned int size () const { return sectors_.size(); };
 
     std::vector<std::shared_ptr<Sector>>& sectors() { return sectors_; }
 
     bool isInside(const EvaluationTargetPosition& pos,
                   bool has_ground_bit, bool ground_bit_set) const;
 
+    // polygon containment of position, appends one flag per sector in sectors order
+    void polygonInsideFlags(double latitude, double longitude, std::vector<bool>& flags) const;
+    // polygon containment of all positions in box per sector, in sectors order
+    std::vector<SectorPolygon::BoxContainment> boxContainment(double latitude_min, double latitude_max,
+                                                              double longitude_min, double longitude_max) const;
+    // same as above, sectors with all positions outside altitude limits are outside
+    std::vector<SectorPolygon::BoxContainment> boxContainment(double latitude_min, double latitude_max,
+                                                              double longitude_min, double longitude_max,
+                                                              double altitude_min, double altitude_max) const;
+    // polygon containment of positions, appends one flag per position and sector, in sectors order per position.
+    // polygons are only checked for sectors with mixed box containment, by the batch check of the sector
+    void polygonInsideFlags(const std::vector<double>& latitudes, const std::vector<double>& longitudes,
+                            const std::vector<SectorPolygon::BoxContainment>& box_containment,
+                            std::vector<bool>& flags) const;
+    // same as isInside, with polygon containment from polygonInsideFlags for pos at flags offset
+    bool isInside(const EvaluationTargetPosition& pos, bool has_ground_bit, bool ground_bit_set,
+                  const std::vector<bool>& polygon_flags, size_t offset) const;
+
     std::pair<double, double> getMinMaxLatitude() const;
     std::pair<double, double> getMinMaxLongitude() const;
 
@@ -0,0 +1,348 @@
+/*
+ * This file is part of OpenATS COMPASS.
+ *
+ * COMPASS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * COMPASS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with COMPASS. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "sectorpolygon.h"
+#include "logger.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+using namespace std;
+
+const double SectorPolygon::boundary_distance_ {1e-9}; // ~0.1 mm
+
+SectorPolygon::SectorPolygon(const std::vector<std::pair<double,double>>& points)
+{
+    ogr_polygon_.reset(new OGRPolygon());
+    OGRLinearRing* ring = new OGRLinearRing();
+
+    for (auto& point_it : points)
+        ring->addPoint(point_it.first, point_it.second);
+
+    if (points.size() && *points.begin() != *points.rbegin())
+        ring->addPoint(points.begin()->first, points.begin()->second); // close if not not closed
+
+    ogr_polygon_->addRingDirectly(ring);
+
+    native_ = ring->getNumPoints() >= 4 && ogr_polygon_->IsValid();
+
+    if (!native_)
+    {
+        logwrn << "SectorPolygon: ctor: polygon with " << ring->getNumPoints()
+               << " points not valid, using OGR";
+        return;
+    }
+
+    unsigned int num_edges = ring->getNumPoints() - 1;
+
+    latitude_min_ = latitude_max_ = ring->getX(0);
+    longitude_min_ = longitude_max_ = ring->getY(0);
+
+    for (unsigned int cnt=1; cnt <= num_edges; ++cnt)
+    {
+        latitude_min_ = min(latitude_min_, ring->getX(cnt));
+        latitude_max_ = max(latitude_max_, ring->getX(cnt));
+        longitude_min_ = min(longitude_min_, ring->getY(cnt));
+        longitude_max_ = max(longitude_max_, ring->getY(cnt));
+    }
+
+    assert (latitude_max_ > latitude_min_);
+
+    num_slabs_ = min(max(num_edges / 2, 1u), max_num_slabs_);
+    slab_size_ = (latitude_max_ - latitude_min_) / num_slabs_;
+
+    // slab index range per edge, expanded by boundary distance so that all edges near a point are in its slab
+    vector<pair<unsigned int, unsigned int>> edge_slabs;
+    vector<unsigned int> slab_counts (num_slabs_, 0);
+
+    double lat1, lat2;
+
+    for (unsigned int cnt=0; cnt < num_edges; ++cnt)
+    {
+        lat1 = ring->getX(cnt);
+        lat2 = ring->getX(cnt+1);
+
+        edge_slabs.push_back({slabIndex(max(min(lat1, lat2) - boundary_distance_, latitude_min_)),
+                              slabIndex(min(max(lat1, lat2) + boundary_distance_, latitude_max_))});
+
+        for (unsigned int slab=edge_slabs.back().first; slab <= edge_slabs.back().second; ++slab)
+            ++slab_counts.at(slab);
+    }
+
+    slab_begins_.resize(num_slabs_ + 1);
+    slab_begins_[0] = 0;
+
+    for (unsigned int slab=0; slab < num_slabs_; ++slab)
+        slab_begins_[slab+1] = slab_begins_[slab] + slab_counts[slab];
+
+    unsigned int num_slab_edges = slab_begins_.back();
+
+    edge_lat1_.resize(num_slab_edges);
+    edge_lon1_.resize(num_slab_edges);
+    edge_lat2_.resize(num_slab_edges);
+    edge_lon2_.resize(num_slab_edges);
+    edge_slope_.resize(num_slab_edges);
+    edge_max_cross_.resize(num_slab_edges);
+
+    vector<unsigned int> slab_pos (slab_begins_.begin(), slab_begins_.end() - 1);
+    unsigned int pos;
+    double lon1, lon2;
+
+    for (unsigned int cnt=0; cnt < num_edges; ++cnt)
+    {
+        lat1 = ring->getX(cnt);
+        lon1 = ring->getY(cnt);
+        lat2 = ring->getX(cnt+1);
+        lon2 = ring->getY(cnt+1);
+
+        for (unsigned int slab=edge_slabs.at(cnt).first; slab <= edge_slabs.at(cnt).second; ++slab)
+        {
+            pos = slab_pos[slab]++;
+
+            edge_lat1_[pos] = lat1;
+            edge_lon1_[pos] = lon1;
+            edge_lat2_[pos] = lat2;
+            edge_lon2_[pos] = lon2;
+            edge_slope_[pos] = lat1 != lat2 ? (lon2 - lon1) / (lat2 - lat1) : 0;
+            edge_max_cross_[pos] = boundary_distance_ * sqrt(pow(lat2 - lat1, 2) + pow(lon2 - lon1, 2));
+        }
+    }
+}
+
+bool SectorPolygon::isInside(double latitude, double longitude) const
+{
+    if (!native_)
+        return isInsideOGR(latitude, longitude);
+
+    // boundary is not contained, inside points are strictly within bounding box
+    if (latitude <= latitude_min_ || latitude >= latitude_max_
+            || longitude <= longitude_min_ || longitude >= longitude_max_)
+        return false;
+
+    unsigned int slab = slabIndex(latitude);
+    unsigned int end = slab_begins_[slab+1];
+
+    unsigned int crossings = 0;
+    bool near_boundary = false;
+
+    const double* lat1 = edge_lat1_.data();
+    const double* lon1 = edge_lon1_.data();
+    const double* lat2 = edge_lat2_.data();
+    const double* lon2 = edge_lon2_.data();
+    const double* slope = edge_slope_.data();
+    const double* max_cross = edge_max_cross_.data();
+
+    for (unsigned int cnt=slab_begins_[slab]; cnt < end; ++cnt)
+    {
+        // crossing of ray to higher longitudes, half-open in latitude
+        crossings += ((lat1[cnt] > latitude) != (lat2[cnt] > latitude))
+                & (longitude < lon1[cnt] + (latitude - lat1[cnt]) * slope[cnt]);
+
+        // within boundary distance of edge
+        near_boundary |= (latitude >= fmin(lat1[cnt], lat2[cnt]) - boundary_distance_)
+                & (latitude <= fmax(lat1[cnt], lat2[cnt]) + boundary_distance_)
+                & (longitude >= fmin(lon1[cnt], lon2[cnt]) - boundary_distance_)
+                & (longitude <= fmax(lon1[cnt], lon2[cnt]) + boundary_distance_)
+                & (fabs((lat2[cnt] - lat1[cnt]) * (longitude - lon1[cnt])
+                        - (lon2[cnt] - lon1[cnt]) * (latitude - lat1[cnt])) <= max_cross[cnt]);
+    }
+
+    if (near_boundary)
+        return isInsideOGR(latitude, longitude);
+
+    return crossings % 2;
+}
+
+void SectorPolygon::isInside(const std::vector<double>& latitudes, const std::vector<double>& longitudes,
+                             std::vector<bool>& flags) const
+{
+    assert (latitudes.size() == longitudes.size());
+
+    size_t size = latitudes.size();
+    size_t offset = flags.size();
+
+    flags.resize(offset + size, false);
+
+    if (!native_)
+    {
+        for (size_t cnt=0; cnt < size; ++cnt)
+            flags[offset+cnt] = isInsideOGR(latitudes[cnt], longitudes[cnt]);
+
+        return;
+    }
+
+    // points strictly within bounding box, sorted by slab
+    vector<unsigned int> slab_begins (num_slabs_ + 1, 0);
+    vector<unsigned int> slabs (size, num_slabs_); // num slabs if outside
+
+    for (size_t cnt=0; cnt < size; ++cnt)
+    {
+        if (latitudes[cnt] <= latitude_min_ || latitudes[cnt] >= latitude_max_
+                || longitudes[cnt] <= longitude_min_ || longitudes[cnt] >= longitude_max_)
+            continue;
+
+        slabs[cnt] = slabIndex(latitudes[cnt]);
+        ++slab_begins[slabs[cnt] + 1];
+    }
+
+    for (unsigned int slab=0; slab < num_slabs_; ++slab)
+        slab_begins[slab+1] += slab_begins[slab];
+
+    vector<size_t> indexes (slab_begins.back());
+    vector<unsigned int> slab_pos (slab_begins.begin(), slab_begins.end() - 1);
+
+    for (size_t cnt=0; cnt < size; ++cnt)
+        if (slabs[cnt] < num_slabs_)
+            indexes[slab_pos[slabs[cnt]]++] = cnt;
+
+    // per slab, edges in outer loop and points of the slab in the inner loop, which is vectorized.
+    // counts are doubles, since mixing with other lane widths prevents vectorization
+    vector<double> lats, lons;
+    vector<double> crossings, near_boundary;
+
+    double lat1, lon1, lat2, lon2, slope, max_cross, lat_lo, lat_hi, lon_lo, lon_hi;
+
+    for (unsigned int slab=0; slab < num_slabs_; ++slab)
+    {
+        unsigned int num_points = slab_begins[slab+1] - slab_begins[slab];
+
+        if (!num_points)
+            continue;
+
+        lats.resize(num_points);
+        lons.resize(num_points);
+
+        for (unsigned int cnt=0; cnt < num_points; ++cnt)
+        {
+            lats[cnt] = latitudes[indexes[slab_begins[slab] + cnt]];
+            lons[cnt] = longitudes[indexes[slab_begins[slab] + cnt]];
+        }
+
+        crossings.assign(num_points, 0);
+        near_boundary.assign(num_points, 0);
+
+        const double* lat = lats.data();
+        const double* lon = lons.data();
+        double* cross = crossings.data();
+        double* near = near_boundary.data();
+
+        for (unsigned int edge=slab_begins_[slab]; edge < slab_begins_[slab+1]; ++edge)
+        {
+            lat1 = edge_lat1_[edge];
+            lon1 = edge_lon1_[edge];
+            lat2 = edge_lat2_[edge];
+            lon2 = edge_lon2_[edge];
+            slope = edge_slope_[edge];
+            max_cross = edge_max_cross_[edge];
+
+            lat_lo = fmin(lat1, lat2) - boundary_distance_;
+            lat_hi = fmax(lat1, lat2) + boundary_distance_;
+            lon_lo = fmin(lon1, lon2) - boundary_distance_;
+            lon_hi = fmax(lon1, lon2) + boundary_distance_;
+
+            // same predicates as in isInside
+            for (unsigned int cnt=0; cnt < num_points; ++cnt)
+            {
+                cross[cnt] += (((lat1 > lat[cnt]) != (lat2 > lat[cnt]))
+                               & (lon[cnt] < lon1 + (lat[cnt] - lat1) * slope)) ? 1.0 : 0.0;
+
+                near[cnt] += ((lat[cnt] >= lat_lo) & (lat[cnt] <= lat_hi)
+                              & (lon[cnt] >= lon_lo) & (lon[cnt] <= lon_hi)
+                              & (fabs((lat2 - lat1) * (lon[cnt] - lon1) - (lon2 - lon1) * (lat[cnt] - lat1))
+                                 <= max_cross)) ? 1.0 : 0.0;
+            }
+        }
+
+        for (unsigned int cnt=0; cnt < num_points; ++cnt)
+        {
+            if (near[cnt])
+                flags[offset + indexes[slab_begins[slab] + cnt]] = isInsideOGR(lat[cnt], lon[cnt]);
+            else
+                flags[offset + indexes[slab_begins[slab] + cnt]] = fmod(cross[cnt], 2.0) != 0;
+        }
+    }
+}
+
+bool SectorPolygon::isInsideOGR(double latitude, double longitude) const
+{
+    OGRPoint ogr_pos (latitude, longitude);
+    return ogr_polygon_->Contains(&ogr_pos);
+}
+
+SectorPolygon::BoxContainment SectorPolygon::boxContainment(double latitude_min, double latitude_max,
+                                                           double longitude_min, double longitude_max) const
+{
+    assert (latitude_min <= latitude_max && longitude_min <= longitude_max);
+
+    if (!native_)
+        return BoxContainment::Mixed;
+
+    // boundary is not contained, as in isInside
+    if (latitude_max <= latitude_min_ || latitude_min >= latitude_max_
+            || longitude_max <= longitude_min_ || longitude_min >= longitude_max_)
+        return BoxContainment::Outside;
+
+    // points near an edge are checked by OGR, so no edge may come near the box. with twice the boundary
+    // distance, the box also excludes points beyond edge ends which pass the boundary check in isInside
+    double margin = 2 * boundary_distance_;
+
+    double lat_min = latitude_min - margin;
+    double lat_max = latitude_max + margin;
+    double lon_min = longitude_min - margin;
+    double lon_max = longitude_max + margin;
+
+    unsigned int end = slab_begins_[slabIndex(min(lat_max, latitude_max_)) + 1];
+
+    for (unsigned int cnt=slab_begins_[slabIndex(max(lat_min, latitude_min_))]; cnt < end; ++cnt)
+    {
+        if (edgeIntersectsBox(cnt, lat_min, lat_max, lon_min, lon_max))
+            return BoxContainment::Mixed;
+    }
+
+    // no boundary in box, all points same as any one
+    return isInside(latitude_min, longitude_min) ? BoxContainment::Inside : BoxContainment::Outside;
+}
+
+unsigned int SectorPolygon::slabIndex(double latitude) const
+{
+    return min((unsigned int) ((latitude - latitude_min_) / slab_size_), num_slabs_ - 1);
+}
+
+bool SectorPolygon::edgeIntersectsBox(unsigned int index, double latitude_min, double latitude_max,
+                                      double longitude_min, double longitude_max) const
+{
+    double lat1 = edge_lat1_[index];
+    double lon1 = edge_lon1_[index];
+    double lat2 = edge_lat2_[index];
+    double lon2 = edge_lon2_[index];
+
+    if (max(lat1, lat2) < latitude_min || min(lat1, lat2) > latitude_max
+            || max(lon1, lon2) < longitude_min || min(lon1, lon2) > longitude_max)
+        return false;
+
+    // bounding boxes overlap, intersects unless all box corners are strictly on one side of the edge line
+    auto side = [&](double latitude, double longitude) {
+        double cross = (lat2 - lat1) * (longitude - lon1) - (lon2 - lon1) * (latitude - lat1);
+        return (cross > 0) - (cross < 0);
+    };
+
+    int sum = side(latitude_min, longitude_min) + side(latitude_min, longitude_max)
+            + side(latitude_max, longitude_min) + side(latitude_max, longitude_max);
+
+    return abs(sum) != 4;
+}
@@ -0,0 +1,91 @@
+/*
+ * This file is part of OpenATS COMPASS.
+ *
+ * COMPASS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * COMPASS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with COMPASS. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SECTORPOLYGON_H
+#define SECTORPOLYGON_H
+
+#include <ogr_geometry.h>
+
+#include <memory>
+#include <vector>
+
+/**
+ * @brief Point-in-polygon test for the ring of a sector, with the same results as OGRPolygon::Contains
+ *
+ * Points outside of the bounding box are rejected directly. Otherwise the edges of the latitude slab
+ * of the point are checked, counting crossings of a ray towards higher longitudes. The edge loop is
+ * branchless over flat arrays, so that it can be vectorized by the compiler.
+ *
+ * Points within a small distance of an edge are on the boundary for practical purposes, where the
+ * result depends on the exact predicates of OGR (boundary is not contained), so these are checked
+ * by OGR. Invalid polygons, e.g. self-intersecting ones, are always checked by OGR.
+ */
+class SectorPolygon
+{
+public:
+    enum class BoxContainment { Outside, Inside, Mixed }; // isInside of all points in a box
+
+    SectorPolygon(const std::vector<std::pair<double,double>>& points); // latitude, longitude
+
+    bool isInside(double latitude, double longitude) const;
+    // appends one flag per position, same results as above. points are grouped by slab, so that the
+    // loop over the points of a slab can be vectorized
+    void isInside(const std::vector<double>& latitudes, const std::vector<double>& longitudes,
+                  std::vector<bool>& flags) const;
+
+    bool isInsideOGR(double latitude, double longitude) const; // reference, always by OGR
+
+    // Outside or Inside if isInside is the same for all points in the box, Mixed if unknown
+    BoxContainment boxContainment(double latitude_min, double latitude_max,
+                                  double longitude_min, double longitude_max) const;
+
+    bool native() const { return native_; } // false if all checks are done by OGR
+    unsigned int numSlabs() const { return num_slabs_; }
+
+protected:
+    static const double boundary_distance_; // deg, points closer to an edge are checked by OGR
+    static const unsigned int max_num_slabs_ {1024};
+
+    std::unique_ptr<OGRPolygon> ogr_polygon_;
+
+    bool native_ {false};
+
+    double latitude_min_ {0};
+    double latitude_max_ {0};
+    double longitude_min_ {0};
+    double longitude_max_ {0};
+
+    unsigned int num_slabs_ {0};
+    double slab_size_ {0}; // deg latitude
+
+    std::vector<unsigned int> slab_begins_; // num slabs + 1, index into edge arrays
+
+    // edges per slab, edges overlapping several slabs are stored in each
+    std::vector<double> edge_lat1_;
+    std::vector<double> edge_lon1_;
+    std::vector<double> edge_lat2_;
+    std::vector<double> edge_lon2_;
+    std::vector<double> edge_slope_; // lon per lat, 0 if no latitude extent
+    std::vector<double> edge_max_cross_; // boundary distance * length
+
+    unsigned int slabIndex(double latitude) const;
+    // whether edge at index in edge arrays touches the box, conservative
+    bool edgeIntersectsBox(unsigned int index, double latitude_min, double latitude_max,
+                           double longitude_min, double longitude_max) const;
+};
+
+#endif // SECTORPOLYGON_H
@@ -18,6 +18,7 @@
 #include "createartasassociationstask.h"
 
 #include "compass.h"
+#include "createassociationstask.h"
 #include "createartasassociationsstatusdialog.h"
 #include "createartasassociationstaskwidget.h"
 #include "dbinterface.h"
@@ -441,6 +442,8 @@ void CreateARTASAssociationsTask::createDoneSlot()
     if (save_associations_)
     {
         COMPASS::instance().interface().setProperty(DONE_PROPERTY_NAME, "1");
+        // associations replaced, no incremental association based on previous state
+        COMPASS::instance().interface().setProperty(CreateAssociationsTask::STATE_PROPERTY_NAME, "");
 
         task_manager_.appendSuccess("CreateARTASAssociationsTask: done after " + time_str);
         done_ = true;
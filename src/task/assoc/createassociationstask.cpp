@@ -26,8 +26,11 @@
 #include "dbodatasource.h"
 #include "dbovariable.h"
 #include "dbovariableset.h"
+#include "dbtable.h"
+#include "dbtablecolumn.h"
 #include "jobmanager.h"
 #include "metadbovariable.h"
+#include "metadbtable.h"
 #include "postprocesstask.h"
 #include "stringconv.h"
 #include "taskmanager.h"
@@ -36,12 +39,18 @@
 
 #include <QApplication>
 #include <QMessageBox>
+#include <algorithm>
+#include <cmath>
 #include <sstream>
 
+#include "json.hpp"
+
 using namespace std;
 using namespace Utils;
 
 const std::string CreateAssociationsTask::DONE_PROPERTY_NAME = "associations_created";
+const std::string CreateAssociationsTask::STATE_PROPERTY_NAME = "associations_state";
+const double CreateAssociationsTask::SECONDS_PER_DAY = 24 * 60 * 60;
 
 CreateAssociationsTask::CreateAssociationsTask(const std::string& class_id,
                                                const std::string& instance_id,
@@ -63,12 +72,16 @@ CreateAssociationsTask::CreateAssociationsTask(const std::string& class_id,
     registerParameter("mode_c_var_str", &mode_c_var_str_, "modec_code_ft");
     registerParameter("latitude_var_str", &latitude_var_str_, "pos_lat_deg");
     registerParameter("longitude_var_str", &longitude_var_str_, "pos_long_deg");
+    registerParameter("streaming_time_var_str", &streaming_time_var_str_, "rec_time_posix");
 
     // common
     registerParameter("associate_non_mode_s", &associate_non_mode_s_, true);
     registerParameter("clean_dubious_utns", &clean_dubious_utns_, true);
     registerParameter("mark_dubious_utns_unused", &mark_dubious_utns_unused_, false);
     registerParameter("comment_dubious_utns", &comment_dubious_utns_, true);
+    registerParameter("incremental", &incremental_, false);
+    registerParameter("streaming", &streaming_, false);
+    registerParameter("streaming_chunk_duration", &streaming_chunk_duration_, 3600.0);
 
     // tracker stuff
     registerParameter("max_time_diff_tracker", &max_time_diff_tracker_, 15.0);
@@ -256,8 +269,63 @@ void CreateAssociationsTask::run()
     checkAndSetMetaVariable(latitude_var_str_, &latitude_var_);
     checkAndSetMetaVariable(longitude_var_str_, &longitude_var_);
 
+    if (streaming_)
+    {
+        assert (streaming_chunk_duration_ > 0);
+
+        // tod wraps at midnight, so chunks on tod would mix the days of a dataset
+        streaming_by_time_ = canStreamByTime();
+
+        MetaDBOVariable* chunk_var = streaming_by_time_ ? streaming_time_var_ : tod_var_;
+
+        std::string min_str = chunk_var->getMinString();
+        std::string max_str = chunk_var->getMaxString();
+        assert (min_str.size() && max_str.size());
+
+        streaming_chunk_begin_ = std::stod(min_str);
+        streaming_max_ = std::stod(max_str);
+        streaming_chunk_cnt_ = 0;
+
+        if (!incremental_) // start from scratch, following chunks continue from state of previous one
+            COMPASS::instance().interface().setProperty(STATE_PROPERTY_NAME, "");
+
+        if (streaming_by_time_)
+            loginf << "CreateAssociationsTask: run: streaming from posix time " << min_str << " to " << max_str
+                   << " in chunks of " << streaming_chunk_duration_ << " s";
+        else
+        {
+            logwrn << "CreateAssociationsTask: run: no " << streaming_time_var_str_ << " values, streaming on "
+                   << "time of day, data of several days is mixed";
+
+            loginf << "CreateAssociationsTask: run: streaming from "
+                   << String::timeStringFromDouble(streaming_chunk_begin_) << " to "
+                   << String::timeStringFromDouble(streaming_max_) << " in chunks of "
+                   << streaming_chunk_duration_ << " s";
+        }
+    }
+
+    loadData();
+
+    status_dialog_->show();
+}
+
+void CreateAssociationsTask::loadData()
+{
     DBObjectManager& object_man = COMPASS::instance().objectManager();
 
+    // only load not yet associated target reports
+    std::map<std::string, unsigned int> watermarks;
+
+    // streaming chunks are disjoint in time, watermarks only skip data from before the first one
+    if (hasIncrementalState() && (!streaming_ || !streaming_chunk_cnt_))
+    {
+        watermarks = associatedRecNumWatermarks();
+        loginf << "CreateAssociationsTask: loadData: incremental, " << watermarks.size() << " watermarks";
+    }
+
+    dbo_loading_done_flags_.clear();
+    dbo_loading_done_ = false;
+
     for (auto& dbo_it : object_man)
     {
         if (!dbo_it.second->hasData())
@@ -269,13 +337,47 @@ void CreateAssociationsTask::run()
         connect(dbo_it.second, &DBObject::loadingDoneSignal, this,
                 &CreateAssociationsTask::loadingDoneSlot);
 
-        dbo_it.second->load(read_set, false, true, &tod_var_->getFor(dbo_it.first), true);
+        std::string custom_filter_clause;
+        std::vector<DBOVariable*> filtered_vars;
+
+        if (watermarks.count(dbo_it.first))
+        {
+            DBOVariable& key_var = key_var_->getFor(dbo_it.first);
+            const DBTableColumn& column = key_var.currentDBColumn();
+            std::string table_db_name = key_var.currentMetaTable().tableFor(column.identifier()).name();
+
+            custom_filter_clause = table_db_name + "." + column.name() + " > "
+                    + std::to_string(watermarks.at(dbo_it.first));
+            filtered_vars.push_back(&key_var);
+        }
+
+        if (streaming_)
+        {
+            DBOVariable& chunk_var = streaming_by_time_ ? streaming_time_var_->getFor(dbo_it.first)
+                                                        : tod_var_->getFor(dbo_it.first);
+            const DBTableColumn& column = chunk_var.currentDBColumn();
+            std::string column_str = chunk_var.currentMetaTable().tableFor(column.identifier()).name()
+                    + "." + column.name();
+
+            if (custom_filter_clause.size())
+                custom_filter_clause += " AND ";
+
+            custom_filter_clause += column_str + " >= " + std::to_string(streaming_chunk_begin_) + " AND "
+                    + column_str + (lastStreamingChunk() ? " <= " : " < ")
+                    + std::to_string(streamingChunkEnd());
+            filtered_vars.push_back(&chunk_var);
+        }
+
+        if (custom_filter_clause.size())
+            dbo_it.second->load(read_set, custom_filter_clause, filtered_vars, true,
+                                &tod_var_->getFor(dbo_it.first), true);
+        else
+            dbo_it.second->load(read_set, false, true, &tod_var_->getFor(dbo_it.first), true);
 
         dbo_loading_done_flags_[dbo_it.first] = false;
     }
 
     status_dialog_->setDBODoneFlags(dbo_loading_done_flags_);
-    status_dialog_->show();
 }
 
 double CreateAssociationsTask::maxTimeDiffTracker() const
@@ -410,6 +512,120 @@ void CreateAssociationsTask::associateNonModeS(bool value)
     associate_non_mode_s_ = value;
 }
 
+bool CreateAssociationsTask::incremental() const
+{
+    return incremental_;
+}
+
+void CreateAssociationsTask::incremental(bool value)
+{
+    loginf << "CreateAssociationsTask: incremental: value " << value;
+    incremental_ = value;
+}
+
+bool CreateAssociationsTask::streaming() const
+{
+    return streaming_;
+}
+
+void CreateAssociationsTask::streaming(bool value)
+{
+    loginf << "CreateAssociationsTask: streaming: value " << value;
+    streaming_ = value;
+}
+
+double CreateAssociationsTask::streamingChunkDuration() const
+{
+    return streaming_chunk_duration_;
+}
+
+void CreateAssociationsTask::streamingChunkDuration(double value)
+{
+    loginf << "CreateAssociationsTask: streamingChunkDuration: value " << value;
+    streaming_chunk_duration_ = value;
+}
+
+int CreateAssociationsTask::streamingChunkDay() const
+{
+    if (!streaming_ || !streaming_by_time_)
+        return 0;
+
+    return std::floor(streaming_chunk_begin_ / SECONDS_PER_DAY);
+}
+
+double CreateAssociationsTask::streamingChunkEnd() const
+{
+    double end = streaming_chunk_begin_ + streaming_chunk_duration_;
+
+    if (streaming_by_time_) // tods of a chunk have to be from one day
+        end = std::min(end, (streamingChunkDay() + 1) * SECONDS_PER_DAY);
+
+    return end;
+}
+
+bool CreateAssociationsTask::lastStreamingChunk() const
+{
+    return streamingChunkEnd() > streaming_max_;
+}
+
+bool CreateAssociationsTask::canStreamByTime()
+{
+    DBObjectManager& object_man = COMPASS::instance().objectManager();
+
+    if (!object_man.existsMetaVariable(streaming_time_var_str_)) // optional, name is kept
+    {
+        loginf << "CreateAssociationsTask: canStreamByTime: var " << streaming_time_var_str_ << " does not exist";
+        return false;
+    }
+
+    streaming_time_var_ = &object_man.metaVariable(streaming_time_var_str_);
+
+    for (auto& dbo_it : object_man)
+    {
+        if (!dbo_it.second->hasData())
+            continue;
+
+        if (!streaming_time_var_->existsIn(dbo_it.first)
+                || streaming_time_var_->getFor(dbo_it.first).getMinString() == NULL_STRING)
+        {
+            loginf << "CreateAssociationsTask: canStreamByTime: no " << streaming_time_var_str_ << " in "
+                   << dbo_it.first;
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool CreateAssociationsTask::hasIncrementalState()
+{
+    DBInterface& db_interface = COMPASS::instance().interface();
+
+    if (!incremental_ && !streaming_)
+        return false;
+
+    bool has_state = db_interface.hasProperty(STATE_PROPERTY_NAME)
+            && db_interface.getProperty(STATE_PROPERTY_NAME).size();
+
+    if (streaming_ && streaming_chunk_cnt_) // continue from state of previous chunk, not done yet
+        return has_state;
+
+    return has_state && db_interface.hasProperty(DONE_PROPERTY_NAME)
+            && db_interface.getProperty(DONE_PROPERTY_NAME) == "1";
+}
+
+std::map<std::string, unsigned int> CreateAssociationsTask::associatedRecNumWatermarks()
+{
+    assert (hasIncrementalState());
+
+    nlohmann::json state = nlohmann::json::parse(
+                COMPASS::instance().interface().getProperty(STATE_PROPERTY_NAME));
+
+    assert (state.contains("watermarks"));
+
+    return state.at("watermarks").get<std::map<std::string, unsigned int>>();
+}
+
 double CreateAssociationsTask::maxSpeedTrackerKts() const
 {
     return max_speed_tracker_kts_;
@@ -510,7 +726,7 @@ void CreateAssociationsTask::loadingDoneSlot(DBObject& object)
 
         for (auto& dbo_it : object_man)
         {
-            if (!dbo_it.second->hasData())
+            if (!dbo_it.second->hasData() || !dbo_it.second->data()) // nothing loaded, e.g. in streaming chunk
                 continue;
 
             buffers[dbo_it.first] = dbo_it.second->data();
@@ -536,7 +752,11 @@ void CreateAssociationsTask::loadingDoneSlot(DBObject& object)
 
         JobManager::instance().addDBJob(create_job_);
 
-        status_dialog_->setAssociationStatus("In Progress");
+        if (streaming_)
+            status_dialog_->setAssociationStatus(
+                        "In Progress (Chunk " + std::to_string(streaming_chunk_cnt_ + 1) + ")");
+        else
+            status_dialog_->setAssociationStatus("In Progress");
     }
 }
 
@@ -544,6 +764,30 @@ void CreateAssociationsTask::createDoneSlot()
 {
     loginf << "CreateAssociationsTask: createDoneSlot";
 
+    assert (create_job_);
+    std::string create_job_state = create_job_->state();
+
+    create_job_ = nullptr;
+
+    bool last_chunk = !streaming_ || lastStreamingChunk();
+
+    // state is needed to continue with the next chunk, done only after all chunks were associated
+    COMPASS::instance().interface().setProperty(STATE_PROPERTY_NAME, create_job_state);
+    COMPASS::instance().interface().setProperty(DONE_PROPERTY_NAME, last_chunk ? "1" : "0");
+
+    if (!last_chunk) // continue with next chunk, from stored state
+    {
+        streaming_chunk_begin_ = streamingChunkEnd();
+        ++streaming_chunk_cnt_;
+
+        loginf << "CreateAssociationsTask: createDoneSlot: loading chunk " << streaming_chunk_cnt_ + 1
+               << " from " << (streaming_by_time_ ? std::to_string(streaming_chunk_begin_)
+                                                  : String::timeStringFromDouble(streaming_chunk_begin_));
+
+        loadData();
+        return;
+    }
+
     create_job_done_ = true;
 
     status_dialog_->setAssociationStatus("Done");
@@ -553,16 +797,12 @@ void CreateAssociationsTask::createDoneSlot()
     if (!show_done_summary_)
         status_dialog_->close();
 
-    create_job_ = nullptr;
-
     stop_time_ = boost::posix_time::microsec_clock::local_time();
 
     boost::posix_time::time_duration diff = stop_time_ - start_time_;
 
     std::string time_str = String::timeStringFromDouble(diff.total_milliseconds() / 1000.0, false);
 
-    COMPASS::instance().interface().setProperty(DONE_PROPERTY_NAME, "1");
-
     task_manager_.appendSuccess("CreateAssociationsTask: done after " + time_str);
     done_ = true;
 
@@ -696,10 +936,6 @@ DBOVariableSet CreateAssociationsTask::getReadSetFor(const std::string& dbo_name
     assert(target_addr_var_->existsIn(dbo_name));
     read_set.add(target_addr_var_->getFor(dbo_name));
 
-    assert(target_id_var_);
-    assert(target_id_var_->existsIn(dbo_name));
-    read_set.add(target_id_var_->getFor(dbo_name));
-
     assert(track_num_var_);
     if(track_num_var_->existsIn(dbo_name))
         read_set.add(track_num_var_->getFor(dbo_name));
@@ -25,6 +25,7 @@
 #include "global.h"
 
 #include <QObject>
+#include <map>
 #include <memory>
 
 #include "boost/date_time/posix_time/posix_time.hpp"
@@ -80,6 +81,25 @@ public:
     void run();
 
     static const std::string DONE_PROPERTY_NAME;
+    static const std::string STATE_PROPERTY_NAME; // target state for incremental association
+    static const double SECONDS_PER_DAY;
+
+    bool incremental() const;
+    void incremental(bool value);
+
+    bool streaming() const;
+    void streaming(bool value);
+
+    double streamingChunkDuration() const;
+    void streamingChunkDuration(double value);
+
+    // day of current streaming chunk, chunks never span midnight. 0 if not streaming or chunked on tod
+    int streamingChunkDay() const;
+
+    // if incremental or streaming and state of previous association (or chunk) exists in database
+    bool hasIncrementalState();
+    // dbo name -> highest associated rec_num, from state of previous association
+    std::map<std::string, unsigned int> associatedRecNumWatermarks();
 
     double maxTimeDiffTracker() const;
     void maxTimeDiffTracker(double value);
@@ -169,10 +189,16 @@ protected:
     std::string longitude_var_str_;
     MetaDBOVariable* longitude_var_{nullptr};
 
+    std::string streaming_time_var_str_; // monotonic posix time in s, for streaming chunks over several days
+    MetaDBOVariable* streaming_time_var_{nullptr};
+
     bool associate_non_mode_s_ {true};
     bool clean_dubious_utns_ {true};
     bool mark_dubious_utns_unused_ {false};
     bool comment_dubious_utns_ {true};
+    bool incremental_ {false};
+    bool streaming_ {false}; // load and associate in time chunks, state is kept between chunks
+    double streaming_chunk_duration_ {3600.0}; // s
 
     // tracker stuff
     double max_time_diff_tracker_ {15.0};
@@ -211,8 +237,19 @@ protected:
     std::shared_ptr<CreateAssociationsJob> create_job_;
     bool create_job_done_{false};
 
+    // streaming chunk [begin, end), last one includes max. in posix time if set for all loaded dbos, else in tod
+    bool streaming_by_time_ {false};
+    double streaming_max_ {0};
+    double streaming_chunk_begin_ {0};
+    unsigned int streaming_chunk_cnt_ {0};
+
     void checkAndSetMetaVariable(std::string& name_str, MetaDBOVariable** var);
 
+    void loadData(); // loads all or current streaming chunk, only not yet associated target reports
+    double streamingChunkEnd() const; // begin + duration, limited to next midnight if by time
+    bool lastStreamingChunk() const;
+    bool canStreamByTime(); // streaming time variable exists with values for all dbos with data
+
     DBOVariableSet getReadSetFor(const std::string& dbo_name);
 };
 
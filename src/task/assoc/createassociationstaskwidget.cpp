@@ -78,6 +78,30 @@ CreateAssociationsTaskWidget::CreateAssociationsTaskWidget(
             this, &CreateAssociationsTaskWidget::toggleCommentDubiousUtnsSlot);
     layout->addWidget(comment_dubious_utns_check_, row, 1);
 
+    ++row;
+    layout->addWidget(new QLabel("Incremental Association"), row, 0);
+
+    incremental_check_ = new QCheckBox ();
+    connect(incremental_check_, &QCheckBox::clicked,
+            this, &CreateAssociationsTaskWidget::toggleIncrementalSlot);
+    layout->addWidget(incremental_check_, row, 1);
+
+    ++row;
+    layout->addWidget(new QLabel("Streaming Association"), row, 0);
+
+    streaming_check_ = new QCheckBox ();
+    connect(streaming_check_, &QCheckBox::clicked,
+            this, &CreateAssociationsTaskWidget::toggleStreamingSlot);
+    layout->addWidget(streaming_check_, row, 1);
+
+    ++row;
+    layout->addWidget(new QLabel("Streaming Chunk Duration [s]"), row, 0);
+
+    streaming_chunk_duration_edit_ = new QLineEdit();
+    connect(streaming_chunk_duration_edit_, &QLineEdit::textEdited,
+            this, &CreateAssociationsTaskWidget::streamingChunkDurationEditedSlot);
+    layout->addWidget(streaming_chunk_duration_edit_, row, 1);
+
     // tracker
     ++row;
     QLabel* tracker_label = new QLabel("Track/Track Association Parameters");
@@ -264,6 +288,15 @@ void CreateAssociationsTaskWidget::update()
     assert (comment_dubious_utns_check_);
     comment_dubious_utns_check_->setChecked(task_.commentDubiousUtns());
 
+    assert (incremental_check_);
+    incremental_check_->setChecked(task_.incremental());
+
+    assert (streaming_check_);
+    streaming_check_->setChecked(task_.streaming());
+
+    assert (streaming_chunk_duration_edit_);
+    streaming_chunk_duration_edit_->setText(QString::number(task_.streamingChunkDuration()));
+
 
     // tracker
     //    QLineEdit* max_time_diff_tracker_edit_{nullptr};
@@ -355,6 +388,35 @@ void CreateAssociationsTaskWidget::toggleCommentDubiousUtnsSlot()
     task_.commentDubiousUtns(comment_dubious_utns_check_->checkState() == Qt::Checked);
 }
 
+void CreateAssociationsTaskWidget::toggleIncrementalSlot()
+{
+    assert (incremental_check_);
+    task_.incremental(incremental_check_->checkState() == Qt::Checked);
+}
+
+void CreateAssociationsTaskWidget::toggleStreamingSlot()
+{
+    assert (streaming_check_);
+    task_.streaming(streaming_check_->checkState() == Qt::Checked);
+}
+
+void CreateAssociationsTaskWidget::streamingChunkDurationEditedSlot (const QString& text)
+{
+    string value_str = text.toStdString();
+
+    loginf << "CreateAssociationsTaskWidget: streamingChunkDurationEditedSlot: value '" << value_str << "'";
+
+    bool ok;
+
+    double value = text.toDouble(&ok);
+
+    if (ok && value > 0)
+        task_.streamingChunkDuration(value);
+    else
+        logwrn << "CreateAssociationsTaskWidget: streamingChunkDurationEditedSlot: unable to parse value '"
+               << value_str << "'";
+}
+
 
 void CreateAssociationsTaskWidget::maxTimeDiffTrackerEditedSlot (const QString& text)
 {
@@ -36,6 +36,9 @@ public slots:
     void toggleCleanDubiousUtnsSlot();
     void toggleMarkDubiousUtnsUnusedSlot();
     void toggleCommentDubiousUtnsSlot();
+    void toggleIncrementalSlot();
+    void toggleStreamingSlot();
+    void streamingChunkDurationEditedSlot (const QString& text);
 
     void maxTimeDiffTrackerEditedSlot (const QString& text);
 
@@ -69,6 +72,9 @@ protected:
     QCheckBox* clean_dubious_utns_check_{nullptr};
     QCheckBox* mark_dubious_utns_unused_check_{nullptr};
     QCheckBox* comment_dubious_utns_check_{nullptr};
+    QCheckBox* incremental_check_{nullptr};
+    QCheckBox* streaming_check_{nullptr};
+    QLineEdit* streaming_chunk_duration_edit_{nullptr};
 
     // tracker
     QLineEdit* max_time_diff_tracker_edit_{nullptr};
@@ -65,6 +65,10 @@ const unsigned int limited_chunk_size = 5000;
 const std::string DONE_PROPERTY_NAME = "asterix_data_imported";
 
 const float ram_threshold = 4.0;
+const float min_free_ram = 1.0;  // GB, mapping is held back below if RAM is limited
+// decoded chunks in flight between decoder and finished insert
+const unsigned int unlimited_chunks_in_flight = 4;
+const unsigned int limited_chunks_in_flight = 2;
 
 ASTERIXImportTask::ASTERIXImportTask(const std::string& class_id, const std::string& instance_id,
                                      TaskManager& task_manager)
@@ -859,6 +863,9 @@ void ASTERIXImportTask::run(bool test, bool create_mapping_stubs)
     status_widget_->markStartTime();
 
     insert_active_ = 0;
+    pending_inserts_.clear();
+
+    decoded_data_.reset(limit_ram_ ? limited_chunks_in_flight : unlimited_chunks_in_flight);
 
     all_done_ = false;
 
@@ -990,46 +997,52 @@ void ASTERIXImportTask::addDecodedASTERIXSlot()
 {
     logdbg << "ASTERIXImportTask: addDecodedASTERIX";
 
-    assert(decode_job_);
-    assert(status_widget_);
+    if (all_done_)  // data already processed after earlier signal
+        return;
 
-    logdbg << "ASTERIXImportTask: addDecodedASTERIX: errors " << decode_job_->numErrors();
+    assert(status_widget_);
 
     status_widget_->numFrames(jasterix_->numFrames());
     status_widget_->numRecords(jasterix_->numRecords());
     status_widget_->numErrors(jasterix_->numErrors());
-    status_widget_->setCategoryCounts(decode_job_->categoryCounts());
+
+    if (decode_job_)  // can be done before signal is processed
+    {
+        logdbg << "ASTERIXImportTask: addDecodedASTERIX: errors " << decode_job_->numErrors();
+        status_widget_->setCategoryCounts(decode_job_->categoryCounts());
+    }
 
     status_widget_->show();
 
-    std::unique_ptr<nlohmann::json> extracted_data = std::move(decode_job_->extractedData());
+    mapDecodedData();
+}
 
-    if (!create_mapping_stubs_)  // test or import
-    {
-        //        map_jobs_mutex_.lock();
-        //        json_map_jobs_.push_back(json_map_job);
-        //        map_jobs_mutex_.unlock();
+void ASTERIXImportTask::mapDecodedData()
+{
+    // only one mapping job can exist at a time, decoder is blocked by channel if all credits used
+    if (json_map_job_ || json_map_stub_job_ || maxLoadReached())
+        return;
 
-        while (json_map_job_)  // only one can exist at a time
-        {
-            if (decode_job_)
-                decode_job_->pause();
+    std::unique_ptr<nlohmann::json> extracted_data;
 
-            QCoreApplication::processEvents(QEventLoop::ExcludeUserInputEvents);
-            QThread::msleep(1);
-        }
+    map_generation_ = decoded_data_.tryPop(extracted_data);
 
-        assert(!json_map_job_);
+    if (!map_generation_)
+        return;
 
-        assert(schema_);
+    assert(extracted_data);
 
-        std::vector<std::string> keys;
+    std::vector<std::string> keys;
 
-        if (current_framing_ == "")
-            keys = {"data_blocks", "content", "records"};
-        else
-            keys = {"frames", "content", "data_blocks", "content", "records"};
+    if (current_framing_ == "")
+        keys = {"data_blocks", "content", "records"};
+    else
+        keys = {"frames", "content", "data_blocks", "content", "records"};
+
+    assert(schema_);
 
+    if (!create_mapping_stubs_)  // test or import
+    {
         json_map_job_ =
             make_shared<JSONMappingJob>(std::move(extracted_data), keys, schema_->parsers());
 
@@ -1041,35 +1054,9 @@ void ASTERIXImportTask::addDecodedASTERIXSlot()
                 &ASTERIXImportTask::mapJSONDoneSlot, Qt::QueuedConnection);
 
         JobManager::instance().addNonBlockingJob(json_map_job_);
-
-        if (decode_job_)
-        {
-            if (maxLoadReached())
-                decode_job_->pause();
-            else
-                decode_job_->unpause();
-        }
     }
     else  // create mappings
     {
-        while (json_map_stub_job_)  // only one can exist at a time
-        {
-            if (decode_job_)
-                decode_job_->pause();
-
-            QCoreApplication::processEvents(QEventLoop::ExcludeUserInputEvents);
-            QThread::msleep(1);
-        }
-
-        assert(json_map_stub_job_ == nullptr);
-
-        std::vector<std::string> keys;
-
-        if (current_framing_ == "")
-            keys = {"data_blocks", "content", "records"};
-        else
-            keys = {"frames", "content", "data_blocks", "content", "records"};
-
         json_map_stub_job_ =
             make_shared<JSONMappingStubsJob>(std::move(extracted_data), keys, schema_->parsers());
         assert(!extracted_data);
@@ -1080,9 +1067,6 @@ void ASTERIXImportTask::addDecodedASTERIXSlot()
                 &ASTERIXImportTask::mapStubsDoneSlot, Qt::QueuedConnection);
 
         JobManager::instance().addNonBlockingJob(json_map_stub_job_);
-
-        if (decode_job_)
-            decode_job_->unpause();
     }
 }
 
@@ -1117,21 +1101,19 @@ void ASTERIXImportTask::mapJSONDoneSlot()
         std::move(json_map_job_->buffers());
     json_map_job_ = nullptr;
 
-    if (decode_job_)
-    {
-        if (maxLoadReached())
-            decode_job_->pause();
-        else
-            decode_job_->unpause();
-    }
-
     if (test_)
     {
+        decoded_data_.release(map_generation_);  // chunk done
+
+        mapDecodedData();
         checkAllDone();
         return;
     }
 
-    insertData(std::move(job_buffers));
+    pending_inserts_.emplace_back(map_generation_, std::move(job_buffers));
+
+    insertPendingData();
+    mapDecodedData();
 }
 
 void ASTERIXImportTask::mapJSONObsoleteSlot()
@@ -1148,9 +1130,11 @@ void ASTERIXImportTask::mapStubsDoneSlot()
     assert(json_map_stub_job_.get() == map_stubs_job);
 
     json_map_stub_job_ = nullptr;
+    decoded_data_.release(map_generation_);  // chunk done
 
     schema_->updateMappings();
 
+    mapDecodedData();
     checkAllDone();
 }
 void ASTERIXImportTask::mapStubsObsoleteSlot()
@@ -1159,6 +1143,19 @@ void ASTERIXImportTask::mapStubsObsoleteSlot()
     json_map_stub_job_ = nullptr;
 }
 
+void ASTERIXImportTask::insertPendingData()
+{
+    // inserts into same DBObject can not run in parallel, so one chunk at a time
+    if (insert_active_ || !pending_inserts_.size())
+        return;
+
+    insert_generation_ = pending_inserts_.front().first;
+    std::map<std::string, std::shared_ptr<Buffer>> job_buffers = std::move(pending_inserts_.front().second);
+    pending_inserts_.pop_front();
+
+    insertData(std::move(job_buffers));
+}
+
 void ASTERIXImportTask::insertData(std::map<std::string, std::shared_ptr<Buffer>> job_buffers)
 {
     logdbg << "ASTERIXImportTask: insertData: inserting into database";
@@ -1195,14 +1192,7 @@ void ASTERIXImportTask::insertData(std::map<std::string, std::shared_ptr<Buffer>
         }
     }
 
-    while (insert_active_)
-    {
-        waiting_for_insert_ = true;
-        QCoreApplication::processEvents(QEventLoop::ExcludeUserInputEvents);
-        QThread::msleep(1);
-    }
-
-    waiting_for_insert_ = false;
+    assert(!insert_active_);
 
     bool has_sac_sic = false;
 
@@ -1327,6 +1317,14 @@ void ASTERIXImportTask::insertData(std::map<std::string, std::shared_ptr<Buffer>
             num_radar_inserted_ += buffer->size(); // store for later check
     }
 
+    if (!insert_active_)  // only empty buffers, chunk done
+    {
+        decoded_data_.release(insert_generation_);
+
+        insertPendingData();
+        mapDecodedData();
+    }
+
     checkAllDone();
 
     logdbg << "JSONImporterTask: insertData: done";
@@ -1341,8 +1339,17 @@ void ASTERIXImportTask::insertProgressSlot(float percent)
 void ASTERIXImportTask::insertDoneSlot(DBObject& object)
 {
     logdbg << "ASTERIXImportTask: insertDoneSlot";
+    assert(insert_active_);
     --insert_active_;
 
+    if (!insert_active_)  // chunk done
+    {
+        decoded_data_.release(insert_generation_);
+        insertPendingData();
+    }
+
+    mapDecodedData();
+
     bool test = test_; // test_ cleared by checkAllDone
 
     checkAllDone();
@@ -1384,11 +1391,13 @@ void ASTERIXImportTask::checkAllDone()
            << (decode_job_ == nullptr)
            //<< " wait map " << !waiting_for_map_
            << " map job " << (json_map_job_ == nullptr) << " map stubs "
-           << (json_map_stub_job_ == nullptr) << " wait insert " << !waiting_for_insert_
+           << (json_map_stub_job_ == nullptr) << " decoded " << decoded_data_.size()
+           << " pending insert " << pending_inserts_.size()
            << " insert active " << (insert_active_ == 0);
 
     if (!all_done_ && decode_job_ == nullptr && json_map_job_ == nullptr &&
-        json_map_stub_job_ == nullptr && !waiting_for_insert_ && insert_active_ == 0)
+        json_map_stub_job_ == nullptr && decoded_data_.empty() && !pending_inserts_.size() &&
+        insert_active_ == 0)
     {
         loginf << "ASTERIXImportTask: checkAllDone: setting all done";
 
@@ -1463,7 +1472,11 @@ void ASTERIXImportTask::closeStatusDialogSlot()
 
 bool ASTERIXImportTask::maxLoadReached()
 {
-    return insert_active_ >= 2;
+    // only hold back mapping if pending insert will free memory, decoder is bounded by credits
+    if (limit_ram_ && (insert_active_ || pending_inserts_.size()))
+        return System::getFreeRAMinGB() < min_free_ram;
+
+    return false;
 
     //    if (limit_ram_)
     //        return json_map_jobs_.size() > limited_num_json_jobs_;
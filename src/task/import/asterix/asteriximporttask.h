@@ -25,6 +25,7 @@
 
 #include "asterixdecodejob.h"
 #include "asterixpostprocess.h"
+#include "boundedchannel.h"
 #include "configurable.h"
 #include "json.hpp"
 #include "jsonmappingjob.h"
@@ -93,6 +94,8 @@ class ASTERIXImportTask : public Task, public Configurable
     const std::string& currentFilename() { return current_filename_; }
 
     std::shared_ptr<jASTERIX::jASTERIX> jASTERIX() { return jasterix_; }
+    /// @brief Returns channel from decoder to mapping, credits are released after insert
+    BoundedChannel<std::unique_ptr<nlohmann::json>>& decodedData() { return decoded_data_; }
     void refreshjASTERIX();
 
     const std::string& currentFraming() const;
@@ -163,8 +166,10 @@ class ASTERIXImportTask : public Task, public Configurable
     std::shared_ptr<JSONParsingSchema> schema_;
 
     std::shared_ptr<ASTERIXDecodeJob> decode_job_;
+    BoundedChannel<std::unique_ptr<nlohmann::json>> decoded_data_{1};  // capacity set in run
 
     std::shared_ptr<JSONMappingJob> json_map_job_;
+    unsigned int map_generation_{0};  // credit generation of chunk being mapped, also by stub job
     // std::deque <std::shared_ptr <JSONMappingJob>> json_map_jobs_;
     // std::mutex map_jobs_mutex_;
     // bool waiting_for_map_ {false};
@@ -175,8 +180,10 @@ class ASTERIXImportTask : public Task, public Configurable
 
     std::unique_ptr<ASTERIXStatusDialog> status_widget_;
 
-    bool waiting_for_insert_{false};
     size_t insert_active_{0};
+    unsigned int insert_generation_{0};  // credit generation of chunk being inserted
+    // credit generation, mapped buffers
+    std::deque<std::pair<unsigned int, std::map<std::string, std::shared_ptr<Buffer>>>> pending_inserts_;
 
     std::map<std::string, std::tuple<std::string, DBOVariableSet>> dbo_variable_sets_;
     std::set<int> added_data_sources_;
@@ -187,6 +194,10 @@ class ASTERIXImportTask : public Task, public Configurable
 
     virtual void checkSubConfigurables();
 
+    // starts mapping of next decoded chunk if possible
+    void mapDecodedData();
+    // starts insert of next mapped chunk if no insert is active
+    void insertPendingData();
     void insertData(std::map<std::string, std::shared_ptr<Buffer>> job_buffers);
     void checkAllDone();
 
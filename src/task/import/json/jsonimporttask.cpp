@@ -58,6 +58,7 @@ using namespace nlohmann;
 using namespace std;
 
 const unsigned int num_objects_chunk = 10000;
+const unsigned int chunks_in_flight = 4;  // read chunks between reader and finished insert
 
 const std::string DONE_PROPERTY_NAME = "json_data_imported";
 
@@ -381,13 +382,21 @@ void JSONImportTask::run()
 
     QApplication::setOverrideCursor(QCursor(Qt::WaitCursor));
 
+    insert_active_ = 0;
+    pending_inserts_.clear();
+    map_generations_.clear();
+
+    read_objects_.reset(chunks_in_flight);
+
 #if USE_JASTERIX
     if (current_schema_ == "jASTERIX")
-        read_json_job_ = std::make_shared<ReadJSONFileJob>(current_filename_, 1);
+        read_json_job_ = std::make_shared<ReadJSONFileJob>(current_filename_, 1, read_objects_);
     else
-        read_json_job_ = std::make_shared<ReadJSONFileJob>(current_filename_, num_objects_chunk);
+        read_json_job_ =
+            std::make_shared<ReadJSONFileJob>(current_filename_, num_objects_chunk, read_objects_);
 #else
-    read_json_job_ = std::make_shared<ReadJSONFileJob>(current_filename_, num_objects_chunk);
+    read_json_job_ =
+        std::make_shared<ReadJSONFileJob>(current_filename_, num_objects_chunk, read_objects_);
 #endif
 
     connect(read_json_job_.get(), &ReadJSONFileJob::readJSONFilePartSignal, this,
@@ -408,37 +417,40 @@ void JSONImportTask::addReadJSONSlot()
 {
     loginf << "JSONImporterTask: addReadJSONSlot";
 
-    assert(read_json_job_);
+    if (all_done_)  // objects already processed after earlier signal
+        return;
 
-    loginf << "JSONImporterTask: addReadJSONSlot: moving objects";
+    if (read_json_job_)  // can be done before signal is processed
+    {
+        bytes_read_ = read_json_job_->bytesRead();
+        bytes_to_read_ = read_json_job_->bytesToRead();
+        read_status_percent_ = read_json_job_->getStatusPercent();
+        loginf << "JSONImporterTask: addReadJSONSlot: bytes " << bytes_read_ << " to read "
+               << bytes_to_read_ << " percent " << read_status_percent_;
+    }
 
-//    if (maxLoadReached())
-//        read_json_job_->pause();
+    parseReadData();
 
-    std::vector<std::string> objects = read_json_job_->objects();
+    loginf << "JSONImporterTask: addReadJSONSlot: updating message box";
+    updateMsgBox();
+}
 
-    bytes_read_ = read_json_job_->bytesRead();
-    bytes_to_read_ = read_json_job_->bytesToRead();
-    read_status_percent_ = read_json_job_->getStatusPercent();
-    objects_read_ += objects.size();
-    loginf << "JSONImporterTask: addReadJSONSlot: bytes " << bytes_read_ << " to read "
-           << bytes_to_read_ << " percent " << read_status_percent_;
+void JSONImportTask::parseReadData()
+{
+    // only one parse job can exist at a time, reader is blocked by channel if all credits used
+    if (json_parse_job_)
+        return;
 
-    while (json_parse_job_)  // only one can exist at a time
-    {
-        if (read_json_job_)
-            read_json_job_->pause();
+    std::vector<std::string> objects;
 
-        updateMsgBox();
+    parse_generation_ = read_objects_.tryPop(objects);
 
-        QCoreApplication::processEvents(QEventLoop::ExcludeUserInputEvents);
-        QThread::msleep(10);
-    }
+    if (!parse_generation_)
+        return;
 
-    // start parse job
-    assert (!json_parse_job_);
+    objects_read_ += objects.size();
 
-    loginf << "JSONImporterTask: addReadJSONSlot: starting parse job";
+    loginf << "JSONImporterTask: parseReadData: starting parse job";
     json_parse_job_ =
             std::make_shared<JSONParseJob>(std::move(objects), current_schema_, post_process_);
 
@@ -448,9 +460,6 @@ void JSONImportTask::addReadJSONSlot()
             &JSONImportTask::parseJSONDoneSlot, Qt::QueuedConnection);
 
     JobManager::instance().addNonBlockingJob(json_parse_job_);
-
-    loginf << "JSONImporterTask: addReadJSONSlot: updating message box";
-    updateMsgBox();
 }
 
 void JSONImportTask::readJSONFileDoneSlot()
@@ -534,18 +543,13 @@ void JSONImportTask::parseJSONDoneSlot()
             Qt::QueuedConnection);
 
     json_map_jobs_.push_back(json_map_job);
+    map_generations_.push_back(parse_generation_);
 
     JobManager::instance().addNonBlockingJob(json_map_job);
 
-    updateMsgBox();
+    parseReadData();
 
-    if (read_json_job_)
-    {
-        if (maxLoadReached())
-            read_json_job_->pause();
-        else
-            read_json_job_->unpause();
-    }
+    updateMsgBox();
 
     loginf << "JSONImporterTask: parseJSONDoneSlot: done";
 }
@@ -575,12 +579,19 @@ void JSONImportTask::mapJSONDoneSlot()
 
     json_map_jobs_.erase(json_map_jobs_.begin());
 
+    assert (map_generations_.size());
+    unsigned int generation = map_generations_.front();
+    map_generations_.pop_front();
+
     for (auto& buf_it : job_buffers)
         if (buf_it.second && buf_it.second->size())
             objects_mapped_ += buf_it.second->size();
 
     if (test_ || !objects_mapped_)
     {
+        read_objects_.release(generation);  // chunk done
+
+        parseReadData();
         checkAllDone();
         updateMsgBox();
         return;
@@ -588,21 +599,27 @@ void JSONImportTask::mapJSONDoneSlot()
 
     updateMsgBox();
 
-    if (read_json_job_)
-    {
-        if (maxLoadReached())
-            read_json_job_->pause();
-        else
-            read_json_job_->unpause();
-    }
-
-    insertData(std::move(job_buffers));
+    pending_inserts_.emplace_back(generation, std::move(job_buffers));
+    insertPendingData();
 
     logdbg << "JSONImporterTask: mapJSONDoneSlot: done";
 }
 
 void JSONImportTask::mapJSONObsoleteSlot() { logdbg << "JSONImporterTask: mapJSONObsoleteSlot"; }
 
+void JSONImportTask::insertPendingData()
+{
+    // inserts into same DBObject can not run in parallel, so one chunk at a time
+    if (insert_active_ || !pending_inserts_.size())
+        return;
+
+    insert_generation_ = pending_inserts_.front().first;
+    std::map<std::string, std::shared_ptr<Buffer>> job_buffers = std::move(pending_inserts_.front().second);
+    pending_inserts_.pop_front();
+
+    insertData(std::move(job_buffers));
+}
+
 void JSONImportTask::insertData(std::map<std::string, std::shared_ptr<Buffer>> job_buffers)
 {
     loginf << "JSONImporterTask: insertData: inserting into database";
@@ -650,11 +667,7 @@ void JSONImportTask::insertData(std::map<std::string, std::shared_ptr<Buffer>> j
         }
     }
 
-    while (insert_active_)
-    {
-        QCoreApplication::processEvents(QEventLoop::ExcludeUserInputEvents);
-        QThread::msleep(1);
-    }
+    assert(!insert_active_);
 
     bool has_sac_sic = false;
 
@@ -796,6 +809,15 @@ void JSONImportTask::insertData(std::map<std::string, std::shared_ptr<Buffer>> j
         // status_widget_->addNumInserted(db_object.name(), buffer->size());
     }
 
+    if (!insert_active_)  // only empty buffers, chunk done
+    {
+        read_objects_.release(insert_generation_);
+
+        insertPendingData();
+        parseReadData();
+        checkAllDone();
+    }
+
     logdbg << "JSONImporterTask: insertData: done";
 }
 
@@ -805,10 +827,13 @@ void JSONImportTask::checkAllDone()
 
     loginf << "JSONImporterTask: checkAllDone: all done " << all_done_ << " read "
            << (read_json_job_ == nullptr) << " parse jobs " << (json_parse_job_ == nullptr)
-           << " map jobs " << json_map_jobs_.empty() << " insert active " << (insert_active_ == 0);
+           << " map jobs " << json_map_jobs_.empty() << " read " << read_objects_.size()
+           << " pending insert " << pending_inserts_.size() << " insert active "
+           << (insert_active_ == 0);
 
     if (!all_done_ && read_json_job_ == nullptr && json_parse_job_ == nullptr &&
-            json_map_jobs_.size() == 0 && insert_active_ == 0)
+            json_map_jobs_.size() == 0 && read_objects_.empty() && !pending_inserts_.size() &&
+            insert_active_ == 0)
     {
         stop_time_ = boost::posix_time::microsec_clock::local_time();
 
@@ -1003,11 +1028,6 @@ void JSONImportTask::updateMsgBox()
     logdbg << "JSONImporterTask: updateMsgBox: done";
 }
 
-bool JSONImportTask::maxLoadReached()
-{
-    return json_parse_job_ != nullptr || json_map_jobs_.size() > 2;
-}
-
 void JSONImportTask::insertProgressSlot(float percent)
 {
     logdbg << "JSONImporterTask: insertProgressSlot: " << String::percentToString(percent) << "%";
@@ -1016,8 +1036,17 @@ void JSONImportTask::insertProgressSlot(float percent)
 void JSONImportTask::insertDoneSlot(DBObject& object)
 {
     logdbg << "JSONImporterTask: insertDoneSlot";
+    assert(insert_active_);
     --insert_active_;
 
+    if (!insert_active_)  // chunk done
+    {
+        read_objects_.release(insert_generation_);
+
+        insertPendingData();
+        parseReadData();
+    }
+
     checkAllDone();
     updateMsgBox();
 
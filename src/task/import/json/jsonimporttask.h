@@ -18,6 +18,7 @@
 #ifndef JSONIMPORTERTASK_H
 #define JSONIMPORTERTASK_H
 
+#include "boundedchannel.h"
 #include "configurable.h"
 #include "json.hpp"
 #include "jsonparsingschema.h"
@@ -25,6 +26,7 @@
 #include "asterixpostprocess.h"
 
 #include <QObject>
+#include <deque>
 #include <memory>
 #include <set>
 
@@ -115,13 +117,20 @@ class JSONImportTask : public Task, public Configurable
     ASTERIXPostProcess post_process_;
 
     size_t insert_active_{0};
+    unsigned int insert_generation_{0};  // credit generation of chunk being inserted
+    // credit generation, mapped buffers
+    std::deque<std::pair<unsigned int, std::map<std::string, std::shared_ptr<Buffer>>>> pending_inserts_;
 
     std::map<std::string, std::tuple<std::string, DBOVariableSet>> dbo_variable_sets_;
     std::set<int> added_data_sources_;
 
     std::shared_ptr<ReadJSONFileJob> read_json_job_;
+    // read objects, credits are released after insert
+    BoundedChannel<std::vector<std::string>> read_objects_{1};  // capacity set in run
     std::shared_ptr<JSONParseJob> json_parse_job_;
+    unsigned int parse_generation_{0};  // credit generation of chunk being parsed
     std::vector<std::shared_ptr<JSONMappingJob>> json_map_jobs_;
+    std::deque<unsigned int> map_generations_;  // credit generations of json_map_jobs_
 
     bool test_{false};
 
@@ -151,14 +160,16 @@ class JSONImportTask : public Task, public Configurable
 
     std::unique_ptr<QMessageBox> msg_box_;
 
+    // starts parsing of next read chunk if possible
+    void parseReadData();
+    // starts insert of next mapped chunk if no insert is active
+    void insertPendingData();
     void insertData(std::map<std::string, std::shared_ptr<Buffer>> job_buffers);
 
     void checkAllDone();
 
     void updateMsgBox();
 
-    bool maxLoadReached();
-
     virtual void checkSubConfigurables() {}
 };
 
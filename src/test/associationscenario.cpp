@@ -0,0 +1,306 @@
+/*
+ * This file is part of OpenATS COMPASS.
+ *
+ * COMPASS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * COMPASS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with COMPASS. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "associationscenario.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <random>
+
+using namespace std;
+
+namespace
+{
+const double meters_per_deg = 111320.0;
+
+/// @brief Random numbers from mt19937 only, standard distributions are implementation defined
+class ScenarioRandom
+{
+  public:
+    ScenarioRandom(unsigned int seed) : engine_(seed) {}
+
+    double uniform(double min, double max)
+    {
+        return min + (max - min) * (engine_() / 4294967296.0);
+    }
+
+    bool chance(double probability) { return uniform(0, 1) < probability; }
+
+    double normal(double std_dev)  // box-muller
+    {
+        double u1 = 1.0 - uniform(0, 1);  // (0, 1]
+        double u2 = uniform(0, 1);
+        return std_dev * sqrt(-2.0 * log(u1)) * cos(2.0 * M_PI * u2);
+    }
+
+    unsigned int index(unsigned int size) { return engine_() % size; }
+
+  protected:
+    mt19937 engine_;
+};
+}  // namespace
+
+AssociationScenario::AssociationScenario(const AssociationScenarioConfig& config) : config_(config)
+{
+    assert(config_.duration_ > 0);
+    assert(config_.radar_period_ > 0);
+    assert(config_.tracker_period_ > 0);
+
+    createAircraft();
+    createRadarReports();
+
+    if (config_.tracker_)
+        createTrackerReports();
+}
+
+void AssociationScenario::createAircraft()
+{
+    ScenarioRandom random(config_.seed_);
+
+    aircraft_.resize(config_.num_aircraft_);
+
+    float tod_end = config_.start_tod_ + config_.duration_;
+
+    for (auto& aircraft : aircraft_)
+    {
+        // start in area, fly for at least a tenth of the duration
+        aircraft.tod_begin_ = random.uniform(config_.start_tod_, tod_end - config_.duration_ / 10.0);
+        aircraft.tod_end_ = random.uniform(aircraft.tod_begin_ + config_.duration_ / 10.0, tod_end);
+
+        double distance = config_.area_radius_ * sqrt(random.uniform(0, 1));
+        double angle = random.uniform(0, 2 * M_PI);
+        aircraft.x_ = distance * cos(angle);
+        aircraft.y_ = distance * sin(angle);
+
+        double speed = random.uniform(60, 250);  // m/s
+        double heading = random.uniform(0, 2 * M_PI);
+        aircraft.vx_ = speed * sin(heading);
+        aircraft.vy_ = speed * cos(heading);
+
+        aircraft.has_ta_ = random.chance(config_.mode_s_ratio_);
+        aircraft.has_mode_ac_ = aircraft.has_ta_ || random.chance(config_.mode_ac_ratio_);
+
+        if (aircraft.has_ta_)
+            aircraft.ta_ = 0x400000 + random.index(0x100000);
+
+        if (aircraft.has_mode_ac_)
+        {
+            aircraft.ma_ = random.index(4096);
+            aircraft.mc_ = 100 * (10 + random.index(400));  // ft
+        }
+    }
+}
+
+void AssociationScenario::createRadarReports()
+{
+    ScenarioRandom random(config_.seed_ + 1);
+
+    float tod_end = config_.start_tod_ + config_.duration_;
+
+    for (unsigned int radar_cnt = 0; radar_cnt < config_.num_radars_; ++radar_cnt)
+    {
+        int sac = 10;
+        int sic = radar_cnt + 1;
+        int ds_id = sac * 255 + sic;
+
+        radar_sources_[ds_id] = {sac, sic};
+
+        double distance = config_.area_radius_ * sqrt(random.uniform(0, 1));
+        double angle = random.uniform(0, 2 * M_PI);
+        double radar_x = distance * cos(angle);
+        double radar_y = distance * sin(angle);
+
+        unsigned int hash_cnt = 0;
+        double x, y;
+
+        for (float tod = config_.start_tod_ + random.uniform(0, config_.radar_period_); tod < tod_end;
+             tod += config_.radar_period_)
+        {
+            for (unsigned int aircraft_cnt = 0; aircraft_cnt < aircraft_.size(); ++aircraft_cnt)
+            {
+                const Aircraft& aircraft = aircraft_[aircraft_cnt];
+
+                if (tod < aircraft.tod_begin_ || tod > aircraft.tod_end_)
+                    continue;
+
+                position(aircraft, tod, x, y);
+
+                if (sqrt(pow(x - radar_x, 2) + pow(y - radar_y, 2)) > config_.radar_range_)
+                    continue;
+
+                if (!random.chance(config_.radar_pd_))
+                    continue;
+
+                SyntheticTargetReport tr;
+
+                tr.truth_id_ = aircraft_cnt;
+                tr.ds_id_ = ds_id;
+                tr.tod_ = tod;
+
+                toLatLong(x + random.normal(config_.radar_noise_),
+                          y + random.normal(config_.radar_noise_), tr.latitude_, tr.longitude_);
+
+                tr.has_ta_ = aircraft.has_ta_;
+                tr.ta_ = aircraft.ta_;
+                tr.has_ma_ = aircraft.has_mode_ac_;
+                tr.ma_ = aircraft.ma_;
+                tr.has_mc_ = aircraft.has_mode_ac_;
+                tr.mc_ = aircraft.mc_;
+
+                tr.hash_ = to_string(ds_id) + ":" + to_string(hash_cnt++);
+
+                radar_reports_.push_back(tr);
+            }
+        }
+    }
+
+    stable_sort(radar_reports_.begin(), radar_reports_.end(),
+                [](const SyntheticTargetReport& a, const SyntheticTargetReport& b) {
+                    return a.tod_ < b.tod_;
+                });
+
+    int rec_num = 1;
+    for (auto& tr : radar_reports_)
+        tr.rec_num_ = rec_num++;
+}
+
+void AssociationScenario::createTrackerReports()
+{
+    ScenarioRandom random(config_.seed_ + 2);
+
+    int sac = 20;
+    int sic = 1;
+    int ds_id = sac * 255 + sic;
+
+    tracker_sources_[ds_id] = {sac, sic};
+
+    // radar reports per aircraft, in time order
+    vector<vector<const SyntheticTargetReport*>> aircraft_radar_reports(aircraft_.size());
+
+    for (auto& tr : radar_reports_)
+        aircraft_radar_reports[tr.truth_id_].push_back(&tr);
+
+    // track number swaps, at most once per aircraft
+    vector<int> swap_partners(aircraft_.size(), -1);
+    vector<float> swap_tods(aircraft_.size(), 0);
+
+    unsigned int num_swaps = config_.track_swap_ratio_ * aircraft_.size() / 2;
+
+    for (unsigned int swap_cnt = 0; swap_cnt < num_swaps && aircraft_.size() > 1; ++swap_cnt)
+    {
+        unsigned int first = random.index(aircraft_.size());
+        unsigned int second = random.index(aircraft_.size());
+
+        if (first == second || swap_partners[first] != -1 || swap_partners[second] != -1)
+            continue;
+
+        float overlap_begin = max(aircraft_[first].tod_begin_, aircraft_[second].tod_begin_);
+        float overlap_end = min(aircraft_[first].tod_end_, aircraft_[second].tod_end_);
+
+        if (overlap_begin >= overlap_end)
+            continue;
+
+        swap_partners[first] = second;
+        swap_partners[second] = first;
+        swap_tods[first] = swap_tods[second] = random.uniform(overlap_begin, overlap_end);
+    }
+
+    double x, y;
+
+    for (unsigned int aircraft_cnt = 0; aircraft_cnt < aircraft_.size(); ++aircraft_cnt)
+    {
+        const Aircraft& aircraft = aircraft_[aircraft_cnt];
+        const vector<const SyntheticTargetReport*>& radar_trs = aircraft_radar_reports[aircraft_cnt];
+        unsigned int radar_tr_cnt = 0;
+
+        for (float tod = aircraft.tod_begin_ + random.uniform(0, config_.tracker_period_);
+             tod <= aircraft.tod_end_; tod += config_.tracker_period_)
+        {
+            SyntheticTargetReport tr;
+
+            tr.truth_id_ = aircraft_cnt;
+            tr.ds_id_ = ds_id;
+            tr.tod_ = tod;
+
+            position(aircraft, tod, x, y);
+            toLatLong(x + random.normal(config_.tracker_noise_),
+                      y + random.normal(config_.tracker_noise_), tr.latitude_, tr.longitude_);
+
+            tr.has_ta_ = aircraft.has_ta_;
+            tr.ta_ = aircraft.ta_;
+            tr.has_ma_ = aircraft.has_mode_ac_;
+            tr.ma_ = aircraft.ma_;
+            tr.has_mc_ = aircraft.has_mode_ac_;
+            tr.mc_ = aircraft.mc_;
+
+            tr.has_tn_ = true;
+            if (swap_partners[aircraft_cnt] != -1 && tod >= swap_tods[aircraft_cnt])
+                tr.tn_ = swap_partners[aircraft_cnt] + 1;
+            else
+                tr.tn_ = aircraft_cnt + 1;
+
+            // tris of radar reports since last update
+            while (radar_tr_cnt < radar_trs.size() && radar_trs[radar_tr_cnt]->tod_ <= tod)
+            {
+                if (tr.hash_.size())
+                    tr.hash_ += ";";
+
+                tr.hash_ += radar_trs[radar_tr_cnt]->hash_;
+                ++radar_tr_cnt;
+            }
+
+            tracker_reports_.push_back(tr);
+        }
+    }
+
+    stable_sort(tracker_reports_.begin(), tracker_reports_.end(),
+                [](const SyntheticTargetReport& a, const SyntheticTargetReport& b) {
+                    return a.tod_ < b.tod_;
+                });
+
+    int rec_num = 1;
+    map<int, SyntheticTargetReport*> last_updates;  // tn -> tr
+
+    for (auto& tr : tracker_reports_)
+    {
+        tr.rec_num_ = rec_num++;
+
+        if (!last_updates.count(tr.tn_))
+            tr.track_begin_ = true;
+
+        last_updates[tr.tn_] = &tr;
+    }
+
+    for (auto& last_it : last_updates)
+        last_it.second->track_end_ = true;
+}
+
+void AssociationScenario::position(const Aircraft& aircraft, float tod, double& x, double& y) const
+{
+    double time_diff = tod - aircraft.tod_begin_;
+
+    x = aircraft.x_ + aircraft.vx_ * time_diff;
+    y = aircraft.y_ + aircraft.vy_ * time_diff;
+}
+
+void AssociationScenario::toLatLong(double x, double y, double& latitude, double& longitude) const
+{
+    latitude = config_.center_latitude_ + y / meters_per_deg;
+    longitude = config_.center_longitude_ +
+                x / (meters_per_deg * cos(config_.center_latitude_ * M_PI / 180.0));
+}
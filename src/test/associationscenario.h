@@ -0,0 +1,136 @@
+/*
+ * This file is part of OpenATS COMPASS.
+ *
+ * COMPASS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * COMPASS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with COMPASS. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef ASSOCIATIONSCENARIO_H
+#define ASSOCIATIONSCENARIO_H
+
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+/// @brief Parameters of a synthetic association scenario, all random values depend only on seed
+struct AssociationScenarioConfig
+{
+    unsigned int seed_{42};
+
+    unsigned int num_aircraft_{100};
+    float start_tod_{36000};  // s
+    float duration_{3600};    // s
+
+    double center_latitude_{47.5};   // deg
+    double center_longitude_{14.0};  // deg
+    double area_radius_{150000};     // m
+
+    float mode_s_ratio_{0.7};   // aircraft with target address
+    float mode_ac_ratio_{0.9};  // aircraft without target address with mode a/c, others primary only
+
+    unsigned int num_radars_{3};
+    double radar_range_{250000};  // m
+    float radar_period_{4.0};     // s
+    float radar_pd_{0.9};         // detection probability
+    double radar_noise_{100};     // m, position standard deviation
+
+    bool tracker_{true};
+    float tracker_period_{4.0};     // s
+    double tracker_noise_{30};      // m, position standard deviation
+    float track_swap_ratio_{0.02};  // aircraft whose track number is swapped with another one
+};
+
+/// @brief Synthetic target report with ground truth
+struct SyntheticTargetReport
+{
+    unsigned int truth_id_{0};  // aircraft index
+    int rec_num_{0};
+    int ds_id_{0};
+    float tod_{0};
+
+    double latitude_{0};
+    double longitude_{0};
+
+    bool has_ta_{false};
+    int ta_{0};
+    bool has_ma_{false};
+    int ma_{0};
+    bool has_mc_{false};
+    int mc_{0};  // ft
+
+    bool has_tn_{false};
+    int tn_{0};
+    bool track_begin_{false};
+    bool track_end_{false};
+
+    std::string hash_;  // own hash for sensors, TRIs for tracker
+};
+
+/**
+ * @brief Generates aircraft on straight trajectories and the target reports of radars and a tracker
+ *
+ * Radars rotate with a fixed period and random phase, detect with the configured probability and add
+ * gaussian position noise. The tracker updates every aircraft with its own period phase, references
+ * the radar reports since its previous update as TRIs and swaps track numbers of configured aircraft
+ * pairs once. Reports are sorted by time, rec_nums are assigned per DBObject in that order.
+ */
+class AssociationScenario
+{
+  public:
+    AssociationScenario(const AssociationScenarioConfig& config);
+
+    const AssociationScenarioConfig& config() const { return config_; }
+
+    const std::vector<SyntheticTargetReport>& radarReports() const { return radar_reports_; }
+    const std::vector<SyntheticTargetReport>& trackerReports() const { return tracker_reports_; }
+
+    /// @brief Returns ds_id -> (sac, sic)
+    const std::map<int, std::pair<int, int>>& radarDataSources() const { return radar_sources_; }
+    const std::map<int, std::pair<int, int>>& trackerDataSources() const { return tracker_sources_; }
+
+  protected:
+    struct Aircraft
+    {
+        float tod_begin_{0};
+        float tod_end_{0};
+        double x_{0};  // m, at tod_begin
+        double y_{0};
+        double vx_{0};  // m/s
+        double vy_{0};
+        bool has_ta_{false};
+        int ta_{0};
+        bool has_mode_ac_{false};
+        int ma_{0};
+        int mc_{0};
+    };
+
+    AssociationScenarioConfig config_;
+
+    std::vector<Aircraft> aircraft_;
+
+    std::vector<SyntheticTargetReport> radar_reports_;
+    std::vector<SyntheticTargetReport> tracker_reports_;
+
+    std::map<int, std::pair<int, int>> radar_sources_;
+    std::map<int, std::pair<int, int>> tracker_sources_;
+
+    void createAircraft();
+    void createRadarReports();
+    void createTrackerReports();
+
+    void position(const Aircraft& aircraft, float tod, double& x, double& y) const;
+    void toLatLong(double x, double y, double& latitude, double& longitude) const;
+};
+
+#endif  // ASSOCIATIONSCENARIO_H
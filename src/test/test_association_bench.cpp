@@ -0,0 +1,580 @@
+/*
+ * This file is part of OpenATS COMPASS.
+ *
+ * COMPASS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * COMPASS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with COMPASS. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define CATCH_CONFIG_RUNNER
+#include <QThread>
+
+#include "associationscenario.h"
+#include "buffer.h"
+#include "catch.hpp"
+#include "client.h"
+#include "compass.h"
+#include "createartasassociationsjob.h"
+#include "createartasassociationstask.h"
+#include "createassociationsjob.h"
+#include "createassociationstask.h"
+#include "databaseopentask.h"
+#include "dbinterface.h"
+#include "dbobject.h"
+#include "dbobjectmanager.h"
+#include "dbovariable.h"
+#include "dbovariableset.h"
+#include "files.h"
+#include "json.hpp"
+#include "logger.h"
+#include "mainwindow.h"
+#include "managedatasourcestask.h"
+#include "metadbovariable.h"
+#include "postprocesstask.h"
+#include "sqliteconnectionwidget.h"
+#include "taskmanager.h"
+#include "taskmanagerwidget.h"
+#include "tracer.h"
+
+#include <chrono>
+#include <fstream>
+
+using namespace Utils;
+using namespace nlohmann;
+
+std::string data_path;
+std::string report_filename{"association_bench.json"};
+
+AssociationScenarioConfig scenario_config;
+
+double min_purity{0};
+double min_completeness{0};
+
+namespace
+{
+const std::string radar_dbo_name{"Radar"};
+const std::string tracker_dbo_name{"Tracker"};
+
+void processEvents(Client& client)
+{
+    while (client.hasPendingEvents())
+        client.processEvents();
+}
+
+/// @brief Creates buffer with all variables needed for insertion and both association jobs
+std::shared_ptr<Buffer> createBuffer(const std::string& dbo_name,
+                                     const std::vector<SyntheticTargetReport>& trs,
+                                     DBOVariableSet& var_set)
+{
+    TaskManager& task_man = COMPASS::instance().taskManager();
+    CreateAssociationsTask& task = task_man.createAssociationsTask();
+    CreateARTASAssociationsTask& artas_task = task_man.createArtasAssociationsTask();
+
+    DBObject& dbo = COMPASS::instance().objectManager().object(dbo_name);
+    bool is_tracker = dbo_name == tracker_dbo_name;
+
+    DBOVariable& sac_var = dbo.variable("sac");
+    DBOVariable& sic_var = dbo.variable("sic");
+    DBOVariable& key_var = task.keyVar()->getFor(dbo_name);
+    DBOVariable& ds_id_var = task.dsIdVar()->getFor(dbo_name);
+    DBOVariable& tod_var = task.todVar()->getFor(dbo_name);
+    DBOVariable& ta_var = task.targetAddrVar()->getFor(dbo_name);
+    DBOVariable& ti_var = task.targetIdVar()->getFor(dbo_name);
+    DBOVariable& m3a_var = task.mode3AVar()->getFor(dbo_name);
+    DBOVariable& mc_var = task.modeCVar()->getFor(dbo_name);
+    DBOVariable& lat_var = task.latitudeVar()->getFor(dbo_name);
+    DBOVariable& long_var = task.longitudeVar()->getFor(dbo_name);
+    DBOVariable& hash_var = artas_task.hashVar()->getFor(dbo_name);
+
+    std::vector<DBOVariable*> vars{&sac_var, &sic_var, &key_var, &ds_id_var, &tod_var, &ta_var,
+                                   &ti_var, &m3a_var, &mc_var, &lat_var, &long_var, &hash_var};
+
+    DBOVariable* tn_var{nullptr};
+    DBOVariable* tr_end_var{nullptr};
+    DBOVariable* tr_begin_var{nullptr};
+    DBOVariable* tr_coasting_var{nullptr};
+
+    if (task.trackNumVar()->existsIn(dbo_name))
+    {
+        tn_var = &task.trackNumVar()->getFor(dbo_name);
+        vars.push_back(tn_var);
+    }
+
+    if (task.trackEndVar()->existsIn(dbo_name))
+    {
+        tr_end_var = &task.trackEndVar()->getFor(dbo_name);
+        vars.push_back(tr_end_var);
+    }
+
+    if (is_tracker)
+    {
+        tr_begin_var = &dbo.variable(artas_task.trackerTrackBeginVarStr());
+        tr_coasting_var = &dbo.variable(artas_task.trackerTrackCoastingVarStr());
+        vars.push_back(tr_begin_var);
+        vars.push_back(tr_coasting_var);
+    }
+
+    PropertyList properties;
+
+    for (auto var_it : vars)
+    {
+        var_set.add(*var_it);
+        properties.addProperty(var_it->name(), var_it->dataType());
+    }
+
+    std::shared_ptr<Buffer> buffer = std::make_shared<Buffer>(properties, dbo_name);
+
+    NullableVector<unsigned char>& sacs = buffer->get<unsigned char>(sac_var.name());
+    NullableVector<unsigned char>& sics = buffer->get<unsigned char>(sic_var.name());
+    NullableVector<int>& rec_nums = buffer->get<int>(key_var.name());
+    NullableVector<int>& ds_ids = buffer->get<int>(ds_id_var.name());
+    NullableVector<float>& tods = buffer->get<float>(tod_var.name());
+    NullableVector<int>& tas = buffer->get<int>(ta_var.name());
+    NullableVector<int>& m3as = buffer->get<int>(m3a_var.name());
+    NullableVector<int>& mcs = buffer->get<int>(mc_var.name());
+    NullableVector<double>& lats = buffer->get<double>(lat_var.name());
+    NullableVector<double>& longs = buffer->get<double>(long_var.name());
+    NullableVector<std::string>& hashes = buffer->get<std::string>(hash_var.name());
+
+    unsigned int cnt = 0;
+
+    for (auto& tr : trs)
+    {
+        sacs.set(cnt, tr.ds_id_ / 255);
+        sics.set(cnt, tr.ds_id_ % 255);
+        rec_nums.set(cnt, tr.rec_num_);
+        ds_ids.set(cnt, tr.ds_id_);
+        tods.set(cnt, tr.tod_);
+
+        if (tr.has_ta_)
+            tas.set(cnt, tr.ta_);
+
+        if (tr.has_ma_)
+            m3as.set(cnt, tr.ma_);
+
+        if (tr.has_mc_)
+            mcs.set(cnt, tr.mc_);
+
+        lats.set(cnt, tr.latitude_);
+        longs.set(cnt, tr.longitude_);
+
+        if (tr.hash_.size())
+            hashes.set(cnt, tr.hash_);
+
+        if (tn_var && tr.has_tn_)
+            buffer->get<int>(tn_var->name()).set(cnt, tr.tn_);
+
+        if (tr_end_var && tr.has_tn_)
+            buffer->get<std::string>(tr_end_var->name()).set(cnt, tr.track_end_ ? "Y" : "N");
+
+        if (is_tracker)
+        {
+            buffer->get<std::string>(tr_begin_var->name()).set(cnt, tr.track_begin_ ? "Y" : "N");
+            buffer->get<std::string>(tr_coasting_var->name()).set(cnt, "N");
+        }
+
+        ++cnt;
+    }
+
+    return buffer;
+}
+
+std::map<std::string, std::shared_ptr<Buffer>> createBuffers(const AssociationScenario& scenario)
+{
+    DBOVariableSet var_set;
+
+    return {{radar_dbo_name, createBuffer(radar_dbo_name, scenario.radarReports(), var_set)},
+            {tracker_dbo_name, createBuffer(tracker_dbo_name, scenario.trackerReports(), var_set)}};
+}
+
+void insertData(Client& client, const std::string& dbo_name,
+                const std::vector<SyntheticTargetReport>& trs,
+                std::map<int, std::pair<int, int>> data_sources)
+{
+    loginf << "AssociationBench: insertData: dbo " << dbo_name << " target reports " << trs.size();
+
+    DBObject& dbo = COMPASS::instance().objectManager().object(dbo_name);
+
+    dbo.addDataSources(data_sources);
+
+    bool insert_done = false;
+    QMetaObject::Connection connection = QObject::connect(
+        &dbo, &DBObject::insertDoneSignal, [&insert_done](DBObject&) { insert_done = true; });
+
+    DBOVariableSet var_set;
+    std::shared_ptr<Buffer> buffer = createBuffer(dbo_name, trs, var_set);
+
+    dbo.insertData(var_set, buffer, false);
+
+    while (!insert_done)
+    {
+        client.processEvents();
+        QThread::msleep(1);
+    }
+
+    QObject::disconnect(connection);
+
+    COMPASS::instance().interface().setProperty(PostProcessTask::DONE_PROPERTY_NAME, "0");
+    COMPASS::instance().interface().databaseContentChanged();
+    dbo.updateToDatabaseContent();
+}
+
+/// @brief Returns summed span duration in s per span name, from the written trace
+std::map<std::string, double> phaseTimes(const std::string& trace_filename)
+{
+    std::map<std::string, double> phase_times;
+
+    std::ifstream input(trace_filename);
+    json trace = json::parse(input);
+
+    for (auto& event_it : trace.at("traceEvents"))
+    {
+        if (!event_it.contains("dur"))
+            continue;
+
+        std::string name = event_it.at("name");
+        phase_times[name] += event_it.at("dur").get<double>() / 1e6;
+    }
+
+    return phase_times;
+}
+
+/// @brief Runs job with tracing, returns total time in s
+template <class JobType>
+double runJob(JobType& job, const std::string& trace_filename,
+              std::map<std::string, double>& phase_times)
+{
+    Tracer::instance().start(trace_filename);
+
+    auto start = std::chrono::steady_clock::now();
+    job.run();
+    auto stop = std::chrono::steady_clock::now();
+
+    Tracer::instance().write();
+
+    phase_times = phaseTimes(trace_filename);
+
+    return std::chrono::duration<double>(stop - start).count();
+}
+
+/// @brief Association quality against ground truth
+struct AssociationMetrics
+{
+    size_t num_target_reports{0};
+    size_t num_associated{0};
+    size_t num_utns{0};
+    double purity{0};        // fraction of associated reports belonging to main aircraft of their utn
+    double completeness{0};  // fraction of reports in the main utn of their aircraft
+
+    json asJSON() const
+    {
+        return {{"target_reports", num_target_reports},
+                {"associated", num_associated},
+                {"utns", num_utns},
+                {"purity", purity},
+                {"completeness", completeness}};
+    }
+};
+
+AssociationMetrics calculateMetrics(const AssociationScenario& scenario)
+{
+    DBObjectManager& object_man = COMPASS::instance().objectManager();
+
+    std::map<unsigned int, std::map<unsigned int, size_t>> utn_truth_counts;  // utn -> truth -> cnt
+    std::map<unsigned int, std::map<unsigned int, size_t>> truth_utn_counts;  // truth -> utn -> cnt
+    std::map<unsigned int, size_t> truth_counts;                              // truth -> cnt
+
+    AssociationMetrics metrics;
+
+    auto add = [&](const std::string& dbo_name, const std::vector<SyntheticTargetReport>& trs) {
+        const DBOAssociationCollection& associations = object_man.object(dbo_name).associations();
+
+        for (auto& tr : trs)
+        {
+            ++metrics.num_target_reports;
+            ++truth_counts[tr.truth_id_];
+
+            std::vector<unsigned int> utns = associations.getUTNsFor(tr.rec_num_);
+
+            if (!utns.size())
+                continue;
+
+            ++metrics.num_associated;
+            ++utn_truth_counts[utns.at(0)][tr.truth_id_];
+            ++truth_utn_counts[tr.truth_id_][utns.at(0)];
+        }
+    };
+
+    add(radar_dbo_name, scenario.radarReports());
+    add(tracker_dbo_name, scenario.trackerReports());
+
+    auto max_count = [](const std::map<unsigned int, size_t>& counts) {
+        size_t max_cnt = 0;
+        for (auto& cnt_it : counts)
+            max_cnt = std::max(max_cnt, cnt_it.second);
+        return max_cnt;
+    };
+
+    size_t pure_cnt = 0;
+    for (auto& utn_it : utn_truth_counts)
+        pure_cnt += max_count(utn_it.second);
+
+    size_t complete_cnt = 0;
+    for (auto& truth_it : truth_utn_counts)
+        complete_cnt += max_count(truth_it.second);
+
+    metrics.num_utns = utn_truth_counts.size();
+
+    if (metrics.num_associated)
+        metrics.purity = (double)pure_cnt / metrics.num_associated;
+
+    if (metrics.num_target_reports)
+        metrics.completeness = (double)complete_cnt / metrics.num_target_reports;
+
+    return metrics;
+}
+
+void logResult(const std::string& job_name, double run_time,
+               const std::map<std::string, double>& phase_times, const AssociationMetrics& metrics)
+{
+    loginf << "AssociationBench: " << job_name << ": run time "
+           << String::doubleToStringPrecision(run_time, 3) << " s";
+
+    for (auto& phase_it : phase_times)
+        loginf << "AssociationBench: " << job_name << ":   " << phase_it.first << " "
+               << String::doubleToStringPrecision(phase_it.second, 3) << " s";
+
+    loginf << "AssociationBench: " << job_name << ": target reports " << metrics.num_target_reports
+           << " associated " << metrics.num_associated << " utns " << metrics.num_utns
+           << " purity " << String::doubleToStringPrecision(metrics.purity, 4)
+           << " completeness " << String::doubleToStringPrecision(metrics.completeness, 4);
+}
+}  // namespace
+
+TEST_CASE("COMPASS Association Benchmark", "[COMPASS]")
+{
+    int argc = 1;
+    char* argv[1];
+    argv[0] = "test";
+
+    // create client
+    Client client(argc, argv);
+
+    QThread::msleep(100);  // delay
+
+    processEvents(client);
+
+    REQUIRE(!client.quitRequested());
+
+    // create main window
+    client.mainWindow().show();
+    client.mainWindow().disableConfigurationSaving();
+
+    QThread::msleep(100);  // delay
+
+    processEvents(client);
+
+    // create and open sqlite3 database
+    std::string db_filename = data_path + "association_bench.db";
+
+    if (Files::fileExists(db_filename))
+        Files::deleteFile(db_filename);
+
+    REQUIRE(!Files::fileExists(db_filename));
+
+    TaskManager& task_manager = COMPASS::instance().taskManager();
+    TaskManagerWidget* task_manager_widget = task_manager.widget();
+
+    DatabaseOpenTask& db_open_task = task_manager.databaseOpenTask();
+    db_open_task.useConnection("SQLite Connection");
+
+    SQLiteConnectionWidget* connection_widget =
+        dynamic_cast<SQLiteConnectionWidget*>(COMPASS::instance().interface().connectionWidget());
+    REQUIRE(connection_widget);
+
+    connection_widget->addFile(db_filename);
+    connection_widget->selectFile(db_filename);
+    connection_widget->openFileSlot();
+
+    processEvents(client);
+
+    // clear previous data sources
+    ManageDataSourcesTask& manage_ds_task = task_manager.manageDataSourcesTask();
+    manage_ds_task.clearConfigDataSources();
+
+    processEvents(client);
+
+    // generate and insert synthetic data
+    loginf << "AssociationBench: generating scenario seed " << scenario_config.seed_ << " aircraft "
+           << scenario_config.num_aircraft_ << " duration " << scenario_config.duration_;
+
+    AssociationScenario scenario(scenario_config);
+
+    REQUIRE(scenario.radarReports().size());
+    REQUIRE(scenario.trackerReports().size());
+
+    insertData(client, radar_dbo_name, scenario.radarReports(), scenario.radarDataSources());
+    insertData(client, tracker_dbo_name, scenario.trackerReports(), scenario.trackerDataSources());
+
+    // post-process
+    PostProcessTask& post_process_task = task_manager.postProcessTask();
+    task_manager_widget->setCurrentTask(post_process_task);
+    REQUIRE(task_manager_widget->getCurrentTaskName() == post_process_task.name());
+    post_process_task.showDoneSummary(false);
+
+    task_manager_widget->runCurrentTaskSlot();
+
+    QThread::msleep(100);
+
+    while (client.hasPendingEvents() || !post_process_task.done())
+        client.processEvents();
+
+    REQUIRE(task_manager_widget->isStartPossible());
+
+    task_manager_widget->startSlot();
+
+    processEvents(client);
+
+    QThread::msleep(100);  // delay
+
+    REQUIRE(COMPASS::instance().objectManager().object(tracker_dbo_name).hasDataSources());
+
+    json report;
+    report["scenario"] = {{"seed", scenario_config.seed_},
+                          {"aircraft", scenario_config.num_aircraft_},
+                          {"duration", scenario_config.duration_},
+                          {"mode_s_ratio", scenario_config.mode_s_ratio_},
+                          {"radars", scenario_config.num_radars_},
+                          {"radar_pd", scenario_config.radar_pd_},
+                          {"track_swap_ratio", scenario_config.track_swap_ratio_},
+                          {"radar_reports", scenario.radarReports().size()},
+                          {"tracker_reports", scenario.trackerReports().size()}};
+
+    // association
+    {
+        CreateAssociationsJob job(task_manager.createAssociationsTask(),
+                                  COMPASS::instance().interface(), createBuffers(scenario));
+
+        std::map<std::string, double> phase_times;
+        double run_time = runJob(job, data_path + "association_bench_trace.json", phase_times);
+
+        AssociationMetrics metrics = calculateMetrics(scenario);
+        logResult("CreateAssociationsJob", run_time, phase_times, metrics);
+
+        report["association"] = metrics.asJSON();
+        report["association"]["run_time"] = run_time;
+        report["association"]["phases"] = phase_times;
+
+        CHECK(metrics.purity >= min_purity);
+        CHECK(metrics.completeness >= min_completeness);
+    }
+
+    // re-run with same settings, cached evaluation results must not be used
+    {
+        DBInterface& db_interface = COMPASS::instance().interface();
+        DBObjectManager& object_man = COMPASS::instance().objectManager();
+
+        db_interface.setEvaluationResults("test_key", {});
+        unsigned int generation = object_man.associationsGeneration();
+
+        CreateAssociationsJob job(task_manager.createAssociationsTask(), db_interface,
+                                  createBuffers(scenario));
+
+        std::map<std::string, double> phase_times;
+        runJob(job, data_path + "association_bench_rerun_trace.json", phase_times);
+
+        REQUIRE(object_man.associationsGeneration() > generation);
+        REQUIRE(db_interface.evaluationResultsKey().empty());
+    }
+
+    // artas association
+    {
+        CreateARTASAssociationsTask& artas_task = task_manager.createArtasAssociationsTask();
+
+        CreateARTASAssociationsJob job(artas_task, COMPASS::instance().interface(),
+                                       createBuffers(scenario));
+        job.setSaveQuestionAnswer(true);  // save regardless of missing hashes
+
+        std::map<std::string, double> phase_times;
+        double run_time = runJob(job, data_path + "artas_association_bench_trace.json", phase_times);
+
+        AssociationMetrics metrics = calculateMetrics(scenario);
+        logResult("CreateARTASAssociationsJob", run_time, phase_times, metrics);
+
+        report["artas_association"] = metrics.asJSON();
+        report["artas_association"]["run_time"] = run_time;
+        report["artas_association"]["phases"] = phase_times;
+        report["artas_association"]["missing_hashes"] = job.missingHashes();
+        report["artas_association"]["dubious_associations"] = job.dubiousAssociations();
+
+        CHECK(job.missingHashes() == 0);
+    }
+
+    std::ofstream output(data_path + report_filename);
+    output << report.dump(4);
+    REQUIRE(output.good());
+
+    loginf << "AssociationBench: report written to '" << data_path + report_filename << "'";
+
+    client.mainWindow().close();
+
+    processEvents(client);
+
+    QThread::msleep(100);  // delay
+}
+
+int main(int argc, char* argv[])
+{
+    Catch::Session session;
+
+    // Build a new parser on top of Catch's
+    using namespace Catch::clara;
+    auto cli = session.cli() |
+               Opt(data_path, "data_path")["--data_path"]("path for database, traces and report") |
+               Opt(report_filename, "report_filename")["--report"]("report filename in data path") |
+               Opt(scenario_config.seed_, "seed")["--seed"]("random seed") |
+               Opt(scenario_config.num_aircraft_, "num_aircraft")["--num_aircraft"](
+                   "number of aircraft") |
+               Opt(scenario_config.duration_, "duration")["--duration"]("scenario duration [s]") |
+               Opt(scenario_config.mode_s_ratio_, "mode_s_ratio")["--mode_s_ratio"](
+                   "ratio of aircraft with target address [0-1]") |
+               Opt(scenario_config.mode_ac_ratio_, "mode_ac_ratio")["--mode_ac_ratio"](
+                   "ratio of non-Mode S aircraft with Mode A/C [0-1]") |
+               Opt(scenario_config.num_radars_, "num_radars")["--num_radars"]("number of radars") |
+               Opt(scenario_config.radar_pd_, "radar_pd")["--radar_pd"](
+                   "radar detection probability [0-1]") |
+               Opt(scenario_config.radar_noise_, "radar_noise")["--radar_noise"](
+                   "radar position standard deviation [m]") |
+               Opt(scenario_config.track_swap_ratio_, "track_swap_ratio")["--track_swap_ratio"](
+                   "ratio of aircraft with swapped track numbers [0-1]") |
+               Opt(min_purity, "min_purity")["--min_purity"]("minimum association purity [0-1]") |
+               Opt(min_completeness, "min_completeness")["--min_completeness"](
+                   "minimum association completeness [0-1]");
+
+    // Now pass the new composite back to Catch so it uses that
+    session.cli(cli);
+
+    // Let Catch (using Clara) parse the command line
+    int returnCode = session.applyCommandLine(argc, argv);
+    if (returnCode != 0)  // Indicates a command line error
+        return returnCode;
+
+    if (data_path.size())
+        std::cout << "data_path: '" << data_path << "'" << std::endl;
+    else
+    {
+        std::cout << "data_path variable missing" << std::endl;
+        return -1;
+    }
+
+    return session.run();
+}
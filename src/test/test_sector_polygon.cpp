@@ -0,0 +1,342 @@
+/*
+ * This file is part of OpenATS COMPASS.
+ *
+ * COMPASS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * COMPASS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with COMPASS. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define CATCH_CONFIG_RUNNER
+#include "catch.hpp"
+#include "json.hpp"
+#include "sectorpolygon.h"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <random>
+
+using namespace nlohmann;
+
+std::string data_path;
+std::string filename;
+
+unsigned int num_random_points {10000};
+
+namespace
+{
+/// @brief Uniform random numbers from mt19937 only, standard distributions are implementation defined
+double uniform(std::mt19937& engine, double min, double max)
+{
+    return min + (max - min) * (engine() / 4294967296.0);
+}
+
+/// @brief Star shaped polygon around center, with random radius per vertex
+std::vector<std::pair<double,double>> createStarPolygon(std::mt19937& engine, double latitude, double longitude,
+                                                        double radius, unsigned int num_points)
+{
+    std::vector<std::pair<double,double>> points;
+
+    double angle, distance;
+
+    for (unsigned int cnt=0; cnt < num_points; ++cnt)
+    {
+        angle = 2 * M_PI * cnt / num_points;
+        distance = uniform(engine, radius / 4, radius);
+
+        points.push_back({latitude + distance * cos(angle), longitude + distance * sin(angle)});
+    }
+
+    return points;
+}
+
+/// @brief Checks vertices, edge points, points close to edges and random points in bounding box against OGR
+void checkPolygon(const std::vector<std::pair<double,double>>& points, std::mt19937& engine,
+                  unsigned int& num_checked, unsigned int& num_inside)
+{
+    SectorPolygon polygon (points);
+
+    std::vector<double> latitudes;
+    std::vector<double> longitudes;
+
+    double lat_min = points.at(0).first, lat_max = lat_min;
+    double lon_min = points.at(0).second, lon_max = lon_min;
+
+    for (auto& point_it : points)
+    {
+        lat_min = std::min(lat_min, point_it.first);
+        lat_max = std::max(lat_max, point_it.first);
+        lon_min = std::min(lon_min, point_it.second);
+        lon_max = std::max(lon_max, point_it.second);
+    }
+
+    double offsets[] {0, 1e-12, -1e-12, 1e-10, -1e-10, 1e-7, -1e-7};
+
+    for (unsigned int cnt=0; cnt < points.size(); ++cnt)
+    {
+        const std::pair<double,double>& point1 = points.at(cnt);
+        const std::pair<double,double>& point2 = points.at((cnt + 1) % points.size());
+
+        for (double offset : offsets)
+        {
+            // vertex
+            latitudes.push_back(point1.first + offset);
+            longitudes.push_back(point1.second);
+            latitudes.push_back(point1.first);
+            longitudes.push_back(point1.second + offset);
+
+            // along edge
+            for (double fraction : {0.5, uniform(engine, 0, 1)})
+            {
+                latitudes.push_back(point1.first + fraction * (point2.first - point1.first) + offset);
+                longitudes.push_back(point1.second + fraction * (point2.second - point1.second));
+                latitudes.push_back(point1.first + fraction * (point2.first - point1.first));
+                longitudes.push_back(point1.second + fraction * (point2.second - point1.second) + offset);
+            }
+        }
+    }
+
+    double lat_margin = (lat_max - lat_min) / 10;
+    double lon_margin = (lon_max - lon_min) / 10;
+
+    for (unsigned int cnt=0; cnt < num_random_points; ++cnt)
+    {
+        latitudes.push_back(uniform(engine, lat_min - lat_margin, lat_max + lat_margin));
+        longitudes.push_back(uniform(engine, lon_min - lon_margin, lon_max + lon_margin));
+    }
+
+    std::vector<bool> flags;
+    polygon.isInside(latitudes, longitudes, flags);
+
+    REQUIRE (flags.size() == latitudes.size());
+
+    for (unsigned int cnt=0; cnt < latitudes.size(); ++cnt)
+    {
+        INFO ("latitude " << std::setprecision(17) << latitudes.at(cnt) << " longitude " << longitudes.at(cnt));
+
+        REQUIRE (flags.at(cnt) == polygon.isInsideOGR(latitudes.at(cnt), longitudes.at(cnt)));
+        REQUIRE (polygon.isInside(latitudes.at(cnt), longitudes.at(cnt)) == flags.at(cnt));
+
+        num_inside += flags.at(cnt);
+    }
+
+    num_checked += latitudes.size();
+}
+
+/// @brief Checks number of random points in bounding box inside by batch API against OGR
+void checkRandomPositions(const std::vector<std::pair<double,double>>& points, std::mt19937& engine)
+{
+    SectorPolygon polygon (points);
+
+    std::vector<double> latitudes;
+    std::vector<double> longitudes;
+
+    auto lat_min_max = std::minmax_element(points.begin(), points.end());
+
+    double lon_min = points.at(0).second, lon_max = lon_min;
+
+    for (auto& point_it : points)
+    {
+        lon_min = std::min(lon_min, point_it.second);
+        lon_max = std::max(lon_max, point_it.second);
+    }
+
+    for (unsigned int cnt=0; cnt < num_random_points; ++cnt)
+    {
+        latitudes.push_back(uniform(engine, lat_min_max.first->first, lat_min_max.second->first));
+        longitudes.push_back(uniform(engine, lon_min, lon_max));
+    }
+
+    unsigned int num_inside_ogr = 0;
+
+    for (unsigned int cnt=0; cnt < num_random_points; ++cnt)
+        num_inside_ogr += polygon.isInsideOGR(latitudes.at(cnt), longitudes.at(cnt));
+
+    std::vector<bool> flags;
+    polygon.isInside(latitudes, longitudes, flags);
+
+    unsigned int num_inside = std::count(flags.begin(), flags.end(), true);
+
+    CHECK (num_inside == num_inside_ogr);
+}
+}  // namespace
+
+TEST_CASE( "COMPASS Sector Polygon Synthetic", "[COMPASS]" )
+{
+    std::mt19937 engine (42);
+
+    unsigned int num_checked = 0;
+    unsigned int num_inside = 0;
+
+    for (unsigned int num_points : {3, 4, 5, 10, 50, 200, 1000, 5000})
+    {
+        std::vector<std::pair<double,double>> points = createStarPolygon(engine, 47.5, 14.0, 1.0, num_points);
+
+        REQUIRE (SectorPolygon(points).native());
+
+        checkPolygon(points, engine, num_checked, num_inside);
+
+        // explicitly closed ring
+        points.push_back(points.at(0));
+        checkPolygon(points, engine, num_checked, num_inside);
+    }
+
+    // axis-aligned rectangle, edges without latitude extent
+    checkPolygon({{47.0, 13.0}, {47.0, 15.0}, {48.0, 15.0}, {48.0, 13.0}}, engine, num_checked, num_inside);
+
+    // self-intersecting bow tie, checked by OGR
+    std::vector<std::pair<double,double>> bow_tie {{47.0, 13.0}, {48.0, 15.0}, {48.0, 13.0}, {47.0, 15.0}};
+    REQUIRE (!SectorPolygon(bow_tie).native());
+    checkPolygon(bow_tie, engine, num_checked, num_inside);
+
+    REQUIRE (num_inside > 0);
+    REQUIRE (num_inside < num_checked);
+
+    checkRandomPositions(createStarPolygon(engine, 47.5, 14.0, 1.0, 50), engine);
+    checkRandomPositions(createStarPolygon(engine, 47.5, 14.0, 1.0, 5000), engine);
+}
+
+TEST_CASE( "COMPASS Sector Polygon Box Containment", "[COMPASS]" )
+{
+    std::mt19937 engine (42);
+
+    unsigned int num_inside = 0;
+    unsigned int num_outside = 0;
+    unsigned int num_mixed = 0;
+
+    for (unsigned int num_points : {3, 10, 200, 5000})
+    {
+        SectorPolygon polygon (createStarPolygon(engine, 47.5, 14.0, 1.0, num_points));
+
+        for (double box_size : {1e-6, 1e-3, 0.05, 0.5, 3.0})
+        {
+            for (unsigned int box_cnt=0; box_cnt < 200; ++box_cnt)
+            {
+                double lat_min = uniform(engine, 46.0, 49.0);
+                double lon_min = uniform(engine, 12.5, 15.5);
+                double lat_max = lat_min + uniform(engine, 0, box_size);
+                double lon_max = lon_min + uniform(engine, 0, box_size);
+
+                SectorPolygon::BoxContainment containment =
+                        polygon.boxContainment(lat_min, lat_max, lon_min, lon_max);
+
+                if (containment == SectorPolygon::BoxContainment::Mixed)
+                {
+                    ++num_mixed;
+                    continue;
+                }
+
+                bool inside = containment == SectorPolygon::BoxContainment::Inside;
+
+                num_inside += inside;
+                num_outside += !inside;
+
+                // corners and random positions in box
+                std::vector<std::pair<double,double>> positions {
+                    {lat_min, lon_min}, {lat_min, lon_max}, {lat_max, lon_min}, {lat_max, lon_max}};
+
+                for (unsigned int cnt=0; cnt < 20; ++cnt)
+                    positions.push_back({uniform(engine, lat_min, lat_max), uniform(engine, lon_min, lon_max)});
+
+                for (auto& pos_it : positions)
+                {
+                    INFO ("latitude " << std::setprecision(17) << pos_it.first << " longitude " << pos_it.second);
+
+                    REQUIRE (polygon.isInside(pos_it.first, pos_it.second) == inside);
+                }
+            }
+        }
+    }
+
+    REQUIRE (num_inside > 0);
+    REQUIRE (num_outside > 0);
+    REQUIRE (num_mixed > 0);
+}
+
+// hidden, only run if selected by tag, fails if the sectors file is not given or missing
+TEST_CASE( "COMPASS Sector Polygon Imported", "[.][COMPASS][imported]" )
+{
+    if (!filename.size())
+        FAIL ("filename missing, imported sectors can not be checked");
+
+    INFO ("sectors file '" << data_path + filename << "'");
+
+    std::ifstream input_file(data_path + filename, std::ifstream::in);
+    REQUIRE (input_file.good());
+
+    json j = json::parse(input_file);
+
+    REQUIRE (j.contains("sectors"));
+    REQUIRE (j.at("sectors").is_array());
+
+    std::mt19937 engine (42);
+
+    unsigned int num_sectors = 0;
+    unsigned int num_checked = 0;
+    unsigned int num_inside = 0;
+
+    for (auto& j_sec_it : j.at("sectors").get<json::array_t>())
+    {
+        if (!j_sec_it.contains("points") || !j_sec_it.at("points").is_array())
+            continue;
+
+        std::vector<std::pair<double,double>> points;
+
+        for (json& point_it : j_sec_it.at("points").get<json::array_t>())
+        {
+            REQUIRE (point_it.is_array());
+            REQUIRE (point_it.size() == 2);
+
+            points.push_back({point_it[0], point_it[1]});
+        }
+
+        if (!points.size())
+            continue;
+
+        std::string name = j_sec_it.contains("name") ? j_sec_it.at("name").get<std::string>() : "";
+
+        INFO ("sector '" << name << "'");
+
+        checkPolygon(points, engine, num_checked, num_inside);
+        checkRandomPositions(points, engine);
+
+        ++num_sectors;
+    }
+
+    REQUIRE (num_sectors > 0);
+    CHECK (num_inside > 0);
+    CHECK (num_inside < num_checked);
+}
+
+int main(int argc, char* argv[])
+{
+    Catch::Session session;
+
+    // Build a new parser on top of Catch's
+    using namespace Catch::clara;
+    auto cli = session.cli() |
+               Opt(data_path, "data_path")["--data_path"]("path for sectors file") |
+               Opt(filename, "filename")["--filename"]("sectors file, as exported from evaluation") |
+               Opt(num_random_points, "num_random_points")["--num_random_points"](
+                   "number of random positions per polygon");
+
+    // Now pass the new composite back to Catch so it uses that
+    session.cli(cli);
+
+    // Let Catch (using Clara) parse the command line
+    int returnCode = session.applyCommandLine(argc, argv);
+    if (returnCode != 0)  // Indicates a command line error
+        return returnCode;
+
+    return session.run();
+}
@@ -0,0 +1,125 @@
+/*
+ * This file is part of OpenATS COMPASS.
+ *
+ * COMPASS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * COMPASS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with COMPASS. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef BOUNDEDCHANNEL_H
+#define BOUNDEDCHANNEL_H
+
+#include <deque>
+#include <mutex>
+#include <utility>
+
+#include "creditgate.h"
+
+/**
+ * @brief Bounded FIFO channel for passing work items from a producer job to a consumer
+ *
+ * Pushing consumes a credit and blocks while none is available. Popping does not return the credit,
+ * the consumer has to release it once the item was processed completely (e.g. mapped and inserted),
+ * so the capacity bounds all items between producer and final consumer.
+ */
+template <typename T>
+class BoundedChannel
+{
+  public:
+    /// @brief Constructor with maximum number of items in flight
+    BoundedChannel(size_t capacity) : credits_(capacity) {}
+
+    BoundedChannel(const BoundedChannel&) = delete;
+    BoundedChannel& operator=(const BoundedChannel&) = delete;
+
+    /// @brief Removes all items, returns all credits, sets capacity and reopens
+    void reset(size_t capacity)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            items_.clear();
+        }
+
+        credits_.reset(capacity);
+    }
+
+    /// @brief Blocks until a credit is available, then adds item. Returns false if closed.
+    bool push(T&& item)
+    {
+        unsigned int generation = credits_.acquire();
+
+        if (!generation)
+            return false;
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        items_.emplace_back(generation, std::move(item));
+
+        return true;
+    }
+
+    /// @brief As push, but returns false after timeout. Item is only moved if added.
+    bool push(T&& item, unsigned int timeout_ms)
+    {
+        unsigned int generation = credits_.acquire(timeout_ms);
+
+        if (!generation)
+            return false;
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        items_.emplace_back(generation, std::move(item));
+
+        return true;
+    }
+
+    /// @brief Moves out the oldest item if one exists, credit stays in use until release.
+    /// Returns the credit generation to be passed to release, 0 if no item exists.
+    unsigned int tryPop(T& item)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        if (!items_.size())
+            return 0;
+
+        unsigned int generation = items_.front().first;
+        item = std::move(items_.front().second);
+        items_.pop_front();
+
+        return generation;
+    }
+
+    /// @brief Returns credit of a completely processed item, wakes a blocked producer. Credits
+    /// of items popped before a reset are ignored.
+    void release(unsigned int generation) { credits_.release(generation); }
+
+    /// @brief Unblocks producers, later pushes fail until reset
+    void close() { credits_.close(); }
+    bool closed() { return credits_.closed(); }
+
+    /// @brief Returns number of items not yet popped
+    size_t size()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return items_.size();
+    }
+    bool empty() { return size() == 0; }
+
+    /// @brief Returns number of items pushed but not released
+    size_t inFlight() { return credits_.inUse(); }
+
+  protected:
+    CreditGate credits_;
+
+    std::mutex mutex_;
+    std::deque<std::pair<unsigned int, T>> items_;  // credit generation, item
+};
+
+#endif  // BOUNDEDCHANNEL_H
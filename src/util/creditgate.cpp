@@ -0,0 +1,130 @@
+/*
+ * This file is part of OpenATS COMPASS.
+ *
+ * COMPASS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * COMPASS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with COMPASS. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "creditgate.h"
+#include "logger.h"
+
+#include <cassert>
+#include <chrono>
+
+CreditGate::CreditGate(size_t capacity) : capacity_(capacity) { assert(capacity_); }
+
+unsigned int CreditGate::reset(size_t capacity)
+{
+    assert(capacity);
+
+    unsigned int generation;
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        capacity_ = capacity;
+        in_use_ = 0;
+        closed_ = false;
+
+        if (!++generation_)  // wrapped
+            generation_ = 1;
+
+        generation = generation_;
+    }
+
+    condition_.notify_all();
+
+    return generation;
+}
+
+unsigned int CreditGate::acquire()
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+
+    condition_.wait(lock, [this] { return closed_ || in_use_ < capacity_; });
+
+    if (closed_)
+        return 0;
+
+    ++in_use_;
+    return generation_;
+}
+
+unsigned int CreditGate::acquire(unsigned int timeout_ms)
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+
+    if (!condition_.wait_for(lock, std::chrono::milliseconds(timeout_ms),
+                             [this] { return closed_ || in_use_ < capacity_; }))
+        return 0;  // timeout
+
+    if (closed_)
+        return 0;
+
+    ++in_use_;
+    return generation_;
+}
+
+void CreditGate::release(unsigned int generation)
+{
+    assert(generation);
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        if (generation != generation_)  // acquired before reset, credits already returned
+        {
+            logdbg << "CreditGate: release: ignoring credit of generation " << generation;
+            return;
+        }
+
+        assert(in_use_);
+        --in_use_;
+    }
+
+    condition_.notify_one();
+}
+
+void CreditGate::close()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        closed_ = true;
+    }
+
+    condition_.notify_all();
+}
+
+bool CreditGate::closed()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return closed_;
+}
+
+size_t CreditGate::capacity()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return capacity_;
+}
+
+size_t CreditGate::inUse()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return in_use_;
+}
+
+unsigned int CreditGate::generation()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return generation_;
+}
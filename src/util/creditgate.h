@@ -0,0 +1,74 @@
+/*
+ * This file is part of OpenATS COMPASS.
+ *
+ * COMPASS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * COMPASS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with COMPASS. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef CREDITGATE_H
+#define CREDITGATE_H
+
+#include <condition_variable>
+#include <mutex>
+
+/**
+ * @brief Credit-based flow control between a producer and its consumers
+ *
+ * A producer acquires one credit per work item before handing it downstream, and blocks while all
+ * credits are in use. The consumer releases the credit once the item was completely processed,
+ * which wakes a blocked producer. This bounds the number of items in flight without polling.
+ *
+ * Closing the gate unblocks all producers, later acquisitions fail until reset.
+ *
+ * Each reset starts a new generation. Acquisitions return the generation of their credit, which
+ * has to be passed to release, so that credits of items in flight before a reset are ignored.
+ */
+class CreditGate
+{
+  public:
+    /// @brief Constructor with number of credits
+    CreditGate(size_t capacity);
+
+    CreditGate(const CreditGate&) = delete;
+    CreditGate& operator=(const CreditGate&) = delete;
+
+    /// @brief Returns all credits, sets capacity and reopens. Returns the new generation.
+    unsigned int reset(size_t capacity);
+
+    /// @brief Blocks until a credit is available. Returns its generation, 0 if closed.
+    unsigned int acquire();
+    /// @brief Blocks until a credit is available or timeout. Returns its generation, 0 if closed or
+    /// timed out.
+    unsigned int acquire(unsigned int timeout_ms);
+    /// @brief Returns a credit of generation, wakes a blocked producer. Ignored for old generations.
+    void release(unsigned int generation);
+
+    /// @brief Unblocks all producers, acquisitions fail until reset
+    void close();
+    bool closed();
+
+    size_t capacity();
+    size_t inUse();
+    unsigned int generation();
+
+  protected:
+    std::mutex mutex_;
+    std::condition_variable condition_;
+
+    size_t capacity_{0};
+    size_t in_use_{0};
+    bool closed_{false};
+    unsigned int generation_{1};  // 0 is returned for failed acquisitions
+};
+
+#endif  // CREDITGATE_H
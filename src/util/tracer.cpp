@@ -0,0 +1,209 @@
+/*
+ * This file is part of OpenATS COMPASS.
+ *
+ * COMPASS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * COMPASS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with COMPASS. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "tracer.h"
+#include "json.hpp"
+#include "logger.h"
+
+#include <cassert>
+#include <fstream>
+#include <stdexcept>
+#include <thread>
+
+using namespace nlohmann;
+
+const std::string TraceSpan::empty_detail_;
+
+TraceBuffer::TraceBuffer(unsigned int thread_id, size_t capacity)
+    : thread_id_(thread_id), capacity_(capacity)
+{
+    assert(capacity);
+}
+
+void TraceBuffer::add(const char* category, const char* name, std::string detail,
+                      uint64_t start_us, uint64_t duration_us)
+{
+    if (events_.empty())  // allocated on first add, so buffers of finished threads stay small
+        events_.resize(capacity_);
+
+    size_t pos = write_pos_.load(std::memory_order_relaxed);
+
+    TraceEvent& event = events_[pos % events_.size()];
+    event.category_ = category;
+    event.name_ = name;
+    event.detail_ = std::move(detail);
+    event.start_us_ = start_us;
+    event.duration_us_ = duration_us;
+
+    write_pos_.store(pos + 1, std::memory_order_release);
+}
+
+void TraceBuffer::reset(size_t capacity)
+{
+    assert(capacity);
+
+    std::vector<TraceEvent>().swap(events_);
+    capacity_ = capacity;
+    write_pos_ = 0;
+}
+
+std::vector<const TraceEvent*> TraceBuffer::events() const
+{
+    size_t end = write_pos_.load(std::memory_order_acquire);
+    size_t begin = end > capacity_ ? end - capacity_ : 0;
+
+    std::vector<const TraceEvent*> events;
+    events.reserve(end - begin);
+
+    for (size_t pos = begin; pos < end; ++pos)
+        events.push_back(&events_[pos % events_.size()]);
+
+    return events;
+}
+
+void Tracer::start(const std::string& filename, size_t events_per_thread)
+{
+    assert(!enabled_);
+    assert(filename.size());
+    assert(events_per_thread);
+
+    loginf << "Tracer: start: recording into '" << filename << "', " << events_per_thread
+           << " events per thread";
+
+    {
+        std::lock_guard<std::mutex> lock(buffers_mutex_);
+
+        // adds of threads which saw enabled_ of the previous recording might still be running
+        waitForWriters();
+
+        for (auto& buffer_it : buffers_)
+            buffer_it->reset(events_per_thread);
+
+        filename_ = filename;
+        events_per_thread_ = events_per_thread;
+    }
+
+    start_time_ = std::chrono::steady_clock::now();
+
+    enabled_ = true;
+}
+
+void Tracer::write()
+{
+    if (!enabled_)
+        return;
+
+    enabled_ = false;  // running spans are dropped
+
+    std::lock_guard<std::mutex> lock(buffers_mutex_);
+
+    // events are not written concurrently
+    waitForWriters();
+
+    loginf << "Tracer: write: writing " << buffers_.size() << " thread buffers to '" << filename_
+           << "'";
+
+    std::ofstream output(filename_);
+
+    if (!output)
+        throw std::runtime_error("Tracer: write: unable to open file " + filename_);
+
+    output << "{\"traceEvents\":[\n";
+
+    bool first = true;
+    size_t num_events = 0;
+
+    for (auto& buffer_it : buffers_)
+    {
+        for (const TraceEvent* event_it : buffer_it->events())
+        {
+            json event{{"ph", "X"},
+                       {"pid", 1},
+                       {"tid", buffer_it->threadId()},
+                       {"cat", event_it->category_},
+                       {"name", event_it->name_},
+                       {"ts", event_it->start_us_},
+                       {"dur", event_it->duration_us_}};
+
+            if (event_it->detail_.size())
+                event["args"]["detail"] = event_it->detail_;
+
+            if (!first)
+                output << ",\n";
+
+            output << event.dump();
+            first = false;
+            ++num_events;
+        }
+    }
+
+    output << "\n],\"displayTimeUnit\":\"ms\"}\n";
+
+    loginf << "Tracer: write: wrote " << num_events << " events";
+}
+
+uint64_t Tracer::now() const
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() -
+                                                                 start_time_)
+        .count();
+}
+
+void Tracer::add(const char* category, const char* name, std::string detail,
+                 uint64_t start_us, uint64_t duration_us)
+{
+    if (!enabled_)
+        return;
+
+    // writing flag of own buffer, so that threads do not contend on shared state
+    TraceBuffer& buffer = threadBuffer();
+
+    buffer.writing(true);
+
+    if (enabled_)  // checked again, write might have started, which then waits for writing to be reset
+        buffer.add(category, name, std::move(detail), start_us, duration_us);
+
+    buffer.writing(false);
+}
+
+TraceBuffer& Tracer::threadBuffer()
+{
+    // owned by tracer, so events of finished threads remain
+    static thread_local TraceBuffer* buffer = nullptr;
+
+    if (!buffer)
+    {
+        std::lock_guard<std::mutex> lock(buffers_mutex_);
+
+        buffers_.emplace_back(new TraceBuffer(buffers_.size() + 1, events_per_thread_));
+        buffer = buffers_.back().get();
+    }
+
+    return *buffer;
+}
+
+void Tracer::waitForWriters()
+{
+    assert(!enabled_);
+
+    // flags are sequentially consistent, so an add either sees enabled_ reset or is waited for
+    for (auto& buffer_it : buffers_)
+    {
+        while (buffer_it->writing())
+            std::this_thread::yield();
+    }
+}
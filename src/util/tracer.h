@@ -0,0 +1,156 @@
+/*
+ * This file is part of OpenATS COMPASS.
+ *
+ * COMPASS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * COMPASS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with COMPASS. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TRACER_H
+#define TRACER_H
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "singleton.h"
+
+/// @brief Recorded span, timestamps in microseconds since tracing start
+struct TraceEvent
+{
+    const char* category_{nullptr};
+    const char* name_{nullptr};
+    std::string detail_;
+    uint64_t start_us_{0};
+    uint64_t duration_us_{0};
+};
+
+/**
+ * @brief Ring buffer of trace events written by one thread
+ *
+ * Only the owning thread writes, the oldest events are overwritten when full. Reading and resetting
+ * is done after tracing was stopped and the owner is not writing anymore.
+ */
+class TraceBuffer
+{
+  public:
+    TraceBuffer(unsigned int thread_id, size_t capacity);
+
+    void add(const char* category, const char* name, std::string detail, uint64_t start_us,
+             uint64_t duration_us);
+
+    /// @brief Set by the owning thread around checking the enabled flag and adding
+    void writing(bool value) { writing_ = value; }
+    bool writing() const { return writing_; }
+
+    /// @brief Removes all events and releases their memory, with new capacity
+    void reset(size_t capacity);
+
+    unsigned int threadId() const { return thread_id_; }
+    /// @brief Returns stored events, oldest first
+    std::vector<const TraceEvent*> events() const;
+
+  protected:
+    unsigned int thread_id_{0};
+    size_t capacity_{0};
+    std::vector<TraceEvent> events_; // capacity_ events, empty until first add
+    std::atomic<size_t> write_pos_{0};
+    std::atomic<bool> writing_{false};
+};
+
+/**
+ * @brief Records scoped spans into per-thread ring buffers, exported as Chrome trace-event JSON
+ *
+ * Disabled by default, in which case spans only check a flag. The written file can be opened in
+ * chrome://tracing or Perfetto.
+ */
+class Tracer : public Singleton
+{
+  public:
+    static Tracer& instance()
+    {
+        static Tracer instance;
+        return instance;
+    }
+
+    /// @brief Starts recording, events of previous recordings are removed. Events are written to
+    /// filename by write()
+    void start(const std::string& filename, size_t events_per_thread = 1 << 16);
+    /// @brief Stops recording and writes all events. Throws std::runtime_error on failure.
+    void write();
+
+    bool enabled() const { return enabled_; }
+
+    /// @brief Returns microseconds since start
+    uint64_t now() const;
+    void add(const char* category, const char* name, std::string detail, uint64_t start_us,
+             uint64_t duration_us);
+
+  protected:
+    std::atomic<bool> enabled_{false};
+    std::string filename_;
+    size_t events_per_thread_{0};
+    std::chrono::steady_clock::time_point start_time_;
+
+    std::mutex buffers_mutex_;  // for buffer creation, reading and resetting
+    std::vector<std::unique_ptr<TraceBuffer>> buffers_; // one per thread, kept over recordings
+
+    Tracer() = default;
+
+    TraceBuffer& threadBuffer();
+    void waitForWriters(); // buffers_mutex_ has to be locked and enabled_ reset
+};
+
+/**
+ * @brief Records the lifetime of the object as span, if tracing is enabled
+ *
+ * Category and name must be string literals, detail is only copied if enabled.
+ */
+class TraceSpan
+{
+  public:
+    TraceSpan(const char* category, const char* name) : TraceSpan(category, name, empty_detail_) {}
+    TraceSpan(const char* category, const char* name, const std::string& detail)
+        : enabled_(Tracer::instance().enabled())
+    {
+        if (enabled_)
+        {
+            category_ = category;
+            name_ = name;
+            detail_ = detail;
+            start_us_ = Tracer::instance().now();
+        }
+    }
+    ~TraceSpan()
+    {
+        if (enabled_)
+            Tracer::instance().add(category_, name_, std::move(detail_), start_us_,
+                                   Tracer::instance().now() - start_us_);
+    }
+
+    TraceSpan(const TraceSpan&) = delete;
+    TraceSpan& operator=(const TraceSpan&) = delete;
+
+  protected:
+    static const std::string empty_detail_;
+
+    bool enabled_{false};
+    const char* category_{nullptr};
+    const char* name_{nullptr};
+    std::string detail_;
+    uint64_t start_us_{0};
+};
+
+#endif  // TRACER_H